@@ -0,0 +1,42 @@
+// Serializing Rust values into Duktape and back. Run with
+// `cargo bench -p ducc-serde --bench roundtrip`.
+
+#[macro_use]
+extern crate criterion;
+extern crate ducc;
+extern crate ducc_serde;
+
+use criterion::Criterion;
+use ducc::Ducc;
+use std::collections::BTreeMap;
+
+// Numbers come back from JavaScript as `f64`.
+type Row = (String, f64, f64, bool, Vec<f64>);
+
+fn roundtrip(c: &mut Criterion) {
+    let ducc = Ducc::new();
+
+    let rows: Vec<Row> = (0..1000)
+        .map(|i| {
+            let i = f64::from(i);
+            (format!("row {}", i), i, i / 3.0, i % 2.0 == 0.0, vec![i, i + 1.0, i + 2.0])
+        })
+        .collect();
+    c.bench_function("rows_to_value", |b| b.iter(|| ducc_serde::to_value(&ducc, &rows).unwrap()));
+    c.bench_function("rows_roundtrip", |b| b.iter(|| {
+        let value = ducc_serde::to_value(&ducc, &rows).unwrap();
+        let back: Vec<Row> = ducc_serde::from_value(value).unwrap();
+        assert_eq!(back.len(), rows.len());
+    }));
+
+    let map: BTreeMap<String, f64> = (0..1000).map(|i| (format!("key{}", i), f64::from(i)))
+        .collect();
+    c.bench_function("map_roundtrip", |b| b.iter(|| {
+        let value = ducc_serde::to_value(&ducc, &map).unwrap();
+        let back: BTreeMap<String, f64> = ducc_serde::from_value(value).unwrap();
+        assert_eq!(back.len(), map.len());
+    }));
+}
+
+criterion_group!(benches, roundtrip);
+criterion_main!(benches);
@@ -12,5 +12,85 @@ fn main() {
         builder.define("RUST_DUK_USE_EXEC_TIMEOUT_CHECK", None);
     }
 
+    if cfg!(feature = "use-exec-propcache") {
+        builder.define("RUST_DUK_USE_EXEC_PROPCACHE", None);
+    }
+
+    if cfg!(feature = "use-exec-computed-goto") {
+        builder.define("RUST_DUK_USE_EXEC_COMPUTED_GOTO", None);
+    }
+
+    if cfg!(feature = "use-exec-superinstructions") {
+        builder.define("RUST_DUK_USE_EXEC_SUPERINSTRUCTIONS", None);
+    }
+
+    if cfg!(feature = "use-regexp-linear") {
+        builder.define("RUST_DUK_USE_REGEXP_LINEAR", None);
+    }
+
+    if cfg!(feature = "use-regexp-cache") {
+        builder.define("RUST_DUK_USE_REGEXP_CACHE", None);
+    }
+
+    if cfg!(feature = "use-regexp-prefilter") {
+        builder.define("RUST_DUK_USE_REGEXP_PREFILTER", None);
+    }
+
+    if cfg!(feature = "use-strhash-wide") {
+        builder.define("RUST_DUK_USE_STRHASH_WIDE", None);
+    }
+
+    if cfg!(feature = "use-concat-inplace") {
+        builder.define("RUST_DUK_USE_CONCAT_INPLACE", None);
+    }
+
+    if cfg!(feature = "use-strcache-index") {
+        builder.define("RUST_DUK_USE_STRCACHE_INDEX", None);
+    }
+
+    if cfg!(feature = "use-strsearch-simd") {
+        builder.define("RUST_DUK_USE_STRSEARCH_SIMD", None);
+    }
+
+    if cfg!(feature = "use-numconv-fast") {
+        builder.define("RUST_DUK_USE_NUMCONV_FAST", None);
+    }
+
+    if cfg!(feature = "use-codec-simd") {
+        builder.define("RUST_DUK_USE_CODEC_SIMD", None);
+    }
+
+    if cfg!(feature = "use-random-xoshiro") {
+        builder.define("RUST_DUK_USE_RANDOM_XOSHIRO", None);
+    }
+
+    if cfg!(feature = "use-typedarray-kernels") {
+        builder.define("RUST_DUK_USE_TYPEDARRAY_KERNELS", None);
+    }
+
+    if cfg!(feature = "use-date-fast") {
+        builder.define("RUST_DUK_USE_DATE_FAST", None);
+    }
+
+    if cfg!(feature = "use-proxy-native") {
+        builder.define("RUST_DUK_USE_PROXY_NATIVE", None);
+    }
+
+    if cfg!(feature = "use-sampling-profiler") {
+        builder.define("RUST_DUK_USE_SAMPLING_PROFILER", None);
+    }
+
+    if cfg!(feature = "use-call-stats") {
+        builder.define("RUST_DUK_USE_CALL_STATS", None);
+    }
+
+    if cfg!(feature = "use-alloc-profiler") {
+        builder.define("RUST_DUK_USE_ALLOC_PROFILER", None);
+    }
+
+    if cfg!(feature = "use-heap-walk") {
+        builder.define("RUST_DUK_USE_HEAP_WALK", None);
+    }
+
     builder.compile("libduktape.a");
 }
@@ -28,4 +28,147 @@ void ducc_set_exec_timeout_function(ducc_exec_timeout_function func);
 ducc_exec_timeout_function ducc_get_exec_timeout_function();
 #endif
 
+// Per-instruction property lookup hints for `obj.key` reads and writes in the
+// bytecode executor (see `duk__propcache_getprop`). With the cache, property
+// lookups in hot code rarely scan an object, so small objects (typically
+// records) skip the hash part, which only pays off for larger objects.
+#ifdef RUST_DUK_USE_EXEC_PROPCACHE
+#define DUK_USE_EXEC_PROPCACHE
+#undef DUK_USE_HOBJECT_HASH_PROP_LIMIT
+#define DUK_USE_HOBJECT_HASH_PROP_LIMIT 16
+#endif
+
+// Threaded opcode dispatch through a computed-goto label table. Only takes
+// effect with GCC-compatible compilers; the switch is used otherwise.
+#ifdef RUST_DUK_USE_EXEC_COMPUTED_GOTO
+#define DUK_USE_EXEC_COMPUTED_GOTO
+#endif
+
+// Compiler peephole pass fusing compare + conditional skip instruction pairs
+// into superinstructions.
+#ifdef RUST_DUK_USE_EXEC_SUPERINSTRUCTIONS
+#define DUK_USE_EXEC_SUPERINSTRUCTIONS
+#endif
+
+// Linear-time NFA fallback for regexps without backreferences or lookaheads,
+// used when backtracking exceeds its step budget (see `duk__re_linear_step_budget`).
+#ifdef RUST_DUK_USE_REGEXP_LINEAR
+#define DUK_USE_REGEXP_LINEAR
+#endif
+
+// Per-heap LRU cache of compiled regexps keyed by (pattern, flags).
+#ifdef RUST_DUK_USE_REGEXP_CACHE
+#define DUK_USE_REGEXP_CACHE
+#endif
+
+// Literal prefix / `^` anchor analysis used to skip impossible match positions.
+#ifdef RUST_DUK_USE_REGEXP_PREFILTER
+#define DUK_USE_REGEXP_PREFILTER
+#endif
+
+// Full-length 64-bit multiply-mix string hash instead of the sampled Bernstein
+// hash, for interning-heavy workloads with long or similar keys.
+#ifdef RUST_DUK_USE_STRHASH_WIDE
+#define DUK_USE_STRHASH_WIDE
+#endif
+
+// Append in place for `s += x` when `s` holds the only reference to a long
+// string, so that building output piece by piece takes linear time.
+#ifdef RUST_DUK_USE_CONCAT_INPLACE
+#define DUK_USE_CONCAT_INPLACE
+#endif
+
+// Index long non-ASCII strings for char offset lookups (charAt, substring,
+// indexOf, ...) and keep more strings in the lookup cache.
+#ifdef RUST_DUK_USE_STRCACHE_INDEX
+#define DUK_USE_STRCACHE_INDEX
+#define DUK_USE_STRCACHE_SIZE 16
+#endif
+
+// Substring search for indexOf, includes, split and replace with memchr() or,
+// where available, an SSE2 first/last byte filter.
+#ifdef RUST_DUK_USE_STRSEARCH_SIMD
+#define DUK_USE_STRSEARCH_SIMD
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define DUK_USE_STRSEARCH_SSE2
+#endif
+#endif
+
+// Grisu3 shortest digits (Dragon4 as fallback) and exact integer shortcuts for
+// radix 10 number-to-string, and Clinger's fast path for string-to-number.
+#ifdef RUST_DUK_USE_NUMCONV_FAST
+#define DUK_USE_NUMCONV_FAST
+#endif
+
+// Vectorized base64 and hex codecs and ASCII run copying in TextEncoder and
+// TextDecoder. SSSE3 and AVX2 kernels are selected at runtime.
+#ifdef RUST_DUK_USE_CODEC_SIMD
+#define DUK_USE_CODEC_SIMD
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DUK_USE_CODEC_X86
+#endif
+#endif
+
+// xoshiro256+ instead of xoroshiro128+ for `Math.random()`, inlined into the
+// builtin. Needs 64-bit integer support.
+#ifdef RUST_DUK_USE_RANDOM_XOSHIRO
+#if defined(DUK_USE_64BIT_OPS) && !defined(DUK_USE_PREFER_SIZE) && \
+    !defined(DUK_USE_GET_RANDOM_DOUBLE)
+#define DUK_USE_RANDOM_XOSHIRO
+#endif
+#endif
+
+// Native `fill`, `copyWithin` and `slice` for typed arrays, direct element
+// conversion in `set`, and the Float64Array kernels behind
+// `duk_push_float64_kernels`.
+#ifdef RUST_DUK_USE_TYPEDARRAY_KERNELS
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+#define DUK_USE_TYPEDARRAY_KERNELS
+#endif
+#endif
+
+// Date fast paths: local time offsets memoized per heap, civil date
+// computation without iteration, and direct ISO 8601 formatting and parsing.
+// Offsets are assumed not to change more than once per day, and the process
+// time zone is assumed fixed for the lifetime of a heap.
+#ifdef RUST_DUK_USE_DATE_FAST
+#define DUK_USE_DATE_FAST
+#endif
+
+// `duk_push_proxy_native`: Proxy traps dispatched directly to a native
+// function, without a trap lookup on the handler or a call setup.
+#ifdef RUST_DUK_USE_PROXY_NATIVE
+#if defined(DUK_USE_ES6_PROXY)
+#define DUK_USE_PROXY_NATIVE
+#endif
+#endif
+
+// `duk_set_sampling_profiler`: the executor interrupt hands a snapshot of the
+// call stack to a native callback every N bytecode instructions.
+#ifdef RUST_DUK_USE_SAMPLING_PROFILER
+#define DUK_USE_INTERRUPT_COUNTER
+#define DUK_USE_SAMPLING_PROFILER
+#endif
+
+// `duk_set_call_stats`: per-function call counts and total/self times, taken
+// from the monotonic clock on activation entry and unwind.
+#ifdef RUST_DUK_USE_CALL_STATS
+#define DUK_USE_CALL_STATS
+#endif
+
+// `duk_set_alloc_sampler`: strings, objects, buffers and property tables
+// report every Nth allocated byte with the current call stack.
+#ifdef RUST_DUK_USE_ALLOC_PROFILER
+#define DUK_USE_ALLOC_PROFILER
+#endif
+
+// `duk_walk_heap`: reports every string, object and buffer in the heap with
+// its size and outgoing references, for heap snapshots.
+#ifdef RUST_DUK_USE_HEAP_WALK
+#define DUK_USE_HEAP_WALK
+#endif
+
 #endif // CUSTOM_DUK_CONFIG_H_INCLUDED
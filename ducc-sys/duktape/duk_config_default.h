@@ -2169,6 +2169,9 @@ typedef struct duk_hthread duk_context;
 #if !defined(DUK_MEMCMP)
 #define DUK_MEMCMP       memcmp
 #endif
+#if !defined(DUK_MEMCHR)
+#define DUK_MEMCHR       memchr
+#endif
 #if !defined(DUK_MEMSET)
 #define DUK_MEMSET       memset
 #endif
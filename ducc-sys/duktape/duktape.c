@@ -735,6 +735,9 @@ struct duk_breakpoint;
 struct duk_activation;
 struct duk_catcher;
 struct duk_strcache;
+struct duk_strhash_state;
+struct duk_regexp_cache;
+struct duk_date_tzo_cache;
 struct duk_ljstate;
 struct duk_strtab_entry;
 
@@ -795,6 +798,9 @@ typedef struct duk_breakpoint duk_breakpoint;
 typedef struct duk_activation duk_activation;
 typedef struct duk_catcher duk_catcher;
 typedef struct duk_strcache duk_strcache;
+typedef struct duk_strhash_state duk_strhash_state;
+typedef struct duk_regexp_cache duk_regexp_cache;
+typedef struct duk_date_tzo_cache duk_date_tzo_cache;
 typedef struct duk_ljstate duk_ljstate;
 typedef struct duk_strtab_entry duk_strtab_entry;
 
@@ -2146,6 +2152,11 @@ DUK_INTERNAL_DECL duk_ret_t duk_bi_textencoder_prototype_encode(duk_context *ctx
 DUK_INTERNAL_DECL duk_ret_t duk_bi_textdecoder_prototype_shared_getter(duk_context *ctx);
 DUK_INTERNAL_DECL duk_ret_t duk_bi_textdecoder_prototype_decode(duk_context *ctx);
 DUK_INTERNAL_DECL duk_ret_t duk_bi_performance_now(duk_context *ctx);
+#if defined(DUK_USE_TYPEDARRAY_KERNELS)
+/* Not in the generated init data, see duk_hthread_create_builtin_objects(). */
+DUK_INTERNAL_DECL duk_ret_t duk_bi_typedarray_fill(duk_context *ctx);
+DUK_INTERNAL_DECL duk_ret_t duk_bi_typedarray_copywithin(duk_context *ctx);
+#endif
 #if !defined(DUK_SINGLE_FILE)
 DUK_INTERNAL_DECL const duk_c_function duk_bi_native_functions[176];
 #endif  /* !DUK_SINGLE_FILE */
@@ -2236,6 +2247,8 @@ DUK_INTERNAL_DECL const duk_uint8_t duk_builtins_data[3972];
 
 #if defined(DUK_USE_GET_RANDOM_DOUBLE)
 #define DUK_UTIL_GET_RANDOM_DOUBLE(thr) DUK_USE_GET_RANDOM_DOUBLE((thr)->heap_udata)
+#elif defined(DUK_USE_RANDOM_XOSHIRO)
+#define DUK_UTIL_GET_RANDOM_DOUBLE(thr) duk_util_xoshiro256plus_double((thr)->heap->rnd_state)
 #else
 #define DUK_UTIL_GET_RANDOM_DOUBLE(thr) duk_util_tinyrandom_get_double(thr)
 #endif
@@ -2749,6 +2762,28 @@ DUK_INTERNAL_DECL duk_double_t duk_util_tinyrandom_get_double(duk_hthread *thr);
 DUK_INTERNAL_DECL void duk_util_tinyrandom_prepare_seed(duk_hthread *thr);
 #endif
 
+#if defined(DUK_USE_RANDOM_XOSHIRO)
+/* xoshiro256+ step, inlined into Math.random() and duk_random_fill().  The
+ * top 53 bits give a double in [0,1) with a uniform 2^-53 grid (the low bits
+ * of the '+' variant are weaker, and are discarded).
+ */
+DUK_LOCAL DUK_ALWAYS_INLINE duk_double_t duk_util_xoshiro256plus_double(duk_uint64_t *s) {
+	duk_uint64_t res;
+	duk_uint64_t t;
+
+	res = s[0] + s[3];
+	t = s[1] << 17U;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = (s[3] << 45U) | (s[3] >> 19U);
+
+	return (duk_double_t) (res >> 11U) * (1.0 / 9007199254740992.0);
+}
+#endif
+
 DUK_INTERNAL_DECL void duk_bw_init(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_hbuffer_dynamic *h_buf);
 DUK_INTERNAL_DECL void duk_bw_init_pushbuf(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t buf_size);
 DUK_INTERNAL_DECL duk_uint8_t *duk_bw_resize(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t sz);
@@ -3370,42 +3405,44 @@ typedef duk_uint32_t duk_instr_t;
 #define DUK_OP_GETPROPC_CR          209
 #define DUK_OP_GETPROPC_RC          210
 #define DUK_OP_GETPROPC_CC          211
-#define DUK_OP_UNUSED212            212
-#define DUK_OP_UNUSED213            213
-#define DUK_OP_UNUSED214            214
-#define DUK_OP_UNUSED215            215
-#define DUK_OP_UNUSED216            216
-#define DUK_OP_UNUSED217            217
-#define DUK_OP_UNUSED218            218
-#define DUK_OP_UNUSED219            219
-#define DUK_OP_UNUSED220            220
-#define DUK_OP_UNUSED221            221
-#define DUK_OP_UNUSED222            222
-#define DUK_OP_UNUSED223            223
-#define DUK_OP_UNUSED224            224
-#define DUK_OP_UNUSED225            225
-#define DUK_OP_UNUSED226            226
-#define DUK_OP_UNUSED227            227
-#define DUK_OP_UNUSED228            228
-#define DUK_OP_UNUSED229            229
-#define DUK_OP_UNUSED230            230
-#define DUK_OP_UNUSED231            231
-#define DUK_OP_UNUSED232            232
-#define DUK_OP_UNUSED233            233
-#define DUK_OP_UNUSED234            234
-#define DUK_OP_UNUSED235            235
-#define DUK_OP_UNUSED236            236
-#define DUK_OP_UNUSED237            237
-#define DUK_OP_UNUSED238            238
-#define DUK_OP_UNUSED239            239
-#define DUK_OP_UNUSED240            240
-#define DUK_OP_UNUSED241            241
-#define DUK_OP_UNUSED242            242
-#define DUK_OP_UNUSED243            243
-#define DUK_OP_UNUSED244            244
-#define DUK_OP_UNUSED245            245
-#define DUK_OP_UNUSED246            246
-#define DUK_OP_UNUSED247            247
+#define DUK_OP_EQ_IF                212  /* compare + IFTRUE/IFFALSE superinstructions */
+#define DUK_OP_EQ_IFTRUE_RR         212
+#define DUK_OP_EQ_IFTRUE_RC         213
+#define DUK_OP_EQ_IFFALSE_RR        214
+#define DUK_OP_EQ_IFFALSE_RC        215
+#define DUK_OP_NEQ_IFTRUE_RR        216
+#define DUK_OP_NEQ_IFTRUE_RC        217
+#define DUK_OP_NEQ_IFFALSE_RR       218
+#define DUK_OP_NEQ_IFFALSE_RC       219
+#define DUK_OP_SEQ_IFTRUE_RR        220
+#define DUK_OP_SEQ_IFTRUE_RC        221
+#define DUK_OP_SEQ_IFFALSE_RR       222
+#define DUK_OP_SEQ_IFFALSE_RC       223
+#define DUK_OP_SNEQ_IFTRUE_RR       224
+#define DUK_OP_SNEQ_IFTRUE_RC       225
+#define DUK_OP_SNEQ_IFFALSE_RR      226
+#define DUK_OP_SNEQ_IFFALSE_RC      227
+#define DUK_OP_GT_IFTRUE_RR         228
+#define DUK_OP_GT_IFTRUE_RC         229
+#define DUK_OP_GT_IFFALSE_RR        230
+#define DUK_OP_GT_IFFALSE_RC        231
+#define DUK_OP_GE_IFTRUE_RR         232
+#define DUK_OP_GE_IFTRUE_RC         233
+#define DUK_OP_GE_IFFALSE_RR        234
+#define DUK_OP_GE_IFFALSE_RC        235
+#define DUK_OP_LT_IFTRUE_RR         236
+#define DUK_OP_LT_IFTRUE_RC         237
+#define DUK_OP_LT_IFFALSE_RR        238
+#define DUK_OP_LT_IFFALSE_RC        239
+#define DUK_OP_LE_IFTRUE_RR         240
+#define DUK_OP_LE_IFTRUE_RC         241
+#define DUK_OP_LE_IFFALSE_RR        242
+#define DUK_OP_LE_IFFALSE_RC        243
+#define DUK_OP_ADDASN               244  /* ADD for 'x += y' where B is a dead temp copy of A */
+#define DUK_OP_ADDASN_RR            244
+#define DUK_OP_ADDASN_CR            245
+#define DUK_OP_ADDASN_RC            246
+#define DUK_OP_ADDASN_CC            247
 #define DUK_OP_UNUSED248            248
 #define DUK_OP_UNUSED249            249
 #define DUK_OP_UNUSED250            250
@@ -4155,6 +4192,56 @@ DUK_INTERNAL_DECL void duk_js_compile(duk_hthread *thr, const duk_uint8_t *src_b
 #define DUK_RE_FLAG_GLOBAL                 (1U << 0)
 #define DUK_RE_FLAG_IGNORE_CASE            (1U << 1)
 #define DUK_RE_FLAG_MULTILINE              (1U << 2)
+#define DUK_RE_FLAG_LINEAR                 (1U << 3)  /* internal: linear matcher program appended to bytecode */
+#define DUK_RE_FLAG_ANCHORED               (1U << 4)  /* internal: can only match at input start */
+#define DUK_RE_FLAG_PREFIX                 (1U << 5)  /* internal: header has a literal prefix */
+
+#if defined(DUK_USE_REGEXP_PREFILTER)
+/* With DUK_RE_FLAG_PREFIX the header continues with the byte length of a
+ * literal (case sensitive) prefix every match must start with, followed by
+ * the prefix in the internal string encoding.  Matching only starts at
+ * positions where the prefix is found.
+ */
+#define DUK_RE_PREFIX_MAX_BYTES            32
+#endif
+
+#if defined(DUK_USE_REGEXP_LINEAR)
+/* Limits for the linear-time matcher program (after expanding simple
+ * quantifiers); larger regexps use the backtracking matcher.
+ */
+#define DUK_RE_LINEAR_MAX_INSTR            2048
+#define DUK_RE_LINEAR_MAX_THREAD_SAVES     65536L  /* max instructions * nsaved */
+
+/* The program is built at compile time and appended to the bytecode after
+ * the final MATCH: instructions, ranges, and a trailer of three duk_uint32_t
+ * values (ninstr, nranges, nrestore), all in native byte order and without
+ * alignment.  The backtracking matcher never reads past the MATCH.
+ */
+#define DUK_RE_LINEAR_TRAILER_SIZE         (3 * sizeof(duk_uint32_t))
+
+/* One linear matcher instruction.  Opcodes are DUK_REOP_xxx; SPLIT1 has the
+ * preferred target in 'x' and the other one in 'y'.
+ */
+typedef struct {
+	duk_uint32_t op;
+	duk_uint32_t x;
+	duk_uint32_t y;
+} duk_re_linear_instr;
+
+/* Linear matcher program built from backtracking bytecode. */
+typedef struct {
+	duk_hthread *thr;
+	const duk_uint8_t *bytecode;      /* code start (after header) */
+	const duk_uint8_t *bytecode_end;
+	duk_uint32_t nsaved;
+	duk_re_linear_instr *instrs;      /* NULL when only computing sizes */
+	duk_codepoint_t *ranges;
+	duk_uint32_t *offset_map;         /* bytecode offset -> instruction index */
+	duk_uint32_t ninstr;
+	duk_uint32_t nranges;             /* number of codepoints in 'ranges' */
+	duk_uint32_t nrestore;            /* capture slots saved/wiped by all instructions */
+} duk_re_linear_prog;
+#endif
 
 struct duk_re_matcher_ctx {
 	duk_hthread *thr;
@@ -4170,6 +4257,10 @@ struct duk_re_matcher_ctx {
 	duk_uint32_t recursion_limit;
 	duk_uint32_t steps_count;
 	duk_uint32_t steps_limit;
+#if defined(DUK_USE_REGEXP_PREFILTER)
+	const duk_uint8_t *prefix;  /* points into the bytecode header, see DUK_RE_FLAG_PREFIX */
+	duk_uint32_t prefix_len;
+#endif
 };
 
 struct duk_re_compiler_ctx {
@@ -4184,6 +4275,9 @@ struct duk_re_compiler_ctx {
 	duk_uint32_t recursion_depth;
 	duk_uint32_t recursion_limit;
 	duk_uint32_t nranges;  /* internal temporary value, used for char classes */
+#if defined(DUK_USE_REGEXP_LINEAR)
+	duk_bool_t linear_unsupported;  /* pattern needs matcher semantics the linear matcher lacks */
+#endif
 };
 
 /*
@@ -4195,6 +4289,9 @@ DUK_INTERNAL_DECL void duk_regexp_compile(duk_hthread *thr);
 DUK_INTERNAL_DECL void duk_regexp_create_instance(duk_hthread *thr);
 DUK_INTERNAL_DECL void duk_regexp_match(duk_hthread *thr);
 DUK_INTERNAL_DECL void duk_regexp_match_force_global(duk_hthread *thr);  /* hacky helper for String.prototype.split() */
+#if defined(DUK_USE_REGEXP_LINEAR)
+DUK_INTERNAL_DECL duk_bool_t duk_regexp_linear_build(duk_re_linear_prog *prog);
+#endif
 #endif
 
 #endif  /* DUK_REGEXP_H_INCLUDED */
@@ -6795,6 +6892,13 @@ DUK_INTERNAL_DECL void duk_hobject_compact_props(duk_hthread *thr, duk_hobject *
 DUK_INTERNAL_DECL duk_bool_t duk_hobject_proxy_check(duk_hobject *obj, duk_hobject **out_target, duk_hobject **out_handler);
 DUK_INTERNAL_DECL duk_hobject *duk_hobject_resolve_proxy_target(duk_hobject *obj);
 #endif
+#if defined(DUK_USE_PROXY_NATIVE)
+DUK_INTERNAL_DECL duk_bool_t duk_hobject_proxy_get_trap(duk_hthread *thr, duk_hobject *obj, duk_small_uint_t stridx_trap);
+DUK_INTERNAL_DECL void duk_hobject_proxy_call_trap(duk_hthread *thr, duk_idx_t nargs);
+#elif defined(DUK_USE_ES6_PROXY)
+#define duk_hobject_proxy_get_trap(thr,obj,stridx_trap)  duk_get_prop_stridx_short((thr), -1, (stridx_trap))
+#define duk_hobject_proxy_call_trap(thr,nargs)  duk_call_method((thr), (nargs))
+#endif
 
 /* enumeration */
 DUK_INTERNAL_DECL void duk_hobject_enumerator_create(duk_hthread *thr, duk_small_uint_t enum_flags);
@@ -7539,6 +7643,16 @@ struct duk_activation {
 
 	duk_instr_t *curr_pc;   /* next instruction to execute (points to 'func' bytecode, stable pointer), NULL for native calls */
 
+#if defined(DUK_USE_CALL_STATS)
+	/* Entry time (negative if the activation started while call stats
+	 * were off), time spent in callees, and an optional label given with
+	 * duk_set_call_stats_label(), see duk_hthread_stacks.c.
+	 */
+	duk_double_t stats_start;
+	duk_double_t stats_child;
+	const duk_call_stats_label *stats_label;
+#endif
+
 	/* bottom_byteoff and retval_byteoff are only used for book-keeping
 	 * of Ecmascript-initiated calls, to allow returning to an Ecmascript
 	 * function properly.
@@ -7713,6 +7827,9 @@ DUK_INTERNAL_DECL duk_bool_t duk_hthread_init_stacks(duk_heap *heap, duk_hthread
 DUK_INTERNAL_DECL void duk_hthread_terminate(duk_hthread *thr);
 
 DUK_INTERNAL_DECL duk_activation *duk_hthread_activation_alloc(duk_hthread *thr);
+#if defined(DUK_USE_CALL_STATS)
+DUK_INTERNAL_DECL void duk_hthread_activation_stats_enter(duk_hthread *thr, duk_activation *act);
+#endif
 DUK_INTERNAL_DECL void duk_hthread_activation_free(duk_hthread *thr, duk_activation *act);
 DUK_INTERNAL_DECL void duk_hthread_activation_unwind_norz(duk_hthread *thr);
 DUK_INTERNAL_DECL void duk_hthread_activation_unwind_reuse_norz(duk_hthread *thr);
@@ -7733,6 +7850,9 @@ DUK_INTERNAL_DECL void *duk_hthread_get_valstack_ptr(duk_heap *heap, void *ud);
 DUK_INTERNAL_DECL duk_uint_fast32_t duk_hthread_get_act_curr_pc(duk_hthread *thr, duk_activation *act);
 #endif
 DUK_INTERNAL_DECL duk_uint_fast32_t duk_hthread_get_act_prev_pc(duk_hthread *thr, duk_activation *act);
+#if defined(DUK_USE_SAMPLING_PROFILER) || defined(DUK_USE_ALLOC_PROFILER)
+DUK_INTERNAL_DECL duk_size_t duk_hthread_get_sample_frames(duk_hthread *thr, duk_sample_frame *frames, duk_size_t max_frames);
+#endif
 DUK_INTERNAL_DECL void duk_hthread_sync_currpc(duk_hthread *thr);
 DUK_INTERNAL_DECL void duk_hthread_sync_and_null_currpc(duk_hthread *thr);
 
@@ -8188,6 +8308,15 @@ struct duk_hproxy {
 
 	/* Proxy handlers (traps). */
 	duk_hobject *handler;
+
+#if defined(DUK_USE_PROXY_NATIVE)
+	/* Traps dispatched directly to a native function instead of being
+	 * looked up from 'handler', see duk_push_proxy_native().
+	 */
+	duk_proxy_trap_function native_func;
+	void *native_udata;
+	duk_uint_t native_traps;  /* DUK_PROXY_TRAP_xxx, 0 for an ordinary Proxy */
+#endif
 };
 
 #endif  /* DUK_HPROXY_H_INCLUDED */
@@ -8340,9 +8469,62 @@ struct duk_hproxy {
 /* Stringcache is used for speeding up char-offset-to-byte-offset
  * translations for non-ASCII strings.
  */
+#if defined(DUK_USE_STRCACHE_SIZE)
+#define DUK_HEAP_STRCACHE_SIZE                            DUK_USE_STRCACHE_SIZE
+#else
 #define DUK_HEAP_STRCACHE_SIZE                            4
+#endif
 #define DUK_HEAP_STRINGCACHE_NOCACHE_LIMIT                16  /* strings up to the this length are not cached */
 
+/* Cached strings of at least DUK_HEAP_STRCACHE_INDEX_LIMIT chars get a
+ * sparse char-to-byte offset index, one byte offset every
+ * DUK_HEAP_STRCACHE_INDEX_STRIDE chars, once they're accessed far from
+ * the cached offset.
+ */
+#if defined(DUK_USE_STRCACHE_INDEX)
+#define DUK_HEAP_STRCACHE_INDEX_STRIDE                    64
+#define DUK_HEAP_STRCACHE_INDEX_LIMIT                     1024
+#endif
+
+/* Property cache used by the executor for GETPROP/PUTPROP instructions
+ * with a plain string key.  Slots are selected by instruction address and
+ * hold an entry part index hint; must be a power of two.
+ */
+#if defined(DUK_USE_EXEC_PROPCACHE)
+#define DUK_HEAP_PROPCACHE_SIZE                           256
+#endif
+
+/* Compiled regexp cache, keyed by (pattern, flags) and kept in most
+ * recently used order.
+ */
+#if defined(DUK_USE_REGEXP_CACHE)
+#define DUK_HEAP_REGEXP_CACHE_SIZE                        16
+#endif
+
+/* Local time offset cache, direct mapped by UTC day number. */
+#if defined(DUK_USE_DATE_FAST)
+#define DUK_HEAP_DATE_TZO_CACHE_SIZE                      32  /* must be a power of two */
+#endif
+
+/* Sampling and allocation profilers: activations captured per sample,
+ * innermost first; deeper stacks lose their outermost frames.
+ */
+#if defined(DUK_USE_SAMPLING_PROFILER) || defined(DUK_USE_ALLOC_PROFILER)
+#define DUK_HEAP_SAMPLE_MAX_FRAMES                        64
+#endif
+
+/* In-place 's += x' is only used for strings of at least this many bytes;
+ * shorter ones are cheap to copy and would just carry unused slack.  Must
+ * be longer than any array index string.
+ */
+#if defined(DUK_USE_CONCAT_INPLACE)
+#define DUK_HEAP_CONCAT_INPLACE_MIN_BLEN                  128
+#if !defined(DUK_USE_REFERENCE_COUNTING) || !defined(DUK_USE_HSTRING_CLEN) || \
+    defined(DUK_USE_STRLEN16) || defined(DUK_USE_STRTAB_PTRCOMP) || defined(DUK_USE_ROM_STRINGS)
+#error DUK_USE_CONCAT_INPLACE requires reference counting and 32-bit RAM strings with a clen field
+#endif
+#endif
+
 /* Some list management macros. */
 #define DUK_HEAP_INSERT_INTO_HEAP_ALLOCATED(heap,hdr)     duk_heap_insert_into_heap_allocated((heap), (hdr))
 #if defined(DUK_USE_REFERENCE_COUNTING)
@@ -8432,6 +8614,21 @@ typedef void *(*duk_mem_getptr)(duk_heap *heap, void *ud);
 #define DUK_ALLOC_CHECKED_ZEROED(thr,size)              duk_heap_mem_alloc_checked_zeroed((thr), (size))
 #define DUK_FREE_CHECKED(thr,ptr)                       duk_heap_mem_free((thr)->heap, (ptr))
 
+/*
+ *  Allocation sampling, see duk_set_alloc_sampler().  Used where the type
+ *  of an allocation is known, after the allocation has succeeded.
+ */
+
+#if defined(DUK_USE_ALLOC_PROFILER)
+#define DUK_HEAP_ALLOC_SAMPLE(heap,type,size) do { \
+		if (DUK_UNLIKELY((heap)->alloc_sample_func != NULL)) { \
+			duk_heap_alloc_sample((heap), (type), (size)); \
+		} \
+	} while (0)
+#else
+#define DUK_HEAP_ALLOC_SAMPLE(heap,type,size) do {} while (0)
+#endif
+
 /*
  *  Memory constants
  */
@@ -8493,8 +8690,51 @@ struct duk_strcache {
 	duk_hstring *h;
 	duk_uint32_t bidx;
 	duk_uint32_t cidx;
+#if defined(DUK_USE_STRCACHE_INDEX)
+	duk_uint32_t *index;  /* byte offsets of chars 0, STRIDE, 2*STRIDE, ...; NULL if not built */
+#endif
 };
 
+/*
+ *  Resumable string hash state, see duk_heap_hashstring_resume().
+ */
+
+struct duk_strhash_state {
+	duk_size_t off;      /* bytes of the string covered by the state */
+#if defined(DUK_USE_STRHASH_WIDE) && defined(DUK_USE_64BIT_OPS)
+	duk_uint64_t seed;
+#endif
+};
+
+/*
+ *  Compiled regexp cache entry.  Unlike the string cache the references
+ *  are strong: they're counted in refcounts and marked as roots by
+ *  mark-and-sweep.
+ */
+
+#if defined(DUK_USE_REGEXP_CACHE)
+struct duk_regexp_cache {
+	duk_hstring *pattern;   /* NULL if entry is unused */
+	duk_hstring *flags;
+	duk_hstring *source;    /* escaped source */
+	duk_hstring *bytecode;
+};
+#endif
+
+/*
+ *  Local time offset cache entry: the offset is known to be 'tzoffset' for
+ *  the whole millisecond range [lo, hi] within UTC day 'day'.
+ */
+
+#if defined(DUK_USE_DATE_FAST)
+struct duk_date_tzo_cache {
+	duk_int_t day;          /* DUK_INT_MIN if entry is unused */
+	duk_int_t lo;
+	duk_int_t hi;
+	duk_int_t tzoffset;     /* seconds */
+};
+#endif
+
 /*
  *  Longjmp state, contains the information needed to perform a longjmp.
  *  Longjmp related values are written to value1, value2, and iserror.
@@ -8671,6 +8911,8 @@ struct duk_heap {
 #if !defined(DUK_USE_GET_RANDOM_DOUBLE)
 #if defined(DUK_USE_PREFER_SIZE) || !defined(DUK_USE_64BIT_OPS)
 	duk_uint32_t rnd_state;  /* State for Shamir's three-op algorithm */
+#elif defined(DUK_USE_RANDOM_XOSHIRO)
+	duk_uint64_t rnd_state[4];  /* State for xoshiro256+ */
 #else
 	duk_uint64_t rnd_state[2];  /* State for xoroshiro128+ */
 #endif
@@ -8740,6 +8982,9 @@ struct duk_heap {
 	duk_uint32_t st_size;    /* stringtable size */
 #if (DUK_USE_STRTAB_MINSIZE != DUK_USE_STRTAB_MAXSIZE)
 	duk_uint32_t st_count;   /* string count for resize load factor checks */
+	duk_uint32_t st_minsize;        /* shrink floor, 2^N >= DUK_USE_STRTAB_MINSIZE */
+	duk_uint32_t st_grow_count;     /* grow steps done, for duk_get_strtab_stats() */
+	duk_uint32_t st_shrink_count;   /* shrink steps done, for duk_get_strtab_stats() */
 #endif
 	duk_bool_t st_resizing;  /* string table is being resized; avoid recursive resize */
 
@@ -8748,6 +8993,62 @@ struct duk_heap {
 	 */
 	duk_strcache strcache[DUK_HEAP_STRCACHE_SIZE];
 
+	/* Executor property cache: entry part index hints, see duk_js_executor.c.
+	 * Hints are always revalidated so no GC handling is needed.
+	 */
+#if defined(DUK_USE_EXEC_PROPCACHE)
+	duk_uint32_t propcache[DUK_HEAP_PROPCACHE_SIZE];
+#endif
+
+	/* String most recently appended to in place by 's += x' (weak reference,
+	 * cleared when the string is freed), its allocated data capacity and
+	 * the hash state of its contents, see duk_heap_strtable_append().
+	 */
+#if defined(DUK_USE_CONCAT_INPLACE)
+	duk_hstring *cat_h;
+	duk_size_t cat_cap;
+	duk_strhash_state cat_hash;
+#endif
+
+	/* Compiled regexps, most recently used first, see duk_regexp_compiler.c. */
+#if defined(DUK_USE_REGEXP_CACHE)
+	duk_regexp_cache recache[DUK_HEAP_REGEXP_CACHE_SIZE];
+#endif
+
+	/* Local time offsets, see duk_bi_date.c. */
+#if defined(DUK_USE_DATE_FAST)
+	duk_date_tzo_cache date_tzo_cache[DUK_HEAP_DATE_TZO_CACHE_SIZE];
+#endif
+
+	/* Sampling profiler callback (NULL when not sampling) and the number
+	 * of bytecode instructions between samples, see duk_js_executor.c.
+	 */
+#if defined(DUK_USE_SAMPLING_PROFILER)
+	duk_sample_function sample_func;
+	void *sample_udata;
+	duk_int_t sample_interval;
+#endif
+
+	/* Call stats callback (NULL when not recording), see
+	 * duk_hthread_stacks.c.
+	 */
+#if defined(DUK_USE_CALL_STATS)
+	duk_call_stats_function call_stats_func;
+	void *call_stats_udata;
+#endif
+
+	/* Allocation sampler callback (NULL when not sampling), the number
+	 * of bytes between samples and the bytes left until the next one,
+	 * see duk_heap_memory.c.
+	 */
+#if defined(DUK_USE_ALLOC_PROFILER)
+	duk_alloc_sample_function alloc_sample_func;
+	void *alloc_sample_udata;
+	duk_size_t alloc_sample_interval;
+	duk_size_t alloc_sample_left;
+	duk_size_t alloc_sample_max_frames;
+#endif
+
 	/* Built-in strings. */
 #if defined(DUK_USE_ROM_STRINGS)
 	/* No field needed when strings are in ROM. */
@@ -8845,12 +9146,22 @@ DUK_INTERNAL_DECL void duk_heap_strtable_unlink(duk_heap *heap, duk_hstring *h);
 #endif
 DUK_INTERNAL_DECL void duk_heap_strtable_unlink_prev(duk_heap *heap, duk_hstring *h, duk_hstring *prev);
 DUK_INTERNAL_DECL void duk_heap_strtable_force_resize(duk_heap *heap);
+DUK_INTERNAL_DECL void duk_heap_strtable_set_min_size(duk_heap *heap, duk_uint32_t min_size);
+DUK_INTERNAL_DECL void duk_heap_strtable_get_stats(duk_heap *heap, duk_strtab_stats *out_stats);
+#if defined(DUK_USE_CONCAT_INPLACE)
+DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_reserve_append(duk_heap *heap, duk_hstring *h, duk_size_t add_blen);
+DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_append(duk_heap *heap, duk_hstring *h, const duk_uint8_t *str, duk_size_t blen);
+#endif
 DUK_INTERNAL void duk_heap_strtable_free(duk_heap *heap);
 #if defined(DUK_USE_DEBUG)
 DUK_INTERNAL void duk_heap_strtable_dump(duk_heap *heap);
 #endif
 
 DUK_INTERNAL_DECL void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h);
+#if defined(DUK_USE_STRCACHE_INDEX)
+DUK_INTERNAL_DECL void duk_heap_strcache_string_grown(duk_heap *heap, duk_hstring *h);
+DUK_INTERNAL_DECL void duk_heap_strcache_free_indexes(duk_heap *heap);
+#endif
 DUK_INTERNAL_DECL duk_uint_fast32_t duk_heap_strcache_offset_char2byte(duk_hthread *thr, duk_hstring *h, duk_uint_fast32_t char_offset);
 
 #if defined(DUK_USE_PROVIDE_DEFAULT_ALLOC_FUNCTIONS)
@@ -8866,6 +9177,9 @@ DUK_INTERNAL_DECL void *duk_heap_mem_alloc_checked_zeroed(duk_hthread *thr, duk_
 DUK_INTERNAL_DECL void *duk_heap_mem_realloc(duk_heap *heap, void *ptr, duk_size_t newsize);
 DUK_INTERNAL_DECL void *duk_heap_mem_realloc_indirect(duk_heap *heap, duk_mem_getptr cb, void *ud, duk_size_t newsize);
 DUK_INTERNAL_DECL void duk_heap_mem_free(duk_heap *heap, void *ptr);
+#if defined(DUK_USE_ALLOC_PROFILER)
+DUK_INTERNAL_DECL void duk_heap_alloc_sample(duk_heap *heap, duk_small_uint_t type, duk_size_t size);
+#endif
 
 DUK_INTERNAL_DECL void duk_heap_free_freelists(duk_heap *heap);
 
@@ -8877,6 +9191,12 @@ DUK_INTERNAL_DECL void duk_heap_process_finalize_list(duk_heap *heap);
 DUK_INTERNAL_DECL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags);
 
 DUK_INTERNAL_DECL duk_uint32_t duk_heap_hashstring(duk_heap *heap, const duk_uint8_t *str, duk_size_t len);
+#if (defined(DUK_USE_STRHASH_WIDE) && defined(DUK_USE_64BIT_OPS)) || defined(DUK_USE_CONCAT_INPLACE)
+DUK_INTERNAL_DECL void duk_heap_hashstring_init(duk_heap *heap, duk_strhash_state *state);
+#endif
+#if defined(DUK_USE_CONCAT_INPLACE)
+DUK_INTERNAL_DECL duk_uint32_t duk_heap_hashstring_resume(duk_heap *heap, duk_strhash_state *state, const duk_uint8_t *str, duk_size_t len);
+#endif
 
 #endif  /* DUK_HEAP_H_INCLUDED */
 /* #include duk_debugger.h */
@@ -10052,6 +10372,9 @@ DUK_INTERNAL_DECL duk_small_int_t duk_unicode_re_is_wordchar(duk_codepoint_t cp)
 /* How large a loop detection stack to use */
 #define DUK_JSON_ENC_LOOPARRAY                64
 
+/* How many nesting levels keep an object size hint when decoding */
+#define DUK_JSON_DEC_SIZEHINTS                32
+
 /* Encoding state.  Heap object references are all borrowed. */
 typedef struct {
 	duk_hthread *thr;
@@ -10095,6 +10418,7 @@ typedef struct {
 #endif
 	duk_int_t recursion_depth;
 	duk_int_t recursion_limit;
+	duk_uint32_t obj_size_hint[DUK_JSON_DEC_SIZEHINTS];  /* indexed by recursion_depth, key count of previous object */
 } duk_json_dec_ctx;
 
 #endif  /* DUK_JSON_H_INCLUDED */
@@ -10332,7 +10656,7 @@ DUK_INTERNAL_DECL void duk_numconv_parse(duk_hthread *thr, duk_small_int_t radix
 
 /* Helpers exposed for internal use */
 DUK_INTERNAL_DECL void duk_bi_date_timeval_to_parts(duk_double_t d, duk_int_t *parts, duk_double_t *dparts, duk_small_uint_t flags);
-DUK_INTERNAL_DECL duk_double_t duk_bi_date_get_timeval_from_dparts(duk_double_t *dparts, duk_small_uint_t flags);
+DUK_INTERNAL_DECL duk_double_t duk_bi_date_get_timeval_from_dparts(duk_hthread *thr, duk_double_t *dparts, duk_small_uint_t flags);
 DUK_INTERNAL_DECL duk_bool_t duk_bi_date_is_leap_year(duk_int_t year);
 DUK_INTERNAL_DECL duk_bool_t duk_bi_date_timeval_in_valid_range(duk_double_t x);
 DUK_INTERNAL_DECL duk_bool_t duk_bi_date_year_in_valid_range(duk_double_t year);
@@ -10391,7 +10715,7 @@ void duk_bi_json_stringify_helper(duk_hthread *thr,
 DUK_INTERNAL_DECL duk_ret_t duk_textdecoder_decode_utf8_nodejs(duk_hthread *thr);
 
 #if defined(DUK_USE_ES6_PROXY)
-DUK_INTERNAL_DECL void duk_proxy_ownkeys_postprocess(duk_hthread *thr, duk_hobject *h_proxy_target, duk_uint_t flags);
+DUK_INTERNAL_DECL void duk_proxy_ownkeys_postprocess(duk_hthread *thr, duk_hobject *h_proxy, duk_hobject *h_proxy_target, duk_uint_t flags);
 #endif
 
 #endif  /* DUK_BUILTIN_PROTOS_H_INCLUDED */
@@ -14684,12 +15008,270 @@ DUK_LOCAL const duk_uint8_t *duk__prep_codec_arg(duk_hthread *thr, duk_idx_t idx
 	return (const duk_uint8_t *) duk_to_lstring(thr, idx, out_len);
 }
 
+/*
+ *  Codec kernels
+ *
+ *  With DUK_USE_CODEC_X86 the base64 and hex helpers and the ASCII span
+ *  scan used by TextEncoder/TextDecoder process 16 (or 32) bytes at a time.
+ *  SSE2 is always present on such targets; SSSE3 and AVX2 are detected at
+ *  runtime.  Blocks the vector code can't handle (whitespace, padding,
+ *  invalid characters) are left to the scalar code which also produces the
+ *  errors, so results are identical with and without the kernels.
+ */
+
+#if defined(DUK_USE_CODEC_X86)
+#define DUK__CODEC_X86_SSE2   1
+#define DUK__CODEC_X86_SSSE3  2
+#define DUK__CODEC_X86_AVX2   3
+
+/* Probed once; racing threads compute the same value. */
+DUK_LOCAL volatile duk_small_int_t duk__codec_x86_level = 0;
+
+DUK_LOCAL duk_small_int_t duk__codec_get_x86_level(void) {
+	duk_small_int_t level = duk__codec_x86_level;
+
+	if (DUK_UNLIKELY(level == 0)) {
+		__builtin_cpu_init();
+		level = DUK__CODEC_X86_SSE2;
+		if (__builtin_cpu_supports("ssse3")) {
+			level = DUK__CODEC_X86_SSSE3;
+			if (__builtin_cpu_supports("avx2")) {
+				level = DUK__CODEC_X86_AVX2;
+			}
+		}
+		duk__codec_x86_level = level;
+	}
+	return level;
+}
+
+__attribute__((target("avx2")))
+DUK_LOCAL duk_size_t duk__ascii_span_avx2(const duk_uint8_t *p, duk_size_t len) {
+	duk_size_t i = 0;
+
+	while (len - i >= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (const void *) (p + i));
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(v);
+		if (mask != 0) {
+			return i + (duk_size_t) __builtin_ctz(mask);
+		}
+		i += 32;
+	}
+	return i;
+}
+
+/* Encodes 12 input bytes (16 are read) into 16 base64 characters.
+ * Wojciech Muła's multiply-shift unpacking and pshufb offset lookup.
+ */
+__attribute__((target("ssse3")))
+DUK_LOCAL void duk__base64_encode_ssse3(const duk_uint8_t **p_src, duk_size_t srclen, duk_uint8_t **p_dst) {
+	const duk_uint8_t *src = *p_src;
+	const duk_uint8_t *src_end = src + srclen;
+	duk_uint8_t *dst = *p_dst;
+	const __m128i shuf = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+	const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+	                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+	                                        '/' - 63, 'A', 0, 0);
+
+	while (src_end - src >= 16) {
+		__m128i in, t0, t1, t2, t3, idx, res, less;
+
+		in = _mm_loadu_si128((const __m128i *) (const void *) src);
+		in = _mm_shuffle_epi8(in, shuf);
+		t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+		t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+		t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		idx = _mm_or_si128(t1, t3);  /* 6-bit values, one per byte */
+
+		res = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		less = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+		res = _mm_or_si128(res, _mm_and_si128(less, _mm_set1_epi8(13)));
+		res = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, res), idx);
+
+		_mm_storeu_si128((__m128i *) (void *) dst, res);
+		src += 12;
+		dst += 16;
+	}
+
+	*p_src = src;
+	*p_dst = dst;
+}
+
+/* Decodes blocks of 16 base64 characters into 12 bytes (16 are written),
+ * stopping at the first block with anything other than the 64 encoding
+ * characters.  Range check and translation as in Muła/Lemire/aklomp.
+ */
+__attribute__((target("ssse3")))
+DUK_LOCAL void duk__base64_decode_ssse3(const duk_uint8_t **p_src, const duk_uint8_t *src_end, duk_uint8_t **p_dst) {
+	const duk_uint8_t *src = *p_src;
+	duk_uint8_t *dst = *p_dst;
+	const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	                                     0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+	const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+	                                     0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i mask_2f = _mm_set1_epi8(0x2f);
+	const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+	/* Output may lag input by less than the 4 bytes written past the
+	 * 12 decoded ones, see duk_base64_decode() output size.
+	 */
+	while (src_end - src >= 24) {
+		__m128i in, hi_nybbles, lo_nybbles, hi, lo, roll, v;
+
+		in = _mm_loadu_si128((const __m128i *) (const void *) src);
+		hi_nybbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask_2f);
+		lo_nybbles = _mm_and_si128(in, mask_2f);
+		hi = _mm_shuffle_epi8(lut_hi, hi_nybbles);
+		lo = _mm_shuffle_epi8(lut_lo, lo_nybbles);
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+			break;
+		}
+
+		roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(in, mask_2f), hi_nybbles));
+		v = _mm_add_epi8(in, roll);  /* 6-bit values */
+		v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+		v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+		v = _mm_shuffle_epi8(v, pack);
+
+		_mm_storeu_si128((__m128i *) (void *) dst, v);
+		src += 16;
+		dst += 12;
+	}
+
+	*p_src = src;
+	*p_dst = dst;
+}
+
+/* 16 input bytes -> 32 lowercase hex digits. */
+DUK_LOCAL void duk__hex_encode_sse2(const duk_uint8_t **p_src, duk_size_t srclen, duk_uint8_t **p_dst) {
+	const duk_uint8_t *src = *p_src;
+	const duk_uint8_t *src_end = src + srclen;
+	duk_uint8_t *dst = *p_dst;
+	const __m128i mask_0f = _mm_set1_epi8(0x0f);
+	const __m128i nine = _mm_set1_epi8(9);
+	const __m128i ascii_0 = _mm_set1_epi8('0');
+	const __m128i alpha_adj = _mm_set1_epi8('a' - '0' - 10);
+
+	while (src_end - src >= 16) {
+		__m128i in, hi, lo, a, b;
+
+		in = _mm_loadu_si128((const __m128i *) (const void *) src);
+		hi = _mm_and_si128(_mm_srli_epi16(in, 4), mask_0f);
+		lo = _mm_and_si128(in, mask_0f);
+		a = _mm_unpacklo_epi8(hi, lo);
+		b = _mm_unpackhi_epi8(hi, lo);
+		a = _mm_add_epi8(_mm_add_epi8(a, ascii_0), _mm_and_si128(_mm_cmpgt_epi8(a, nine), alpha_adj));
+		b = _mm_add_epi8(_mm_add_epi8(b, ascii_0), _mm_and_si128(_mm_cmpgt_epi8(b, nine), alpha_adj));
+
+		_mm_storeu_si128((__m128i *) (void *) dst, a);
+		_mm_storeu_si128((__m128i *) (void *) (dst + 16), b);
+		src += 16;
+		dst += 32;
+	}
+
+	*p_src = src;
+	*p_dst = dst;
+}
+
+/* Hex digits of 16 characters to nybble values; returns 0 if any character
+ * is not a hex digit.
+ */
+DUK_LOCAL DUK_ALWAYS_INLINE duk_bool_t duk__hex_nybbles_sse2(__m128i in, __m128i *out) {
+	__m128i d, l, d_ok, l_ok;
+
+	d = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+	l = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	d_ok = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+	l_ok = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+	if (_mm_movemask_epi8(_mm_or_si128(d_ok, l_ok)) != 0xffff) {
+		return 0;
+	}
+	*out = _mm_or_si128(_mm_and_si128(d_ok, d),
+	                    _mm_andnot_si128(d_ok, _mm_add_epi8(l, _mm_set1_epi8(10))));
+	return 1;
+}
+
+/* 32 hex digits -> 16 bytes; stops at a block with an invalid character. */
+DUK_LOCAL void duk__hex_decode_sse2(const duk_uint8_t **p_src, duk_size_t srclen, duk_uint8_t **p_dst) {
+	const duk_uint8_t *src = *p_src;
+	const duk_uint8_t *src_end = src + srclen;
+	duk_uint8_t *dst = *p_dst;
+	const __m128i mask_00ff = _mm_set1_epi16(0x00ff);
+
+	while (src_end - src >= 32) {
+		__m128i a, b;
+
+		if (!duk__hex_nybbles_sse2(_mm_loadu_si128((const __m128i *) (const void *) src), &a) ||
+		    !duk__hex_nybbles_sse2(_mm_loadu_si128((const __m128i *) (const void *) (src + 16)), &b)) {
+			break;
+		}
+		/* Each 16-bit lane holds (low nybble << 8) | high nybble. */
+		a = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(a, mask_00ff), 4), _mm_srli_epi16(a, 8));
+		b = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b, mask_00ff), 4), _mm_srli_epi16(b, 8));
+		_mm_storeu_si128((__m128i *) (void *) dst, _mm_packus_epi16(a, b));
+		src += 32;
+		dst += 16;
+	}
+
+	*p_src = src;
+	*p_dst = dst;
+}
+#endif  /* DUK_USE_CODEC_X86 */
+
+/* Length of the initial run of ASCII bytes in 'buf'.  Shared by TextEncoder,
+ * TextDecoder and host code converting between UTF-8 and CESU-8 (which agree
+ * on ASCII).
+ */
+DUK_EXTERNAL duk_size_t duk_ascii_span(const void *buf, duk_size_t len) {
+	const duk_uint8_t *p = (const duk_uint8_t *) buf;
+	duk_size_t i = 0;
+
+#if defined(DUK_USE_CODEC_X86)
+	if (len >= 64 && duk__codec_get_x86_level() >= DUK__CODEC_X86_AVX2) {
+		i = duk__ascii_span_avx2(p, len);
+		if (len - i >= 32) {
+			return i;  /* stopped at a non-ASCII byte */
+		}
+	}
+	while (len - i >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (const void *) (p + i));
+		unsigned int mask = (unsigned int) _mm_movemask_epi8(v);
+		if (mask != 0) {
+			return i + (duk_size_t) __builtin_ctz(mask);
+		}
+		i += 16;
+	}
+#elif defined(DUK_USE_64BIT_OPS)
+	while (len - i >= 8) {
+		duk_uint64_t w;
+		DUK_MEMCPY((void *) &w, (const void *) (p + i), 8);
+		if (w & DUK_U64_CONSTANT(0x8080808080808080)) {
+			break;
+		}
+		i += 8;
+	}
+#endif
+	while (i < len && p[i] < 0x80U) {
+		i++;
+	}
+	return i;
+}
+
 #if defined(DUK_USE_BASE64_FASTPATH)
 DUK_LOCAL void duk__base64_encode_helper(const duk_uint8_t *src, duk_size_t srclen, duk_uint8_t *dst) {
 	duk_uint_t t;
 	duk_size_t n_full, n_full3, n_final;
 	const duk_uint8_t *src_end_fast;
 
+#if defined(DUK_USE_CODEC_X86)
+	if (srclen >= 16 && duk__codec_get_x86_level() >= DUK__CODEC_X86_SSSE3) {
+		const duk_uint8_t *src_start = src;
+		duk__base64_encode_ssse3(&src, srclen, &dst);
+		srclen -= (duk_size_t) (src - src_start);
+	}
+#endif
+
 	n_full = srclen / 3;  /* full 3-byte -> 4-char conversions */
 	n_full3 = n_full * 3;
 	n_final = srclen - n_full3;
@@ -14806,9 +15388,15 @@ DUK_LOCAL duk_bool_t duk__base64_decode_helper(const duk_uint8_t *src, duk_size_
 	duk_small_uint_t n_chars;
 	const duk_uint8_t *src_end;
 	const duk_uint8_t *src_end_safe;
+#if defined(DUK_USE_CODEC_X86)
+	duk_bool_t use_ssse3;
+#endif
 
 	src_end = src + srclen;
 	src_end_safe = src_end - 4;  /* if 'src < src_end_safe', safe to read 4 bytes */
+#if defined(DUK_USE_CODEC_X86)
+	use_ssse3 = (srclen >= 24 && duk__codec_get_x86_level() >= DUK__CODEC_X86_SSSE3);
+#endif
 
 	/* Innermost fast path processes 4 valid base-64 characters at a time
 	 * but bails out on whitespace, padding chars ('=') and invalid chars.
@@ -14817,6 +15405,13 @@ DUK_LOCAL duk_bool_t duk__base64_decode_helper(const duk_uint8_t *src, duk_size_
 	 * reasonably well because the majority of a line is in the fast path.
 	 */
 	for (;;) {
+#if defined(DUK_USE_CODEC_X86)
+		/* Vector fast path for runs of 16 clean characters. */
+		if (use_ssse3) {
+			duk__base64_decode_ssse3(&src, src_end, &dst);
+		}
+#endif
+
 		/* Fast path, handle units with just actual encoding characters. */
 
 		while (src <= src_end_safe) {
@@ -15112,92 +15707,73 @@ DUK_EXTERNAL void duk_base64_decode(duk_hthread *thr, duk_idx_t idx) {
 	DUK_ERROR_TYPE(thr, DUK_STR_BASE64_DECODE_FAILED);
 }
 
-DUK_EXTERNAL const char *duk_hex_encode(duk_hthread *thr, duk_idx_t idx) {
-	const duk_uint8_t *inp;
-	duk_size_t len;
+DUK_LOCAL void duk__hex_encode_helper(const duk_uint8_t *inp, duk_size_t len, duk_uint8_t *buf) {
 	duk_size_t i;
-	duk_uint8_t *buf;
-	const char *ret;
 #if defined(DUK_USE_HEX_FASTPATH)
 	duk_size_t len_safe;
 	duk_uint16_t *p16;
 #endif
 
-	DUK_ASSERT_API_ENTRY(thr);
-
-	idx = duk_require_normalize_index(thr, idx);
-	inp = duk__prep_codec_arg(thr, idx, &len);
-	DUK_ASSERT(inp != NULL || len == 0);
-
-	/* Fixed buffer, no zeroing because we'll fill all the data. */
-	buf = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr, len * 2);
-	DUK_ASSERT(buf != NULL);
-
+	i = 0;
 #if defined(DUK_USE_HEX_FASTPATH)
-	DUK_ASSERT((((duk_size_t) buf) & 0x01U) == 0);   /* pointer is aligned, guaranteed for fixed buffer */
-	p16 = (duk_uint16_t *) (void *) buf;
-	len_safe = len & ~0x03U;
-	for (i = 0; i < len_safe; i += 4) {
-		p16[0] = duk_hex_enctab[inp[i]];
-		p16[1] = duk_hex_enctab[inp[i + 1]];
-		p16[2] = duk_hex_enctab[inp[i + 2]];
-		p16[3] = duk_hex_enctab[inp[i + 3]];
-		p16 += 4;
+	/* Duktape buffers are always aligned, host buffers may not be. */
+	if ((((duk_size_t) buf) & 0x01U) == 0) {
+		p16 = (duk_uint16_t *) (void *) buf;
+#if defined(DUK_USE_CODEC_X86)
+		if (len >= 16) {
+			const duk_uint8_t *src = inp;
+			duk_uint8_t *dst = buf;
+			duk__hex_encode_sse2(&src, len, &dst);
+			i = (duk_size_t) (src - inp);
+			p16 = (duk_uint16_t *) (void *) dst;
+		}
+#endif
+		len_safe = len & ~0x03U;
+		for (; i < len_safe; i += 4) {
+			p16[0] = duk_hex_enctab[inp[i]];
+			p16[1] = duk_hex_enctab[inp[i + 1]];
+			p16[2] = duk_hex_enctab[inp[i + 2]];
+			p16[3] = duk_hex_enctab[inp[i + 3]];
+			p16 += 4;
+		}
+		for (; i < len; i++) {
+			*p16++ = duk_hex_enctab[inp[i]];
+		}
+		return;
 	}
+#endif  /* DUK_USE_HEX_FASTPATH */
 	for (; i < len; i++) {
-		*p16++ = duk_hex_enctab[inp[i]];
-	}
-#else  /* DUK_USE_HEX_FASTPATH */
-	for (i = 0; i < len; i++) {
 		duk_small_uint_t t;
 		t = (duk_small_uint_t) inp[i];
 		buf[i*2 + 0] = duk_lc_digits[t >> 4];
 		buf[i*2 + 1] = duk_lc_digits[t & 0x0f];
 	}
-#endif  /* DUK_USE_HEX_FASTPATH */
-
-	/* XXX: Using a string return value forces a string intern which is
-	 * not always necessary.  As a rough performance measure, hex encode
-	 * time for tests/perf/test-hex-encode.js dropped from ~35s to ~15s
-	 * without string coercion.  Change to returning a buffer and let the
-	 * caller coerce to string if necessary?
-	 */
-
-	ret = duk_buffer_to_string(thr, -1);  /* Safe, result is ASCII. */
-	duk_replace(thr, idx);
-	return ret;
 }
 
-DUK_EXTERNAL void duk_hex_decode(duk_hthread *thr, duk_idx_t idx) {
-	const duk_uint8_t *inp;
-	duk_size_t len;
+/* Decodes an even number of hex digits; returns 0 for invalid characters. */
+DUK_LOCAL duk_bool_t duk__hex_decode_helper(const duk_uint8_t *inp, duk_size_t len, duk_uint8_t *buf) {
 	duk_size_t i;
 	duk_int_t t;
-	duk_uint8_t *buf;
 #if defined(DUK_USE_HEX_FASTPATH)
 	duk_int_t chk;
 	duk_uint8_t *p;
 	duk_size_t len_safe;
 #endif
 
-	DUK_ASSERT_API_ENTRY(thr);
-
-	idx = duk_require_normalize_index(thr, idx);
-	inp = duk__prep_codec_arg(thr, idx, &len);
-	DUK_ASSERT(inp != NULL || len == 0);
-
-	if (len & 0x01) {
-		goto type_error;
-	}
-
-	/* Fixed buffer, no zeroing because we'll fill all the data. */
-	buf = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr, len / 2);
-	DUK_ASSERT(buf != NULL);
+	DUK_ASSERT((len & 0x01) == 0);
 
 #if defined(DUK_USE_HEX_FASTPATH)
 	p = buf;
+	i = 0;
+#if defined(DUK_USE_CODEC_X86)
+	if (len >= 32) {
+		const duk_uint8_t *src = inp;
+		duk__hex_decode_sse2(&src, len, &p);
+		i = (duk_size_t) (src - inp);
+	}
+#endif
 	len_safe = len & ~0x07U;
-	for (i = 0; i < len_safe; i += 8) {
+	for (; i < len_safe; i += 8) {
 		t = ((duk_int_t) duk_hex_dectab_shift4[inp[i]]) |
 		    ((duk_int_t) duk_hex_dectab[inp[i + 1]]);
 		chk = t;
@@ -15218,14 +15794,14 @@ DUK_EXTERNAL void duk_hex_decode(duk_hthread *thr, duk_idx_t idx) {
 
 		/* Check if any lookup above had a negative result. */
 		if (DUK_UNLIKELY(chk < 0)) {
-			goto type_error;
+			return 0;
 		}
 	}
 	for (; i < len; i += 2) {
 		t = (((duk_int_t) duk_hex_dectab[inp[i]]) << 4) |
 		    ((duk_int_t) duk_hex_dectab[inp[i + 1]]);
 		if (DUK_UNLIKELY(t < 0)) {
-			goto type_error;
+			return 0;
 		}
 		*p++ = (duk_uint8_t) t;
 	}
@@ -15238,12 +15814,69 @@ DUK_EXTERNAL void duk_hex_decode(duk_hthread *thr, duk_idx_t idx) {
 		t = (((duk_int_t) duk_hex_dectab[inp[i]]) << 4) |
 		    ((duk_int_t) duk_hex_dectab[inp[i + 1]]);
 		if (DUK_UNLIKELY(t < 0)) {
-			goto type_error;
+			return 0;
 		}
 		buf[i >> 1] = (duk_uint8_t) t;
 	}
 #endif  /* DUK_USE_HEX_FASTPATH */
 
+	return 1;
+}
+
+DUK_EXTERNAL const char *duk_hex_encode(duk_hthread *thr, duk_idx_t idx) {
+	const duk_uint8_t *inp;
+	duk_size_t len;
+	duk_uint8_t *buf;
+	const char *ret;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+	idx = duk_require_normalize_index(thr, idx);
+	inp = duk__prep_codec_arg(thr, idx, &len);
+	DUK_ASSERT(inp != NULL || len == 0);
+
+	/* Fixed buffer, no zeroing because we'll fill all the data. */
+	buf = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr, len * 2);
+	DUK_ASSERT(buf != NULL);
+	DUK_ASSERT((((duk_size_t) buf) & 0x01U) == 0);   /* pointer is aligned, guaranteed for fixed buffer */
+
+	duk__hex_encode_helper(inp, len, buf);
+
+	/* XXX: Using a string return value forces a string intern which is
+	 * not always necessary.  As a rough performance measure, hex encode
+	 * time for tests/perf/test-hex-encode.js dropped from ~35s to ~15s
+	 * without string coercion.  Change to returning a buffer and let the
+	 * caller coerce to string if necessary?
+	 */
+
+	ret = duk_buffer_to_string(thr, -1);  /* Safe, result is ASCII. */
+	duk_replace(thr, idx);
+	return ret;
+}
+
+DUK_EXTERNAL void duk_hex_decode(duk_hthread *thr, duk_idx_t idx) {
+	const duk_uint8_t *inp;
+	duk_size_t len;
+	duk_uint8_t *buf;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+	idx = duk_require_normalize_index(thr, idx);
+	inp = duk__prep_codec_arg(thr, idx, &len);
+	DUK_ASSERT(inp != NULL || len == 0);
+
+	if (len & 0x01) {
+		goto type_error;
+	}
+
+	/* Fixed buffer, no zeroing because we'll fill all the data. */
+	buf = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr, len / 2);
+	DUK_ASSERT(buf != NULL);
+
+	if (!duk__hex_decode_helper(inp, len, buf)) {
+		goto type_error;
+	}
+
 	duk_replace(thr, idx);
 	return;
 
@@ -15251,6 +15884,43 @@ DUK_EXTERNAL void duk_hex_decode(duk_hthread *thr, duk_idx_t idx) {
 	DUK_ERROR_TYPE(thr, DUK_STR_HEX_DECODE_FAILED);
 }
 
+/* Heap-free variants for host code, sharing the helpers (and kernels) above.
+ * Output sizes: base64 encode (len + 2) / 3 * 4, base64 decode at most
+ * (len + 3) / 4 * 3, hex encode len * 2, hex decode len / 2.  Decoders
+ * return 0 for invalid input.
+ */
+DUK_EXTERNAL void duk_base64_encode_raw(const void *src, duk_size_t len, void *dst) {
+	duk__base64_encode_helper((const duk_uint8_t *) src, len, (duk_uint8_t *) dst);
+}
+
+DUK_EXTERNAL duk_bool_t duk_base64_decode_raw(const void *src, duk_size_t len, void *dst, duk_size_t *out_len) {
+	duk_uint8_t *dst_final;
+
+	/* The helper computes 'src + len - 4', which may wrap for the dangling
+	 * non-NULL pointers hosts use for empty slices.
+	 */
+	if (len == 0) {
+		*out_len = 0;
+		return 1;
+	}
+	if (!duk__base64_decode_helper((const duk_uint8_t *) src, len, (duk_uint8_t *) dst, &dst_final)) {
+		return 0;
+	}
+	*out_len = (duk_size_t) (dst_final - (duk_uint8_t *) dst);
+	return 1;
+}
+
+DUK_EXTERNAL void duk_hex_encode_raw(const void *src, duk_size_t len, void *dst) {
+	duk__hex_encode_helper((const duk_uint8_t *) src, len, (duk_uint8_t *) dst);
+}
+
+DUK_EXTERNAL duk_bool_t duk_hex_decode_raw(const void *src, duk_size_t len, void *dst) {
+	if (len & 0x01) {
+		return 0;
+	}
+	return duk__hex_decode_helper((const duk_uint8_t *) src, len, (duk_uint8_t *) dst);
+}
+
 #if defined(DUK_USE_JSON_SUPPORT)
 DUK_EXTERNAL const char *duk_json_encode(duk_hthread *thr, duk_idx_t idx) {
 #if defined(DUK_USE_ASSERTIONS)
@@ -16274,6 +16944,575 @@ DUK_EXTERNAL void duk_gc(duk_hthread *thr, duk_uint_t flags) {
 	ms_flags = (duk_small_uint_t) flags;
 	duk_heap_mark_and_sweep(heap, ms_flags);
 }
+
+DUK_EXTERNAL void duk_get_strtab_stats(duk_hthread *thr, duk_strtab_stats *out_stats) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(out_stats != NULL);
+	DUK_ASSERT(thr->heap != NULL);
+
+	duk_heap_strtable_get_stats(thr->heap, out_stats);
+}
+
+DUK_EXTERNAL void duk_set_strtab_min_size(duk_hthread *thr, duk_uint32_t min_size) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+	duk_heap_strtable_set_min_size(thr->heap, min_size);
+}
+
+/* Call 'func' with the current call stack every 'interval' bytecode
+ * instructions (at least 1), or stop sampling if 'func' is NULL.  The
+ * callback runs inside the executor interrupt: it must not call into
+ * Duktape, and the frame strings are only valid for the duration of the
+ * call.  Time spent in native code is not sampled.
+ */
+DUK_EXTERNAL void duk_set_sampling_profiler(duk_hthread *thr, duk_uint32_t interval, duk_sample_function func, void *udata) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_SAMPLING_PROFILER)
+	if (interval < 1) {
+		interval = 1;
+	} else if (interval > (duk_uint32_t) DUK_HTHREAD_INTCTR_DEFAULT) {
+		interval = (duk_uint32_t) DUK_HTHREAD_INTCTR_DEFAULT;
+	}
+	thr->heap->sample_func = func;
+	thr->heap->sample_udata = udata;
+	thr->heap->sample_interval = (duk_int_t) interval;
+
+	/* Take the first sample after 'interval' instructions rather than
+	 * whenever the current interrupt countdown runs out.
+	 */
+	if (func != NULL && thr->interrupt_counter > (duk_int_t) interval) {
+		thr->interrupt_init = (duk_int_t) interval;
+		thr->interrupt_counter = (duk_int_t) interval - 1;
+	}
+#else
+	DUK_UNREF(interval);
+	DUK_UNREF(func);
+	DUK_UNREF(udata);
+	DUK_ERROR_UNSUPPORTED(thr);
+#endif
+}
+
+/* Call 'func' whenever an Ecmascript function, or a native function that
+ * labelled its call with duk_set_call_stats_label(), returns or throws,
+ * with its total and self time in milliseconds.  Calls already running
+ * when recording starts are not reported.  NULL stops recording.  The
+ * callback must not call into Duktape.
+ */
+DUK_EXTERNAL void duk_set_call_stats(duk_hthread *thr, duk_call_stats_function func, void *udata) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_CALL_STATS)
+	thr->heap->call_stats_func = func;
+	thr->heap->call_stats_udata = udata;
+#else
+	DUK_UNREF(func);
+	DUK_UNREF(udata);
+	DUK_ERROR_UNSUPPORTED(thr);
+#endif
+}
+
+/* Have call stats report the current native call under 'label', which is
+ * only referenced (not copied) and must stay valid until the call returns.
+ * Returns zero if call stats are not being recorded.
+ */
+DUK_EXTERNAL duk_bool_t duk_set_call_stats_label(duk_hthread *thr, const duk_call_stats_label *label) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_CALL_STATS)
+	if (thr->heap->call_stats_func == NULL || thr->callstack_curr == NULL) {
+		return 0;
+	}
+	thr->callstack_curr->stats_label = label;
+	return 1;
+#else
+	DUK_UNREF(thr);
+	DUK_UNREF(label);
+	return 0;
+#endif
+}
+
+/* Call 'func' about once every 'interval' bytes (at least 1) allocated for
+ * strings, objects, buffers and property tables, with the allocation and
+ * the innermost 'max_frames' activations of the call stack, or stop sampling
+ * if 'func' is NULL.  The callback runs inside the allocation: it must not
+ * call into Duktape, and the frame strings are only valid for the duration
+ * of the call.
+ */
+DUK_EXTERNAL void duk_set_alloc_sampler(duk_hthread *thr, duk_size_t interval, duk_uint_t max_frames, duk_alloc_sample_function func, void *udata) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_ALLOC_PROFILER)
+	if (interval < 1) {
+		interval = 1;
+	}
+	if (max_frames > DUK_HEAP_SAMPLE_MAX_FRAMES) {
+		max_frames = DUK_HEAP_SAMPLE_MAX_FRAMES;
+	}
+	thr->heap->alloc_sample_func = func;
+	thr->heap->alloc_sample_udata = udata;
+	thr->heap->alloc_sample_interval = interval;
+	thr->heap->alloc_sample_left = interval;
+	thr->heap->alloc_sample_max_frames = (duk_size_t) max_frames;
+#else
+	DUK_UNREF(interval);
+	DUK_UNREF(max_frames);
+	DUK_UNREF(func);
+	DUK_UNREF(udata);
+	DUK_ERROR_UNSUPPORTED(thr);
+#endif
+}
+
+#if defined(DUK_USE_HEAP_WALK)
+typedef struct {
+	duk_heap *heap;
+	duk_heap_edge_function edge_func;
+	void *udata;
+	const void *from;
+} duk__heap_walk_state;
+
+DUK_LOCAL void duk__walk_edge(duk__heap_walk_state *st, duk_heaphdr *to, duk_uint_t kind, duk_uint32_t index, const char *name, duk_size_t name_len) {
+	duk_heap_edge edge;
+
+	if (to == NULL) {
+		return;
+	}
+	edge.from = st->from;
+	edge.to = (const void *) to;
+	edge.kind = kind;
+	edge.index = index;
+	edge.name = name;
+	edge.name_len = name_len;
+	st->edge_func(st->udata, &edge);
+}
+
+DUK_LOCAL void duk__walk_edge_named(duk__heap_walk_state *st, duk_heaphdr *to, duk_uint_t kind, duk_uint32_t index, const char *name) {
+	duk__walk_edge(st, to, kind, index, name, DUK_STRLEN(name));
+}
+
+DUK_LOCAL void duk__walk_edge_tval(duk__heap_walk_state *st, duk_tval *tv, duk_uint_t kind, duk_uint32_t index, const char *name) {
+	if (DUK_TVAL_IS_HEAP_ALLOCATED(tv)) {
+		duk__walk_edge(st, DUK_TVAL_GET_HEAPHDR(tv), kind, index, name, name != NULL ? DUK_STRLEN(name) : 0);
+	}
+}
+
+/* Property edges are named by their key, except that hidden keys (whose
+ * first byte marks them as hidden) make internal edges named by the rest
+ * of the key.
+ */
+DUK_LOCAL void duk__walk_edge_prop(duk__heap_walk_state *st, duk_heaphdr *to, duk_uint_t kind, duk_hstring *key) {
+	const char *name = (const char *) DUK_HSTRING_GET_DATA(key);
+	duk_size_t name_len = DUK_HSTRING_GET_BYTELEN(key);
+
+	if (DUK_HSTRING_HAS_HIDDEN(key) && name_len > 0) {
+		duk__walk_edge(st, to, DUK_HEAP_EDGE_INTERNAL, 0, name + 1, name_len - 1);
+	} else {
+		duk__walk_edge(st, to, kind, 0, name, name_len);
+	}
+}
+
+DUK_LOCAL duk_hstring *duk__walk_own_string(duk_heap *heap, duk_hobject *obj, duk_hstring *key) {
+	duk_tval *tv;
+
+	tv = duk_hobject_find_existing_entry_tval_ptr(heap, obj, key);
+	if (tv != NULL && DUK_TVAL_IS_STRING(tv)) {
+		return DUK_TVAL_GET_STRING(tv);
+	}
+	return NULL;
+}
+
+/* Functions are named by their own 'name', other objects by the 'name' of
+ * the 'constructor' they inherit.  Only plain own data properties are
+ * looked at, so this has no side effects.
+ */
+DUK_LOCAL duk_hstring *duk__walk_object_name(duk_heap *heap, duk_hobject *obj) {
+	duk_hobject *proto;
+	duk_tval *tv;
+	duk_int_t sanity;
+
+	if (DUK_HOBJECT_IS_FUNCTION(obj)) {
+		return duk__walk_own_string(heap, obj, DUK_HEAP_STRING_NAME(heap));
+	}
+	sanity = DUK_HOBJECT_PROTOTYPE_CHAIN_SANITY;
+	for (proto = DUK_HOBJECT_GET_PROTOTYPE(heap, obj);
+	     proto != NULL && sanity-- > 0;
+	     proto = DUK_HOBJECT_GET_PROTOTYPE(heap, proto)) {
+		tv = duk_hobject_find_existing_entry_tval_ptr(heap, proto, DUK_HEAP_STRING_CONSTRUCTOR(heap));
+		if (tv != NULL) {
+			if (DUK_TVAL_IS_OBJECT(tv)) {
+				return duk__walk_own_string(heap, DUK_TVAL_GET_OBJECT(tv), DUK_HEAP_STRING_NAME(heap));
+			}
+			return NULL;
+		}
+	}
+	return NULL;
+}
+
+DUK_LOCAL duk_size_t duk__walk_object_size(duk_hobject *h) {
+	duk_size_t size;
+
+	if (DUK_HOBJECT_IS_COMPFUNC(h)) {
+		size = sizeof(duk_hcompfunc);
+	} else if (DUK_HOBJECT_IS_NATFUNC(h)) {
+		size = sizeof(duk_hnatfunc);
+	} else if (DUK_HOBJECT_IS_BOUNDFUNC(h)) {
+		size = sizeof(duk_hboundfunc) + (duk_size_t) ((duk_hboundfunc *) h)->nargs * sizeof(duk_tval);
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+	} else if (DUK_HOBJECT_IS_BUFOBJ(h)) {
+		size = sizeof(duk_hbufobj);
+#endif
+	} else if (DUK_HOBJECT_IS_THREAD(h)) {
+		duk_hthread *t = (duk_hthread *) h;
+		size = sizeof(duk_hthread) +
+		       (duk_size_t) (t->valstack_alloc_end - t->valstack) * sizeof(duk_tval) +
+		       t->callstack_top * sizeof(duk_activation);
+	} else if (DUK_HOBJECT_IS_DECENV(h)) {
+		size = sizeof(duk_hdecenv);
+	} else if (DUK_HOBJECT_IS_OBJENV(h)) {
+		size = sizeof(duk_hobjenv);
+#if defined(DUK_USE_ES6_PROXY)
+	} else if (DUK_HOBJECT_IS_PROXY(h)) {
+		size = sizeof(duk_hproxy);
+#endif
+	} else if (DUK_HOBJECT_IS_ARRAY(h)) {
+		size = sizeof(duk_harray);
+	} else {
+		size = sizeof(duk_hobject);
+	}
+	return size + DUK_HOBJECT_P_ALLOC_SIZE(h);
+}
+
+/* Same references as duk__mark_hobject(), except for the hash part. */
+DUK_LOCAL void duk__walk_hobject_edges(duk__heap_walk_state *st, duk_hobject *h) {
+	duk_heap *heap = st->heap;
+	duk_uint_fast32_t i;
+
+	DUK_UNREF(heap);
+
+	for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ENEXT(h); i++) {
+		duk_hstring *key = DUK_HOBJECT_E_GET_KEY(heap, h, i);
+		if (key == NULL) {
+			continue;
+		}
+		if (DUK_HOBJECT_E_SLOT_IS_ACCESSOR(heap, h, i)) {
+			duk__walk_edge_prop(st, (duk_heaphdr *) DUK_HOBJECT_E_GET_VALUE_PTR(heap, h, i)->a.get, DUK_HEAP_EDGE_GETTER, key);
+			duk__walk_edge_prop(st, (duk_heaphdr *) DUK_HOBJECT_E_GET_VALUE_PTR(heap, h, i)->a.set, DUK_HEAP_EDGE_SETTER, key);
+		} else {
+			duk_tval *tv = &DUK_HOBJECT_E_GET_VALUE_PTR(heap, h, i)->v;
+			if (DUK_TVAL_IS_HEAP_ALLOCATED(tv)) {
+				duk__walk_edge_prop(st, DUK_TVAL_GET_HEAPHDR(tv), DUK_HEAP_EDGE_PROPERTY, key);
+			}
+		}
+		duk__walk_edge_named(st, (duk_heaphdr *) key, DUK_HEAP_EDGE_HIDDEN, (duk_uint32_t) i, "key");
+	}
+
+	for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ASIZE(h); i++) {
+		duk__walk_edge_tval(st, DUK_HOBJECT_A_GET_VALUE_PTR(heap, h, i), DUK_HEAP_EDGE_ELEMENT, (duk_uint32_t) i, NULL);
+	}
+
+	duk__walk_edge_named(st, (duk_heaphdr *) DUK_HOBJECT_GET_PROTOTYPE(heap, h), DUK_HEAP_EDGE_INTERNAL, 0, "__proto__");
+
+	if (DUK_HOBJECT_HAS_FASTREFS(h)) {
+		return;
+	}
+
+	if (DUK_HOBJECT_IS_COMPFUNC(h)) {
+		duk_hcompfunc *f = (duk_hcompfunc *) h;
+		duk_tval *tv, *tv_base, *tv_end;
+		duk_hobject **fn, **fn_base, **fn_end;
+
+		duk__walk_edge_named(st, (duk_heaphdr *) DUK_HCOMPFUNC_GET_DATA(heap, f), DUK_HEAP_EDGE_INTERNAL, 0, "code");
+		duk__walk_edge_named(st, (duk_heaphdr *) DUK_HCOMPFUNC_GET_LEXENV(heap, f), DUK_HEAP_EDGE_INTERNAL, 0, "lex_env");
+		duk__walk_edge_named(st, (duk_heaphdr *) DUK_HCOMPFUNC_GET_VARENV(heap, f), DUK_HEAP_EDGE_INTERNAL, 0, "var_env");
+		if (DUK_HCOMPFUNC_GET_DATA(heap, f) != NULL) {
+			tv_base = DUK_HCOMPFUNC_GET_CONSTS_BASE(heap, f);
+			tv_end = DUK_HCOMPFUNC_GET_CONSTS_END(heap, f);
+			for (tv = tv_base; tv < tv_end; tv++) {
+				duk__walk_edge_tval(st, tv, DUK_HEAP_EDGE_HIDDEN, (duk_uint32_t) (tv - tv_base), "constant");
+			}
+			fn_base = DUK_HCOMPFUNC_GET_FUNCS_BASE(heap, f);
+			fn_end = DUK_HCOMPFUNC_GET_FUNCS_END(heap, f);
+			for (fn = fn_base; fn < fn_end; fn++) {
+				duk__walk_edge_named(st, (duk_heaphdr *) *fn, DUK_HEAP_EDGE_HIDDEN, (duk_uint32_t) (fn - fn_base), "function");
+			}
+		}
+	} else if (DUK_HOBJECT_IS_DECENV(h)) {
+		duk_hdecenv *e = (duk_hdecenv *) h;
+		duk__walk_edge_named(st, (duk_heaphdr *) e->thread, DUK_HEAP_EDGE_INTERNAL, 0, "thread");
+		duk__walk_edge_named(st, (duk_heaphdr *) e->varmap, DUK_HEAP_EDGE_INTERNAL, 0, "varmap");
+	} else if (DUK_HOBJECT_IS_OBJENV(h)) {
+		duk_hobjenv *e = (duk_hobjenv *) h;
+		duk__walk_edge_named(st, (duk_heaphdr *) e->target, DUK_HEAP_EDGE_INTERNAL, 0, "target");
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+	} else if (DUK_HOBJECT_IS_BUFOBJ(h)) {
+		duk_hbufobj *b = (duk_hbufobj *) h;
+		duk__walk_edge_named(st, (duk_heaphdr *) b->buf, DUK_HEAP_EDGE_INTERNAL, 0, "buffer");
+		duk__walk_edge_named(st, (duk_heaphdr *) b->buf_prop, DUK_HEAP_EDGE_INTERNAL, 0, "buffer_object");
+#endif
+	} else if (DUK_HOBJECT_IS_BOUNDFUNC(h)) {
+		duk_hboundfunc *f = (duk_hboundfunc *) h;
+		duk_idx_t j;
+		duk__walk_edge_tval(st, &f->target, DUK_HEAP_EDGE_INTERNAL, 0, "target");
+		duk__walk_edge_tval(st, &f->this_binding, DUK_HEAP_EDGE_INTERNAL, 0, "this");
+		for (j = 0; j < f->nargs; j++) {
+			duk__walk_edge_tval(st, f->args + j, DUK_HEAP_EDGE_HIDDEN, (duk_uint32_t) j, "argument");
+		}
+#if defined(DUK_USE_ES6_PROXY)
+	} else if (DUK_HOBJECT_IS_PROXY(h)) {
+		duk_hproxy *p = (duk_hproxy *) h;
+		duk__walk_edge_named(st, (duk_heaphdr *) p->target, DUK_HEAP_EDGE_INTERNAL, 0, "target");
+		duk__walk_edge_named(st, (duk_heaphdr *) p->handler, DUK_HEAP_EDGE_INTERNAL, 0, "handler");
+#endif
+	} else if (DUK_HOBJECT_IS_THREAD(h)) {
+		duk_hthread *t = (duk_hthread *) h;
+		duk_activation *act;
+		duk_tval *tv;
+		duk_uint32_t depth;
+
+		for (tv = t->valstack; tv < t->valstack_top; tv++) {
+			duk__walk_edge_tval(st, tv, DUK_HEAP_EDGE_HIDDEN, (duk_uint32_t) (tv - t->valstack), "stack");
+		}
+		for (act = t->callstack_curr, depth = 0; act != NULL; act = act->parent, depth++) {
+			duk__walk_edge_named(st, (duk_heaphdr *) DUK_ACT_GET_FUNC(act), DUK_HEAP_EDGE_HIDDEN, depth, "function");
+			duk__walk_edge_named(st, (duk_heaphdr *) act->var_env, DUK_HEAP_EDGE_HIDDEN, depth, "var_env");
+			duk__walk_edge_named(st, (duk_heaphdr *) act->lex_env, DUK_HEAP_EDGE_HIDDEN, depth, "lex_env");
+#if defined(DUK_USE_NONSTD_FUNC_CALLER_PROPERTY)
+			duk__walk_edge_named(st, (duk_heaphdr *) act->prev_caller, DUK_HEAP_EDGE_HIDDEN, depth, "caller");
+#endif
+		}
+		duk__walk_edge_named(st, (duk_heaphdr *) t->resumer, DUK_HEAP_EDGE_INTERNAL, 0, "resumer");
+		for (i = 0; i < DUK_NUM_BUILTINS; i++) {
+			duk__walk_edge_named(st, (duk_heaphdr *) t->builtins[i], DUK_HEAP_EDGE_HIDDEN, (duk_uint32_t) i, "builtin");
+		}
+	}
+}
+
+DUK_LOCAL void duk__walk_heaphdr(duk__heap_walk_state *st, duk_heap_node_function node_func, duk_heaphdr *hdr) {
+	duk_heap *heap = st->heap;
+	duk_heap_node node;
+	duk_hstring *name = NULL;
+
+	node.ptr = (const void *) hdr;
+	node.class_number = 0;
+	node.name = NULL;
+	node.name_len = 0;
+
+	switch (DUK_HEAPHDR_GET_TYPE(hdr)) {
+	case DUK_HTYPE_STRING: {
+		duk_hstring *h = (duk_hstring *) hdr;
+		duk_size_t cap = DUK_HSTRING_GET_BYTELEN(h);
+#if defined(DUK_USE_CONCAT_INPLACE)
+		if (heap->cat_h == h) {
+			cap = heap->cat_cap;
+		}
+#endif
+		node.kind = DUK_HEAP_NODE_STRING;
+		node.size = DUK_HSTRING_HAS_EXTDATA(h) ? sizeof(duk_hstring_external) : sizeof(duk_hstring) + cap + 1;
+		name = h;
+		break;
+	}
+	case DUK_HTYPE_OBJECT: {
+		duk_hobject *h = (duk_hobject *) hdr;
+		node.kind = DUK_HEAP_NODE_OBJECT;
+		node.class_number = (duk_uint_t) DUK_HOBJECT_GET_CLASS_NUMBER(h);
+		node.size = duk__walk_object_size(h);
+		name = duk__walk_object_name(heap, h);
+		break;
+	}
+	default: {
+		duk_hbuffer *h = (duk_hbuffer *) hdr;
+		DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(hdr) == DUK_HTYPE_BUFFER);
+		node.kind = DUK_HEAP_NODE_BUFFER;
+		if (DUK_HBUFFER_HAS_EXTERNAL(h)) {
+			node.size = sizeof(duk_hbuffer_external);
+		} else if (DUK_HBUFFER_HAS_DYNAMIC(h)) {
+			node.size = sizeof(duk_hbuffer_dynamic) + DUK_HBUFFER_GET_SIZE(h);
+		} else {
+			node.size = sizeof(duk_hbuffer_fixed) + DUK_HBUFFER_GET_SIZE(h);
+		}
+		break;
+	}
+	}
+	if (name != NULL) {
+		node.name = (const char *) DUK_HSTRING_GET_DATA(name);
+		node.name_len = DUK_HSTRING_GET_BYTELEN(name);
+	}
+	node_func(st->udata, &node);
+
+	if (node.kind == DUK_HEAP_NODE_OBJECT) {
+		st->from = node.ptr;
+		duk__walk_hobject_edges(st, (duk_hobject *) hdr);
+	}
+}
+
+DUK_LOCAL void duk__walk_heaphdr_list(duk__heap_walk_state *st, duk_heap_node_function node_func, duk_heaphdr *hdr) {
+	while (hdr != NULL) {
+		duk__walk_heaphdr(st, node_func, hdr);
+		hdr = DUK_HEAPHDR_GET_NEXT(st->heap, hdr);
+	}
+}
+#endif  /* DUK_USE_HEAP_WALK */
+
+/* Report every string, object and buffer in the heap to 'node_func', each
+ * one immediately followed by its references to other nodes, reported to
+ * 'edge_func'.  The heap's roots, the same as for mark-and-sweep, are
+ * reported first as edges from NULL.  The callbacks must not call into
+ * Duktape, and the names are only valid for the duration of the call.
+ */
+DUK_EXTERNAL void duk_walk_heap(duk_hthread *thr, duk_heap_node_function node_func, duk_heap_edge_function edge_func, void *udata) {
+#if defined(DUK_USE_HEAP_WALK)
+	duk__heap_walk_state st;
+	duk_heap *heap;
+	duk_uint32_t i;
+	duk_hstring *h;
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	duk_heaphdr *hdr;
+#endif
+#endif
+
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_HEAP_WALK)
+	heap = thr->heap;
+	st.heap = heap;
+	st.edge_func = edge_func;
+	st.udata = udata;
+	st.from = NULL;
+
+	duk__walk_edge_named(&st, (duk_heaphdr *) heap->heap_thread, DUK_HEAP_EDGE_INTERNAL, 0, "heap_thread");
+	duk__walk_edge_named(&st, (duk_heaphdr *) heap->heap_object, DUK_HEAP_EDGE_INTERNAL, 0, "heap_object");
+	for (i = 0; i < DUK_HEAP_NUM_STRINGS; i++) {
+		duk__walk_edge_named(&st, (duk_heaphdr *) DUK_HEAP_GET_STRING(heap, i), DUK_HEAP_EDGE_HIDDEN, i, "builtin_string");
+	}
+	duk__walk_edge_tval(&st, &heap->lj.value1, DUK_HEAP_EDGE_INTERNAL, 0, "longjmp_value1");
+	duk__walk_edge_tval(&st, &heap->lj.value2, DUK_HEAP_EDGE_INTERNAL, 0, "longjmp_value2");
+#if defined(DUK_USE_REGEXP_CACHE)
+	for (i = 0; i < DUK_HEAP_REGEXP_CACHE_SIZE; i++) {
+		duk_regexp_cache *c = heap->recache + i;
+		if (c->pattern != NULL) {
+			duk__walk_edge_named(&st, (duk_heaphdr *) c->pattern, DUK_HEAP_EDGE_HIDDEN, i, "regexp_cache");
+			duk__walk_edge_named(&st, (duk_heaphdr *) c->flags, DUK_HEAP_EDGE_HIDDEN, i, "regexp_cache");
+			duk__walk_edge_named(&st, (duk_heaphdr *) c->source, DUK_HEAP_EDGE_HIDDEN, i, "regexp_cache");
+			duk__walk_edge_named(&st, (duk_heaphdr *) c->bytecode, DUK_HEAP_EDGE_HIDDEN, i, "regexp_cache");
+		}
+	}
+#endif
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	for (hdr = heap->finalize_list, i = 0; hdr != NULL; hdr = DUK_HEAPHDR_GET_NEXT(heap, hdr), i++) {
+		duk__walk_edge_named(&st, hdr, DUK_HEAP_EDGE_HIDDEN, i, "pending_finalizer");
+	}
+#endif
+
+	duk__walk_heaphdr_list(&st, node_func, heap->heap_allocated);
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	duk__walk_heaphdr_list(&st, node_func, heap->finalize_list);
+#endif
+#if defined(DUK_USE_REFERENCE_COUNTING)
+	duk__walk_heaphdr_list(&st, node_func, heap->refzero_list);
+#endif
+
+	for (i = 0; i < heap->st_size; i++) {
+#if defined(DUK_USE_STRTAB_PTRCOMP)
+		h = DUK_USE_HEAPPTR_DEC16(heap->heap_udata, heap->strtable16[i]);
+#else
+		h = heap->strtable[i];
+#endif
+		while (h != NULL) {
+			duk__walk_heaphdr(&st, node_func, (duk_heaphdr *) h);
+			h = h->hdr.h_next;
+		}
+	}
+#else
+	DUK_UNREF(node_func);
+	DUK_UNREF(edge_func);
+	DUK_UNREF(udata);
+	DUK_ERROR_UNSUPPORTED(thr);
+#endif
+}
+
+/* Reseed the heap PRNG used by Math.random().  The sequence that follows
+ * depends only on 'seed', so it can be used for deterministic replay.  No-op
+ * when the application provides DUK_USE_GET_RANDOM_DOUBLE.
+ */
+DUK_EXTERNAL void duk_random_seed(duk_hthread *thr, duk_uint64_t seed) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_GET_RANDOM_DOUBLE)
+	DUK_UNREF(seed);
+#elif defined(DUK_USE_PREFER_SIZE) || !defined(DUK_USE_64BIT_OPS)
+	thr->heap->rnd_state = (duk_uint32_t) (seed ^ (seed >> 32U));
+	duk_util_tinyrandom_prepare_seed(thr);
+#else
+	thr->heap->rnd_state[0] = seed;
+	duk_util_tinyrandom_prepare_seed(thr);
+#endif
+}
+
+/* Write 'count' doubles from the same sequence as Math.random() to 'out',
+ * which needs no particular alignment.
+ */
+DUK_EXTERNAL void duk_random_fill(duk_hthread *thr, void *out, duk_size_t count) {
+	duk_uint8_t *p;
+	duk_double_t d;
+#if defined(DUK_USE_RANDOM_XOSHIRO)
+	duk_uint64_t s[4];
+#endif
+
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ASSERT(out != NULL || count == 0);
+
+	p = (duk_uint8_t *) out;
+#if defined(DUK_USE_RANDOM_XOSHIRO)
+	/* Keep the state in locals so that it stays in registers. */
+	DUK_MEMCPY((void *) s, (const void *) thr->heap->rnd_state, sizeof(s));
+	while (count-- > 0) {
+		d = duk_util_xoshiro256plus_double(s);
+		DUK_MEMCPY((void *) p, (const void *) &d, sizeof(d));
+		p += sizeof(d);
+	}
+	DUK_MEMCPY((void *) thr->heap->rnd_state, (const void *) s, sizeof(s));
+#else
+	while (count-- > 0) {
+		d = (duk_double_t) DUK_UTIL_GET_RANDOM_DOUBLE(thr);
+		DUK_MEMCPY((void *) p, (const void *) &d, sizeof(d));
+		p += sizeof(d);
+	}
+#endif
+}
+
+/* Native function (nargs 1) filling a Float64Array argument with Math.random()
+ * values in one call, for hosts to expose e.g. as fillRandom().  Returns the
+ * argument.
+ */
+DUK_EXTERNAL duk_ret_t duk_random_fill_float64array(duk_hthread *thr) {
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+	duk_hobject *h;
+	duk_hbufobj *h_bufobj;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+	h = duk_get_hobject(thr, 0);
+	if (h == NULL || DUK_HOBJECT_GET_CLASS_NUMBER(h) != DUK_HOBJECT_CLASS_FLOAT64ARRAY) {
+		DUK_ERROR_TYPE(thr, "not Float64Array");
+	}
+	h_bufobj = (duk_hbufobj *) h;
+	if (h_bufobj->buf == NULL || !DUK_HBUFOBJ_VALID_SLICE(h_bufobj)) {
+		DUK_ERROR_TYPE_INVALID_ARGS(thr);
+	}
+	duk_random_fill(thr, (void *) DUK_HBUFOBJ_GET_SLICE_BASE(thr->heap, h_bufobj), (duk_size_t) (h_bufobj->length >> 3));
+	duk_set_top(thr, 1);
+	return 1;
+#else
+	DUK_ERROR_UNSUPPORTED(thr);
+#endif
+}
 #line 1 "duk_api_object.c"
 /*
  *  Object handling: property access and other support functions.
@@ -22457,6 +23696,11 @@ DUK_EXTERNAL duk_idx_t duk_push_proxy(duk_hthread *thr, duk_uint_t proxy_flags)
 	h_proxy->target = h_target;
 	DUK_ASSERT(h_handler != NULL);
 	h_proxy->handler = h_handler;
+#if defined(DUK_USE_PROXY_NATIVE)
+	h_proxy->native_func = NULL;
+	h_proxy->native_udata = NULL;
+	h_proxy->native_traps = 0;
+#endif
 	DUK_ASSERT_HPROXY_VALID(h_proxy);
 
 	DUK_ASSERT(duk_get_hobject(thr, -2) == h_target);
@@ -22484,6 +23728,47 @@ DUK_EXTERNAL duk_idx_t duk_push_proxy(duk_hthread *thr, duk_uint_t proxy_flags)
 }
 #endif  /* DUK_USE_ES6_PROXY */
 
+/* Like duk_push_proxy(), but the traps in 'traps' are dispatched straight
+ * to 'func' without looking them up from the handler or setting up a call.
+ * Other traps are looked up from the handler as usual.  The handler is
+ * also a convenient place for a finalizer releasing 'udata'.
+ *
+ * 'func' is called with the ES2015 trap arguments on the value stack top
+ * (see DUK_PROXY_TRAP_xxx) and no new stack frame, so it must only use
+ * negative indices and leave the arguments in place.  Like a Duktape/C
+ * function it returns 1 with the trap result pushed or 0 for undefined; a
+ * negative return value throws the value on the stack top, which lets
+ * callers that can't longjmp themselves raise errors.
+ */
+#if defined(DUK_USE_PROXY_NATIVE)
+DUK_EXTERNAL duk_idx_t duk_push_proxy_native(duk_hthread *thr, duk_proxy_trap_function func, duk_uint_t traps, void *udata) {
+	duk_hproxy *h_proxy;
+	duk_idx_t ret;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+	if (func == NULL || (traps & ~((duk_uint_t) DUK_PROXY_TRAP_ALL)) != 0) {
+		DUK_ERROR_TYPE_INVALID_ARGS(thr);
+	}
+
+	ret = duk_push_proxy(thr, 0 /*flags*/);
+	h_proxy = (duk_hproxy *) duk_known_hobject(thr, -1);
+	DUK_ASSERT(DUK_HOBJECT_IS_PROXY((duk_hobject *) h_proxy));
+	h_proxy->native_func = func;
+	h_proxy->native_udata = udata;
+	h_proxy->native_traps = traps;
+	return ret;
+}
+#else  /* DUK_USE_PROXY_NATIVE */
+DUK_EXTERNAL duk_idx_t duk_push_proxy_native(duk_hthread *thr, duk_proxy_trap_function func, duk_uint_t traps, void *udata) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_UNREF(func);
+	DUK_UNREF(traps);
+	DUK_UNREF(udata);
+	DUK_ERROR_UNSUPPORTED(thr);
+}
+#endif  /* DUK_USE_PROXY_NATIVE */
+
 #if defined(DUK_USE_ASSERTIONS)
 DUK_LOCAL void duk__validate_push_heapptr(duk_hthread *thr, void *ptr) {
 	duk_heaphdr *h;
@@ -24188,7 +25473,7 @@ DUK_EXTERNAL duk_double_t duk_components_to_time(duk_hthread *thr, duk_time_comp
 	dparts[DUK_DATE_IDX_MILLISECOND] = comp->milliseconds;
 	dparts[DUK_DATE_IDX_WEEKDAY] = 0;  /* ignored */
 
-	d = duk_bi_date_get_timeval_from_dparts(dparts, flags);
+	d = duk_bi_date_get_timeval_from_dparts(thr, dparts, flags);
 
 	return d;
 }
@@ -24283,13 +25568,12 @@ DUK_LOCAL duk_uint32_t duk__push_this_obj_len_u32_limited(duk_hthread *thr) {
  * significant fraction to improve performance.  Return a non-NULL duk_harray
  * pointer when all fast path criteria are met, NULL otherwise.
  */
-DUK_LOCAL duk_harray *duk__arraypart_fastpath_this(duk_hthread *thr) {
-	duk_tval *tv;
+DUK_LOCAL duk_harray *duk__arraypart_fastpath_tval(duk_hthread *thr, duk_tval *tv) {
 	duk_hobject *h;
 	duk_uint_t flags_mask, flags_bits, flags_value;
 
-	DUK_ASSERT(thr->valstack_bottom > thr->valstack);  /* because call in progress */
-	tv = DUK_GET_THIS_TVAL_PTR(thr);
+	DUK_ASSERT(tv != NULL);
+	DUK_UNREF(thr);
 
 	/* Fast path requires that 'this' is a duk_harray.  Read only arrays
 	 * (ROM backed) are also rejected for simplicity.
@@ -24330,6 +25614,54 @@ DUK_LOCAL duk_harray *duk__arraypart_fastpath_this(duk_hthread *thr) {
 	DUK_DD(DUK_DDPRINT("array fast path allowed for: %!O", (duk_heaphdr *) h));
 	return (duk_harray *) h;
 }
+
+DUK_LOCAL duk_harray *duk__arraypart_fastpath_this(duk_hthread *thr) {
+	DUK_ASSERT(thr->valstack_bottom > thr->valstack);  /* because call in progress */
+	return duk__arraypart_fastpath_tval(thr, DUK_GET_THIS_TVAL_PTR(thr));
+}
+
+/* Same as duk_get_prop_index() but reads a present element directly from
+ * the array part of a fast path compatible Array.  The check is repeated
+ * for every call because callbacks may modify the array in between.
+ */
+DUK_LOCAL duk_bool_t duk__get_prop_index_fastpath(duk_hthread *thr, duk_idx_t obj_idx, duk_uarridx_t arr_idx) {
+	duk_harray *h_arr;
+	duk_tval *tv_val;
+
+	h_arr = duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_POSIDX(thr, obj_idx));
+	if (h_arr != NULL && arr_idx < h_arr->length) {
+		tv_val = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_arr) + arr_idx;
+		if (!DUK_TVAL_IS_UNUSED(tv_val)) {
+			duk_push_tval(thr, tv_val);
+			return 1;
+		}
+		/* Holes may be backed by inherited properties. */
+	}
+	return duk_get_prop_index(thr, obj_idx, arr_idx);
+}
+
+/* Ensure the array part of a result Array under construction (not yet
+ * visible to user code) has room for 'size' elements.  May have side
+ * effects (GC), so callers must re-validate any source array afterwards.
+ */
+DUK_LOCAL void duk__array_reserve_fastpath(duk_hthread *thr, duk_harray *h_arr, duk_uint32_t size) {
+	duk_hobject *h = (duk_hobject *) h_arr;
+	duk_uint32_t new_a_size;
+
+	DUK_ASSERT(DUK_HOBJECT_HAS_ARRAY_PART(h));
+	if (size <= DUK_HOBJECT_GET_ASIZE(h)) {
+		return;
+	}
+	new_a_size = size;
+	if (DUK_HOBJECT_GET_ASIZE(h) > 0) {
+		/* Grow geometrically when appending repeatedly (concat). */
+		new_a_size = DUK_HOBJECT_GET_ASIZE(h) + DUK_HOBJECT_GET_ASIZE(h) / 2;
+		if (new_a_size < size) {
+			new_a_size = size;
+		}
+	}
+	duk_hobject_realloc_props(thr, h, DUK_HOBJECT_GET_ESIZE(h), new_a_size, DUK_HOBJECT_GET_HSIZE(h), 0);
+}
 #endif  /* DUK_USE_ARRAY_FASTPATH */
 
 /*
@@ -24466,7 +25798,44 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_concat(duk_hthread *thr) {
 		 * correctly now.
 		 */
 		len = (duk_uarridx_t) duk_get_length(thr, -1);
-		for (j = 0; j < len; j++) {
+		j = 0;
+
+#if defined(DUK_USE_ARRAY_FASTPATH)
+		/* Fast path: append present elements of a dense source directly
+		 * to the result array part, stopping at the first hole.  The
+		 * result only has elements below 'idx' so far.
+		 */
+		if (len > 0 && duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_NEGIDX(thr, -1)) != NULL) {
+			duk_harray *h_src;
+			duk_harray *h_res;
+
+			h_res = (duk_harray *) duk_known_hobject(thr, -2);
+			DUK_ASSERT(h_res->length <= idx);
+			if (DUK_HOBJECT_HAS_ARRAY_PART((duk_hobject *) h_res) && idx + len > idx) {
+				duk__array_reserve_fastpath(thr, h_res, idx + len);
+				h_src = duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_NEGIDX(thr, -1));
+				if (h_src != NULL) {
+					duk_tval *tv_src;
+					duk_tval *tv_dst;
+
+					tv_src = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_src);
+					tv_dst = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_res);
+					for (; j < len && j < h_src->length; j++) {
+						if (DUK_TVAL_IS_UNUSED(tv_src + j)) {
+							break;
+						}
+						DUK_TVAL_SET_TVAL(tv_dst + idx, tv_src + j);
+						DUK_TVAL_INCREF(thr, tv_dst + idx);
+						idx++;
+					}
+					h_res->length = idx;
+					idx_last = idx;
+				}
+			}
+		}
+#endif  /* DUK_USE_ARRAY_FASTPATH */
+
+		for (; j < len; j++) {
 			if (duk_get_prop_index(thr, -1, j)) {
 				/* [ ToObject(this) item1 ... itemN arr item(i) item(i)[j] ] */
 				duk_xdef_prop_index_wec(thr, -3, idx++);
@@ -24780,308 +26149,559 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_push(duk_hthread *thr) {
 /*
  *  sort()
  *
- *  Currently qsort with random pivot.  This is now really, really slow,
- *  because there is no fast path for array parts.
+ *  Stable adaptive merge sort in the style of TimSort.  Present elements
+ *  are first collected into an internal work array (undefined values are
+ *  only counted), the work array is sorted, and the result is written
+ *  back followed by the undefined values and deletes for the holes, as
+ *  described in ES2019+ SortIndexedProperties().
+ *
+ *  The work array is never visible to user code, so a comparefn which
+ *  modifies the array being sorted doesn't affect the sort itself.  The
+ *  work array is kept fully populated (unused slots are 'undefined') so
+ *  that emergency GC object compaction never shrinks or abandons its array
+ *  part; compaction may still reallocate it, so the base pointer is looked
+ *  up again after anything with side effects.
  *
- *  Signed indices are used because qsort() leaves and degenerate cases
- *  may use a negative offset.
+ *  Elements are moved by swapping duk_tvals within the work array: every
+ *  value is always held by exactly one slot (including the scratch area
+ *  used by merges), so no refcount updates are needed while sorting.
+ *
+ *  Without a comparefn, an all-string input is compared directly.  Other
+ *  primitive inputs (numbers etc) get their ToString() keys computed once
+ *  and stored next to the values ("keyed" records of two slots).  Objects
+ *  are coerced on every comparison as before because their coercion may
+ *  have side effects.
  */
 
-DUK_LOCAL duk_small_int_t duk__array_sort_compare(duk_hthread *thr, duk_int_t idx1, duk_int_t idx2) {
-	duk_bool_t have1, have2;
-	duk_bool_t undef1, undef2;
-	duk_small_int_t ret;
-	duk_idx_t idx_obj = 1;  /* fixed offsets in valstack */
-	duk_idx_t idx_fn = 0;
-	duk_hstring *h1, *h2;
+#define DUK__SORT_MODE_COMPAREFN  0   /* call comparefn at stack[0] */
+#define DUK__SORT_MODE_STRING     1   /* first record slot is a string, compare directly */
+#define DUK__SORT_MODE_COERCE     2   /* ToString() coerce both values for every compare */
 
-	/* Fast exit if indices are identical.  This is valid for a non-existent property,
-	 * for an undefined value, and almost always for ToString() coerced comparison of
-	 * arbitrary values (corner cases where this is not the case include e.g. a an
-	 * object with varying ToString() coercion).
-	 *
-	 * The specification does not prohibit "caching" of values read from the array, so
-	 * assuming equality for comparing an index with itself falls into the category of
-	 * "caching".
-	 *
-	 * Also, compareFn may be inconsistent, so skipping a call to compareFn here may
-	 * have an effect on the final result.  The specification does not require any
-	 * specific behavior for inconsistent compare functions, so again, this fast path
-	 * is OK.
-	 */
+#define DUK__SORT_MIN_MERGE       64
+#define DUK__SORT_MAX_RUNS        64  /* plenty for 2**31 elements given run length invariants */
 
-	if (idx1 == idx2) {
-		DUK_DDD(DUK_DDDPRINT("duk__array_sort_compare: idx1=%ld, idx2=%ld -> indices identical, quick exit",
-		                     (long) idx1, (long) idx2));
-		return 0;
+typedef struct {
+	duk_hthread *thr;
+	duk_hobject *h_work;      /* work array: [ records | scratch records ] */
+	duk_int_t scratch;        /* record index of first scratch record */
+	duk_small_uint_t width;   /* slots per record: 1, or 2 for [ key value ] */
+	duk_small_uint_t mode;
+	duk_int_t run_base[DUK__SORT_MAX_RUNS];
+	duk_int_t run_len[DUK__SORT_MAX_RUNS];
+	duk_int_t num_runs;
+} duk__sort_ctx;
+
+/* Resize the work array, filling new slots with 'undefined'. */
+DUK_LOCAL void duk__sort_work_resize(duk_hthread *thr, duk_hobject *h_work, duk_uint32_t new_size) {
+	duk_uint32_t old_size;
+	duk_tval *tv;
+
+	old_size = DUK_HOBJECT_GET_ASIZE(h_work);
+	DUK_ASSERT(new_size >= old_size);
+	duk_hobject_realloc_props(thr, h_work, DUK_HOBJECT_GET_ESIZE(h_work), new_size, DUK_HOBJECT_GET_HSIZE(h_work), 0);
+	tv = DUK_HOBJECT_A_GET_BASE(thr->heap, h_work);
+	while (old_size < new_size) {
+		DUK_TVAL_SET_UNDEFINED(tv + old_size);
+		old_size++;
 	}
+	((duk_harray *) h_work)->length = new_size;
+}
 
-	have1 = duk_get_prop_index(thr, idx_obj, (duk_uarridx_t) idx1);
-	have2 = duk_get_prop_index(thr, idx_obj, (duk_uarridx_t) idx2);
+DUK_LOCAL DUK_INLINE duk_tval *duk__sort_record(duk__sort_ctx *sc, duk_int_t rec) {
+	return DUK_HOBJECT_A_GET_BASE(sc->thr->heap, sc->h_work) + (duk_size_t) rec * sc->width;
+}
 
-	DUK_DDD(DUK_DDDPRINT("duk__array_sort_compare: idx1=%ld, idx2=%ld, have1=%ld, have2=%ld, val1=%!T, val2=%!T",
-	                     (long) idx1, (long) idx2, (long) have1, (long) have2,
-	                     (duk_tval *) duk_get_tval(thr, -2), (duk_tval *) duk_get_tval(thr, -1)));
+DUK_LOCAL DUK_INLINE void duk__sort_swap(duk__sort_ctx *sc, duk_int_t a, duk_int_t b) {
+	duk_tval *tv_a, *tv_b;
+	duk_tval tv_tmp;
+	duk_small_uint_t i;
 
-	if (have1) {
-		if (have2) {
-			;
-		} else {
-			ret = -1;
-			goto pop_ret;
-		}
-	} else {
-		if (have2) {
-			ret = 1;
-			goto pop_ret;
-		} else {
-			ret = 0;
-			goto pop_ret;
-		}
+	tv_a = duk__sort_record(sc, a);
+	tv_b = duk__sort_record(sc, b);
+	for (i = 0; i < sc->width; i++) {
+		DUK_TVAL_SET_TVAL(&tv_tmp, tv_a + i);
+		DUK_TVAL_SET_TVAL(tv_a + i, tv_b + i);
+		DUK_TVAL_SET_TVAL(tv_b + i, &tv_tmp);
 	}
+}
 
-	undef1 = duk_is_undefined(thr, -2);
-	undef2 = duk_is_undefined(thr, -1);
-	if (undef1) {
-		if (undef2) {
-			ret = 0;
-			goto pop_ret;
-		} else {
-			ret = 1;
-			goto pop_ret;
-		}
-	} else {
-		if (undef2) {
-			ret = -1;
-			goto pop_ret;
-		} else {
-			;
-		}
+/* Compare records 'a' and 'b', returns <0, 0, >0.  May have side effects
+ * (comparefn call, ToString() coercion) which may also reallocate the work
+ * array part.
+ */
+DUK_LOCAL duk_small_int_t duk__sort_compare(duk__sort_ctx *sc, duk_int_t a, duk_int_t b) {
+	duk_hthread *thr = sc->thr;
+	duk_hstring *h1, *h2;
+	duk_small_int_t ret;
+
+	if (sc->mode == DUK__SORT_MODE_STRING) {
+		duk_tval *tv_a = duk__sort_record(sc, a);
+		duk_tval *tv_b = duk__sort_record(sc, b);
+		DUK_ASSERT(DUK_TVAL_IS_STRING(tv_a));
+		DUK_ASSERT(DUK_TVAL_IS_STRING(tv_b));
+		return duk_js_string_compare(DUK_TVAL_GET_STRING(tv_a), DUK_TVAL_GET_STRING(tv_b));
 	}
 
-	if (!duk_is_undefined(thr, idx_fn)) {
+	if (sc->mode == DUK__SORT_MODE_COMPAREFN) {
 		duk_double_t d;
 
-		/* No need to check callable; duk_call() will do that. */
-		duk_dup(thr, idx_fn);    /* -> [ ... x y fn ] */
-		duk_insert(thr, -3);     /* -> [ ... fn x y ] */
-		duk_call(thr, 2);        /* -> [ ... res ] */
+		duk_dup(thr, 0);
+		duk_push_tval(thr, duk__sort_record(sc, a));
+		duk_push_tval(thr, duk__sort_record(sc, b));
+		duk_call(thr, 2);
 
-		/* ES5 is a bit vague about what to do if the return value is
-		 * not a number.  ES2015 provides a concrete description:
-		 * http://www.ecma-international.org/ecma-262/6.0/#sec-sortcompare.
+		/* ES2015+ SortCompare(): ToNumber() of the result, NaN is
+		 * handled like zero because it compares false.
 		 */
-
 		d = duk_to_number_m1(thr);
 		if (d < 0.0) {
 			ret = -1;
 		} else if (d > 0.0) {
 			ret = 1;
 		} else {
-			/* Because NaN compares to false, NaN is handled here
-			 * without an explicit check above.
-			 */
 			ret = 0;
 		}
-
 		duk_pop_nodecref_unsafe(thr);
-		DUK_DDD(DUK_DDDPRINT("-> result %ld (from comparefn, after coercion)", (long) ret));
 		return ret;
 	}
 
-	/* string compare is the default (a bit oddly) */
-
-	/* XXX: any special handling for plain array; causes repeated coercion now? */
+	DUK_ASSERT(sc->mode == DUK__SORT_MODE_COERCE);
+	duk_push_tval(thr, duk__sort_record(sc, a));
+	duk_push_tval(thr, duk__sort_record(sc, b));
 	h1 = duk_to_hstring(thr, -2);
 	h2 = duk_to_hstring_m1(thr);
 	DUK_ASSERT(h1 != NULL);
 	DUK_ASSERT(h2 != NULL);
-
-	ret = duk_js_string_compare(h1, h2);  /* retval is directly usable */
-	goto pop_ret;
-
- pop_ret:
+	ret = duk_js_string_compare(h1, h2);
 	duk_pop_2_unsafe(thr);
-	DUK_DDD(DUK_DDDPRINT("-> result %ld", (long) ret));
 	return ret;
 }
 
-DUK_LOCAL void duk__array_sort_swap(duk_hthread *thr, duk_int_t l, duk_int_t r) {
-	duk_bool_t have_l, have_r;
-	duk_idx_t idx_obj = 1;  /* fixed offset in valstack */
+/* Sort [lo,hi[ using binary insertion sort, knowing [lo,start[ is already
+ * sorted.  Insertion is after equal elements which keeps the sort stable.
+ */
+DUK_LOCAL void duk__sort_binary_insertion(duk__sort_ctx *sc, duk_int_t lo, duk_int_t hi, duk_int_t start) {
+	duk_int_t left, right, mid, k;
 
-	if (l == r) {
-		return;
+	for (; start < hi; start++) {
+		left = lo;
+		right = start;
+		while (left < right) {
+			mid = left + ((right - left) >> 1);
+			if (duk__sort_compare(sc, start, mid) < 0) {
+				right = mid;
+			} else {
+				left = mid + 1;
+			}
+		}
+		for (k = start; k > left; k--) {
+			duk__sort_swap(sc, k, k - 1);
+		}
 	}
+}
 
-	/* swap elements; deal with non-existent elements correctly */
-	have_l = duk_get_prop_index(thr, idx_obj, (duk_uarridx_t) l);
-	have_r = duk_get_prop_index(thr, idx_obj, (duk_uarridx_t) r);
+/* Find the length of the run starting at 'lo', reversing it if it's
+ * strictly descending (strictness keeps the sort stable).
+ */
+DUK_LOCAL duk_int_t duk__sort_count_run(duk__sort_ctx *sc, duk_int_t lo, duk_int_t hi) {
+	duk_int_t k, l, r;
 
-	if (have_r) {
-		/* right exists, [[Put]] regardless whether or not left exists */
-		duk_put_prop_index(thr, idx_obj, (duk_uarridx_t) l);
-	} else {
-		duk_del_prop_index(thr, idx_obj, (duk_uarridx_t) l);
-		duk_pop_undefined(thr);
+	DUK_ASSERT(lo < hi);
+	k = lo + 1;
+	if (k == hi) {
+		return 1;
 	}
-
-	if (have_l) {
-		duk_put_prop_index(thr, idx_obj, (duk_uarridx_t) r);
+	if (duk__sort_compare(sc, k, lo) < 0) {
+		for (k++; k < hi && duk__sort_compare(sc, k, k - 1) < 0; k++) {
+			;
+		}
+		for (l = lo, r = k - 1; l < r; l++, r--) {
+			duk__sort_swap(sc, l, r);
+		}
 	} else {
-		duk_del_prop_index(thr, idx_obj, (duk_uarridx_t) r);
-		duk_pop_undefined(thr);
+		for (k++; k < hi && duk__sort_compare(sc, k, k - 1) >= 0; k++) {
+			;
+		}
 	}
+	return k - lo;
 }
 
-#if defined(DUK_USE_DEBUG_LEVEL) && (DUK_USE_DEBUG_LEVEL >= 2)
-/* Debug print which visualizes the qsort partitioning process. */
-DUK_LOCAL void duk__debuglog_qsort_state(duk_hthread *thr, duk_int_t lo, duk_int_t hi, duk_int_t pivot) {
-	char buf[4096];
-	char *ptr = buf;
-	duk_int_t i, n;
-	n = (duk_int_t) duk_get_length(thr, 1);
-	if (n > 4000) {
-		n = 4000;
+DUK_LOCAL duk_int_t duk__sort_min_run(duk_int_t n) {
+	duk_int_t r = 0;
+
+	while (n >= DUK__SORT_MIN_MERGE) {
+		r |= n & 1;
+		n >>= 1;
 	}
-	*ptr++ = '[';
-	for (i = 0; i < n; i++) {
-		if (i == pivot) {
-			*ptr++ = '|';
-		} else if (i == lo) {
-			*ptr++ = '<';
-		} else if (i == hi) {
-			*ptr++ = '>';
-		} else if (i >= lo && i <= hi) {
-			*ptr++ = '-';
+	return n + r;
+}
+
+/* Number of records in [base,base+len[ which compare less than (or equal
+ * to, if 'right' is set) record 'key'.  The range is sorted.
+ */
+DUK_LOCAL duk_int_t duk__sort_bisect(duk__sort_ctx *sc, duk_int_t key, duk_int_t base, duk_int_t len, duk_bool_t right) {
+	duk_int_t left = 0, mid;
+	duk_small_int_t c;
+
+	while (left < len) {
+		mid = left + ((len - left) >> 1);
+		c = duk__sort_compare(sc, base + mid, key);
+		if (c < 0 || (right && c == 0)) {
+			left = mid + 1;
 		} else {
-			*ptr++ = ' ';
+			len = mid;
 		}
 	}
-	*ptr++ = ']';
-	*ptr++ = '\0';
+	return left;
+}
 
-	DUK_DDD(DUK_DDDPRINT("%s   (lo=%ld, hi=%ld, pivot=%ld)",
-	                     (const char *) buf, (long) lo, (long) hi, (long) pivot));
+/* Merge adjacent runs when the first one is the shorter one: move it to
+ * the scratch area and merge forwards.  Slots in [k,j[ only ever hold
+ * values already moved elsewhere, so swapping into them is safe.
+ */
+DUK_LOCAL void duk__sort_merge_lo(duk__sort_ctx *sc, duk_int_t base1, duk_int_t len1, duk_int_t base2, duk_int_t len2) {
+	duk_int_t i, j, k, end2;
+
+	for (i = 0; i < len1; i++) {
+		duk__sort_swap(sc, sc->scratch + i, base1 + i);
+	}
+	i = 0;
+	j = base2;
+	k = base1;
+	end2 = base2 + len2;
+	while (i < len1 && j < end2) {
+		if (duk__sort_compare(sc, j, sc->scratch + i) < 0) {
+			duk__sort_swap(sc, k, j++);
+		} else {
+			duk__sort_swap(sc, k, sc->scratch + i++);
+		}
+		k++;
+	}
+	while (i < len1) {
+		duk__sort_swap(sc, k++, sc->scratch + i++);
+	}
 }
-#endif
 
-DUK_LOCAL void duk__array_qsort(duk_hthread *thr, duk_int_t lo, duk_int_t hi) {
-	duk_int_t p, l, r;
+/* Same as above but for a shorter second run, merging backwards. */
+DUK_LOCAL void duk__sort_merge_hi(duk__sort_ctx *sc, duk_int_t base1, duk_int_t len1, duk_int_t base2, duk_int_t len2) {
+	duk_int_t i, j, k;
 
-	/* The lo/hi indices may be crossed and hi < 0 is possible at entry. */
+	for (i = 0; i < len2; i++) {
+		duk__sort_swap(sc, sc->scratch + i, base2 + i);
+	}
+	i = len2 - 1;
+	j = base1 + len1 - 1;
+	k = base2 + len2 - 1;
+	while (i >= 0 && j >= base1) {
+		if (duk__sort_compare(sc, sc->scratch + i, j) < 0) {
+			duk__sort_swap(sc, k, j--);
+		} else {
+			duk__sort_swap(sc, k, sc->scratch + i--);
+		}
+		k--;
+	}
+	while (i >= 0) {
+		duk__sort_swap(sc, k--, sc->scratch + i--);
+	}
+}
 
-	DUK_DDD(DUK_DDDPRINT("duk__array_qsort: lo=%ld, hi=%ld, obj=%!T",
-	                     (long) lo, (long) hi, (duk_tval *) duk_get_tval(thr, 1)));
+/* Merge runs 'idx' and 'idx + 1' of the run stack. */
+DUK_LOCAL void duk__sort_merge_at(duk__sort_ctx *sc, duk_int_t idx) {
+	duk_int_t base1, len1, base2, len2, k;
 
-	DUK_ASSERT_TOP(thr, 3);
+	base1 = sc->run_base[idx];
+	len1 = sc->run_len[idx];
+	base2 = sc->run_base[idx + 1];
+	len2 = sc->run_len[idx + 1];
+	DUK_ASSERT(base1 + len1 == base2);
 
-	/* In some cases it may be that lo > hi, or hi < 0; these
-	 * degenerate cases happen e.g. for empty arrays, and in
-	 * recursion leaves.
-	 */
+	sc->run_len[idx] = len1 + len2;
+	if (idx == sc->num_runs - 3) {
+		sc->run_base[idx + 1] = sc->run_base[idx + 2];
+		sc->run_len[idx + 1] = sc->run_len[idx + 2];
+	}
+	sc->num_runs--;
 
-	/* trivial cases */
-	if (hi - lo < 1) {
-		DUK_DDD(DUK_DDDPRINT("degenerate case, return immediately"));
+	/* Elements of run1 not greater than run2[0] and elements of run2
+	 * not less than run1[last] are already in place.
+	 */
+	k = duk__sort_bisect(sc, base2, base1, len1, 1 /*right*/);
+	base1 += k;
+	len1 -= k;
+	if (len1 == 0) {
+		return;
+	}
+	len2 = duk__sort_bisect(sc, base1 + len1 - 1, base2, len2, 0 /*right*/);
+	if (len2 == 0) {
 		return;
 	}
-	DUK_ASSERT(hi > lo);
-	DUK_ASSERT(hi - lo + 1 >= 2);
 
-	/* randomized pivot selection */
-	p = lo + (duk_int_t) (DUK_UTIL_GET_RANDOM_DOUBLE(thr) * (duk_double_t) (hi - lo + 1));
-	DUK_ASSERT(p >= lo && p <= hi);
-	DUK_DDD(DUK_DDDPRINT("lo=%ld, hi=%ld, chose pivot p=%ld", (long) lo, (long) hi, (long) p));
+	if (len1 <= len2) {
+		duk__sort_merge_lo(sc, base1, len1, base2, len2);
+	} else {
+		duk__sort_merge_hi(sc, base1, len1, base2, len2);
+	}
+}
 
-	/* move pivot out of the way */
-	duk__array_sort_swap(thr, p, lo);
-	p = lo;
-	DUK_DDD(DUK_DDDPRINT("pivot moved out of the way: %!T", (duk_tval *) duk_get_tval(thr, 1)));
+/* Restore the run length invariants (including the corrected check for
+ * the third run from the top).
+ */
+DUK_LOCAL void duk__sort_merge_collapse(duk__sort_ctx *sc) {
+	duk_int_t *len = sc->run_len;
+	duk_int_t k;
 
-	l = lo + 1;
-	r = hi;
-	for (;;) {
-		/* find elements to swap */
-		for (;;) {
-			DUK_DDD(DUK_DDDPRINT("left scan: l=%ld, r=%ld, p=%ld",
-			                     (long) l, (long) r, (long) p));
-			if (l >= hi) {
-				break;
-			}
-			if (duk__array_sort_compare(thr, l, p) >= 0) {  /* !(l < p) */
-				break;
+	while (sc->num_runs > 1) {
+		k = sc->num_runs - 2;
+		if ((k > 0 && len[k - 1] <= len[k] + len[k + 1]) ||
+		    (k > 1 && len[k - 2] <= len[k - 1] + len[k])) {
+			if (len[k - 1] < len[k + 1]) {
+				k--;
 			}
-			l++;
-		}
-		for (;;) {
-			DUK_DDD(DUK_DDDPRINT("right scan: l=%ld, r=%ld, p=%ld",
-			                     (long) l, (long) r, (long) p));
-			if (r <= lo) {
-				break;
-			}
-			if (duk__array_sort_compare(thr, p, r) >= 0) {  /* !(p < r) */
-				break;
-			}
-			r--;
-		}
-		if (l >= r) {
-			goto done;
+		} else if (len[k] > len[k + 1]) {
+			break;
 		}
-		DUK_ASSERT(l < r);
-
-		DUK_DDD(DUK_DDDPRINT("swap %ld and %ld", (long) l, (long) r));
-
-		duk__array_sort_swap(thr, l, r);
-
-		DUK_DDD(DUK_DDDPRINT("after swap: %!T", (duk_tval *) duk_get_tval(thr, 1)));
-		l++;
-		r--;
+		duk__sort_merge_at(sc, k);
 	}
- done:
-	/* Note that 'l' and 'r' may cross, i.e. r < l */
-	DUK_ASSERT(l >= lo && l <= hi);
-	DUK_ASSERT(r >= lo && r <= hi);
+}
 
-	/* XXX: there's no explicit recursion bound here now.  For the average
-	 * qsort recursion depth O(log n) that's not really necessary: e.g. for
-	 * 2**32 recursion depth would be about 32 which is OK.  However, qsort
-	 * worst case recursion depth is O(n) which may be a problem.
-	 */
+DUK_LOCAL void duk__sort_records(duk__sort_ctx *sc, duk_int_t n) {
+	duk_int_t lo, run, min_run, forced, k;
 
-	/* move pivot to its final place */
-	DUK_DDD(DUK_DDDPRINT("before final pivot swap: %!T", (duk_tval *) duk_get_tval(thr, 1)));
-	duk__array_sort_swap(thr, lo, r);
+	sc->num_runs = 0;
+	if (n < 2) {
+		return;
+	}
+	if (n < DUK__SORT_MIN_MERGE) {
+		run = duk__sort_count_run(sc, 0, n);
+		duk__sort_binary_insertion(sc, 0, n, run);
+		return;
+	}
 
-#if defined(DUK_USE_DEBUG_LEVEL) && (DUK_USE_DEBUG_LEVEL >= 2)
-	duk__debuglog_qsort_state(thr, lo, hi, r);
-#endif
+	min_run = duk__sort_min_run(n);
+	for (lo = 0; lo < n; lo += run) {
+		run = duk__sort_count_run(sc, lo, n);
+		if (run < min_run) {
+			forced = (n - lo < min_run ? n - lo : min_run);
+			duk__sort_binary_insertion(sc, lo, lo + forced, lo + run);
+			run = forced;
+		}
+		DUK_ASSERT(sc->num_runs < DUK__SORT_MAX_RUNS);
+		sc->run_base[sc->num_runs] = lo;
+		sc->run_len[sc->num_runs] = run;
+		sc->num_runs++;
+		duk__sort_merge_collapse(sc);
+	}
 
-	DUK_DDD(DUK_DDDPRINT("recurse: pivot=%ld, obj=%!T", (long) r, (duk_tval *) duk_get_tval(thr, 1)));
-	duk__array_qsort(thr, lo, r - 1);
-	duk__array_qsort(thr, r + 1, hi);
+	while (sc->num_runs > 1) {
+		k = sc->num_runs - 2;
+		if (k > 0 && sc->run_len[k - 1] < sc->run_len[k + 1]) {
+			k--;
+		}
+		duk__sort_merge_at(sc, k);
+	}
 }
 
 DUK_INTERNAL duk_ret_t duk_bi_array_prototype_sort(duk_hthread *thr) {
+	duk__sort_ctx sc;
 	duk_uint32_t len;
+	duk_uint32_t i;
+	duk_uint32_t n = 0;
+	duk_uint32_t num_undef = 0;
+	duk_uint32_t size;
+	duk_hobject *h_work;
+	duk_tval *tv;
+	duk_bool_t all_strings = 1;
+	duk_bool_t all_primitive = 1;
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	duk_harray *h_arr;
+#endif
 
-	/* XXX: len >= 0x80000000 won't work below because a signed type
-	 * is needed by qsort.
-	 */
+	if (!duk_is_undefined(thr, 0)) {
+		duk_require_callable(thr, 0);
+	}
 	len = duk__push_this_obj_len_u32_limited(thr);
 
 	/* stack[0] = compareFn
 	 * stack[1] = ToObject(this)
 	 * stack[2] = ToUint32(length)
+	 * stack[3] = work array
 	 */
 
-	if (len > 0) {
-		/* avoid degenerate cases, so that (len - 1) won't underflow */
-		duk__array_qsort(thr, (duk_int_t) 0, (duk_int_t) (len - 1));
+	size = len;
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	h_arr = duk__arraypart_fastpath_this(thr);
+	if (h_arr == NULL && size > 64) {
+		/* Possibly sparse, grow on demand. */
+		size = 64;
 	}
+#else
+	if (size > 64) {
+		size = 64;
+	}
+#endif
+	h_work = (duk_hobject *) duk_push_harray(thr);
+	duk__sort_work_resize(thr, h_work, size);
 
-	DUK_ASSERT_TOP(thr, 3);
-	duk_pop_nodecref_unsafe(thr);
+	/* Collect present elements, counting but not collecting undefined
+	 * values.
+	 */
+	i = 0;
+	while (i < len) {
+		if (n >= DUK_HOBJECT_GET_ASIZE(h_work)) {
+			size = DUK_HOBJECT_GET_ASIZE(h_work);
+			size = (len - i > size / 2 ? size + size / 2 : size + (len - i));
+			duk__sort_work_resize(thr, h_work, size);
+		}
+#if defined(DUK_USE_ARRAY_FASTPATH)
+		h_arr = duk__arraypart_fastpath_this(thr);
+		if (h_arr != NULL && i < h_arr->length) {
+			duk_tval *tv_src = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_arr);
+			duk_uint32_t limit;
+
+			limit = (h_arr->length < len ? h_arr->length : len);
+			if (limit - i > DUK_HOBJECT_GET_ASIZE(h_work) - n) {
+				limit = i + (DUK_HOBJECT_GET_ASIZE(h_work) - n);
+			}
+			tv = DUK_HOBJECT_A_GET_BASE(thr->heap, h_work);
+			for (; i < limit; i++) {
+				duk_tval *tv_val = tv_src + i;
+				if (DUK_TVAL_IS_UNUSED(tv_val)) {
+					break;
+				}
+				if (DUK_TVAL_IS_UNDEFINED(tv_val)) {
+					num_undef++;
+					continue;
+				}
+				DUK_TVAL_SET_TVAL(tv + n, tv_val);
+				DUK_TVAL_INCREF(thr, tv_val);
+				n++;
+			}
+			if (i >= limit) {
+				/* Done, out of work array room, or past 'length'. */
+				continue;
+			}
+		}
+#endif
+		/* Generic path; also covers holes which may be backed by
+		 * inherited properties.
+		 */
+		if (duk_get_prop_index(thr, 1, (duk_uarridx_t) i)) {
+			tv = DUK_GET_TVAL_NEGIDX(thr, -1);
+			if (DUK_TVAL_IS_UNDEFINED(tv)) {
+				num_undef++;
+			} else {
+				duk_tval *tv_dst = DUK_HOBJECT_A_GET_BASE(thr->heap, h_work) + n;
+				DUK_TVAL_SET_TVAL(tv_dst, tv);
+				DUK_TVAL_INCREF(thr, tv);
+				n++;
+			}
+		}
+		duk_pop_unsafe(thr);
+		i++;
+	}
+
+	/* Choose the comparison mode. */
+	tv = DUK_HOBJECT_A_GET_BASE(thr->heap, h_work);
+	for (i = 0; i < n; i++) {
+		if (DUK_TVAL_IS_STRING(tv + i) && !DUK_HSTRING_HAS_SYMBOL(DUK_TVAL_GET_STRING(tv + i))) {
+			continue;
+		}
+		all_strings = 0;
+		if (!(DUK_TVAL_IS_NUMBER(tv + i) || DUK_TVAL_IS_BOOLEAN(tv + i) || DUK_TVAL_IS_NULL(tv + i) ||
+		      DUK_TVAL_IS_STRING(tv + i))) {
+			all_primitive = 0;
+			break;
+		}
+	}
+
+	sc.thr = thr;
+	sc.scratch = (duk_int_t) n;
+	sc.width = 1;
+	if (!duk_is_undefined(thr, 0)) {
+		sc.mode = DUK__SORT_MODE_COMPAREFN;
+	} else if (all_strings) {
+		sc.mode = DUK__SORT_MODE_STRING;
+	} else if (all_primitive && n >= 2 && n <= DUK_HOBJECT_MAX_PROPERTIES / 3) {
+		/* Symbols end up here too, and throw when coerced for keys
+		 * like they would when compared: with two or more values each
+		 * one takes part in at least one comparison.  A single value is
+		 * never compared, so it must not be coerced.
+		 */
+		duk_tval *tv_keyed;
+
+		sc.mode = DUK__SORT_MODE_STRING;
+		sc.width = 2;
+		duk__sort_work_resize(thr, (duk_hobject *) duk_push_harray(thr), (n + n / 2) * 2);
+		for (i = 0; i < n; i++) {
+			duk_push_tval(thr, DUK_HOBJECT_A_GET_BASE(thr->heap, h_work) + i);
+			duk_to_hstring_m1(thr);
+			tv_keyed = DUK_HOBJECT_A_GET_BASE(thr->heap, duk_known_hobject(thr, -2)) + i * 2;
+			DUK_TVAL_SET_TVAL(tv_keyed, DUK_GET_TVAL_NEGIDX(thr, -1));
+			DUK_TVAL_INCREF(thr, tv_keyed);
+			tv = DUK_HOBJECT_A_GET_BASE(thr->heap, h_work) + i;
+			DUK_TVAL_SET_TVAL(tv_keyed + 1, tv);
+			DUK_TVAL_INCREF(thr, tv);
+			duk_pop_unsafe(thr);
+		}
+		duk_remove_m2(thr);
+		h_work = duk_known_hobject(thr, -1);
+	} else {
+		sc.mode = DUK__SORT_MODE_COERCE;
+	}
+	if (sc.width == 1) {
+		size = n + n / 2;
+		if (size < n || size > DUK_HOBJECT_MAX_PROPERTIES) {
+			DUK_ERROR_RANGE_INVALID_LENGTH(thr);
+		}
+		if (size > DUK_HOBJECT_GET_ASIZE(h_work)) {
+			duk__sort_work_resize(thr, h_work, size);
+		}
+	}
+	sc.h_work = h_work;
+
+	DUK_ASSERT_TOP(thr, 4);
+	duk__sort_records(&sc, (duk_int_t) n);
+	DUK_ASSERT_TOP(thr, 4);
+
+	/* Write back sorted values, then undefined values, then delete the
+	 * remaining indices so that holes move to the end.
+	 */
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	h_arr = duk__arraypart_fastpath_this(thr);
+	if (h_arr != NULL && len <= h_arr->length && DUK_HOBJECT_HAS_EXTENSIBLE((duk_hobject *) h_arr)) {
+		duk_tval *tv_dst = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_arr);
+
+		tv = DUK_HOBJECT_A_GET_BASE(thr->heap, h_work) + (sc.width - 1);
+		for (i = 0; i < n; i++) {
+			DUK_TVAL_SET_TVAL_UPDREF_NORZ(thr, tv_dst + i, tv + i * sc.width);
+		}
+		for (; i < n + num_undef; i++) {
+			DUK_TVAL_SET_UNDEFINED_UPDREF_NORZ(thr, tv_dst + i);
+		}
+		for (; i < len; i++) {
+			duk_tval tv_tmp;
+			DUK_TVAL_SET_TVAL(&tv_tmp, tv_dst + i);
+			DUK_TVAL_SET_UNUSED(tv_dst + i);
+			DUK_TVAL_DECREF_NORZ(thr, &tv_tmp);
+		}
+		DUK_REFZERO_CHECK_SLOW(thr);
+	} else
+#endif
+	{
+		for (i = 0; i < n; i++) {
+			duk_push_tval(thr, DUK_HOBJECT_A_GET_BASE(thr->heap, h_work) + i * sc.width + (sc.width - 1));
+			duk_put_prop_index(thr, 1, (duk_uarridx_t) i);
+		}
+		for (; i < n + num_undef; i++) {
+			duk_push_undefined(thr);
+			duk_put_prop_index(thr, 1, (duk_uarridx_t) i);
+		}
+		for (; i < len; i++) {
+			duk_del_prop_index(thr, 1, (duk_uarridx_t) i);
+		}
+	}
+
+	duk_set_top(thr, 2);
 	return 1;  /* return ToObject(this) */
 }
 
@@ -25359,7 +26979,41 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_slice(duk_hthread *thr) {
 	DUK_ASSERT(end >= 0 && end <= len);
 
 	idx = 0;
-	for (i = start; i < end; i++) {
+	i = start;
+
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	/* Fast path: copy present elements from the source array part into
+	 * a preallocated result, stopping at the first hole.  Source checks
+	 * are done after the allocation because it may have side effects.
+	 */
+	if (end > start && duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_POSIDX(thr, 2)) != NULL) {
+		duk_harray *h_src;
+		duk_harray *h_res;
+
+		h_res = (duk_harray *) duk_known_hobject(thr, 4);
+		duk__array_reserve_fastpath(thr, h_res, (duk_uint32_t) (end - start));
+		h_src = duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_POSIDX(thr, 2));
+		if (h_src != NULL) {
+			duk_tval *tv_src;
+			duk_tval *tv_dst;
+
+			tv_src = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_src);
+			tv_dst = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_res);
+			for (; i < end && (duk_uint32_t) i < h_src->length; i++) {
+				if (DUK_TVAL_IS_UNUSED(tv_src + i)) {
+					break;
+				}
+				DUK_TVAL_SET_TVAL(tv_dst + idx, tv_src + i);
+				DUK_TVAL_INCREF(thr, tv_dst + idx);
+				idx++;
+			}
+			h_res->length = idx;
+			res_length = idx;
+		}
+	}
+#endif  /* DUK_USE_ARRAY_FASTPATH */
+
+	for (; i < end; i++) {
 		DUK_ASSERT_TOP(thr, 5);
 		if (duk_get_prop_index(thr, 2, (duk_uarridx_t) i)) {
 			duk_xdef_prop_index_wec(thr, 4, idx);
@@ -25491,6 +27145,9 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_indexof_shared(duk_hthread *thr) {
 	duk_int_t i, len;
 	duk_int_t from_idx;
 	duk_small_int_t idx_step = duk_get_current_magic(thr);  /* idx_step is +1 for indexOf, -1 for lastIndexOf */
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	duk_harray *h_arr;
+#endif
 
 	/* lastIndexOf() needs to be a vararg function because we must distinguish
 	 * between an undefined fromIndex and a "not given" fromIndex; indexOf() is
@@ -25553,7 +27210,41 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_indexof_shared(duk_hthread *thr) {
 	 * stack[3] = length (not needed, but not popped above)
 	 */
 
-	for (i = from_idx; i >= 0 && i < len; i += idx_step) {
+	i = from_idx;
+
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	/* Fast path: compare against the array part directly, strict equality
+	 * has no side effects.  Stop at the first hole (which may be backed
+	 * by an inherited property) or at the current length (fromIndex
+	 * coercion may have shrunk the array) and let the generic loop
+	 * continue from there.
+	 */
+	h_arr = duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_POSIDX(thr, 2));
+	if (h_arr != NULL) {
+		duk_tval *tv_base;
+		duk_tval *tv_search;
+
+		tv_base = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_arr);
+		tv_search = DUK_GET_TVAL_POSIDX(thr, 0);
+		for (; i >= 0 && i < len; i += idx_step) {
+			duk_tval *tv_elem;
+
+			if ((duk_uint32_t) i >= h_arr->length) {
+				break;
+			}
+			tv_elem = tv_base + i;
+			if (DUK_TVAL_IS_UNUSED(tv_elem)) {
+				break;
+			}
+			if (duk_js_strict_equals(tv_search, tv_elem)) {
+				duk_push_int(thr, i);
+				return 1;
+			}
+		}
+	}
+#endif  /* DUK_USE_ARRAY_FASTPATH */
+
+	for (; i >= 0 && i < len; i += idx_step) {
 		DUK_ASSERT_TOP(thr, 4);
 
 		if (duk_get_prop_index(thr, 2, (duk_uarridx_t) i)) {
@@ -25594,6 +27285,9 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_iter_shared(duk_hthread *thr) {
 	duk_bool_t bval;
 	duk_small_int_t iter_type = duk_get_current_magic(thr);
 	duk_uint32_t res_length = 0;
+#if defined(DUK_USE_ARRAY_FASTPATH)
+	duk_harray *h_res = NULL;
+#endif
 
 	/* each call this helper serves has nargs==2 */
 	DUK_ASSERT_TOP(thr, 2);
@@ -25602,7 +27296,22 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_iter_shared(duk_hthread *thr) {
 	duk_require_callable(thr, 0);
 	/* if thisArg not supplied, behave as if undefined was supplied */
 
-	if (iter_type == DUK__ITER_MAP || iter_type == DUK__ITER_FILTER) {
+	if (iter_type == DUK__ITER_MAP) {
+#if defined(DUK_USE_ARRAY_FASTPATH)
+		/* For a dense input, preallocate the result and store callback
+		 * results directly.  'len' is backed by an actual allocation
+		 * so this is safe even for a large 'length'.
+		 */
+		if (duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_POSIDX(thr, 2)) != NULL) {
+			h_res = duk_push_harray_with_size(thr, len);
+			h_res->length = 0;
+		} else {
+			duk_push_array(thr);
+		}
+#else
+		duk_push_array(thr);
+#endif
+	} else if (iter_type == DUK__ITER_FILTER) {
 		duk_push_array(thr);
 	} else {
 		duk_push_undefined(thr);
@@ -25619,7 +27328,11 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_iter_shared(duk_hthread *thr) {
 	for (i = 0; i < len; i++) {
 		DUK_ASSERT_TOP(thr, 5);
 
+#if defined(DUK_USE_ARRAY_FASTPATH)
+		if (!duk__get_prop_index_fastpath(thr, 2, (duk_uarridx_t) i)) {
+#else
 		if (!duk_get_prop_index(thr, 2, (duk_uarridx_t) i)) {
+#endif
 #if defined(DUK_USE_NONSTD_ARRAY_MAP_TRAILER)
 			/* Real world behavior for map(): trailing non-existent
 			 * elements don't invoke the user callback, but are still
@@ -25669,6 +27382,25 @@ DUK_INTERNAL duk_ret_t duk_bi_array_prototype_iter_shared(duk_hthread *thr) {
 			/* nop */
 			break;
 		case DUK__ITER_MAP:
+#if defined(DUK_USE_ARRAY_FASTPATH)
+			/* Result array is not reachable from user code and
+			 * was preallocated for 'len' elements, but emergency GC
+			 * compaction during the callback may have shrunk or
+			 * abandoned its array part.
+			 */
+			if (h_res != NULL && DUK_HOBJECT_HAS_ARRAY_PART((duk_hobject *) h_res) &&
+			    i < DUK_HOBJECT_GET_ASIZE((duk_hobject *) h_res)) {
+				duk_tval *tv_dst;
+
+				tv_dst = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_res) + i;
+				DUK_ASSERT(DUK_TVAL_IS_UNUSED(tv_dst));
+				DUK_TVAL_SET_TVAL(tv_dst, DUK_GET_TVAL_NEGIDX(thr, -1));
+				DUK_TVAL_INCREF(thr, tv_dst);
+				h_res->length = i + 1;
+				res_length = i + 1;
+				break;
+			}
+#endif
 			duk_dup_top(thr);
 			duk_xdef_prop_index_wec(thr, 4, (duk_uarridx_t) i);  /* retval to result[i] */
 			res_length = i + 1;
@@ -26406,6 +28138,92 @@ DUK_INTERNAL void duk_hbufobj_validated_write(duk_hthread *thr, duk_hbufobj *h_b
 	DUK_MEMCPY((void *) p, (const void *) du.uc, (size_t) elem_size);
 }
 
+#if defined(DUK_USE_TYPEDARRAY_KERNELS)
+/* Value stack free equivalents of duk_hbufobj_push_validated_read() and
+ * duk_hbufobj_validated_write() for bulk kernels.  The write handles the
+ * common in-range cases inline and falls back to the generic coercion
+ * (through the value stack, but still side effect free) otherwise.
+ */
+DUK_LOCAL DUK_ALWAYS_INLINE duk_double_t duk__hbufobj_read_number(duk_hbufobj *h_bufobj, const duk_uint8_t *p) {
+	duk_double_union du;
+
+	switch (h_bufobj->elem_type) {
+	case DUK_HBUFOBJ_ELEM_UINT8:
+	case DUK_HBUFOBJ_ELEM_UINT8CLAMPED:
+		return (duk_double_t) p[0];
+	case DUK_HBUFOBJ_ELEM_INT8:
+		return (duk_double_t) (duk_int8_t) p[0];
+	case DUK_HBUFOBJ_ELEM_UINT16:
+		DUK_MEMCPY((void *) du.uc, (const void *) p, 2);
+		return (duk_double_t) du.us[0];
+	case DUK_HBUFOBJ_ELEM_INT16:
+		DUK_MEMCPY((void *) du.uc, (const void *) p, 2);
+		return (duk_double_t) (duk_int16_t) du.us[0];
+	case DUK_HBUFOBJ_ELEM_UINT32:
+		DUK_MEMCPY((void *) du.uc, (const void *) p, 4);
+		return (duk_double_t) du.ui[0];
+	case DUK_HBUFOBJ_ELEM_INT32:
+		DUK_MEMCPY((void *) du.uc, (const void *) p, 4);
+		return (duk_double_t) (duk_int32_t) du.ui[0];
+	case DUK_HBUFOBJ_ELEM_FLOAT32:
+		DUK_MEMCPY((void *) du.uc, (const void *) p, 4);
+		return (duk_double_t) du.f[0];
+	default:
+		DUK_ASSERT(h_bufobj->elem_type == DUK_HBUFOBJ_ELEM_FLOAT64);
+		DUK_MEMCPY((void *) du.uc, (const void *) p, 8);
+		return du.d;
+	}
+}
+
+DUK_LOCAL DUK_ALWAYS_INLINE void duk__hbufobj_write_number(duk_hthread *thr, duk_hbufobj *h_bufobj, duk_uint8_t *p, duk_small_uint_t elem_size, duk_double_t d) {
+	duk_double_union du;
+	duk_uint32_t u;
+
+	switch (h_bufobj->elem_type) {
+	case DUK_HBUFOBJ_ELEM_UINT8CLAMPED:
+		if (d >= 0.0 && d <= 255.0 && d == (duk_double_t) (duk_small_uint_t) d) {
+			p[0] = (duk_uint8_t) d;
+			return;
+		}
+		break;
+	case DUK_HBUFOBJ_ELEM_FLOAT32:
+		du.f[0] = (duk_float_t) d;
+		DUK_MEMCPY((void *) p, (const void *) du.uc, 4);
+		return;
+	case DUK_HBUFOBJ_ELEM_FLOAT64:
+		du.d = d;
+		DUK_MEMCPY((void *) p, (const void *) du.uc, 8);
+		return;
+	default:
+		/* ToInt32()/ToUint32() truncate towards zero and wrap modulo
+		 * 2^32, which matches C casts in this range; NaN, infinities
+		 * and larger magnitudes use the slow path.
+		 */
+		if (d >= 0.0 && d < 4294967296.0) {
+			u = (duk_uint32_t) d;
+		} else if (d < 0.0 && d > -2147483649.0) {
+			u = (duk_uint32_t) (duk_int32_t) d;
+		} else {
+			break;
+		}
+		if (elem_size == 1) {
+			p[0] = (duk_uint8_t) u;
+		} else if (elem_size == 2) {
+			du.us[0] = (duk_uint16_t) u;
+			DUK_MEMCPY((void *) p, (const void *) du.uc, 2);
+		} else {
+			du.ui[0] = u;
+			DUK_MEMCPY((void *) p, (const void *) du.uc, 4);
+		}
+		return;
+	}
+
+	duk_push_number(thr, d);
+	duk_hbufobj_validated_write(thr, h_bufobj, p, elem_size);
+	duk_pop(thr);
+}
+#endif  /* DUK_USE_TYPEDARRAY_KERNELS */
+
 /* Helper to create a fixed buffer from argument value at index 0.
  * Node.js and allocPlain() compatible.
  */
@@ -27673,9 +29491,13 @@ DUK_INTERNAL duk_ret_t duk_bi_typedarray_set(duk_hthread *thr) {
 			/* A validated read() is always a number, so it's write coercion
 			 * is always side effect free an won't invalidate pointers etc.
 			 */
+#if defined(DUK_USE_TYPEDARRAY_KERNELS)
+			duk__hbufobj_write_number(thr, h_this, p_dst, dst_elem_size, duk__hbufobj_read_number(h_bufarg, p_src));
+#else
 			duk_hbufobj_push_validated_read(thr, h_bufarg, p_src, src_elem_size);
 			duk_hbufobj_validated_write(thr, h_this, p_dst, dst_elem_size);
 			duk_pop(thr);
+#endif
 			p_src += src_elem_size;
 			p_dst += dst_elem_size;
 		}
@@ -27711,7 +29533,37 @@ DUK_INTERNAL duk_ret_t duk_bi_typedarray_set(duk_hthread *thr) {
 		DUK_ASSERT_TOP(thr, 2);
 		duk_push_this(thr);
 
-		for (i = 0; i < n; i++) {
+		i = 0;
+#if defined(DUK_USE_TYPEDARRAY_KERNELS) && defined(DUK_USE_ARRAY_FASTPATH)
+		/* Fast path: numbers in the array part of a dense Array are
+		 * written directly.  Number writes have no side effects, so
+		 * validating the target once is enough.  Stops at the first
+		 * hole or non-number and continues with the generic loop.
+		 */
+		{
+			duk_harray *h_arr;
+
+			h_arr = duk__arraypart_fastpath_tval(thr, DUK_GET_TVAL_POSIDX(thr, 0));
+			if (h_arr != NULL && n <= h_arr->length &&
+			    DUK_HBUFOBJ_VALID_BYTEOFFSET_EXCL(h_this, offset_bytes + (n << h_this->shift))) {
+				duk_tval *tv_src;
+				duk_uint8_t *p_dst;
+				duk_small_uint_t dst_elem_size;
+
+				tv_src = DUK_HOBJECT_A_GET_BASE(thr->heap, (duk_hobject *) h_arr);
+				p_dst = DUK_HBUFOBJ_GET_SLICE_BASE(thr->heap, h_this) + offset_bytes;
+				dst_elem_size = (duk_small_uint_t) (1U << h_this->shift);
+				for (; i < n; i++) {
+					if (!DUK_TVAL_IS_NUMBER(tv_src + i)) {
+						break;
+					}
+					duk__hbufobj_write_number(thr, h_this, p_dst, dst_elem_size, DUK_TVAL_GET_NUMBER(tv_src + i));
+					p_dst += dst_elem_size;
+				}
+			}
+		}
+#endif
+		for (; i < n; i++) {
 			duk_get_prop_index(thr, 0, i);
 			duk_put_prop_index(thr, 2, offset_elems + i);
 		}
@@ -27724,6 +29576,294 @@ DUK_INTERNAL duk_ret_t duk_bi_typedarray_set(duk_hthread *thr) {
 }
 #endif  /* DUK_USE_BUFFEROBJECT_SUPPORT */
 
+/*
+ *  TypedArray.prototype.fill(value, [start], [end])
+ *  TypedArray.prototype.copyWithin(target, start, [end])
+ *
+ *  Not part of the generated built-in data, added to %TypedArrayPrototype%
+ *  by duk_hthread_create_builtin_objects().  Both work on the byte data
+ *  directly: fill() encodes the value once and replicates it, copyWithin()
+ *  is a single memmove().  Like set(), they're no-ops when the underlying
+ *  buffer doesn't cover the view.
+ */
+
+#if defined(DUK_USE_TYPEDARRAY_KERNELS)
+/* ES2015 relative index: ToInteger(), negative counts from 'len', clamped to
+ * [0,len].  Undefined gives 'def' when 'def' >= 0.
+ */
+DUK_LOCAL duk_int_t duk__typedarray_relidx(duk_hthread *thr, duk_idx_t idx, duk_int_t len, duk_int_t def) {
+	duk_int_t i;
+
+	if (def >= 0 && duk_is_undefined(thr, idx)) {
+		return def;
+	}
+	i = duk_to_int(thr, idx);
+	if (i < 0) {
+		i = (i < -len ? 0 : len + i);
+	} else if (i > len) {
+		i = len;
+	}
+	return i;
+}
+
+DUK_INTERNAL duk_ret_t duk_bi_typedarray_fill(duk_hthread *thr) {
+	duk_hbufobj *h_this;
+	duk_int_t len;
+	duk_int_t start;
+	duk_int_t end;
+	duk_small_uint_t elem_size;
+	duk_uint8_t elem[8];
+	duk_uint8_t *p;
+	duk_size_t fill_bytes;
+	duk_size_t done;
+
+	h_this = duk__require_bufobj_this(thr);
+	DUK_ASSERT(h_this != NULL);
+	if (!h_this->is_typedarray) {
+		DUK_DCERROR_TYPE_INVALID_ARGS(thr);
+	}
+
+	/* [ value start end ] */
+
+	duk_to_number(thr, 0);
+	len = (duk_int_t) (h_this->length >> h_this->shift);
+	start = duk__typedarray_relidx(thr, 1, len, 0);
+	end = duk__typedarray_relidx(thr, 2, len, len);
+
+	duk_push_this(thr);
+	if (start >= end || h_this->buf == NULL || !DUK_HBUFOBJ_VALID_SLICE(h_this)) {
+		return 1;
+	}
+
+	/* Number coercion of the value is side effect free, so the slice
+	 * stays valid.
+	 */
+	elem_size = (duk_small_uint_t) (1U << h_this->shift);
+	duk_dup(thr, 0);
+	duk_hbufobj_validated_write(thr, h_this, elem, elem_size);
+	duk_pop(thr);
+
+	p = DUK_HBUFOBJ_GET_SLICE_BASE(thr->heap, h_this) + ((duk_size_t) start << h_this->shift);
+	fill_bytes = (duk_size_t) (end - start) << h_this->shift;
+	if (elem_size == 1) {
+		DUK_MEMSET((void *) p, (int) elem[0], fill_bytes);
+	} else {
+		/* Replicate with doubling copies. */
+		DUK_MEMCPY((void *) p, (const void *) elem, (size_t) elem_size);
+		done = elem_size;
+		while (done < fill_bytes) {
+			duk_size_t chunk = (done <= fill_bytes - done ? done : fill_bytes - done);
+			DUK_MEMCPY((void *) (p + done), (const void *) p, chunk);
+			done += chunk;
+		}
+	}
+	return 1;
+}
+
+DUK_INTERNAL duk_ret_t duk_bi_typedarray_copywithin(duk_hthread *thr) {
+	duk_hbufobj *h_this;
+	duk_int_t len;
+	duk_int_t to;
+	duk_int_t from;
+	duk_int_t final;
+	duk_int_t count;
+	duk_uint8_t *p;
+
+	h_this = duk__require_bufobj_this(thr);
+	DUK_ASSERT(h_this != NULL);
+	if (!h_this->is_typedarray) {
+		DUK_DCERROR_TYPE_INVALID_ARGS(thr);
+	}
+
+	/* [ target start end ] */
+
+	len = (duk_int_t) (h_this->length >> h_this->shift);
+	to = duk__typedarray_relidx(thr, 0, len, -1);
+	from = duk__typedarray_relidx(thr, 1, len, -1);
+	final = duk__typedarray_relidx(thr, 2, len, len);
+	count = final - from;
+	if (count > len - to) {
+		count = len - to;
+	}
+
+	duk_push_this(thr);
+	if (count <= 0 || h_this->buf == NULL || !DUK_HBUFOBJ_VALID_SLICE(h_this)) {
+		return 1;
+	}
+
+	p = DUK_HBUFOBJ_GET_SLICE_BASE(thr->heap, h_this);
+	DUK_MEMMOVE((void *) (p + ((duk_size_t) to << h_this->shift)),
+	            (const void *) (p + ((duk_size_t) from << h_this->shift)),
+	            (size_t) ((duk_size_t) count << h_this->shift));
+	return 1;
+}
+
+/*
+ *  Float64Array kernels for hosts, see duk_push_float64_kernels():
+ *
+ *    add/sub/mul/div(dst, a, b)  dst[i] = a[i] op b[i] (or a[i] op b for a number b)
+ *    sum(a), dot(a, b)
+ *
+ *  Array arguments must be Float64Arrays of equal length; they may alias.
+ *  Elements are accessed with memcpy() so that unaligned external buffers
+ *  work; compilers turn these into plain (vectorizable) loads and stores.
+ */
+
+DUK_LOCAL duk_uint8_t *duk__require_float64_data(duk_hthread *thr, duk_idx_t idx, duk_size_t *inout_count) {
+	duk_hobject *h;
+	duk_hbufobj *h_bufobj;
+	duk_size_t count;
+
+	h = duk_get_hobject(thr, idx);
+	if (h == NULL || DUK_HOBJECT_GET_CLASS_NUMBER(h) != DUK_HOBJECT_CLASS_FLOAT64ARRAY) {
+		DUK_ERROR_TYPE(thr, "not Float64Array");
+	}
+	h_bufobj = (duk_hbufobj *) h;
+	if (h_bufobj->buf == NULL || !DUK_HBUFOBJ_VALID_SLICE(h_bufobj)) {
+		DUK_ERROR_TYPE_INVALID_ARGS(thr);
+	}
+	count = (duk_size_t) (h_bufobj->length >> 3);
+	if (*inout_count != (duk_size_t) -1 && *inout_count != count) {
+		DUK_ERROR_RANGE(thr, "length mismatch");
+	}
+	*inout_count = count;
+	return DUK_HBUFOBJ_GET_SLICE_BASE(thr->heap, h_bufobj);
+}
+
+#define DUK__F64_LOAD(p,i,out) DUK_MEMCPY((void *) &(out), (const void *) ((p) + (i) * 8), 8)
+#define DUK__F64_STORE(p,i,val) DUK_MEMCPY((void *) ((p) + (i) * 8), (const void *) &(val), 8)
+#define DUK__F64_BINOP_LOOP(op) do { \
+		if (p_b != NULL) { \
+			for (i = 0; i < n; i++) { \
+				DUK__F64_LOAD(p_a, i, x); \
+				DUK__F64_LOAD(p_b, i, y); \
+				x = x op y; \
+				DUK__F64_STORE(p_dst, i, x); \
+			} \
+		} else { \
+			for (i = 0; i < n; i++) { \
+				DUK__F64_LOAD(p_a, i, x); \
+				x = x op y; \
+				DUK__F64_STORE(p_dst, i, x); \
+			} \
+		} \
+	} while (0)
+
+/* Magic: 0=add, 1=sub, 2=mul, 3=div. */
+DUK_LOCAL duk_ret_t duk__float64_kernel_binop(duk_hthread *thr) {
+	duk_uint8_t *p_dst;
+	duk_uint8_t *p_a;
+	duk_uint8_t *p_b = NULL;
+	duk_size_t n = (duk_size_t) -1;
+	duk_size_t i;
+	duk_double_t x;
+	duk_double_t y = 0.0;
+
+	if (duk_is_number(thr, 2)) {
+		y = duk_get_number(thr, 2);
+	}
+	p_dst = duk__require_float64_data(thr, 0, &n);
+	p_a = duk__require_float64_data(thr, 1, &n);
+	if (!duk_is_number(thr, 2)) {
+		p_b = duk__require_float64_data(thr, 2, &n);
+	}
+
+	switch (duk_get_current_magic(thr)) {
+	case 0:
+		DUK__F64_BINOP_LOOP(+);
+		break;
+	case 1:
+		DUK__F64_BINOP_LOOP(-);
+		break;
+	case 2:
+		DUK__F64_BINOP_LOOP(*);
+		break;
+	default:
+		DUK__F64_BINOP_LOOP(/);
+		break;
+	}
+
+	duk_set_top(thr, 1);
+	return 1;
+}
+
+/* Magic: 0=sum(a), 1=dot(a, b).  Four partial sums break the dependency
+ * chain (so results may differ from a sequential loop in the last bits).
+ */
+DUK_LOCAL duk_ret_t duk__float64_kernel_reduce(duk_hthread *thr) {
+	duk_uint8_t *p_a;
+	duk_uint8_t *p_b;
+	duk_size_t n = (duk_size_t) -1;
+	duk_size_t i;
+	duk_double_t acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+	duk_double_t x;
+	duk_double_t y;
+	duk_small_uint_t k;
+
+	p_a = duk__require_float64_data(thr, 0, &n);
+	p_b = (duk_get_current_magic(thr) == 1 ? duk__require_float64_data(thr, 1, &n) : NULL);
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		for (k = 0; k < 4; k++) {
+			DUK__F64_LOAD(p_a, i + k, x);
+			if (p_b != NULL) {
+				DUK__F64_LOAD(p_b, i + k, y);
+				x *= y;
+			}
+			acc[k] += x;
+		}
+	}
+	for (; i < n; i++) {
+		DUK__F64_LOAD(p_a, i, x);
+		if (p_b != NULL) {
+			DUK__F64_LOAD(p_b, i, y);
+			x *= y;
+		}
+		acc[0] += x;
+	}
+
+	duk_push_number(thr, (acc[0] + acc[1]) + (acc[2] + acc[3]));
+	return 1;
+}
+#undef DUK__F64_LOAD
+#undef DUK__F64_STORE
+#undef DUK__F64_BINOP_LOOP
+#endif  /* DUK_USE_TYPEDARRAY_KERNELS */
+
+/* Push an object with the Float64Array kernels above, for hosts to expose
+ * as a module.
+ */
+DUK_EXTERNAL void duk_push_float64_kernels(duk_hthread *thr) {
+#if defined(DUK_USE_TYPEDARRAY_KERNELS)
+	static const struct {
+		const char *name;
+		duk_c_function func;
+		duk_idx_t nargs;
+		duk_int_t magic;
+	} kernels[] = {
+		{ "add", duk__float64_kernel_binop, 3, 0 },
+		{ "sub", duk__float64_kernel_binop, 3, 1 },
+		{ "mul", duk__float64_kernel_binop, 3, 2 },
+		{ "div", duk__float64_kernel_binop, 3, 3 },
+		{ "sum", duk__float64_kernel_reduce, 1, 0 },
+		{ "dot", duk__float64_kernel_reduce, 2, 1 }
+	};
+	duk_small_uint_t i;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+	duk_push_object(thr);
+	for (i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+		duk_push_c_function(thr, kernels[i].func, kernels[i].nargs);
+		duk_set_magic(thr, -1, kernels[i].magic);
+		duk_put_prop_string(thr, -2, kernels[i].name);
+	}
+#else
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ERROR_UNSUPPORTED(thr);
+#endif
+}
+
 /*
  *  Node.js Buffer.prototype.slice([start], [end])
  *  ArrayBuffer.prototype.slice(begin, [end])
@@ -29012,6 +31152,43 @@ DUK_LOCAL duk_bool_t duk__parse_string_iso8601_subset(duk_hthread *thr, const ch
 	parts[DUK_DATE_IDX_MONTH] = 1;
 	parts[DUK_DATE_IDX_DAY] = 1;
 
+#if defined(DUK_USE_DATE_FAST)
+	/* Fast path for the exact toISOString() form, 'YYYY-MM-DDTHH:mm:ss.sssZ',
+	 * which is what JSON round trips produce.  The template is matched left
+	 * to right so a shorter input stops at its NUL.  The parts are the same
+	 * the rule table would produce.
+	 */
+	{
+		const duk_uint8_t *tmpl = (const duk_uint8_t *) "dddd-dd-ddTdd:dd:dd.dddZ";
+		duk_small_uint_t nparts = 0;
+
+		p = (const duk_uint8_t *) str;
+		for (i = 0; tmpl[i] != 0; i++) {
+			ch = p[i];
+			if (tmpl[i] == DUK_ASC_LC_D) {
+				if (!(ch >= DUK_ASC_0 && ch <= DUK_ASC_9)) {
+					break;
+				}
+				accum = accum * 10 + ((duk_int_t) ch) - ((duk_int_t) DUK_ASC_0);
+			} else {
+				if (ch != tmpl[i]) {
+					break;
+				}
+				parts[nparts++] = accum;
+				accum = 0;
+			}
+		}
+		if (tmpl[i] == 0 && p[i] == 0) {
+			DUK_ASSERT(nparts == DUK__PI_MILLISECOND + 1);
+			goto accept;
+		}
+		DUK_MEMZERO(parts, sizeof(parts));
+		parts[DUK_DATE_IDX_MONTH] = 1;
+		parts[DUK_DATE_IDX_DAY] = 1;
+		accum = 0;
+	}
+#endif
+
 	/* Special handling for year sign. */
 	p = (const duk_uint8_t *) str;
 	ch = p[0];
@@ -29164,7 +31341,7 @@ DUK_LOCAL duk_bool_t duk__parse_string_iso8601_subset(duk_hthread *thr, const ch
 		dparts[i] = parts[i];
 	}
 
-	d = duk_bi_date_get_timeval_from_dparts(dparts, 0 /*flags*/);
+	d = duk_bi_date_get_timeval_from_dparts(thr, dparts, 0 /*flags*/);
 	duk_push_number(thr, d);
 	return 1;
 }
@@ -29312,6 +31489,7 @@ DUK_LOCAL duk_int_t duk__day_from_year(duk_int_t year) {
 }
 
 /* Given a day number, determine year and day-within-year. */
+#if !defined(DUK_USE_DATE_FAST)
 DUK_LOCAL duk_int_t duk__year_from_day(duk_int_t day, duk_small_int_t *out_day_within_year) {
 	duk_int_t year;
 	duk_int_t diff_days;
@@ -29345,6 +31523,7 @@ DUK_LOCAL duk_int_t duk__year_from_day(duk_int_t day, duk_small_int_t *out_day_w
 		year -= 1 + (diff_days - 1) / 366;  /* conservative */
 	}
 }
+#endif  /* !DUK_USE_DATE_FAST */
 
 /* Given a (year, month, day-within-month) triple, compute day number.
  * The input triple is un-normalized and may contain non-finite values.
@@ -29483,6 +31662,30 @@ DUK_INTERNAL void duk_bi_date_timeval_to_parts(duk_double_t d, duk_int_t *parts,
 	parts[DUK_DATE_IDX_WEEKDAY] = (t2 + 4 + DUK__WEEKDAY_MOD_ADDER) % 7;  /* E5.1 Section 15.9.1.6 */
 	DUK_ASSERT(parts[DUK_DATE_IDX_WEEKDAY] >= 0 && parts[DUK_DATE_IDX_WEEKDAY] <= 6);
 
+#if defined(DUK_USE_DATE_FAST)
+	/* Civil date from day number without iteration, see Howard Hinnant's
+	 * 'chrono-Compatible Low-Level Date Algorithms'.  Years are counted
+	 * from March 1 so that the leap day is the last day of the year, and
+	 * 400-year eras are shifted to be non-negative for the valid range.
+	 */
+	{
+		duk_int_t z, era, doe, yoe, doy, mp;
+
+		z = t2 + 719468;  /* days from 0000-03-01 */
+		era = (z >= 0 ? z : z - 146096) / 146097;
+		doe = z - era * 146097;  /* [0, 146096] */
+		yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  /* [0, 399] */
+		doy = doe - (365 * yoe + yoe / 4 - yoe / 100);  /* [0, 365], March 1 based */
+		mp = (5 * doy + 2) / 153;  /* [0, 11], March based */
+		day = (duk_small_int_t) (doy - (153 * mp + 2) / 5);
+		month = (duk_small_int_t) (mp < 10 ? mp + 2 : mp - 10);
+		year = yoe + era * 400 + (mp >= 10 ? 1 : 0);
+		is_leap = duk_bi_date_is_leap_year(year);
+		day_in_year = (duk_small_int_t) (mp >= 10 ? doy - 306 : doy + 59 + (duk_int_t) is_leap);
+		DUK_UNREF(dim);
+	}
+	DUK_ASSERT(day_since_epoch - day_in_year == duk__day_from_year(year));
+#else
 	year = duk__year_from_day(t2, &day_in_year);
 	day = day_in_year;
 	is_leap = duk_bi_date_is_leap_year(year);
@@ -29498,6 +31701,7 @@ DUK_INTERNAL void duk_bi_date_timeval_to_parts(duk_double_t d, duk_int_t *parts,
 		}
 		day -= dim;
 	}
+#endif
 	DUK_DDD(DUK_DDDPRINT("final month=%ld", (long) month));
 	DUK_ASSERT(month >= 0 && month <= 11);
 	DUK_ASSERT(day >= 0 && day <= 31);
@@ -29551,13 +31755,95 @@ DUK_INTERNAL void duk_bi_date_timeval_to_parts(duk_double_t d, duk_int_t *parts,
 	}
 }
 
+/* Local time offset lookup.  With DUK_USE_DATE_FAST the platform provider
+ * is memoized per heap: each entry covers a millisecond range of one UTC day
+ * whose endpoints have been looked up and have the same offset.  Lookups on
+ * the same day with the same offset widen the range; once a day has seen
+ * three distinct instants both ends of the day are looked up and, if they
+ * agree, the entry covers the whole day.  Sparse lookups thus cost the same
+ * as without the cache, and dense ones settle quickly.  This assumes
+ * there are never two offset changes within a single day, and that the
+ * platform time zone doesn't change while the heap is alive.
+ */
+#if defined(DUK_USE_DATE_FAST)
+DUK_LOCAL duk_int_t duk__get_local_tzoffset_cached(duk_heap *heap, duk_double_t d) {
+	duk_date_tzo_cache *c;
+	duk_double_t d_day;
+	duk_int_t day;
+	duk_int_t msec;
+	duk_int_t tzoffset;
+
+	if (!DUK_ISFINITE(d) || !duk_bi_date_timeval_in_leeway_range(d)) {
+		return DUK_USE_DATE_GET_LOCAL_TZOFFSET(d);
+	}
+
+	d = DUK_FLOOR(d);
+	d_day = DUK_FLOOR(d / (duk_double_t) DUK_DATE_MSEC_DAY);
+	day = (duk_int_t) d_day;
+	msec = (duk_int_t) (d - d_day * (duk_double_t) DUK_DATE_MSEC_DAY);
+	DUK_ASSERT(day != DUK_INT_MIN);
+	DUK_ASSERT(msec >= 0 && msec < DUK_DATE_MSEC_DAY);
+
+	c = heap->date_tzo_cache + ((duk_uint_t) day & (DUK_HEAP_DATE_TZO_CACHE_SIZE - 1));
+	if (c->day == day && msec >= c->lo && msec <= c->hi) {
+		return c->tzoffset;
+	}
+
+	if (c->day == day && c->lo < c->hi && c->lo > 0 && c->hi < DUK_DATE_MSEC_DAY - 1) {
+		duk_int_t tzo_first;
+		duk_int_t tzo_last;
+
+		tzo_first = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d - (duk_double_t) msec);
+		tzo_last = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d - (duk_double_t) msec + (duk_double_t) (DUK_DATE_MSEC_DAY - 1));
+		if (tzo_first == tzo_last) {
+			c->lo = 0;
+			c->hi = DUK_DATE_MSEC_DAY - 1;
+			c->tzoffset = tzo_first;
+			return tzo_first;
+		}
+
+		/* The offset changes during this day: anchor the range at
+		 * whichever end of the day 'd' agrees with.
+		 */
+		tzoffset = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d);
+		if (tzoffset == tzo_first) {
+			c->lo = 0;
+			c->hi = msec;
+		} else {
+			c->lo = msec;
+			c->hi = DUK_DATE_MSEC_DAY - 1;
+		}
+		c->tzoffset = tzoffset;
+		return tzoffset;
+	}
+
+	tzoffset = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d);
+	if (c->day == day && c->tzoffset == tzoffset) {
+		if (msec < c->lo) {
+			c->lo = msec;
+		} else {
+			c->hi = msec;
+		}
+	} else {
+		c->day = day;
+		c->lo = msec;
+		c->hi = msec;
+		c->tzoffset = tzoffset;
+	}
+	return tzoffset;
+}
+#define DUK__GET_LOCAL_TZOFFSET(thr,d)  duk__get_local_tzoffset_cached((thr)->heap, (d))
+#else
+#define DUK__GET_LOCAL_TZOFFSET(thr,d)  DUK_USE_DATE_GET_LOCAL_TZOFFSET((d))
+#endif
+
 /* Compute time value from (double) parts.  The parts can be either UTC
  * or local time; if local, they need to be (conceptually) converted into
  * UTC time.  The parts may represent valid or invalid time, and may be
  * wildly out of range (but may cancel each other and still come out in
  * the valid Date range).
  */
-DUK_INTERNAL duk_double_t duk_bi_date_get_timeval_from_dparts(duk_double_t *dparts, duk_small_uint_t flags) {
+DUK_INTERNAL duk_double_t duk_bi_date_get_timeval_from_dparts(duk_hthread *thr, duk_double_t *dparts, duk_small_uint_t flags) {
 #if defined(DUK_USE_PARANOID_DATE_COMPUTATION)
 	/* See comments below on MakeTime why these are volatile. */
 	volatile duk_double_t tmp_time;
@@ -29571,6 +31857,9 @@ DUK_INTERNAL duk_double_t duk_bi_date_get_timeval_from_dparts(duk_double_t *dpar
 	duk_small_uint_t i;
 	duk_int_t tzoff, tzoffprev1, tzoffprev2;
 
+	DUK_ASSERT(thr != NULL || !(flags & DUK_DATE_FLAG_LOCALTIME));
+	DUK_UNREF(thr);
+
 	/* Expects 'this' at top of stack on entry. */
 
 	/* Coerce all finite parts with ToInteger().  ToInteger() must not
@@ -29656,7 +31945,7 @@ DUK_INTERNAL duk_double_t duk_bi_date_get_timeval_from_dparts(duk_double_t *dpar
 		for (i = 0; i < DUK__LOCAL_TZOFFSET_MAXITER; i++) {
 			tzoffprev2 = tzoffprev1;
 			tzoffprev1 = tzoff;
-			tzoff = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d - tzoff * 1000L);
+			tzoff = DUK__GET_LOCAL_TZOFFSET(thr, d - tzoff * 1000L);
 			DUK_DDD(DUK_DDDPRINT("tzoffset iteration, i=%d, tzoff=%ld, tzoffprev1=%ld tzoffprev2=%ld",
 			                     (int) i, (long) tzoff, (long) tzoffprev1, (long) tzoffprev2));
 			if (tzoff == tzoffprev1) {
@@ -29725,7 +32014,7 @@ DUK_LOCAL duk_double_t duk__push_this_get_timeval_tzoffset(duk_hthread *thr, duk
 		/* Note: DST adjustment is determined using UTC time.
 		 * If 'd' is NaN, tzoffset will be 0.
 		 */
-		tzoffset = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d);  /* seconds */
+		tzoffset = DUK__GET_LOCAL_TZOFFSET(thr, d);  /* seconds */
 		d += tzoffset * 1000L;
 	}
 	if (out_tzoffset) {
@@ -29749,7 +32038,7 @@ DUK_LOCAL duk_ret_t duk__set_this_timeval_from_dparts(duk_hthread *thr, duk_doub
 
 	/* [ ... this ] */
 
-	d = duk_bi_date_get_timeval_from_dparts(dparts, flags);
+	d = duk_bi_date_get_timeval_from_dparts(thr, dparts, flags);
 	duk_push_number(thr, d);  /* -> [ ... this timeval_new ] */
 	duk_dup_top(thr);         /* -> [ ... this timeval_new timeval_new ] */
 	duk_put_prop_stridx_short(thr, -3, DUK_STRIDX_INT_VALUE);
@@ -29759,6 +32048,81 @@ DUK_LOCAL duk_ret_t duk__set_this_timeval_from_dparts(duk_hthread *thr, duk_doub
 }
 
 /* 'out_buf' must be at least DUK_BI_DATE_ISO8601_BUFSIZE long. */
+#if defined(DUK_USE_DATE_FAST)
+/* Write 'ndigits' zero padded decimal digits of 'val'. */
+DUK_LOCAL duk_uint8_t *duk__format_digits(duk_uint8_t *p, duk_uint_t val, duk_small_uint_t ndigits) {
+	duk_uint8_t *q;
+
+	p += ndigits;
+	q = p;
+	while (ndigits-- > 0) {
+		*--q = (duk_uint8_t) (DUK_ASC_0 + val % 10U);
+		val /= 10U;
+	}
+	return p;
+}
+
+/* Same output as the snprintf() based formatter below, written directly. */
+DUK_LOCAL void duk__format_parts_iso8601(duk_int_t *parts, duk_int_t tzoffset, duk_small_uint_t flags, duk_uint8_t *out_buf) {
+	duk_uint8_t *p = out_buf;
+	duk_int_t year = parts[DUK_DATE_IDX_YEAR];
+
+	DUK_ASSERT(parts[DUK_DATE_IDX_MONTH] >= 1 && parts[DUK_DATE_IDX_MONTH] <= 12);
+	DUK_ASSERT(parts[DUK_DATE_IDX_DAY] >= 1 && parts[DUK_DATE_IDX_DAY] <= 31);
+	DUK_ASSERT(year >= -999999 && year <= 999999);
+
+	if (flags & DUK_DATE_FLAG_TOSTRING_DATE) {
+		if (year >= 0 && year <= 9999) {
+			p = duk__format_digits(p, (duk_uint_t) year, 4);
+		} else if (year >= 0) {
+			*p++ = DUK_ASC_PLUS;
+			p = duk__format_digits(p, (duk_uint_t) year, 6);
+		} else {
+			*p++ = DUK_ASC_MINUS;
+			p = duk__format_digits(p, (duk_uint_t) -year, 6);
+		}
+		*p++ = DUK_ASC_MINUS;
+		p = duk__format_digits(p, (duk_uint_t) parts[DUK_DATE_IDX_MONTH], 2);
+		*p++ = DUK_ASC_MINUS;
+		p = duk__format_digits(p, (duk_uint_t) parts[DUK_DATE_IDX_DAY], 2);
+		if (!(flags & DUK_DATE_FLAG_TOSTRING_TIME)) {
+			*p = (duk_uint8_t) 0;
+			return;
+		}
+		*p++ = (flags & DUK_DATE_FLAG_SEP_T) ? DUK_ASC_UC_T : DUK_ASC_SPACE;
+	}
+
+	DUK_ASSERT(flags & DUK_DATE_FLAG_TOSTRING_TIME);
+	p = duk__format_digits(p, (duk_uint_t) parts[DUK_DATE_IDX_HOUR], 2);
+	*p++ = DUK_ASC_COLON;
+	p = duk__format_digits(p, (duk_uint_t) parts[DUK_DATE_IDX_MINUTE], 2);
+	*p++ = DUK_ASC_COLON;
+	p = duk__format_digits(p, (duk_uint_t) parts[DUK_DATE_IDX_SECOND], 2);
+	*p++ = DUK_ASC_PERIOD;
+	p = duk__format_digits(p, (duk_uint_t) parts[DUK_DATE_IDX_MILLISECOND], 3);
+
+	if (flags & DUK_DATE_FLAG_LOCALTIME) {
+		/* tzoffset seconds are dropped */
+		duk_uint_t tmp;
+
+		if (tzoffset >= 0) {
+			*p++ = DUK_ASC_PLUS;
+			tmp = (duk_uint_t) tzoffset;
+		} else {
+			*p++ = DUK_ASC_MINUS;
+			tmp = (duk_uint_t) -tzoffset;
+		}
+		tmp = tmp / 60U;
+		DUK_ASSERT(tmp / 60U <= 24);
+		p = duk__format_digits(p, tmp / 60U, 2);
+		*p++ = DUK_ASC_COLON;
+		p = duk__format_digits(p, tmp % 60U, 2);
+	} else {
+		*p++ = DUK_ASC_UC_Z;
+	}
+	*p = (duk_uint8_t) 0;
+}
+#else  /* DUK_USE_DATE_FAST */
 DUK_LOCAL void duk__format_parts_iso8601(duk_int_t *parts, duk_int_t tzoffset, duk_small_uint_t flags, duk_uint8_t *out_buf) {
 	char yearstr[8];   /* "-123456\0" */
 	char tzstr[8];     /* "+11:22\0" */
@@ -29824,6 +32188,7 @@ DUK_LOCAL void duk__format_parts_iso8601(duk_int_t *parts, duk_int_t tzoffset, d
 		            (const char *) tzstr);
 	}
 }
+#endif  /* DUK_USE_DATE_FAST */
 
 /* Helper for string conversion calls: check 'this' binding, get the
  * internal time value, and format date and/or time in a few formats.
@@ -30295,7 +32660,7 @@ DUK_INTERNAL duk_ret_t duk_bi_date_constructor_utc(duk_hthread *thr) {
 		duk_push_nan(thr);
 	} else {
 		duk__set_parts_from_args(thr, dparts, nargs);
-		d = duk_bi_date_get_timeval_from_dparts(dparts, 0 /*flags*/);
+		d = duk_bi_date_get_timeval_from_dparts(thr, dparts, 0 /*flags*/);
 		duk_push_number(thr, d);
 	}
 	return 1;
@@ -30456,7 +32821,7 @@ DUK_INTERNAL duk_ret_t duk_bi_date_prototype_get_timezone_offset(duk_hthread *th
 		duk_push_nan(thr);
 	} else {
 		DUK_ASSERT(DUK_ISFINITE(d));
-		tzoffset = DUK_USE_DATE_GET_LOCAL_TZOFFSET(d);
+		tzoffset = DUK__GET_LOCAL_TZOFFSET(thr, d);
 		duk_push_int(thr, -tzoffset / 60);
 	}
 	return 1;
@@ -30537,6 +32902,7 @@ DUK_INTERNAL duk_ret_t duk_bi_date_prototype_set_time(duk_hthread *thr) {
 #undef DUK__DPRINT_DPARTS
 #undef DUK__DPRINT_PARTS
 #undef DUK__DPRINT_PARTS_AND_DPARTS
+#undef DUK__GET_LOCAL_TZOFFSET
 #undef DUK__LOCAL_TZOFFSET_MAXITER
 #undef DUK__NUM_ISO8601_PARSER_PARTS
 #undef DUK__PACK_RULE
@@ -30708,7 +33074,7 @@ DUK_INTERNAL duk_int_t duk_bi_date_get_local_tzoffset_gmtime(duk_double_t d) {
 	duk_bi_date_timeval_to_parts(d, parts, dparts, DUK_DATE_FLAG_EQUIVYEAR /*flags*/);
 	DUK_ASSERT(parts[DUK_DATE_IDX_YEAR] >= 1970 && parts[DUK_DATE_IDX_YEAR] <= 2038);
 
-	d = duk_bi_date_get_timeval_from_dparts(dparts, 0 /*flags*/);
+	d = duk_bi_date_get_timeval_from_dparts(NULL /*thr, unused for UTC*/, dparts, 0 /*flags*/);
 	DUK_ASSERT(d >= 0 && d < 2147483648.0 * 1000.0);  /* unsigned 31-bit range */
 	t = (time_t) (d / 1000.0);
 	DUK_DDD(DUK_DDDPRINT("timeval: %lf -> time_t %ld", (double) d, (long) t));
@@ -31532,6 +33898,20 @@ DUK_LOCAL duk_ret_t duk__decode_helper(duk_hthread *thr, duk__decode_context *de
 	in = input;
 	out = output;
 	while (in < input + len) {
+#if defined(DUK_USE_CODEC_SIMD)
+		/* ASCII runs outside a multibyte sequence are copied as is; a
+		 * leading ASCII character can't be a BOM.
+		 */
+		if (*in < 0x80U && dec_ctx->needed == 0) {
+			duk_size_t n = duk_ascii_span((const void *) in, (duk_size_t) (input + len - in));
+			DUK_ASSERT(n >= 1);
+			DUK_MEMCPY((void *) out, (const void *) in, n);
+			in += n;
+			out += n;
+			dec_ctx->bom_handled = 1;
+			continue;
+		}
+#endif
 		codepoint = duk__utf8_decode_next(dec_ctx, *in++);
 		if (codepoint < 0) {
 			if (codepoint == DUK__CP_CONTINUE) {
@@ -31612,12 +33992,18 @@ DUK_INTERNAL duk_ret_t duk_bi_textencoder_prototype_encode(duk_hthread *thr) {
 	duk_size_t len;
 	duk_size_t final_len;
 	duk_uint8_t *output;
+#if defined(DUK_USE_CODEC_SIMD)
+	duk_hstring *h_input = NULL;
+	duk_size_t alloc_len;
+#endif
 
 	DUK_ASSERT_TOP(thr, 1);
 	if (duk_is_undefined(thr, 0)) {
 		len = 0;
 	} else {
+#if !defined(DUK_USE_CODEC_SIMD)
 		duk_hstring *h_input;
+#endif
 
 		h_input = duk_to_hstring(thr, 0);
 		DUK_ASSERT(h_input != NULL);
@@ -31638,7 +34024,16 @@ DUK_INTERNAL duk_ret_t duk_bi_textencoder_prototype_encode(duk_hthread *thr) {
 	 * figure out the space needed ahead of time?
 	 */
 	DUK_ASSERT(3 * len >= len);
+#if defined(DUK_USE_CODEC_SIMD)
+	/* ASCII input encodes to itself, so the exact size is known. */
+	alloc_len = 3 * len;
+	if (h_input != NULL && DUK_HSTRING_GET_BYTELEN(h_input) == len) {
+		alloc_len = len;
+	}
+	output = (duk_uint8_t *) duk_push_dynamic_buffer(thr, alloc_len);
+#else
 	output = (duk_uint8_t *) duk_push_dynamic_buffer(thr, 3 * len);
+#endif
 
 	if (len > 0) {
 		DUK_ASSERT(duk_is_string(thr, 0));  /* True if len > 0. */
@@ -31657,7 +34052,33 @@ DUK_INTERNAL duk_ret_t duk_bi_textencoder_prototype_encode(duk_hthread *thr) {
 		 */
 		enc_ctx.lead = 0x0000L;
 		enc_ctx.out = output;
+#if defined(DUK_USE_CODEC_SIMD)
+		{
+			/* Same as duk_decode_string() below, but ASCII runs
+			 * (outside a pending surrogate pair) are copied as is.
+			 */
+			const duk_uint8_t *p, *p_start, *p_end;
+			duk_size_t n;
+
+			DUK_ASSERT(h_input != NULL);
+			p_start = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
+			p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_input);
+			p = p_start;
+			while (p < p_end) {
+				if (*p < 0x80U && enc_ctx.lead == 0x0000L) {
+					n = duk_ascii_span((const void *) p, (duk_size_t) (p_end - p));
+					DUK_ASSERT(n >= 1);
+					DUK_MEMCPY((void *) enc_ctx.out, (const void *) p, n);
+					enc_ctx.out += n;
+					p += n;
+				} else {
+					duk__utf8_encode_char((void *) &enc_ctx, duk_unicode_decode_xutf8_checked(thr, &p, p_start, p_end));
+				}
+			}
+		}
+#else
 		duk_decode_string(thr, 0, duk__utf8_encode_char, (void *) &enc_ctx);
+#endif
 		if (enc_ctx.lead != 0x0000L) {
 			/* unpaired high surrogate at end of string */
 			enc_ctx.out = duk__utf8_emit_repl(enc_ctx.out);
@@ -31671,7 +34092,13 @@ DUK_INTERNAL duk_ret_t duk_bi_textencoder_prototype_encode(duk_hthread *thr) {
 		DUK_ASSERT(output == (duk_uint8_t *) duk_get_buffer_data(thr, -1, NULL));
 
 		final_len = (duk_size_t) (enc_ctx.out - output);
+#if defined(DUK_USE_CODEC_SIMD)
+		if (final_len != alloc_len) {
+			duk_resize_buffer(thr, -1, final_len);
+		}
+#else
 		duk_resize_buffer(thr, -1, final_len);
+#endif
 		/* 'output' and 'enc_ctx.out' are potentially invalidated by the resize. */
 	} else {
 		final_len = 0;
@@ -34090,7 +36517,9 @@ DUK_LOCAL void duk__dec_objarr_exit(duk_json_dec_ctx *js_ctx) {
 
 DUK_LOCAL void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 	duk_hthread *thr = js_ctx->thr;
+	duk_hobject *h_obj;
 	duk_int_t key_count;  /* XXX: a "first" flag would suffice */
+	duk_uint32_t size_hint;
 	duk_uint8_t x;
 
 	DUK_DDD(DUK_DDDPRINT("parse_object"));
@@ -34099,6 +36528,24 @@ DUK_LOCAL void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 
 	duk_push_object(thr);
 
+	/* Records in JSON data usually come in runs of identically shaped
+	 * objects (e.g. an array of events).  Size the entry part from the
+	 * key count of the previous object decoded at the same nesting level
+	 * so that such objects are allocated once with an exact size instead
+	 * of growing step by step.
+	 */
+	size_hint = 0;
+	if (js_ctx->recursion_depth < DUK_JSON_DEC_SIZEHINTS) {
+		size_hint = js_ctx->obj_size_hint[js_ctx->recursion_depth];
+	}
+#if !defined(DUK_USE_PREFER_SIZE)
+	if (size_hint > 0) {
+		duk_hobject_resize_entrypart(thr, duk_known_hobject(thr, -1), size_hint);
+	}
+#else
+	DUK_UNREF(size_hint);
+#endif
+
 	/* Initial '{' has been checked and eaten by caller. */
 
 	key_count = 0;
@@ -34160,6 +36607,17 @@ DUK_LOCAL void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 
 	/* [ ... obj ] */
 
+	/* Drop entry part slack left by growing (or by a too large hint),
+	 * decoded objects are usually long lived.
+	 */
+	h_obj = duk_known_hobject(thr, -1);
+	if (DUK_HOBJECT_GET_ESIZE(h_obj) != DUK_HOBJECT_GET_ENEXT(h_obj)) {
+		duk_hobject_compact_props(thr, h_obj);
+	}
+	if (js_ctx->recursion_depth < DUK_JSON_DEC_SIZEHINTS) {
+		js_ctx->obj_size_hint[js_ctx->recursion_depth] = DUK_HOBJECT_GET_ENEXT(h_obj);
+	}
+
 	DUK_DDD(DUK_DDDPRINT("parse_object: final object is %!T",
 	                     (duk_tval *) duk_get_tval(thr, -1)));
 
@@ -38046,7 +40504,7 @@ DUK_INTERNAL duk_ret_t duk_bi_object_constructor_keys_shared(duk_hthread *thr) {
 	}
 
 	duk_push_hobject(thr, h_proxy_handler);
-	if (!duk_get_prop_stridx_short(thr, -1, DUK_STRIDX_OWN_KEYS)) {
+	if (!duk_hobject_proxy_get_trap(thr, obj, DUK_STRIDX_OWN_KEYS)) {
 		/* Careful with reachability here: don't pop 'obj' before pushing
 		 * proxy target.
 		 */
@@ -38061,7 +40519,7 @@ DUK_INTERNAL duk_ret_t duk_bi_object_constructor_keys_shared(duk_hthread *thr) {
 	/* [ obj handler trap ] */
 	duk_insert(thr, -2);
 	duk_push_hobject(thr, h_proxy_target);  /* -> [ obj trap handler target ] */
-	duk_call_method(thr, 1 /*nargs*/);      /* -> [ obj trap_result ] */
+	duk_hobject_proxy_call_trap(thr, 1 /*nargs*/);  /* -> [ obj trap_result ] */
 	h_trap_result = duk_require_hobject(thr, -1);
 	DUK_UNREF(h_trap_result);
 
@@ -38069,7 +40527,7 @@ DUK_INTERNAL duk_ret_t duk_bi_object_constructor_keys_shared(duk_hthread *thr) {
 	DUK_ASSERT(magic >= 0 && magic < (duk_int_t) (sizeof(duk__object_keys_enum_flags) / sizeof(duk_small_uint_t)));
 	enum_flags = duk__object_keys_enum_flags[magic];
 
-	duk_proxy_ownkeys_postprocess(thr, h_proxy_target, enum_flags);
+	duk_proxy_ownkeys_postprocess(thr, obj, h_proxy_target, enum_flags);
 	return 1;
 
  skip_proxy:
@@ -38347,13 +40805,28 @@ DUK_INTERNAL duk_ret_t duk_bi_promise_then(duk_hthread *thr) {
  * array of valid result keys (strings or symbols).  TypeError for invalid
  * values.  Flags are shared with duk_enum().
  */
-DUK_INTERNAL void duk_proxy_ownkeys_postprocess(duk_hthread *thr, duk_hobject *h_proxy_target, duk_uint_t flags) {
+DUK_INTERNAL void duk_proxy_ownkeys_postprocess(duk_hthread *thr, duk_hobject *h_proxy, duk_hobject *h_proxy_target, duk_uint_t flags) {
 	duk_uarridx_t i, len, idx;
 	duk_propdesc desc;
+	duk_bool_t check_enumerable;
 
 	DUK_ASSERT_CTX_VALID(thr);
+	DUK_ASSERT(h_proxy != NULL);
 	DUK_ASSERT(h_proxy_target != NULL);
 
+	check_enumerable = !(flags & DUK_ENUM_INCLUDE_NONENUMERABLE);
+#if defined(DUK_USE_PROXY_NATIVE)
+	/* A native 'ownKeys' trap has no 'getOwnPropertyDescriptor' trap to go
+	 * with it, and its target is typically empty: the keys it returns are
+	 * taken to be enumerable own properties.
+	 */
+	if (((duk_hproxy *) h_proxy)->native_traps & DUK_PROXY_TRAP_OWN_KEYS) {
+		check_enumerable = 0;
+	}
+#else
+	DUK_UNREF(h_proxy);
+#endif
+
 	len = (duk_uarridx_t) duk_get_length(thr, -1);
 	idx = 0;
 	duk_push_array(thr);
@@ -38368,7 +40841,7 @@ DUK_INTERNAL void duk_proxy_ownkeys_postprocess(duk_hthread *thr, duk_hobject *h
 			DUK_ERROR_TYPE_INVALID_TRAP_RESULT(thr);
 		}
 
-		if (!(flags & DUK_ENUM_INCLUDE_NONENUMERABLE)) {
+		if (check_enumerable) {
 			/* No support for 'getOwnPropertyDescriptor' trap yet,
 			 * so check enumerability always from target object
 			 * descriptor.
@@ -38794,6 +41267,67 @@ DUK_LOCAL duk_hstring *duk__str_tostring_notregexp(duk_hthread *thr, duk_idx_t i
 	return h;
 }
 
+#if defined(DUK_USE_STRSEARCH_SIMD)
+/* Find the first occurrence of [q, q + q_blen) in [p, p_end), NULL if none.
+ * With SSE2, 16 candidate positions are filtered at a time by comparing
+ * both the first and the last byte of the search string, and only the
+ * survivors are memcmp()'d; otherwise memchr() finds first byte matches.
+ */
+DUK_LOCAL const duk_uint8_t *duk__str_find_bytes(const duk_uint8_t *p, const duk_uint8_t *p_end, const duk_uint8_t *q, duk_size_t q_blen) {
+	const duk_uint8_t *p_last;  /* last possible match start */
+
+	if ((duk_size_t) (p_end - p) < q_blen) {
+		return NULL;
+	}
+	if (q_blen == 0) {
+		return p;
+	}
+	p_last = p_end - q_blen;
+
+#if defined(DUK_USE_STRSEARCH_SSE2)
+	if (q_blen >= 2) {
+		__m128i v_first = _mm_set1_epi8((char) q[0]);
+		__m128i v_last = _mm_set1_epi8((char) q[q_blen - 1]);
+
+		while (p_last - p >= 15) {
+			__m128i b_first = _mm_loadu_si128((const __m128i *) (const void *) p);
+			__m128i b_last = _mm_loadu_si128((const __m128i *) (const void *) (p + q_blen - 1));
+			unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(b_first, v_first),
+			                                                                   _mm_cmpeq_epi8(b_last, v_last)));
+			while (mask != 0) {
+				unsigned int i = (unsigned int) __builtin_ctz(mask);
+				if (DUK_MEMCMP((const void *) (p + i + 1), (const void *) (q + 1), (size_t) (q_blen - 2)) == 0) {
+					return p + i;
+				}
+				mask &= mask - 1;
+			}
+			p += 16;
+		}
+	}
+#endif  /* DUK_USE_STRSEARCH_SSE2 */
+
+	while (p <= p_last) {
+		p = (const duk_uint8_t *) DUK_MEMCHR((const void *) p, (int) q[0], (size_t) (p_last - p + 1));
+		if (p == NULL) {
+			return NULL;
+		}
+		if (DUK_MEMCMP((const void *) (p + 1), (const void *) (q + 1), (size_t) (q_blen - 1)) == 0) {
+			return p;
+		}
+		p++;
+	}
+	return NULL;
+}
+
+/* Number of chars in [p, q) of string 'h'. */
+DUK_LOCAL duk_size_t duk__str_count_chars(duk_hstring *h, const duk_uint8_t *p, const duk_uint8_t *q) {
+	if (DUK_HSTRING_IS_ASCII(h)) {
+		return (duk_size_t) (q - p);
+	}
+	return duk_unicode_unvalidated_utf8_length(p, (duk_size_t) (q - p));
+}
+#endif  /* DUK_USE_STRSEARCH_SIMD */
+
 DUK_LOCAL duk_int_t duk__str_search_shared(duk_hthread *thr, duk_hstring *h_this, duk_hstring *h_search, duk_int_t start_cpos, duk_bool_t backwards) {
 	duk_int_t cpos;
 	duk_int_t bpos;
@@ -38822,6 +41356,18 @@ DUK_LOCAL duk_int_t duk__str_search_shared(duk_hthread *thr, duk_hstring *h_this
 	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_this);
 	p = p_start + bpos;
 
+#if defined(DUK_USE_STRSEARCH_SIMD)
+	if (!backwards) {
+		const duk_uint8_t *p_found;
+
+		p_found = duk__str_find_bytes(p, p_end, q_start, (duk_size_t) q_blen);
+		if (p_found == NULL) {
+			return -1;
+		}
+		return cpos + (duk_int_t) duk__str_count_chars(h_this, p, p_found);
+	}
+#endif
+
 	/* This loop is optimized for size.  For speed, there should be
 	 * two separate loops, and we should ensure that memcmp() can be
 	 * used without an extra "will searchstring fit" check.  Doing
@@ -39412,10 +41958,22 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_hthread *thr) {
 			q_start = DUK_HSTRING_GET_DATA(h_search);
 			q_blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_search);
 
-			p_end -= q_blen;  /* ensure full memcmp() fits in while */
-
 			match_start_coff = 0;
 
+#if defined(DUK_USE_STRSEARCH_SIMD)
+			p = duk__str_find_bytes(p, p_end, q_start, q_blen);
+			if (p != NULL) {
+				match_start_coff = (duk_uint32_t) duk__str_count_chars(h_input, p_start, p);
+				duk_dup_0(thr);
+				h_match = duk_known_hstring(thr, -1);
+#if defined(DUK_USE_REGEXP_SUPPORT)
+				match_caps = 0;
+#endif
+				goto found;
+			}
+#else  /* DUK_USE_STRSEARCH_SIMD */
+			p_end -= q_blen;  /* ensure full memcmp() fits in while */
+
 			while (p <= p_end) {
 				DUK_ASSERT(p + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
 				if (DUK_MEMCMP((const void *) p, (const void *) q_start, (size_t) q_blen) == 0) {
@@ -39433,6 +41991,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_hthread *thr) {
 				}
 				p++;
 			}
+#endif  /* DUK_USE_STRSEARCH_SIMD */
 
 			/* not found */
 			break;
@@ -39796,6 +42355,18 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_split(duk_hthread *thr) {
 			}
 
 			DUK_ASSERT(q_blen > 0 && q_clen > 0);
+#if defined(DUK_USE_STRSEARCH_SIMD)
+			{
+				const duk_uint8_t *p_found;
+
+				p_found = duk__str_find_bytes(p, p_end + q_blen, q_start, q_blen);
+				if (p_found != NULL) {
+					match_start_coff += (duk_uint32_t) duk__str_count_chars(h_input, p, p_found);
+					p = p_found;
+					goto found;
+				}
+			}
+#else  /* DUK_USE_STRSEARCH_SIMD */
 			while (p <= p_end) {
 				DUK_ASSERT(p + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
 				DUK_ASSERT(q_blen > 0);  /* no issues with empty memcmp() */
@@ -39810,6 +42381,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_split(duk_hthread *thr) {
 				}
 				p++;
 			}
+#endif  /* DUK_USE_STRSEARCH_SIMD */
 
 		 not_found:
 			/* not found */
@@ -40984,12 +43556,12 @@ DUK_LOCAL const char * const duk__bc_optab[256] = {
 
 	"NEWOBJ", "NEWARR", "MPUTOBJ", "MPUTOBJI", "INITSET", "INITGET", "MPUTARR", "MPUTARRI",
 	"SETALEN", "INITENUM", "NEXTENUM", "NEWTARGET", "DEBUGGER", "NOP", "INVALID", "UNUSED207",
-	"GETPROPC_RR", "GETPROPC_CR", "GETPROPC_RC", "GETPROPC_CC", "UNUSED212", "UNUSED213", "UNUSED214", "UNUSED215",
-	"UNUSED216", "UNUSED217", "UNUSED218", "UNUSED219", "UNUSED220", "UNUSED221", "UNUSED222", "UNUSED223",
+	"GETPROPC_RR", "GETPROPC_CR", "GETPROPC_RC", "GETPROPC_CC", "EQ_IFTRUE_RR", "EQ_IFTRUE_RC", "EQ_IFFALSE_RR", "EQ_IFFALSE_RC",
+	"NEQ_IFTRUE_RR", "NEQ_IFTRUE_RC", "NEQ_IFFALSE_RR", "NEQ_IFFALSE_RC", "SEQ_IFTRUE_RR", "SEQ_IFTRUE_RC", "SEQ_IFFALSE_RR", "SEQ_IFFALSE_RC",
 
-	"UNUSED224", "UNUSED225", "UNUSED226", "UNUSED227", "UNUSED228", "UNUSED229", "UNUSED230", "UNUSED231",
-	"UNUSED232", "UNUSED233", "UNUSED234", "UNUSED235", "UNUSED236", "UNUSED237", "UNUSED238", "UNUSED239",
-	"UNUSED240", "UNUSED241", "UNUSED242", "UNUSED243", "UNUSED244", "UNUSED245", "UNUSED246", "UNUSED247",
+	"SNEQ_IFTRUE_RR", "SNEQ_IFTRUE_RC", "SNEQ_IFFALSE_RR", "SNEQ_IFFALSE_RC", "GT_IFTRUE_RR", "GT_IFTRUE_RC", "GT_IFFALSE_RR", "GT_IFFALSE_RC",
+	"GE_IFTRUE_RR", "GE_IFTRUE_RC", "GE_IFFALSE_RR", "GE_IFFALSE_RC", "LT_IFTRUE_RR", "LT_IFTRUE_RC", "LT_IFFALSE_RR", "LT_IFFALSE_RC",
+	"LE_IFTRUE_RR", "LE_IFTRUE_RC", "LE_IFFALSE_RR", "LE_IFFALSE_RC", "ADDASN_RR", "ADDASN_CR", "ADDASN_RC", "ADDASN_CC",
 	"UNUSED248", "UNUSED249", "UNUSED250", "UNUSED251", "UNUSED252", "UNUSED253", "UNUSED254", "UNUSED255"
 };
 
@@ -45957,6 +48529,9 @@ DUK_INTERNAL duk_hbuffer *duk_hbuffer_alloc(duk_heap *heap, duk_size_t size, duk
 	}
         DUK_HEAP_INSERT_INTO_HEAP_ALLOCATED(heap, &res->hdr);
 
+	DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_BUFFER,
+	                      (flags & (DUK_BUF_FLAG_DYNAMIC | DUK_BUF_FLAG_EXTERNAL)) == DUK_BUF_FLAG_DYNAMIC ? alloc_size + size : alloc_size);
+
 	DUK_DDD(DUK_DDDPRINT("allocated hbuffer: %p", (void *) res));
 	return res;
 
@@ -46032,6 +48607,7 @@ DUK_INTERNAL void duk_hbuffer_resize(duk_hthread *thr, duk_hbuffer_dynamic *buf,
 			DUK_MEMZERO((void *) ((char *) res + prev_size),
 			            (duk_size_t) (new_size - prev_size));
 #endif
+			DUK_HEAP_ALLOC_SAMPLE(thr->heap, DUK_ALLOC_TYPE_BUFFER, (duk_size_t) (new_size - prev_size));
 		}
 
 		DUK_HBUFFER_DYNAMIC_SET_SIZE(buf, new_size);
@@ -46168,6 +48744,12 @@ DUK_INTERNAL void duk_free_hstring(duk_heap *heap, duk_hstring *h) {
 	DUK_UNREF(heap);
 	DUK_UNREF(h);
 
+#if defined(DUK_USE_CONCAT_INPLACE)
+	if (heap->cat_h == h) {
+		heap->cat_h = NULL;
+	}
+#endif
+
 #if defined(DUK_USE_HSTRING_EXTDATA) && defined(DUK_USE_EXTSTR_FREE)
 	if (DUK_HSTRING_HAS_EXTDATA(h)) {
 		DUK_DDD(DUK_DDDPRINT("free extstr: hstring %!O, extdata: %p",
@@ -46488,6 +49070,10 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	duk__free_finalize_list(heap);
 #endif
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+	duk_heap_strcache_free_indexes(heap);
+#endif
+
 	DUK_D(DUK_DPRINT("freeing string table of heap: %p", (void *) heap));
 	duk__free_stringtable(heap);
 
@@ -47101,6 +49687,9 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 	res->st_mask = st_initsize - 1;
 #if (DUK_USE_STRTAB_MINSIZE != DUK_USE_STRTAB_MAXSIZE)
 	DUK_ASSERT(res->st_count == 0);
+	DUK_ASSERT(res->st_grow_count == 0);
+	DUK_ASSERT(res->st_shrink_count == 0);
+	res->st_minsize = st_initsize;
 #endif
 
 #if defined(DUK_USE_STRTAB_PTRCOMP)
@@ -47128,10 +49717,59 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 		duk_small_uint_t i;
 		for (i = 0; i < DUK_HEAP_STRCACHE_SIZE; i++) {
 			res->strcache[i].h = NULL;
+#if defined(DUK_USE_STRCACHE_INDEX)
+			res->strcache[i].index = NULL;
+#endif
 		}
 	}
 #endif
 
+#if defined(DUK_USE_CONCAT_INPLACE) && defined(DUK_USE_EXPLICIT_NULL_INIT)
+	res->cat_h = NULL;
+#endif
+
+	/*
+	 *  Init regexp cache
+	 */
+
+#if defined(DUK_USE_REGEXP_CACHE) && defined(DUK_USE_EXPLICIT_NULL_INIT)
+	{
+		duk_small_uint_t i;
+		for (i = 0; i < DUK_HEAP_REGEXP_CACHE_SIZE; i++) {
+			res->recache[i].pattern = NULL;
+			res->recache[i].flags = NULL;
+			res->recache[i].source = NULL;
+			res->recache[i].bytecode = NULL;
+		}
+	}
+#endif
+
+	/*
+	 *  Init local time offset cache
+	 */
+
+#if defined(DUK_USE_DATE_FAST)
+	{
+		duk_small_uint_t i;
+		for (i = 0; i < DUK_HEAP_DATE_TZO_CACHE_SIZE; i++) {
+			res->date_tzo_cache[i].day = DUK_INT_MIN;
+		}
+	}
+#endif
+
+#if defined(DUK_USE_SAMPLING_PROFILER) && defined(DUK_USE_EXPLICIT_NULL_INIT)
+	res->sample_func = NULL;
+	res->sample_udata = NULL;
+#endif
+#if defined(DUK_USE_CALL_STATS) && defined(DUK_USE_EXPLICIT_NULL_INIT)
+	res->call_stats_func = NULL;
+	res->call_stats_udata = NULL;
+#endif
+#if defined(DUK_USE_ALLOC_PROFILER) && defined(DUK_USE_EXPLICIT_NULL_INIT)
+	res->alloc_sample_func = NULL;
+	res->alloc_sample_udata = NULL;
+#endif
+
 	/* XXX: error handling is incomplete.  It would be cleanest if
 	 * there was a setjmp catchpoint, so that all init code could
 	 * freely throw errors.  If that were the case, the return code
@@ -47744,7 +50382,135 @@ DUK_INTERNAL void duk_heap_run_finalizer(duk_heap *heap, duk_hobject *obj) {
 
 /* #include duk_internal.h -> already included */
 
-#if defined(DUK_USE_STRHASH_DENSE)
+#if defined(DUK_USE_STRHASH_WIDE) && defined(DUK_USE_64BIT_OPS)
+/* Constants for duk_hashstring(), from wyhash (public domain).  Without
+ * 64-bit integer support the variants below are used instead.
+ */
+#define DUK__STRHASH_P0            DUK_U64_CONSTANT(0xa0761d6478bd642f)
+#define DUK__STRHASH_P1            DUK_U64_CONSTANT(0xe7037ed1a0b428db)
+#define DUK__STRHASH_P2            DUK_U64_CONSTANT(0x8ebc6af09c88c6e3)
+
+/* 64x64 -> 128 bit multiply, folded to 64 bits by XORing the halves. */
+DUK_LOCAL DUK_ALWAYS_INLINE duk_uint64_t duk__strhash_mix(duk_uint64_t a, duk_uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = (__uint128_t) a * (__uint128_t) b;
+	return (duk_uint64_t) r ^ (duk_uint64_t) (r >> 64);
+#else
+	duk_uint64_t a_hi = a >> 32, a_lo = a & 0xffffffffUL;
+	duk_uint64_t b_hi = b >> 32, b_lo = b & 0xffffffffUL;
+	duk_uint64_t hh = a_hi * b_hi;
+	duk_uint64_t hl = a_hi * b_lo;
+	duk_uint64_t lh = a_lo * b_hi;
+	duk_uint64_t ll = a_lo * b_lo;
+	duk_uint64_t lo;
+	duk_uint64_t hi;
+	duk_uint64_t t;
+
+	t = ll + (hl << 32);
+	hi = hh + (hl >> 32) + (lh >> 32) + (t < ll ? 1U : 0U);
+	lo = t + (lh << 32);
+	hi += (lo < t ? 1U : 0U);
+	return lo ^ hi;
+#endif
+}
+
+DUK_LOCAL DUK_ALWAYS_INLINE duk_uint64_t duk__strhash_read64(const duk_uint8_t *p) {
+	duk_uint64_t v;
+	DUK_MEMCPY((void *) &v, (const void *) p, sizeof(v));
+	return v;
+}
+
+DUK_LOCAL DUK_ALWAYS_INLINE duk_uint64_t duk__strhash_read32(const duk_uint8_t *p) {
+	duk_uint32_t v;
+	DUK_MEMCPY((void *) &v, (const void *) p, sizeof(v));
+	return (duk_uint64_t) v;
+}
+
+/* Hash str[0,len[ continuing from 'state', which must cover (a prefix of)
+ * the 16-byte blocks of 'str'.  On return 'state' covers all blocks but
+ * the last one, so that it can be resumed if the string is appended to.
+ */
+DUK_LOCAL duk_uint32_t duk__strhash_wide(duk_strhash_state *state, const duk_uint8_t *str, duk_size_t len) {
+	duk_uint64_t seed;
+	duk_uint64_t a;
+	duk_uint64_t b;
+	duk_uint32_t hash;
+
+	/* Multiply-mix hash over the full string (a simplified wyhash):
+	 * 16 bytes are consumed per 64x64 bit multiply, so hashing every
+	 * byte is cheaper than the sampled Bernstein hash is for short
+	 * strings and avoids the collisions sampling causes for long keys
+	 * differing only in skipped bytes.
+	 *
+	 * Multibyte reads are done in native byte order; hashes are never
+	 * persisted so this is fine, but DUK_USE_ROM_STRINGS (precomputed
+	 * hashes) cannot be used with this variant.
+	 */
+
+	DUK_ASSERT(state->off <= len);
+	DUK_ASSERT((state->off & 0x0fU) == 0);
+	seed = state->seed;
+
+	if (len <= 16) {
+		if (len >= 4) {
+			duk_size_t mid = (len >> 3) << 2;
+			a = (duk__strhash_read32(str) << 32) | duk__strhash_read32(str + mid);
+			b = (duk__strhash_read32(str + len - 4) << 32) | duk__strhash_read32(str + len - 4 - mid);
+		} else if (len > 0) {
+			a = ((duk_uint64_t) str[0] << 16) | ((duk_uint64_t) str[len >> 1] << 8) | (duk_uint64_t) str[len - 1];
+			b = 0;
+		} else {
+			a = 0;
+			b = 0;
+		}
+	} else {
+		duk_size_t off = state->off;
+
+		while (len - off > 16) {
+			seed = duk__strhash_mix(duk__strhash_read64(str + off) ^ DUK__STRHASH_P1,
+			                        duk__strhash_read64(str + off + 8) ^ seed);
+			off += 16;
+		}
+		state->seed = seed;
+		state->off = off;
+
+		/* Last 16 bytes, possibly overlapping already hashed ones. */
+		a = duk__strhash_read64(str + len - 16);
+		b = duk__strhash_read64(str + len - 8);
+	}
+
+	a = duk__strhash_mix(a ^ DUK__STRHASH_P1, b ^ seed);
+	a = duk__strhash_mix(a ^ DUK__STRHASH_P2 ^ (duk_uint64_t) len, DUK__STRHASH_P1);
+	hash = (duk_uint32_t) (a ^ (a >> 32));
+
+#if defined(DUK_USE_STRHASH16)
+	/* Truncate to 16 bits here, so that a computed hash can be compared
+	 * against a hash stored in a 16-bit field.
+	 */
+	hash &= 0x0000ffffUL;
+#endif
+	return hash;
+}
+
+DUK_INTERNAL void duk_heap_hashstring_init(duk_heap *heap, duk_strhash_state *state) {
+	state->seed = duk__strhash_mix((duk_uint64_t) heap->hash_seed ^ DUK__STRHASH_P0, DUK__STRHASH_P1);
+	state->off = 0;
+}
+
+#if defined(DUK_USE_CONCAT_INPLACE)
+DUK_INTERNAL duk_uint32_t duk_heap_hashstring_resume(duk_heap *heap, duk_strhash_state *state, const duk_uint8_t *str, duk_size_t len) {
+	DUK_UNREF(heap);
+	return duk__strhash_wide(state, str, len);
+}
+#endif
+
+DUK_INTERNAL duk_uint32_t duk_heap_hashstring(duk_heap *heap, const duk_uint8_t *str, duk_size_t len) {
+	duk_strhash_state state;
+
+	duk_heap_hashstring_init(heap, &state);
+	return duk__strhash_wide(&state, str, len);
+}
+#elif defined(DUK_USE_STRHASH_DENSE)
 /* Constants for duk_hashstring(). */
 #define DUK__STRHASH_SHORTSTRING   4096L
 #define DUK__STRHASH_MEDIUMSTRING  (256L * 1024L)
@@ -47838,11 +50604,29 @@ DUK_INTERNAL duk_uint32_t duk_heap_hashstring(duk_heap *heap, const duk_uint8_t
 #endif
 	return hash;
 }
-#endif  /* DUK_USE_STRHASH_DENSE */
+#endif  /* DUK_USE_STRHASH_WIDE && DUK_USE_64BIT_OPS, DUK_USE_STRHASH_DENSE */
+
+#if defined(DUK_USE_CONCAT_INPLACE) && !(defined(DUK_USE_STRHASH_WIDE) && defined(DUK_USE_64BIT_OPS))
+/* The sampling hashes only look at a bounded part of the string, so there's
+ * no state worth keeping when a string is appended to.
+ */
+DUK_INTERNAL void duk_heap_hashstring_init(duk_heap *heap, duk_strhash_state *state) {
+	DUK_UNREF(heap);
+	state->off = 0;
+}
+
+DUK_INTERNAL duk_uint32_t duk_heap_hashstring_resume(duk_heap *heap, duk_strhash_state *state, const duk_uint8_t *str, duk_size_t len) {
+	DUK_UNREF(state);
+	return duk_heap_hashstring(heap, str, len);
+}
+#endif
 
 /* automatic undefs */
 #undef DUK__STRHASH_BLOCKSIZE
 #undef DUK__STRHASH_MEDIUMSTRING
+#undef DUK__STRHASH_P0
+#undef DUK__STRHASH_P1
+#undef DUK__STRHASH_P2
 #undef DUK__STRHASH_SHORTSTRING
 #line 1 "duk_heap_markandsweep.c"
 /*
@@ -48134,6 +50918,18 @@ DUK_LOCAL void duk__mark_roots_heap(duk_heap *heap) {
 		duk__mark_heaphdr(heap, (duk_heaphdr *) heap->dbg_breakpoints[i].filename);
 	}
 #endif
+
+#if defined(DUK_USE_REGEXP_CACHE)
+	for (i = 0; i < DUK_HEAP_REGEXP_CACHE_SIZE; i++) {
+		duk_regexp_cache *c = heap->recache + i;
+		if (c->pattern != NULL) {
+			duk__mark_heaphdr(heap, (duk_heaphdr *) c->pattern);
+			duk__mark_heaphdr(heap, (duk_heaphdr *) c->flags);
+			duk__mark_heaphdr(heap, (duk_heaphdr *) c->source);
+			duk__mark_heaphdr(heap, (duk_heaphdr *) c->bytecode);
+		}
+	}
+#endif
 }
 
 /*
@@ -49584,6 +52380,43 @@ DUK_INTERNAL void duk_heap_mem_free(duk_heap *heap, void *ptr) {
 	 */
 }
 
+/*
+ *  Allocation sampling
+ */
+
+#if defined(DUK_USE_ALLOC_PROFILER)
+/* Count 'size' newly allocated bytes of 'type' towards the sampling
+ * interval, and report the allocation with the current call stack when
+ * the interval runs out.  An allocation is thus sampled with a probability
+ * proportional to its size, and always if it's at least 'interval' bytes.
+ */
+DUK_INTERNAL void duk_heap_alloc_sample(duk_heap *heap, duk_small_uint_t type, duk_size_t size) {
+	duk_sample_frame frames[DUK_HEAP_SAMPLE_MAX_FRAMES];
+	duk_size_t num_frames;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(heap->alloc_sample_func != NULL);
+
+	/* Mark-and-sweep only reallocates property tables when compacting,
+	 * and objects may be mid-reallocation: don't walk the call stack.
+	 */
+	if (heap->ms_running) {
+		return;
+	}
+	if (size < heap->alloc_sample_left) {
+		heap->alloc_sample_left -= size;
+		return;
+	}
+	heap->alloc_sample_left = heap->alloc_sample_interval;
+
+	num_frames = 0;
+	if (heap->curr_thread != NULL) {
+		num_frames = duk_hthread_get_sample_frames(heap->curr_thread, frames, heap->alloc_sample_max_frames);
+	}
+	heap->alloc_sample_func(heap->alloc_sample_udata, (duk_uint_t) type, size, frames, num_frames);
+}
+#endif  /* DUK_USE_ALLOC_PROFILER */
+
 /* automatic undefs */
 #undef DUK__VOLUNTARY_PERIODIC_GC
 #line 1 "duk_heap_misc.c"
@@ -50639,6 +53472,12 @@ DUK_INTERNAL void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h
 			DUK_DD(DUK_DDPRINT("deleting weak strcache reference to hstring %p from heap %p",
 			                   (void *) h, (void *) heap));
 			c->h = NULL;
+#if defined(DUK_USE_STRCACHE_INDEX)
+			if (c->index != NULL) {
+				DUK_FREE_RAW(heap, (void *) c->index);
+				c->index = NULL;
+			}
+#endif
 
 			/* XXX: the string shouldn't appear twice, but we now loop to the
 			 * end anyway; if fixed, add a looping assertion to ensure there
@@ -50648,6 +53487,37 @@ DUK_INTERNAL void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h
 	}
 }
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+/* Called when 'h' is appended to in place.  Cached offsets into the
+ * unchanged prefix stay valid, but an offset index doesn't cover the new
+ * chars, so it is dropped and rebuilt on demand.
+ */
+DUK_INTERNAL void duk_heap_strcache_string_grown(duk_heap *heap, duk_hstring *h) {
+	duk_small_int_t i;
+	for (i = 0; i < DUK_HEAP_STRCACHE_SIZE; i++) {
+		duk_strcache *c = heap->strcache + i;
+		if (c->h == h && c->index != NULL) {
+			DUK_FREE_RAW(heap, (void *) c->index);
+			c->index = NULL;
+		}
+	}
+}
+
+/* Free all offset indexes on heap destruction; strings are freed without
+ * going through duk_heap_strcache_string_remove() then.
+ */
+DUK_INTERNAL void duk_heap_strcache_free_indexes(duk_heap *heap) {
+	duk_small_int_t i;
+	for (i = 0; i < DUK_HEAP_STRCACHE_SIZE; i++) {
+		duk_strcache *c = heap->strcache + i;
+		if (c->index != NULL) {
+			DUK_FREE_RAW(heap, (void *) c->index);
+			c->index = NULL;
+		}
+	}
+}
+#endif  /* DUK_USE_STRCACHE_INDEX */
+
 /*
  *  String scanning helpers
  *
@@ -50688,6 +53558,52 @@ DUK_LOCAL const duk_uint8_t *duk__scan_backwards(const duk_uint8_t *p, const duk
 	return p;
 }
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+/* Build a sparse offset index for 'h': entry i is the byte offset of char
+ * i * DUK_HEAP_STRCACHE_INDEX_STRIDE, the last entry may be the end of the
+ * string.  Uses a raw allocation so that no GC (and no finalizer touching
+ * the string cache) can run; returns NULL if allocation fails or the data
+ * is inconsistent with 'char_length', in which case the caller just scans.
+ */
+DUK_LOCAL duk_uint32_t *duk__strcache_build_index(duk_heap *heap, duk_hstring *h, duk_uint_fast32_t char_length) {
+	duk_uint32_t *index;
+	duk_uint_fast32_t n;
+	duk_uint_fast32_t cidx;
+	const duk_uint8_t *p_start;
+	const duk_uint8_t *p_end;
+	const duk_uint8_t *p;
+
+	n = char_length / DUK_HEAP_STRCACHE_INDEX_STRIDE + 1;
+	index = (duk_uint32_t *) DUK_ALLOC_RAW(heap, sizeof(duk_uint32_t) * n);
+	if (DUK_UNLIKELY(index == NULL)) {
+		return NULL;
+	}
+
+	p_start = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h);
+	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h);
+	index[n - 1] = (duk_uint32_t) (p_end - p_start);  /* char_length itself, if on a stride boundary */
+	cidx = 0;
+	for (p = p_start; p < p_end; p++) {
+		if ((*p & 0xc0) == 0x80) {
+			continue;
+		}
+		if ((cidx % DUK_HEAP_STRCACHE_INDEX_STRIDE) == 0) {
+			if (DUK_UNLIKELY(cidx >= char_length)) {
+				DUK_FREE_RAW(heap, (void *) index);
+				return NULL;
+			}
+			index[cidx / DUK_HEAP_STRCACHE_INDEX_STRIDE] = (duk_uint32_t) (p - p_start);
+		}
+		cidx++;
+	}
+	if (DUK_UNLIKELY(cidx != char_length)) {
+		DUK_FREE_RAW(heap, (void *) index);
+		return NULL;
+	}
+	return index;
+}
+#endif  /* DUK_USE_STRCACHE_INDEX */
+
 /*
  *  Convert char offset to byte offset
  *
@@ -50791,6 +53707,25 @@ DUK_INTERNAL duk_uint_fast32_t duk_heap_strcache_offset_char2byte(duk_hthread *t
 	p_end = (const duk_uint8_t *) (p_start + DUK_HSTRING_GET_BYTELEN(h));
 	p_found = NULL;
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+	/* A cached long string accessed far from the cached offset (i.e.
+	 * not sequentially) gets an index, making every later lookup a scan
+	 * of at most STRIDE - 1 chars.
+	 */
+	if (sce && char_length >= DUK_HEAP_STRCACHE_INDEX_LIMIT && char_offset < char_length &&
+	    (char_offset >= sce->cidx ? char_offset - sce->cidx : sce->cidx - char_offset) > DUK_HEAP_STRCACHE_INDEX_STRIDE) {
+		if (sce->index == NULL) {
+			sce->index = duk__strcache_build_index(heap, h, char_length);
+		}
+		if (sce->index != NULL) {
+			p_found = duk__scan_forwards(p_start + sce->index[char_offset / DUK_HEAP_STRCACHE_INDEX_STRIDE],
+			                             p_end,
+			                             char_offset % DUK_HEAP_STRCACHE_INDEX_STRIDE);
+			goto scan_done;
+		}
+	}
+#endif
+
 	if (sce) {
 		if (char_offset >= sce->cidx) {
 			dist_sce = char_offset - sce->cidx;
@@ -50882,6 +53817,12 @@ DUK_INTERNAL duk_uint_fast32_t duk_heap_strcache_offset_char2byte(duk_hthread *t
 		if (!sce) {
 			sce = heap->strcache + DUK_HEAP_STRCACHE_SIZE - 1;  /* take last entry */
 			sce->h = h;
+#if defined(DUK_USE_STRCACHE_INDEX)
+			if (sce->index != NULL) {
+				DUK_FREE_RAW(heap, (void *) sce->index);
+				sce->index = NULL;
+			}
+#endif
 		}
 		DUK_ASSERT(sce != NULL);
 		sce->bidx = (duk_uint32_t) (p_found - p_start);
@@ -51090,6 +54031,7 @@ DUK_LOCAL duk_hstring *duk__strtable_alloc_hstring(duk_heap *heap,
 		if (DUK_UNLIKELY(res == NULL)) {
 			goto alloc_error;
 		}
+		DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_STRING, sizeof(duk_hstring_external));
 		DUK_MEMZERO(res, sizeof(duk_hstring_external));
 #if defined(DUK_USE_EXPLICIT_NULL_INIT)
 		DUK_HEAPHDR_STRING_INIT_NULLS(&res->hdr);
@@ -51110,6 +54052,7 @@ DUK_LOCAL duk_hstring *duk__strtable_alloc_hstring(duk_heap *heap,
 		if (DUK_UNLIKELY(res == NULL)) {
 			goto alloc_error;
 		}
+		DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_STRING, sizeof(duk_hstring) + blen + 1);
 		DUK_MEMZERO(res, sizeof(duk_hstring));
 #if defined(DUK_USE_EXPLICIT_NULL_INIT)
 		DUK_HEAPHDR_STRING_INIT_NULLS(&res->hdr);
@@ -51291,6 +54234,7 @@ DUK_LOCAL void duk__strtable_grow_inplace(duk_heap *heap) {
 
 	heap->st_size = new_st_size;
 	heap->st_mask = new_st_size - 1;
+	heap->st_grow_count++;
 
 #if defined(DUK_USE_ASSERTIONS)
 	duk__strtable_assert_checks(heap);
@@ -51357,6 +54301,7 @@ DUK_LOCAL void duk__strtable_shrink_inplace(duk_heap *heap) {
 
 	heap->st_size = new_st_size;
 	heap->st_mask = new_st_size - 1;
+	heap->st_shrink_count++;
 
 	/* The strtable is now consistent and we can realloc safely.  Even
 	 * if side effects cause string interning or removal the strtable
@@ -51429,7 +54374,7 @@ DUK_LOCAL DUK_COLD DUK_NOINLINE void duk__strtable_resize_check(duk_heap *heap)
 			duk__strtable_grow_inplace(heap);
 		}
 	} else if (load_factor <= DUK_USE_STRTAB_SHRINK_LIMIT) {
-		if (heap->st_size <= DUK_USE_STRTAB_MINSIZE) {
+		if (heap->st_size <= heap->st_minsize) {
 			DUK_DD(DUK_DDPRINT("want to shrink strtable (based on load factor) but already minimum size"));
 		} else {
 			DUK_D(DUK_DPRINT("shrink string table: %lu -> %lu", (unsigned long) heap->st_size, (unsigned long) heap->st_size / 2));
@@ -51861,6 +54806,239 @@ DUK_INTERNAL void duk_heap_strtable_force_resize(duk_heap *heap) {
 #endif
 }
 
+/*
+ *  In-place append for 's += x'.
+ *
+ *  Strings are immutable and interned, so normally every concatenation
+ *  step copies the whole result into a new string, which makes building
+ *  output piece by piece quadratic.  When the executor knows the left hand
+ *  side string is only referenced by the target register, it's instead
+ *  grown in place: the allocation gets slack for later appends and the
+ *  string is rehashed and moved to its new string table chain.  Only the
+ *  appended bytes are copied and, with a resumable hash, hashed.
+ *
+ *  The string stays a regular interned string at all times, so nothing else
+ *  needs to know about this.  The only extra state is a weak reference to
+ *  the current target in the heap, which knows its capacity.
+ */
+
+#if defined(DUK_USE_CONCAT_INPLACE)
+DUK_LOCAL void duk__strtable_relink(duk_heap *heap, duk_hstring *h) {
+	duk_hstring **slot;
+
+	slot = heap->strtable + (DUK_HSTRING_GET_HASH(h) & heap->st_mask);
+	h->hdr.h_next = *slot;
+	*slot = h;
+#if defined(DUK__STRTAB_RESIZE_CHECK)
+	heap->st_count++;
+#endif
+}
+
+/* Make room for appending 'add_blen' bytes to 'h'.  Returns 'h', possibly
+ * reallocated (the caller must update its reference), or NULL if there's no
+ * memory; 'h' is then unchanged.  Causes no side effects.
+ */
+DUK_INTERNAL duk_hstring *duk_heap_strtable_reserve_append(duk_heap *heap, duk_hstring *h, duk_size_t add_blen) {
+	duk_size_t old_blen;
+	duk_size_t new_blen;
+	duk_size_t new_cap;
+	duk_bool_t is_target;
+	duk_hstring *res;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(!DUK_HSTRING_HAS_EXTDATA(h));
+	DUK_ASSERT(add_blen > 0);
+
+	old_blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h);
+	new_blen = old_blen + add_blen;
+	DUK_ASSERT(new_blen > old_blen && new_blen <= (duk_size_t) DUK_HSTRING_MAX_BYTELEN);  /* Caller checks. */
+
+	is_target = (heap->cat_h == h);
+	if (is_target && new_blen <= heap->cat_cap) {
+		return h;
+	}
+
+	new_cap = new_blen + new_blen / 2;
+	if (new_cap < new_blen || new_cap > (duk_size_t) DUK_HSTRING_MAX_BYTELEN) {
+		new_cap = (duk_size_t) DUK_HSTRING_MAX_BYTELEN;
+	}
+
+	/* The string moves, so it must be unlinked while reallocating.  A raw
+	 * realloc never triggers a GC, which would find the string missing
+	 * from the string table.
+	 */
+	duk_heap_strtable_unlink(heap, h);
+	duk_heap_strcache_string_remove(heap, h);
+	res = (duk_hstring *) DUK_REALLOC_RAW(heap, (void *) h, sizeof(duk_hstring) + new_cap + 1);
+	if (DUK_UNLIKELY(res == NULL)) {
+		duk__strtable_relink(heap, h);
+		return NULL;
+	}
+	duk__strtable_relink(heap, res);
+	DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_STRING, new_cap - (is_target ? heap->cat_cap : old_blen));
+
+	if (!is_target) {
+		duk_heap_hashstring_init(heap, &heap->cat_hash);
+	}
+	heap->cat_h = res;
+	heap->cat_cap = new_cap;
+	return res;
+}
+
+/* Append str[0,blen[ to 'h' which must have room for it.  If the result
+ * is already interned, returns the existing string and leaves 'h' as is;
+ * otherwise updates and returns 'h'.  Causes no side effects.
+ */
+DUK_INTERNAL duk_hstring *duk_heap_strtable_append(duk_heap *heap, duk_hstring *h, const duk_uint8_t *str, duk_size_t blen) {
+	duk_uint8_t *data;
+	duk_size_t old_blen;
+	duk_size_t new_blen;
+	duk_size_t clen;
+	duk_uint32_t strhash;
+	duk_strhash_state hash_state;
+	duk_hstring *other;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(h != NULL && h == heap->cat_h);
+	DUK_ASSERT(str != NULL && blen > 0);
+
+	old_blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h);
+	new_blen = old_blen + blen;
+	DUK_ASSERT(new_blen <= heap->cat_cap);
+	DUK_ASSERT(old_blen >= DUK_HEAP_CONCAT_INPLACE_MIN_BLEN);  /* Can't become an array index. */
+
+	data = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h);
+	DUK_MEMCPY((void *) (data + old_blen), (const void *) str, blen);
+
+	/* Commit the resumed hash state only if 'h' is actually updated. */
+	hash_state = heap->cat_hash;
+	strhash = duk_heap_hashstring_resume(heap, &hash_state, data, new_blen);
+
+	other = heap->strtable[strhash & heap->st_mask];
+	while (other != NULL) {
+		if (DUK_HSTRING_GET_HASH(other) == strhash &&
+		    DUK_HSTRING_GET_BYTELEN(other) == new_blen &&
+		    DUK_MEMCMP((const void *) data, (const void *) DUK_HSTRING_GET_DATA(other), new_blen) == 0) {
+			data[old_blen] = (duk_uint8_t) 0;
+			return other;
+		}
+		other = other->hdr.h_next;
+	}
+
+	/* Charlen is additive; the lazy charlen of 'h' is computed at most
+	 * once per append target.
+	 */
+	clen = duk_hstring_get_charlen(h) + duk_unicode_unvalidated_utf8_length(str, blen);
+
+	duk_heap_strtable_unlink(heap, h);
+#if defined(DUK_USE_STRCACHE_INDEX)
+	duk_heap_strcache_string_grown(heap, h);
+#endif
+	data[new_blen] = (duk_uint8_t) 0;
+	DUK_HSTRING_SET_BYTELEN(h, new_blen);
+	DUK_HSTRING_SET_HASH(h, strhash);
+	h->clen = (duk_uint32_t) clen;
+	if (clen == new_blen) {
+		DUK_HSTRING_SET_ASCII(h);
+	} else {
+		DUK_HSTRING_CLEAR_ASCII(h);
+	}
+	duk__strtable_relink(heap, h);
+
+	heap->cat_hash = hash_state;
+	return h;
+}
+#endif  /* DUK_USE_CONCAT_INPLACE */
+
+/*
+ *  Application control of the minimum size, and statistics.
+ */
+
+DUK_INTERNAL void duk_heap_strtable_set_min_size(duk_heap *heap, duk_uint32_t min_size) {
+	DUK_ASSERT(heap != NULL);
+	DUK_UNREF(heap);
+	DUK_UNREF(min_size);
+
+#if defined(DUK__STRTAB_RESIZE_CHECK)
+	{
+		duk_uint32_t new_minsize;
+		duk_uint32_t old_st_size;
+
+		/* Round up to 2^N within the configured limits. */
+		new_minsize = DUK_USE_STRTAB_MINSIZE;
+		while (new_minsize < min_size && new_minsize < DUK_USE_STRTAB_MAXSIZE) {
+			new_minsize <<= 1U;
+		}
+		heap->st_minsize = new_minsize;
+
+		/* Grow right away so that the first interning burst doesn't go
+		 * through one resize per doubling.  A shrink back to the new
+		 * floor happens through the normal resize checks.
+		 */
+		if (DUK__GET_STRTABLE(heap) == NULL || heap->st_resizing != 0U) {
+			return;
+		}
+		heap->pf_prevent_count++;
+		heap->st_resizing = 1;
+		while (heap->st_size < new_minsize) {
+			old_st_size = heap->st_size;
+			duk__strtable_grow_inplace(heap);
+			if (heap->st_size == old_st_size) {
+				/* Out of memory, keep the current size. */
+				break;
+			}
+		}
+		heap->st_resizing = 0;
+		DUK_ASSERT(heap->pf_prevent_count > 0);
+		heap->pf_prevent_count--;
+	}
+#endif
+}
+
+DUK_INTERNAL void duk_heap_strtable_get_stats(duk_heap *heap, duk_strtab_stats *out_stats) {
+#if defined(DUK_USE_STRTAB_PTRCOMP)
+	duk_uint16_t *strtable;
+#else
+	duk_hstring **strtable;
+#endif
+	duk_uint32_t i;
+	duk_uint32_t chain;
+	duk_hstring *h;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(out_stats != NULL);
+
+	DUK_MEMZERO((void *) out_stats, sizeof(*out_stats));
+	out_stats->size = heap->st_size;
+#if defined(DUK__STRTAB_RESIZE_CHECK)
+	out_stats->min_size = heap->st_minsize;
+	out_stats->grow_count = heap->st_grow_count;
+	out_stats->shrink_count = heap->st_shrink_count;
+#else
+	out_stats->min_size = DUK_USE_STRTAB_MINSIZE;
+#endif
+
+	strtable = DUK__GET_STRTABLE(heap);
+	for (i = 0; i < heap->st_size; i++) {
+		h = DUK__HEAPPTR_DEC16(heap, strtable[i]);
+		chain = 0;
+		while (h != NULL) {
+			chain++;
+			h = h->hdr.h_next;
+		}
+		if (chain > 0) {
+			out_stats->used_buckets++;
+			out_stats->count += chain;
+			/* Number of string comparisons to find every string once. */
+			out_stats->probe_total += (duk_double_t) chain * (duk_double_t) (chain + 1) / 2.0;
+		}
+		if (chain > out_stats->max_chain) {
+			out_stats->max_chain = chain;
+		}
+	}
+}
+
 /*
  *  Free strings in the string table and the string table itself.
  */
@@ -51964,6 +55142,7 @@ DUK_LOCAL void *duk__hobject_alloc_init(duk_hthread *thr, duk_uint_t hobject_fla
 	res = (void *) DUK_ALLOC_CHECKED_ZEROED(thr, size);
 	DUK_ASSERT(res != NULL);
 	duk__init_object_parts(thr->heap, hobject_flags, (duk_hobject *) res);
+	DUK_HEAP_ALLOC_SAMPLE(thr->heap, DUK_ALLOC_TYPE_OBJECT, size);
 	return res;
 }
 
@@ -51995,6 +55174,7 @@ DUK_INTERNAL duk_hobject *duk_hobject_alloc_unchecked(duk_heap *heap, duk_uint_t
 	DUK_ASSERT(!DUK_HOBJECT_IS_THREAD(res));
 
 	duk__init_object_parts(heap, hobject_flags, res);
+	DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_OBJECT, sizeof(duk_hobject));
 
 	DUK_ASSERT(!DUK_HOBJECT_IS_THREAD(res));
 	return res;
@@ -52055,6 +55235,7 @@ DUK_INTERNAL duk_hboundfunc *duk_hboundfunc_alloc(duk_heap *heap, duk_uint_t hob
 	res->args = NULL;
 #endif
 
+	DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_OBJECT, sizeof(duk_hboundfunc));
 	return res;
 }
 
@@ -52119,6 +55300,7 @@ DUK_INTERNAL duk_hthread *duk_hthread_alloc_unchecked(duk_heap *heap, duk_uint_t
 	res->heap = heap;
 
 	/* XXX: Any reason not to merge duk_hthread_alloc.c here? */
+	DUK_HEAP_ALLOC_SAMPLE(heap, DUK_ALLOC_TYPE_OBJECT, sizeof(duk_hthread));
 	return res;
 }
 
@@ -52429,7 +55611,7 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_hthread *thr, duk_small_uint
 	 */
 	DUK_DDD(DUK_DDDPRINT("proxy enumeration"));
 	duk_push_hobject(thr, h_proxy_handler);
-	if (!duk_get_prop_stridx_short(thr, -1, DUK_STRIDX_OWN_KEYS)) {
+	if (!duk_hobject_proxy_get_trap(thr, enum_target, DUK_STRIDX_OWN_KEYS)) {
 		/* No need to replace the 'enum_target' value in stack, only the
 		 * enum_target reference.  This also ensures that the original
 		 * enum target is reachable, which keeps the proxy and the proxy
@@ -52449,11 +55631,11 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_hthread *thr, duk_small_uint
 	/* [ ... enum_target res handler trap ] */
 	duk_insert(thr, -2);
 	duk_push_hobject(thr, h_proxy_target);    /* -> [ ... enum_target res trap handler target ] */
-	duk_call_method(thr, 1 /*nargs*/);        /* -> [ ... enum_target res trap_result ] */
+	duk_hobject_proxy_call_trap(thr, 1 /*nargs*/);  /* -> [ ... enum_target res trap_result ] */
 	h_trap_result = duk_require_hobject(thr, -1);
 	DUK_UNREF(h_trap_result);
 
-	duk_proxy_ownkeys_postprocess(thr, h_proxy_target, enum_flags);
+	duk_proxy_ownkeys_postprocess(thr, enum_target, h_proxy_target, enum_flags);
 	/* -> [ ... enum_target res trap_result keys_array ] */
 
 	/* Copy cleaned up trap result keys into the enumerator object. */
@@ -53593,7 +56775,121 @@ DUK_INTERNAL duk_hobject *duk_hobject_resolve_proxy_target(duk_hobject *obj) {
 }
 #endif  /* DUK_USE_ES6_PROXY */
 
+/* Trap lookup and call for native Proxy handlers.  Lookup expects
+ * [ ... handler ] and leaves [ ... handler trap ] like a property read, so
+ * that after the usual duk_insert() the stack is [ ... trap handler ].  For
+ * a native trap the handler slot is replaced with the Proxy and the trap
+ * slot holds the DUK_PROXY_TRAP_xxx number; duk_hobject_proxy_call_trap()
+ * recognizes that and calls the native function with the trap arguments on
+ * the stack top.
+ */
+#if defined(DUK_USE_PROXY_NATIVE)
+DUK_LOCAL duk_uint_t duk__proxy_native_trap(duk_small_uint_t stridx_trap) {
+	switch (stridx_trap) {
+	case DUK_STRIDX_GET:
+		return DUK_PROXY_TRAP_GET;
+	case DUK_STRIDX_SET:
+		return DUK_PROXY_TRAP_SET;
+	case DUK_STRIDX_HAS:
+		return DUK_PROXY_TRAP_HAS;
+	case DUK_STRIDX_DELETE_PROPERTY:
+		return DUK_PROXY_TRAP_DELETE_PROPERTY;
+	case DUK_STRIDX_OWN_KEYS:
+		return DUK_PROXY_TRAP_OWN_KEYS;
+	default:
+		return 0;
+	}
+}
+
+DUK_INTERNAL duk_bool_t duk_hobject_proxy_get_trap(duk_hthread *thr, duk_hobject *obj, duk_small_uint_t stridx_trap) {
+	duk_hproxy *h_proxy;
+	duk_uint_t trap;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(DUK_HOBJECT_IS_PROXY(obj));
+
+	h_proxy = (duk_hproxy *) obj;
+	trap = duk__proxy_native_trap(stridx_trap);
+	if (DUK_LIKELY((h_proxy->native_traps & trap) != 0)) {
+		DUK_ASSERT(h_proxy->native_func != NULL);
+		duk_push_hobject(thr, obj);
+		duk_replace(thr, -2);
+		duk_push_uint(thr, (duk_uint_t) trap);
+		return 1;
+	}
+	return duk_get_prop_stridx_short(thr, -1, stridx_trap);
+}
+
+DUK_INTERNAL void duk_hobject_proxy_call_trap(duk_hthread *thr, duk_idx_t nargs) {
+	duk_tval *tv_trap;
+	duk_hproxy *h_proxy;
+	duk_idx_t idx_base;
+	duk_uint_t trap;
+	duk_ret_t rc;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(nargs >= 0);
+
+	/* A handler is never a Proxy, so a Proxy in the 'this' slot means
+	 * a native trap (a bogus non-callable trap value from an ordinary
+	 * handler falls through to the call and fails there).
+	 */
+	idx_base = duk_get_top(thr) - nargs - 2;
+	DUK_ASSERT(idx_base >= 0);
+	tv_trap = DUK_GET_TVAL_POSIDX(thr, idx_base);
+	h_proxy = (duk_hproxy *) duk_get_hobject(thr, idx_base + 1);
+	if (!DUK_TVAL_IS_NUMBER(tv_trap) || h_proxy == NULL || !DUK_HOBJECT_IS_PROXY((duk_hobject *) h_proxy)) {
+		duk_call_method(thr, nargs);
+		return;
+	}
+	trap = (duk_uint_t) DUK_TVAL_GET_NUMBER(tv_trap);
+	DUK_ASSERT((h_proxy->native_traps & trap) != 0);
+	DUK_ASSERT(h_proxy->native_func != NULL);
+
+	/* Same guarantees as for a native function call: value stack
+	 * reserve and a C recursion limit.  The value stack frame is not
+	 * changed, so the trap must use negative indices.  The Proxy (and
+	 * thus its handler and 'udata') stays reachable from the stack.
+	 */
+	duk_require_stack(thr, DUK_API_ENTRY_STACK);
+	if (DUK_UNLIKELY(thr->heap->call_recursion_depth >= thr->heap->call_recursion_limit)) {
+		DUK_ERROR_RANGE(thr, DUK_STR_C_CALLSTACK_LIMIT);
+	}
+	thr->heap->call_recursion_depth++;
+	rc = h_proxy->native_func(thr, trap, h_proxy->native_udata);
+	thr->heap->call_recursion_depth--;
+
+	if (rc < 0) {
+		(void) duk_throw(thr);
+	}
+	if (rc > 1 || duk_get_top(thr) < idx_base + 2 + nargs + rc) {
+		DUK_ERROR_TYPE(thr, DUK_STR_INVALID_CFUNC_RC);
+	}
+	if (rc == 0) {
+		duk_push_undefined(thr);
+	}
+	duk_replace(thr, idx_base);
+	duk_set_top(thr, idx_base + 1);
+}
+#endif  /* DUK_USE_PROXY_NATIVE */
+
 #if defined(DUK_USE_ES6_PROXY)
+#if defined(DUK_USE_PROXY_NATIVE)
+/* Proxy invariant checks look up the key on the target after the trap, which
+ * coerces (and interns) number keys.  A target without own or virtual
+ * properties can't have a conflicting property, so the lookup is skipped for
+ * it; such empty targets are the norm for natively backed proxies.
+ */
+DUK_LOCAL duk_bool_t duk__proxy_target_may_have_props(duk_hobject *h_target) {
+	return DUK_HOBJECT_HAS_EXOTIC_BEHAVIOR(h_target) ||
+	       DUK_HOBJECT_GET_ENEXT(h_target) != 0 ||
+	       DUK_HOBJECT_GET_ASIZE(h_target) != 0;
+}
+#else
+#define duk__proxy_target_may_have_props(h_target) 1
+#endif
+
 DUK_LOCAL duk_bool_t duk__proxy_check_prop(duk_hthread *thr, duk_hobject *obj, duk_small_uint_t stridx_trap, duk_tval *tv_key, duk_hobject **out_target) {
 	duk_hobject *h_handler;
 
@@ -53646,7 +56942,7 @@ DUK_LOCAL duk_bool_t duk__proxy_check_prop(duk_hthread *thr, duk_hobject *obj, d
 
 	duk_require_stack(thr, DUK__VALSTACK_PROXY_LOOKUP);
 	duk_push_hobject(thr, h_handler);
-	if (duk_get_prop_stridx_short(thr, -1, stridx_trap)) {
+	if (duk_hobject_proxy_get_trap(thr, obj, stridx_trap)) {
 		/* -> [ ... handler trap ] */
 		duk_insert(thr, -2);  /* -> [ ... trap handler ] */
 
@@ -53835,6 +57131,7 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 			 */
 			goto alloc_failed;
 		}
+		DUK_HEAP_ALLOC_SAMPLE(thr->heap, DUK_ALLOC_TYPE_PROPERTIES, new_alloc_size);
 	}
 
 	/* Set up pointers to the new property area: this is hidden behind a macro
@@ -55695,11 +58992,14 @@ DUK_INTERNAL duk_bool_t duk_hobject_getprop(duk_hthread *thr, duk_tval *tv_obj,
 				duk_push_hobject(thr, h_target);  /* target */
 				duk_push_tval(thr, tv_key);       /* P */
 				duk_push_tval(thr, tv_obj);       /* Receiver: Proxy object */
-				duk_call_method(thr, 3 /*nargs*/);
+				duk_hobject_proxy_call_trap(thr, 3 /*nargs*/);
 
 				/* Target object must be checked for a conflicting
 				 * non-configurable property.
 				 */
+				if (!duk__proxy_target_may_have_props(h_target)) {
+					return 1;  /* return value */
+				}
 				arr_idx = duk__push_tval_to_property_key(thr, tv_key, &key);
 				DUK_ASSERT(key != NULL);
 
@@ -56088,7 +59388,7 @@ DUK_INTERNAL duk_bool_t duk_hobject_hasprop(duk_hthread *thr, duk_tval *tv_obj,
 			DUK_DDD(DUK_DDDPRINT("-> proxy object 'has' for key %!T", (duk_tval *) tv_key));
 			duk_push_hobject(thr, h_target);  /* target */
 			duk_push_tval(thr, tv_key);       /* P */
-			duk_call_method(thr, 2 /*nargs*/);
+			duk_hobject_proxy_call_trap(thr, 2 /*nargs*/);
 			tmp_bool = duk_to_boolean(thr, -1);
 			if (!tmp_bool) {
 				/* Target object must be checked for a conflicting
@@ -56674,7 +59974,7 @@ DUK_INTERNAL duk_bool_t duk_hobject_putprop(duk_hthread *thr, duk_tval *tv_obj,
 				duk_push_tval(thr, tv_key);       /* P */
 				duk_push_tval(thr, tv_val);       /* V */
 				duk_push_tval(thr, tv_obj);       /* Receiver: Proxy object */
-				duk_call_method(thr, 4 /*nargs*/);
+				duk_hobject_proxy_call_trap(thr, 4 /*nargs*/);
 				tmp_bool = duk_to_boolean(thr, -1);
 				duk_pop_nodecref_unsafe(thr);
 				if (!tmp_bool) {
@@ -56684,6 +59984,9 @@ DUK_INTERNAL duk_bool_t duk_hobject_putprop(duk_hthread *thr, duk_tval *tv_obj,
 				/* Target object must be checked for a conflicting
 				 * non-configurable property.
 				 */
+				if (!duk__proxy_target_may_have_props(h_target)) {
+					return 1;  /* success */
+				}
 				arr_idx = duk__push_tval_to_property_key(thr, tv_key, &key);
 				DUK_ASSERT(key != NULL);
 
@@ -57638,7 +60941,7 @@ DUK_INTERNAL duk_bool_t duk_hobject_delprop(duk_hthread *thr, duk_tval *tv_obj,
 				DUK_DDD(DUK_DDDPRINT("-> proxy object 'deleteProperty' for key %!T", (duk_tval *) tv_key));
 				duk_push_hobject(thr, h_target);  /* target */
 				duk_dup_m4(thr);  /* P */
-				duk_call_method(thr, 2 /*nargs*/);
+				duk_hobject_proxy_call_trap(thr, 2 /*nargs*/);
 				tmp_bool = duk_to_boolean(thr, -1);
 				duk_pop_nodecref_unsafe(thr);
 				if (!tmp_bool) {
@@ -60358,6 +63661,47 @@ DUK_INTERNAL void duk_hthread_create_builtin_objects(duk_hthread *thr) {
 	                DUK_USE_COMPILER_STRING);
 	duk_xdef_prop_stridx_short(thr, DUK_BIDX_DUKTAPE, DUK_STRIDX_ENV, DUK_PROPDESC_FLAGS_WC);
 
+#if defined(DUK_USE_TYPEDARRAY_KERNELS)
+	/*
+	 *  ES2015 TypedArray methods missing from the generated init data,
+	 *  set up like the function properties above.  slice() is the copying
+	 *  variant of the shared subarray() helper.
+	 */
+
+	{
+		static const struct {
+			const char *name;
+			duk_c_function func;
+			duk_small_int_t nargs;
+			duk_small_uint_t length;
+			duk_small_int_t magic;
+		} ta_methods[] = {
+			{ "fill", duk_bi_typedarray_fill, 3, 1, 0 },
+			{ "copyWithin", duk_bi_typedarray_copywithin, 3, 2, 0 },
+			{ "slice", duk_bi_buffer_slice_shared, 2, 2, 0x03 /*isView | copy*/ }
+		};
+		duk_hobject *h_ta_proto;
+
+		h_ta_proto = DUK_HOBJECT_GET_PROTOTYPE(thr->heap, duk_known_hobject(thr, DUK_BIDX_UINT8ARRAY_PROTOTYPE));
+		DUK_ASSERT(h_ta_proto != NULL);
+		duk_push_hobject(thr, h_ta_proto);
+		for (i = 0; i < sizeof(ta_methods) / sizeof(ta_methods[0]); i++) {
+			duk_hnatfunc *h_func;
+
+			duk_push_string(thr, ta_methods[i].name);
+			duk_push_c_function_builtin_noconstruct(thr, ta_methods[i].func, ta_methods[i].nargs);
+			h_func = duk_known_hnatfunc(thr, -1);
+			h_func->magic = ta_methods[i].magic;
+			duk_push_uint(thr, (duk_uint_t) ta_methods[i].length);
+			duk_xdef_prop_stridx_short(thr, -2, DUK_STRIDX_LENGTH, DUK_PROPDESC_FLAGS_C);
+			duk_dup_m2(thr);
+			duk_xdef_prop_stridx_short(thr, -2, DUK_STRIDX_NAME, DUK_PROPDESC_FLAGS_C);
+			duk_xdef_prop(thr, -3, DUK_PROPDESC_FLAGS_WC);
+		}
+		duk_pop(thr);
+	}
+#endif  /* DUK_USE_TYPEDARRAY_KERNELS */
+
 	/*
 	 *  Since built-ins are not often extended, compact them.
 	 */
@@ -60662,6 +64006,79 @@ DUK_INTERNAL void duk_hthread_activation_free(duk_hthread *thr, duk_activation *
 /* Internal helper: process the unwind for the topmost activation of a thread,
  * but leave the duk_activation in place for possible tailcall reuse.
  */
+#if defined(DUK_USE_CALL_STATS)
+/* Call stats: every activation records its entry time when call stats are
+ * on, and on unwind adds its total time to the caller's callee time and
+ * reports total and self time for Ecmascript functions and labelled native
+ * functions.  A tail call reports the function being replaced and restarts
+ * the clock for the new one.
+ */
+DUK_INTERNAL void duk_hthread_activation_stats_enter(duk_hthread *thr, duk_activation *act) {
+	act->stats_start = thr->heap->call_stats_func != NULL ? duk_time_get_monotonic_time(thr) : -1.0;
+	act->stats_child = 0.0;
+	act->stats_label = NULL;
+}
+
+DUK_LOCAL void duk__activation_stats_exit(duk_hthread *thr, duk_activation *act) {
+	duk_call_stats_entry entry;
+	duk_hobject *func;
+	duk_double_t total;
+#if defined(DUK_USE_PC2LINE)
+	duk_tval *tv;
+#endif
+
+	if (act->stats_start < 0.0 || thr->heap->call_stats_func == NULL) {
+		return;
+	}
+	total = duk_time_get_monotonic_time(thr) - act->stats_start;
+	if (act->parent != NULL) {
+		act->parent->stats_child += total;
+	}
+
+	func = DUK_ACT_GET_FUNC(act);
+	entry.name = NULL;
+	entry.name_len = 0;
+	entry.filename = NULL;
+	entry.filename_len = 0;
+	entry.line = 0;
+	entry.total_time = total;
+	entry.self_time = total - act->stats_child;
+	if (func != NULL && DUK_HOBJECT_IS_COMPFUNC(func)) {
+		/* Closures of the same function template share their data. */
+		entry.key = (const void *) DUK_HCOMPFUNC_GET_DATA(thr->heap, (duk_hcompfunc *) func);
+		entry.native = 0;
+		tv = duk_hobject_find_existing_entry_tval_ptr(thr->heap, func, DUK_HTHREAD_STRING_NAME(thr));
+		if (tv != NULL && DUK_TVAL_IS_STRING(tv)) {
+			entry.name = (const char *) DUK_HSTRING_GET_DATA(DUK_TVAL_GET_STRING(tv));
+			entry.name_len = DUK_HSTRING_GET_BYTELEN(DUK_TVAL_GET_STRING(tv));
+		}
+		tv = duk_hobject_find_existing_entry_tval_ptr(thr->heap, func, DUK_HTHREAD_STRING_FILE_NAME(thr));
+		if (tv != NULL && DUK_TVAL_IS_STRING(tv)) {
+			entry.filename = (const char *) DUK_HSTRING_GET_DATA(DUK_TVAL_GET_STRING(tv));
+			entry.filename_len = DUK_HSTRING_GET_BYTELEN(DUK_TVAL_GET_STRING(tv));
+		}
+#if defined(DUK_USE_PC2LINE)
+		tv = duk_hobject_find_existing_entry_tval_ptr(thr->heap, func, DUK_HTHREAD_STRING_INT_PC2LINE(thr));
+		if (tv != NULL && DUK_TVAL_IS_BUFFER(tv)) {
+			entry.line = (duk_uint32_t) duk__hobject_pc2line_query_raw(thr, (duk_hbuffer_fixed *) DUK_TVAL_GET_BUFFER(tv), 0);
+		}
+#endif
+	} else if (act->stats_label != NULL) {
+		entry.key = act->stats_label->key;
+		entry.native = 1;
+		entry.name = act->stats_label->name;
+		entry.name_len = act->stats_label->name_len;
+		entry.filename = act->stats_label->filename;
+		entry.filename_len = act->stats_label->filename_len;
+		entry.line = act->stats_label->line;
+	} else {
+		return;
+	}
+
+	thr->heap->call_stats_func(thr->heap->call_stats_udata, &entry);
+}
+#endif  /* DUK_USE_CALL_STATS */
+
 DUK_LOCAL void duk__activation_unwind_nofree_norz(duk_hthread *thr) {
 #if defined(DUK_USE_DEBUGGER_SUPPORT)
 	duk_heap *heap;
@@ -60681,6 +64098,10 @@ DUK_LOCAL void duk__activation_unwind_nofree_norz(duk_hthread *thr) {
 	 * pointer and not affected by side effects.
 	 */
 
+#if defined(DUK_USE_CALL_STATS)
+	duk__activation_stats_exit(thr, act);
+#endif
+
 #if defined(DUK_USE_NONSTD_FUNC_CALLER_PROPERTY)
 	/*
 	 *  Restore 'caller' property for non-strict callee functions.
@@ -62619,6 +66040,9 @@ DUK_LOCAL duk_small_uint_t duk__call_setup_act_attempt_tailcall(duk_hthread *thr
 	DUK_ASSERT(func != NULL);
 	DUK_ASSERT(DUK_HOBJECT_HAS_COMPFUNC(func));
 	act->func = func;  /* don't want an intermediate exposed state with func == NULL */
+#if defined(DUK_USE_CALL_STATS)
+	duk_hthread_activation_stats_enter(thr, act);
+#endif
 #if defined(DUK_USE_NONSTD_FUNC_CALLER_PROPERTY)
 	act->prev_caller = NULL;
 #endif
@@ -62828,6 +66252,9 @@ DUK_LOCAL void duk__call_setup_act_not_tailcall(duk_hthread *thr,
 	act->curr_pc = NULL;
 #if defined(DUK_USE_DEBUGGER_SUPPORT)
 	act->prev_line = 0;
+#endif
+#if defined(DUK_USE_CALL_STATS)
+	duk_hthread_activation_stats_enter(thr, act);
 #endif
 	act->bottom_byteoff = entry_valstack_bottom_byteoff + sizeof(duk_tval) * ((duk_size_t) idx_func + 2U);
 #if 0
@@ -65763,6 +69190,98 @@ DUK_LOCAL void duk__peephole_optimize_bytecode(duk_compiler_ctx *comp_ctx) {
 	}
 }
 
+#if defined(DUK_USE_EXEC_SUPERINSTRUCTIONS)
+/* Fuse a compare (EQ, NEQ, SEQ, SNEQ, GT, GE, LT, LE with a register B)
+ * and an immediately following IFTRUE_R/IFFALSE_R testing the compare
+ * target into a single superinstruction, see DUK_OP_EQ_IF.  The IF is left
+ * in place so that no pc values (jumps, catchers, line info) need to be
+ * relocated; the executor skips it.  A pair is only fused if nothing
+ * can transfer control directly to the IF.
+ */
+DUK_LOCAL void duk__peephole_fuse_compare_if(duk_compiler_ctx *comp_ctx) {
+	duk_hthread *thr;
+	duk_compiler_instr *bc;
+	duk_uint8_t *is_target;
+	duk_int_t i, n;
+	duk_int_t count_fused;
+
+	thr = comp_ctx->thr;
+	n = (duk_int_t) (DUK_BW_GET_SIZE(thr, &comp_ctx->curr_func.bw_code) / sizeof(duk_compiler_instr));
+	if (n < 2) {
+		return;
+	}
+
+	/* Mark instructions which may be entered other than by falling
+	 * through from the previous instruction.  Jump slots of LABEL and
+	 * TRYCATCH are JUMPs and get marked through their targets.
+	 */
+	is_target = (duk_uint8_t *) duk_push_fixed_buffer_zero(thr, (duk_size_t) n + 3);
+	bc = (duk_compiler_instr *) (void *) DUK_BW_GET_BASEPTR(thr, &comp_ctx->curr_func.bw_code);
+	for (i = 0; i < n; i++) {
+		duk_instr_t ins;
+		duk_int_t target_pc;
+
+		ins = bc[i].ins;
+		switch (DUK_DEC_OP(ins)) {
+		case DUK_OP_JUMP:
+			target_pc = i + 1 + (duk_int_t) DUK_DEC_ABC(ins) - (duk_int_t) DUK_BC_JUMP_BIAS;
+			DUK_ASSERT(target_pc >= 0 && target_pc < n);
+			is_target[target_pc] = 1;
+			break;
+		case DUK_OP_IFTRUE_R:
+		case DUK_OP_IFTRUE_C:
+		case DUK_OP_IFFALSE_R:
+		case DUK_OP_IFFALSE_C:
+		case DUK_OP_NEXTENUM:
+			is_target[i + 2] = 1;
+			break;
+		case DUK_OP_LABEL:
+		case DUK_OP_TRYCATCH:
+			is_target[i + 3] = 1;
+			break;
+		default:
+			break;
+		}
+	}
+
+	count_fused = 0;
+	for (i = 0; i < n - 1; i++) {
+		duk_instr_t ins;
+		duk_instr_t ins_next;
+		duk_small_uint_t op;
+		duk_small_uint_t op_next;
+		duk_small_uint_t op_fused;
+
+		ins = bc[i].ins;
+		op = (duk_small_uint_t) DUK_DEC_OP(ins);
+		if (op < DUK_OP_EQ || op > DUK_OP_LE_CC || (op & 0x01) != 0) {
+			/* Not a compare, or B is a constant (_CR, _CC). */
+			continue;
+		}
+		ins_next = bc[i + 1].ins;
+		op_next = (duk_small_uint_t) DUK_DEC_OP(ins_next);
+		if ((op_next != DUK_OP_IFTRUE_R && op_next != DUK_OP_IFFALSE_R) ||
+		    DUK_DEC_BC(ins_next) != DUK_DEC_A(ins) ||
+		    is_target[i + 1]) {
+			continue;
+		}
+
+		op_fused = DUK_OP_EQ_IF + (DUK_BC_NOREGCONST_OP(op) - DUK_OP_EQ) +
+		           (op_next == DUK_OP_IFFALSE_R ? 2 : 0) +
+		           ((op & 0x02) >> 1);
+		DUK_ASSERT(op_fused >= DUK_OP_EQ_IFTRUE_RR && op_fused <= DUK_OP_LE_IFFALSE_RC);
+		bc[i].ins = (ins & ~((duk_instr_t) DUK_BC_SHIFTED_MASK_OP)) | (duk_instr_t) op_fused;
+		count_fused++;
+		i++;  /* the IF is consumed */
+	}
+
+	DUK_DD(DUK_DDPRINT("fused %ld compare + IF pairs", (long) count_fused));
+	DUK_UNREF(count_fused);
+
+	duk_pop(thr);
+}
+#endif  /* DUK_USE_EXEC_SUPERINSTRUCTIONS */
+
 /*
  *  Intermediate value helpers
  */
@@ -68463,6 +71982,15 @@ DUK_LOCAL void duk__expr_led(duk_compiler_ctx *comp_ctx, duk_ivalue *left, duk_i
 					} else {
 						DUK_DD(DUK_DDPRINT("rhs evaluation emitted code, not sure if rhs is side effect free; use temp reg for LHS"));
 						reg_src = reg_temp;
+#if defined(DUK_USE_CONCAT_INPLACE)
+						/* The temp copy of 'x' is dead after the ADD;
+						 * ADDASN lets the executor drop it so that
+						 * 's += ...' can append in place.
+						 */
+						if (args_op == DUK_OP_ADD && reg_res == reg_varbind) {
+							args_op = DUK_OP_ADDASN;
+						}
+#endif
 					}
 
 					duk__emit_a_b_c(comp_ctx,
@@ -71361,11 +74889,15 @@ DUK_LOCAL void duk__parse_func_body(duk_compiler_ctx *comp_ctx, duk_bool_t expec
 	}
 
 	/*
-	 *  Peephole optimize JUMP chains.
+	 *  Peephole optimize JUMP chains and fuse instruction pairs.
 	 */
 
 	duk__peephole_optimize_bytecode(comp_ctx);
 
+#if defined(DUK_USE_EXEC_SUPERINSTRUCTIONS)
+	duk__peephole_fuse_compare_if(comp_ctx);
+#endif
+
 	/*
 	 *  comp_ctx->curr_func is now ready to be converted into an actual
 	 *  function template.
@@ -71982,6 +75514,48 @@ DUK_LOCAL_DECL void duk__js_execute_bytecode_inner(duk_hthread *entry_thread, du
 #define DUK__NOINLINE_PERF DUK_NOINLINE
 #endif
 
+/* Threaded dispatch using "labels as values" (GCC and Clang).  Each case
+ * clause of the opcode switch also gets a label, and the dispatcher jumps
+ * through a 256-entry label table instead of the switch.  This avoids the
+ * switch bounds check and lets the compiler duplicate the indirect jump
+ * into the opcode handlers.  The plain switch is the portable fallback.
+ */
+#if defined(DUK_USE_EXEC_COMPUTED_GOTO) && defined(__GNUC__) && !defined(DUK_USE_EXEC_PREFER_SIZE) && \
+    !defined(DUK_USE_ASSERTIONS) && !defined(DUK_USE_DEBUG)
+#define DUK__EXEC_COMPUTED_GOTO
+#define DUK__OPCASE(name) case DUK_OP_##name: duk__oplbl_##name
+#else
+#define DUK__OPCASE(name) case DUK_OP_##name
+#endif
+
+/* End an opcode handler.  With threaded dispatch the next instruction is
+ * fetched and dispatched inline; a pending interrupt falls back to the
+ * dispatch loop head which handles it.  Must only be used at the top level
+ * of an opcode handler: 'continue' and 'break' refer to the dispatch loop
+ * and the opcode switch.
+ */
+#if defined(DUK__EXEC_COMPUTED_GOTO)
+#if defined(DUK_USE_INTERRUPT_COUNTER)
+#define DUK__DISPATCH_INTERRUPT_CHECK() \
+		int_ctr = thr->interrupt_counter; \
+		if (DUK_UNLIKELY(int_ctr <= 0)) { \
+			continue; \
+		} \
+		thr->interrupt_counter = int_ctr - 1;
+#else
+#define DUK__DISPATCH_INTERRUPT_CHECK()
+#endif
+#define DUK__DISPATCH_NEXT() { \
+		DUK__DISPATCH_INTERRUPT_CHECK(); \
+		ins = *curr_pc++; \
+		DUK_STATS_INC(thr->heap, stats_exec_opcodes); \
+		op = (duk_uint8_t) DUK_DEC_OP(ins); \
+		goto *duk__opcode_labels[op]; \
+	}
+#else
+#define DUK__DISPATCH_NEXT() { break; }
+#endif
+
 /* Replace value stack top to value at 'tv_ptr'.  Optimize for
  * performance by only applying the net refcount change.
  */
@@ -72018,6 +75592,130 @@ DUK_LOCAL void duk__push_tvals_incref_only(duk_hthread *thr, duk_tval *tv_src, d
 }
 #endif
 
+/*
+ *  Property cache for GETPROP/PUTPROP.
+ *
+ *  Objects don't have a shape identity, but objects created by the same
+ *  code path insert their properties in the same order, so the entry part
+ *  index of a certain key accessed by a certain instruction is very stable
+ *  even when the base object varies.  Each instruction maps (by address)
+ *  to a heap level slot holding the entry index of the last hit.  A hint
+ *  is only used after checking that the entry at that index has the exact
+ *  key, so a stale or shared slot costs a lookup but never gives a wrong
+ *  result.
+ *
+ *  Only keys which cannot trigger exotic or virtual property behavior are
+ *  handled: array index keys, 'length' and 'caller' take the slow path, as
+ *  do Proxy objects and accessor properties.  For all other keys the entry
+ *  part is authoritative for any object in the inheritance chain.
+ */
+
+#if defined(DUK_USE_EXEC_PROPCACHE)
+#define DUK__PROPCACHE_SLOT(thr,pc) \
+	((thr)->heap->propcache + (((duk_size_t) (void *) (pc) / sizeof(duk_instr_t)) & (DUK_HEAP_PROPCACHE_SIZE - 1)))
+
+DUK_LOCAL DUK__INLINE_PERF duk_hstring *duk__propcache_key(duk_hthread *thr, duk_tval *tv_obj, duk_tval *tv_key) {
+	duk_hstring *key;
+
+	if (DUK_UNLIKELY(!DUK_TVAL_IS_OBJECT(tv_obj) || !DUK_TVAL_IS_STRING(tv_key))) {
+		return NULL;
+	}
+	key = DUK_TVAL_GET_STRING(tv_key);
+	if (DUK_UNLIKELY(DUK_HSTRING_HAS_ARRIDX(key) ||
+	                 key == DUK_HTHREAD_STRING_LENGTH(thr) ||
+	                 key == DUK_HTHREAD_STRING_CALLER(thr))) {
+		return NULL;
+	}
+	return key;
+}
+
+/* Find the entry index of an own property, trying the cached hint first. */
+DUK_LOCAL DUK__INLINE_PERF duk_bool_t duk__propcache_find_own(duk_heap *heap, duk_hobject *obj, duk_hstring *key, duk_uint32_t *slot, duk_int_t *out_e_idx) {
+	duk_uint32_t hint;
+	duk_int_t h_idx;
+
+	hint = *slot;
+	if (DUK_LIKELY(hint < DUK_HOBJECT_GET_ENEXT(obj) &&
+	               DUK_HOBJECT_E_GET_KEY(heap, obj, hint) == key)) {
+		*out_e_idx = (duk_int_t) hint;
+		return 1;
+	}
+	if (duk_hobject_find_existing_entry(heap, obj, key, out_e_idx, &h_idx)) {
+		DUK_ASSERT(*out_e_idx >= 0);
+		*slot = (duk_uint32_t) *out_e_idx;
+		return 1;
+	}
+	return 0;
+}
+
+/* Returns a pointer to the (possibly inherited) data property value, or
+ * NULL if the generic getprop path must be used.  Side effect free.
+ */
+DUK_LOCAL DUK__INLINE_PERF duk_tval *duk__propcache_getprop(duk_hthread *thr, duk_tval *tv_obj, duk_tval *tv_key, duk_uint32_t *slot) {
+	duk_heap *heap;
+	duk_hobject *curr;
+	duk_hstring *key;
+	duk_int_t e_idx;
+	duk_uint_t sanity;
+
+	key = duk__propcache_key(thr, tv_obj, tv_key);
+	if (key == NULL) {
+		return NULL;
+	}
+
+	heap = thr->heap;
+	curr = DUK_TVAL_GET_OBJECT(tv_obj);
+	sanity = DUK_HOBJECT_PROTOTYPE_CHAIN_SANITY;
+	do {
+		if (DUK_UNLIKELY(DUK_HOBJECT_HAS_EXOTIC_PROXYOBJ(curr))) {
+			return NULL;
+		}
+		if (duk__propcache_find_own(heap, curr, key, slot, &e_idx)) {
+			if (DUK_UNLIKELY(DUK_HOBJECT_E_SLOT_IS_ACCESSOR(heap, curr, e_idx))) {
+				return NULL;
+			}
+			return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(heap, curr, e_idx);
+		}
+		curr = DUK_HOBJECT_GET_PROTOTYPE(heap, curr);
+	} while (curr != NULL && --sanity > 0);
+
+	/* Not found (undefined) or sanity limit hit: let the slow path
+	 * handle both.
+	 */
+	return NULL;
+}
+
+/* Returns a pointer to an own writable data property value to be updated
+ * in place, or NULL if the generic putprop path must be used.
+ */
+DUK_LOCAL DUK__INLINE_PERF duk_tval *duk__propcache_putprop(duk_hthread *thr, duk_tval *tv_obj, duk_tval *tv_key, duk_uint32_t *slot) {
+	duk_heap *heap;
+	duk_hobject *obj;
+	duk_hstring *key;
+	duk_int_t e_idx;
+	duk_small_uint_t flags;
+
+	key = duk__propcache_key(thr, tv_obj, tv_key);
+	if (key == NULL) {
+		return NULL;
+	}
+
+	heap = thr->heap;
+	obj = DUK_TVAL_GET_OBJECT(tv_obj);
+	if (DUK_UNLIKELY(DUK_HOBJECT_HAS_EXOTIC_PROXYOBJ(obj))) {
+		return NULL;
+	}
+	if (!duk__propcache_find_own(heap, obj, key, slot, &e_idx)) {
+		return NULL;
+	}
+	flags = DUK_HOBJECT_E_GET_FLAGS(heap, obj, e_idx);
+	if (DUK_UNLIKELY((flags & (DUK_PROPDESC_FLAG_ACCESSOR | DUK_PROPDESC_FLAG_WRITABLE)) != DUK_PROPDESC_FLAG_WRITABLE)) {
+		return NULL;
+	}
+	return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(heap, obj, e_idx);
+}
+#endif  /* DUK_USE_EXEC_PROPCACHE */
+
 /*
  *  Arithmetic, binary, and logical helpers.
  *
@@ -72043,6 +75741,58 @@ DUK_LOCAL DUK__INLINE_PERF duk_double_t duk__compute_exp(duk_double_t d1, duk_do
 }
 #endif
 
+#if defined(DUK_USE_CONCAT_INPLACE)
+/* 's += x' where 's' is a register holding the only reference to a string:
+ * append to the string in place (see duk_heap_strtable_append()) instead of
+ * copying it into a new one.  Returns 0 if not applicable.
+ */
+DUK_LOCAL duk_bool_t duk__vm_concat_inplace(duk_hthread *thr, duk_tval *tv_z, duk_hstring *h2) {
+	duk_heap *heap;
+	duk_hstring *h1;
+	duk_hstring *res;
+	duk_size_t blen1;
+	duk_size_t blen2;
+
+	h1 = DUK_TVAL_GET_STRING(tv_z);
+	if (DUK_HEAPHDR_GET_REFCOUNT((duk_heaphdr *) h1) != 1 || h1 == h2) {
+		return 0;
+	}
+	/* Only plain strings: no symbols, no external data, no flags that
+	 * depend on the exact contents (except ASCII which is updated).
+	 */
+	if (DUK_HEAPHDR_CHECK_FLAG_BITS((duk_heaphdr *) h1,
+	                               DUK_HSTRING_FLAG_ARRIDX | DUK_HSTRING_FLAG_SYMBOL |
+	                               DUK_HSTRING_FLAG_RESERVED_WORD | DUK_HSTRING_FLAG_STRICT_RESERVED_WORD |
+	                               DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS | DUK_HSTRING_FLAG_EXTDATA) ||
+	    DUK_HSTRING_HAS_SYMBOL(h2)) {
+		return 0;
+	}
+	blen1 = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h1);
+	blen2 = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h2);
+	if (blen1 < DUK_HEAP_CONCAT_INPLACE_MIN_BLEN || blen2 == 0 ||
+	    blen2 > (duk_size_t) DUK_HSTRING_MAX_BYTELEN - blen1) {
+		return 0;
+	}
+
+	heap = thr->heap;
+	res = duk_heap_strtable_reserve_append(heap, h1, blen2);
+	if (res == NULL) {
+		return 0;
+	}
+	DUK_TVAL_SET_STRING(tv_z, res);  /* reallocated, reference moves along */
+	h1 = res;
+
+	res = duk_heap_strtable_append(heap, h1, DUK_HSTRING_GET_DATA(h2), blen2);
+	if (res != h1) {
+		/* Result was already interned: drop 'h1' (no side effects
+		 * other than freeing it).
+		 */
+		DUK_TVAL_SET_STRING_UPDREF(thr, tv_z, res);
+	}
+	return 1;
+}
+#endif  /* DUK_USE_CONCAT_INPLACE */
+
 DUK_LOCAL DUK__INLINE_PERF void duk__vm_arith_add(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y, duk_small_uint_fast_t idx_z) {
 	/*
 	 *  Addition operator is different from other arithmetic
@@ -72115,6 +75865,14 @@ DUK_LOCAL DUK__INLINE_PERF void duk__vm_arith_add(duk_hthread *thr, duk_tval *tv
 		return;
 	}
 
+#if defined(DUK_USE_CONCAT_INPLACE)
+	if (DUK_TVAL_IS_STRING(tv_x) && DUK_TVAL_IS_STRING(tv_y) &&
+	    tv_x == thr->valstack_bottom + idx_z &&
+	    duk__vm_concat_inplace(thr, tv_x, DUK_TVAL_GET_STRING(tv_y))) {
+		return;
+	}
+#endif
+
 	/*
 	 *  Slow path: potentially requires function calls for coercion
 	 */
@@ -72150,6 +75908,32 @@ DUK_LOCAL DUK__INLINE_PERF void duk__vm_arith_add(duk_hthread *thr, duk_tval *tv
 	duk_replace(thr, (duk_idx_t) idx_z);  /* side effects */
 }
 
+#if defined(DUK_USE_CONCAT_INPLACE)
+/* ADDASN: 'x += y' for a reg-bound 'x' when the compiler had to snapshot
+ * 'x' into a temp (register B) before evaluating 'y'.  The temp is dead
+ * after this instruction, so if it still holds the same string as the
+ * target, drop the temp's reference and add from the target instead; the
+ * values are identical, and the target may now be the only reference,
+ * allowing an in-place append.
+ */
+DUK_LOCAL DUK__INLINE_PERF void duk__vm_arith_add_assign(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y, duk_small_uint_fast_t idx_z) {
+	duk_tval *tv_z;
+	duk_hstring *h;
+
+	tv_z = thr->valstack_bottom + idx_z;
+	if (DUK_TVAL_IS_STRING(tv_x) && DUK_TVAL_IS_STRING(tv_z) && tv_x != tv_z) {
+		h = DUK_TVAL_GET_STRING(tv_x);
+		if (DUK_TVAL_GET_STRING(tv_z) == h) {
+			DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT((duk_heaphdr *) h) >= 2);
+			DUK_TVAL_SET_UNDEFINED(tv_x);
+			DUK_HSTRING_DECREF_NORZ(thr, h);  /* 'tv_z' still holds a reference, no side effects */
+			tv_x = tv_z;
+		}
+	}
+	duk__vm_arith_add(thr, tv_x, tv_y, idx_z);
+}
+#endif  /* DUK_USE_CONCAT_INPLACE */
+
 DUK_LOCAL DUK__INLINE_PERF void duk__vm_arith_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y, duk_uint_fast_t idx_z, duk_small_uint_fast_t opcode) {
 	/*
 	 *  Arithmetic operations other than '+' have number-only semantics
@@ -73864,6 +77648,89 @@ DUK_LOCAL void duk__interrupt_handle_debugger(duk_hthread *thr, duk_bool_t *out_
 }
 #endif  /* DUK_USE_DEBUGGER_SUPPORT */
 
+#if defined(DUK_USE_SAMPLING_PROFILER) || defined(DUK_USE_ALLOC_PROFILER)
+DUK_LOCAL void duk__sample_string_prop(duk_hthread *thr, duk_hobject *func, duk_hstring *key, const char **out_str, duk_size_t *out_len) {
+	duk_tval *tv;
+	duk_hstring *h;
+
+	/* Own properties only: the name of a native function without one
+	 * would otherwise come from Function.prototype.
+	 */
+	tv = duk_hobject_find_existing_entry_tval_ptr(thr->heap, func, key);
+	if (tv != NULL && DUK_TVAL_IS_STRING(tv)) {
+		h = DUK_TVAL_GET_STRING(tv);
+		if (DUK_HSTRING_GET_BYTELEN(h) > 0) {
+			*out_str = (const char *) DUK_HSTRING_GET_DATA(h);
+			*out_len = DUK_HSTRING_GET_BYTELEN(h);
+		}
+	}
+}
+
+/* Describe the call stack of 'thr' in 'frames', innermost first, returning
+ * the number of frames written (at most 'max_frames').  Shared with the
+ * allocation sampler in duk_heap_memory.c.
+ */
+DUK_INTERNAL duk_size_t duk_hthread_get_sample_frames(duk_hthread *thr, duk_sample_frame *frames, duk_size_t max_frames) {
+	duk_sample_frame *frame;
+	duk_activation *act;
+	duk_hobject *func;
+	duk_size_t num_frames;
+#if defined(DUK_USE_PC2LINE)
+	duk_tval *tv;
+#endif
+
+	/* The executor only writes back the pc of the innermost activation
+	 * at calls and interrupts; allocations happen in between.
+	 */
+	duk_hthread_sync_currpc(thr);
+
+	num_frames = 0;
+	for (act = thr->callstack_curr;
+	     act != NULL && num_frames < max_frames;
+	     act = act->parent) {
+		frame = frames + num_frames++;
+		frame->name = NULL;
+		frame->name_len = 0;
+		frame->filename = NULL;
+		frame->filename_len = 0;
+		frame->pc = 0;
+		frame->line = 0;
+		frame->native = 1;
+
+		func = DUK_ACT_GET_FUNC(act);
+		if (func == NULL) {
+			continue;  /* lightfunc */
+		}
+		duk__sample_string_prop(thr, func, DUK_HTHREAD_STRING_NAME(thr), &frame->name, &frame->name_len);
+		if (!DUK_HOBJECT_IS_COMPFUNC(func)) {
+			continue;
+		}
+
+		frame->native = 0;
+		frame->pc = (duk_uint32_t) duk_hthread_get_act_prev_pc(thr, act);
+		duk__sample_string_prop(thr, func, DUK_HTHREAD_STRING_FILE_NAME(thr), &frame->filename, &frame->filename_len);
+#if defined(DUK_USE_PC2LINE)
+		tv = duk_hobject_find_existing_entry_tval_ptr(thr->heap, func, DUK_HTHREAD_STRING_INT_PC2LINE(thr));
+		if (tv != NULL && DUK_TVAL_IS_BUFFER(tv)) {
+			frame->line = (duk_uint32_t) duk__hobject_pc2line_query_raw(thr, (duk_hbuffer_fixed *) DUK_TVAL_GET_BUFFER(tv), frame->pc);
+		}
+#endif
+	}
+
+	return num_frames;
+}
+#endif  /* DUK_USE_SAMPLING_PROFILER || DUK_USE_ALLOC_PROFILER */
+
+#if defined(DUK_USE_SAMPLING_PROFILER)
+DUK_LOCAL void duk__interrupt_take_sample(duk_hthread *thr) {
+	duk_sample_frame frames[DUK_HEAP_SAMPLE_MAX_FRAMES];
+	duk_size_t num_frames;
+
+	num_frames = duk_hthread_get_sample_frames(thr, frames, DUK_HEAP_SAMPLE_MAX_FRAMES);
+	thr->heap->sample_func(thr->heap->sample_udata, frames, num_frames);
+}
+#endif  /* DUK_USE_SAMPLING_PROFILER */
+
 DUK_LOCAL DUK__NOINLINE_PERF DUK_COLD duk_small_uint_t duk__executor_interrupt(duk_hthread *thr) {
 	duk_int_t ctr;
 	duk_activation *act;
@@ -73943,6 +77810,13 @@ DUK_LOCAL DUK__NOINLINE_PERF DUK_COLD duk_small_uint_t duk__executor_interrupt(d
 	}
 #endif  /* DUK_USE_EXEC_TIMEOUT_CHECK */
 
+#if defined(DUK_USE_SAMPLING_PROFILER)
+	if (thr->heap->sample_func != NULL) {
+		duk__interrupt_take_sample(thr);
+		ctr = thr->heap->sample_interval;
+	}
+#endif
+
 #if defined(DUK_USE_DEBUGGER_SUPPORT)
 	if (!thr->heap->dbg_processing &&
 	    (thr->heap->dbg_read_cb != NULL || thr->heap->dbg_detaching)) {
@@ -74601,6 +78475,28 @@ DUK_LOCAL DUK__NOINLINE_PERF duk_small_uint_t duk__handle_op_nextenum(duk_hthrea
 DUK_LOCAL duk_bool_t duk__executor_handle_call(duk_hthread *thr, duk_idx_t idx, duk_idx_t nargs, duk_small_uint_t call_flags) {
 	duk_bool_t rc;
 
+#if defined(DUK_USE_RANDOM_XOSHIRO)
+	/* Math.random() intrinsic: it has no side effects and ignores its
+	 * arguments, so skip the native call setup and write the result
+	 * directly to the call base register like a handled call would.
+	 */
+	if ((call_flags & DUK_CALL_FLAG_CONSTRUCT) == 0) {
+		duk_tval *tv_func;
+
+		tv_func = thr->valstack_bottom + idx;
+		if (DUK_TVAL_IS_OBJECT(tv_func)) {
+			duk_hobject *h_func;
+
+			h_func = DUK_TVAL_GET_OBJECT(tv_func);
+			if (DUK_HOBJECT_IS_NATFUNC(h_func) &&
+			    ((duk_hnatfunc *) h_func)->func == duk_bi_math_object_random) {
+				DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_func, DUK_UTIL_GET_RANDOM_DOUBLE(thr));
+				return 0;
+			}
+		}
+	}
+#endif
+
 	duk_set_top_unsafe(thr, (duk_idx_t) (idx + nargs + 2));   /* [ ... func this arg1 ... argN ] */
 
 	/* Attempt an Ecma-to-Ecma call setup.  If the call
@@ -74960,6 +78856,76 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 	duk_size_t valstack_top_base;    /* valstack top, should match before interpreting each op (no leftovers) */
 #endif
 
+#if defined(DUK__EXEC_COMPUTED_GOTO)
+	/* Indexed by opcode, must be kept in sync with DUK_OP_xxx. */
+	static const void * const duk__opcode_labels[256] = {
+		&&duk__oplbl_LDREG, &&duk__oplbl_STREG, &&duk__oplbl_JUMP, &&duk__oplbl_LDCONST,
+		&&duk__oplbl_LDINT, &&duk__oplbl_LDINTX, &&duk__oplbl_LDTHIS, &&duk__oplbl_LDUNDEF,
+		&&duk__oplbl_LDNULL, &&duk__oplbl_LDTRUE, &&duk__oplbl_LDFALSE, &&duk__oplbl_GETVAR,
+		&&duk__oplbl_BNOT, &&duk__oplbl_LNOT, &&duk__oplbl_UNM, &&duk__oplbl_UNP,
+		&&duk__oplbl_EQ_RR, &&duk__oplbl_EQ_CR, &&duk__oplbl_EQ_RC, &&duk__oplbl_EQ_CC,
+		&&duk__oplbl_NEQ_RR, &&duk__oplbl_NEQ_CR, &&duk__oplbl_NEQ_RC, &&duk__oplbl_NEQ_CC,
+		&&duk__oplbl_SEQ_RR, &&duk__oplbl_SEQ_CR, &&duk__oplbl_SEQ_RC, &&duk__oplbl_SEQ_CC,
+		&&duk__oplbl_SNEQ_RR, &&duk__oplbl_SNEQ_CR, &&duk__oplbl_SNEQ_RC, &&duk__oplbl_SNEQ_CC,
+		&&duk__oplbl_GT_RR, &&duk__oplbl_GT_CR, &&duk__oplbl_GT_RC, &&duk__oplbl_GT_CC,
+		&&duk__oplbl_GE_RR, &&duk__oplbl_GE_CR, &&duk__oplbl_GE_RC, &&duk__oplbl_GE_CC,
+		&&duk__oplbl_LT_RR, &&duk__oplbl_LT_CR, &&duk__oplbl_LT_RC, &&duk__oplbl_LT_CC,
+		&&duk__oplbl_LE_RR, &&duk__oplbl_LE_CR, &&duk__oplbl_LE_RC, &&duk__oplbl_LE_CC,
+		&&duk__oplbl_IFTRUE_R, &&duk__oplbl_IFTRUE_C, &&duk__oplbl_IFFALSE_R, &&duk__oplbl_IFFALSE_C,
+		&&duk__oplbl_ADD_RR, &&duk__oplbl_ADD_CR, &&duk__oplbl_ADD_RC, &&duk__oplbl_ADD_CC,
+		&&duk__oplbl_SUB_RR, &&duk__oplbl_SUB_CR, &&duk__oplbl_SUB_RC, &&duk__oplbl_SUB_CC,
+		&&duk__oplbl_MUL_RR, &&duk__oplbl_MUL_CR, &&duk__oplbl_MUL_RC, &&duk__oplbl_MUL_CC,
+		&&duk__oplbl_DIV_RR, &&duk__oplbl_DIV_CR, &&duk__oplbl_DIV_RC, &&duk__oplbl_DIV_CC,
+		&&duk__oplbl_MOD_RR, &&duk__oplbl_MOD_CR, &&duk__oplbl_MOD_RC, &&duk__oplbl_MOD_CC,
+		&&duk__oplbl_EXP_RR, &&duk__oplbl_EXP_CR, &&duk__oplbl_EXP_RC, &&duk__oplbl_EXP_CC,
+		&&duk__oplbl_BAND_RR, &&duk__oplbl_BAND_CR, &&duk__oplbl_BAND_RC, &&duk__oplbl_BAND_CC,
+		&&duk__oplbl_BOR_RR, &&duk__oplbl_BOR_CR, &&duk__oplbl_BOR_RC, &&duk__oplbl_BOR_CC,
+		&&duk__oplbl_BXOR_RR, &&duk__oplbl_BXOR_CR, &&duk__oplbl_BXOR_RC, &&duk__oplbl_BXOR_CC,
+		&&duk__oplbl_BASL_RR, &&duk__oplbl_BASL_CR, &&duk__oplbl_BASL_RC, &&duk__oplbl_BASL_CC,
+		&&duk__oplbl_BLSR_RR, &&duk__oplbl_BLSR_CR, &&duk__oplbl_BLSR_RC, &&duk__oplbl_BLSR_CC,
+		&&duk__oplbl_BASR_RR, &&duk__oplbl_BASR_CR, &&duk__oplbl_BASR_RC, &&duk__oplbl_BASR_CC,
+		&&duk__oplbl_INSTOF_RR, &&duk__oplbl_INSTOF_CR, &&duk__oplbl_INSTOF_RC, &&duk__oplbl_INSTOF_CC,
+		&&duk__oplbl_IN_RR, &&duk__oplbl_IN_CR, &&duk__oplbl_IN_RC, &&duk__oplbl_IN_CC,
+		&&duk__oplbl_GETPROP_RR, &&duk__oplbl_GETPROP_CR, &&duk__oplbl_GETPROP_RC, &&duk__oplbl_GETPROP_CC,
+		&&duk__oplbl_PUTPROP_RR, &&duk__oplbl_PUTPROP_CR, &&duk__oplbl_PUTPROP_RC, &&duk__oplbl_PUTPROP_CC,
+		&&duk__oplbl_DELPROP_RR, &&duk__oplbl_DELPROP_CR_UNUSED, &&duk__oplbl_DELPROP_RC, &&duk__oplbl_DELPROP_CC_UNUSED,
+		&&duk__oplbl_PREINCR, &&duk__oplbl_PREDECR, &&duk__oplbl_POSTINCR, &&duk__oplbl_POSTDECR,
+		&&duk__oplbl_PREINCV, &&duk__oplbl_PREDECV, &&duk__oplbl_POSTINCV, &&duk__oplbl_POSTDECV,
+		&&duk__oplbl_PREINCP_RR, &&duk__oplbl_PREINCP_CR, &&duk__oplbl_PREINCP_RC, &&duk__oplbl_PREINCP_CC,
+		&&duk__oplbl_PREDECP_RR, &&duk__oplbl_PREDECP_CR, &&duk__oplbl_PREDECP_RC, &&duk__oplbl_PREDECP_CC,
+		&&duk__oplbl_POSTINCP_RR, &&duk__oplbl_POSTINCP_CR, &&duk__oplbl_POSTINCP_RC, &&duk__oplbl_POSTINCP_CC,
+		&&duk__oplbl_POSTDECP_RR, &&duk__oplbl_POSTDECP_CR, &&duk__oplbl_POSTDECP_RC, &&duk__oplbl_POSTDECP_CC,
+		&&duk__oplbl_DECLVAR_RR, &&duk__oplbl_DECLVAR_CR, &&duk__oplbl_DECLVAR_RC, &&duk__oplbl_DECLVAR_CC,
+		&&duk__oplbl_REGEXP_RR, &&duk__oplbl_REGEXP_CR, &&duk__oplbl_REGEXP_RC, &&duk__oplbl_REGEXP_CC,
+		&&duk__oplbl_CLOSURE, &&duk__oplbl_TYPEOF, &&duk__oplbl_TYPEOFID, &&duk__oplbl_PUTVAR,
+		&&duk__oplbl_DELVAR, &&duk__oplbl_RETREG, &&duk__oplbl_RETUNDEF, &&duk__oplbl_RETCONST,
+		&&duk__oplbl_RETCONSTN, &&duk__oplbl_LABEL, &&duk__oplbl_ENDLABEL, &&duk__oplbl_BREAK,
+		&&duk__oplbl_CONTINUE, &&duk__oplbl_TRYCATCH, &&duk__oplbl_ENDTRY, &&duk__oplbl_ENDCATCH,
+		&&duk__oplbl_ENDFIN, &&duk__oplbl_THROW, &&duk__oplbl_INVLHS, &&duk__oplbl_CSREG,
+		&&duk__oplbl_CSVAR_RR, &&duk__oplbl_CSVAR_CR, &&duk__oplbl_CSVAR_RC, &&duk__oplbl_CSVAR_CC,
+		&&duk__oplbl_CALL0, &&duk__oplbl_CALL1, &&duk__oplbl_CALL2, &&duk__oplbl_CALL3,
+		&&duk__oplbl_CALL4, &&duk__oplbl_CALL5, &&duk__oplbl_CALL6, &&duk__oplbl_CALL7,
+		&&duk__oplbl_CALL8, &&duk__oplbl_CALL9, &&duk__oplbl_CALL10, &&duk__oplbl_CALL11,
+		&&duk__oplbl_CALL12, &&duk__oplbl_CALL13, &&duk__oplbl_CALL14, &&duk__oplbl_CALL15,
+		&&duk__oplbl_NEWOBJ, &&duk__oplbl_NEWARR, &&duk__oplbl_MPUTOBJ, &&duk__oplbl_MPUTOBJI,
+		&&duk__oplbl_INITSET, &&duk__oplbl_INITGET, &&duk__oplbl_MPUTARR, &&duk__oplbl_MPUTARRI,
+		&&duk__oplbl_SETALEN, &&duk__oplbl_INITENUM, &&duk__oplbl_NEXTENUM, &&duk__oplbl_NEWTARGET,
+		&&duk__oplbl_DEBUGGER, &&duk__oplbl_NOP, &&duk__oplbl_INVALID, &&duk__oplbl_UNUSED207,
+		&&duk__oplbl_GETPROPC_RR, &&duk__oplbl_GETPROPC_CR, &&duk__oplbl_GETPROPC_RC, &&duk__oplbl_GETPROPC_CC,
+		&&duk__oplbl_EQ_IFTRUE_RR, &&duk__oplbl_EQ_IFTRUE_RC, &&duk__oplbl_EQ_IFFALSE_RR, &&duk__oplbl_EQ_IFFALSE_RC,
+		&&duk__oplbl_NEQ_IFTRUE_RR, &&duk__oplbl_NEQ_IFTRUE_RC, &&duk__oplbl_NEQ_IFFALSE_RR, &&duk__oplbl_NEQ_IFFALSE_RC,
+		&&duk__oplbl_SEQ_IFTRUE_RR, &&duk__oplbl_SEQ_IFTRUE_RC, &&duk__oplbl_SEQ_IFFALSE_RR, &&duk__oplbl_SEQ_IFFALSE_RC,
+		&&duk__oplbl_SNEQ_IFTRUE_RR, &&duk__oplbl_SNEQ_IFTRUE_RC, &&duk__oplbl_SNEQ_IFFALSE_RR, &&duk__oplbl_SNEQ_IFFALSE_RC,
+		&&duk__oplbl_GT_IFTRUE_RR, &&duk__oplbl_GT_IFTRUE_RC, &&duk__oplbl_GT_IFFALSE_RR, &&duk__oplbl_GT_IFFALSE_RC,
+		&&duk__oplbl_GE_IFTRUE_RR, &&duk__oplbl_GE_IFTRUE_RC, &&duk__oplbl_GE_IFFALSE_RR, &&duk__oplbl_GE_IFFALSE_RC,
+		&&duk__oplbl_LT_IFTRUE_RR, &&duk__oplbl_LT_IFTRUE_RC, &&duk__oplbl_LT_IFFALSE_RR, &&duk__oplbl_LT_IFFALSE_RC,
+		&&duk__oplbl_LE_IFTRUE_RR, &&duk__oplbl_LE_IFTRUE_RC, &&duk__oplbl_LE_IFFALSE_RR, &&duk__oplbl_LE_IFFALSE_RC,
+		&&duk__oplbl_ADDASN_RR, &&duk__oplbl_ADDASN_CR, &&duk__oplbl_ADDASN_RC, &&duk__oplbl_ADDASN_CC,
+		&&duk__oplbl_UNUSED248, &&duk__oplbl_UNUSED249, &&duk__oplbl_UNUSED250, &&duk__oplbl_UNUSED251,
+		&&duk__oplbl_UNUSED252, &&duk__oplbl_UNUSED253, &&duk__oplbl_UNUSED254, &&duk__oplbl_UNUSED255
+	};
+#endif
+
 	/* Optimized reg/const access macros assume sizeof(duk_tval) to be
 	 * either 8 or 16.  Heap allocation checks this even without asserts
 	 * enabled now because it can't be autodetected in duk_config.h.
@@ -75189,6 +79155,12 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * will (at least usually) omit a bounds check.
 		 */
 		op = (duk_uint8_t) DUK_DEC_OP(ins);
+#if defined(DUK__EXEC_COMPUTED_GOTO)
+		/* Jump directly to the handler label; the switch below is
+		 * then only used for its case labels.
+		 */
+		goto *duk__opcode_labels[op];
+#endif
 		switch (op) {
 
 		/* Some useful macros.  These access inner executor variables
@@ -75205,8 +79177,8 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_TOP_A_BREAK(); \
 	}
 #else
-#define DUK__REPLACE_TOP_A_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_A(ins)); break; }
-#define DUK__REPLACE_TOP_BC_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_BC(ins)); break; }
+#define DUK__REPLACE_TOP_A_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_A(ins)); DUK__DISPATCH_NEXT(); }
+#define DUK__REPLACE_TOP_BC_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_BC(ins)); DUK__DISPATCH_NEXT(); }
 #define DUK__REPLACE_BOOL_A_BREAK(bval) { \
 		duk_bool_t duk__bval; \
 		duk_tval *duk__tvdst; \
@@ -75214,7 +79186,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK_ASSERT(duk__bval == 0 || duk__bval == 1); \
 		duk__tvdst = DUK__REGP_A(ins); \
 		DUK_TVAL_SET_BOOLEAN_UPDREF(thr, duk__tvdst, duk__bval); \
-		break; \
+		DUK__DISPATCH_NEXT(); \
 	}
 #endif
 
@@ -75226,31 +79198,31 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * duk_dup() + duk_replace(), but because they're used quite a lot
 		 * they're currently intentionally not size optimized.
 		 */
-		case DUK_OP_LDREG: {
+		DUK__OPCASE(LDREG): {
 			duk_tval *tv1, *tv2;
 
 			tv1 = DUK__REGP_A(ins);
 			tv2 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv1, tv2);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_STREG: {
+		DUK__OPCASE(STREG): {
 			duk_tval *tv1, *tv2;
 
 			tv1 = DUK__REGP_A(ins);
 			tv2 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv2, tv1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_LDCONST: {
+		DUK__OPCASE(LDCONST): {
 			duk_tval *tv1, *tv2;
 
 			tv1 = DUK__REGP_A(ins);
 			tv2 = DUK__CONSTP_BC(ins);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv1, tv2);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 		/* LDINT and LDINTX are intended to load an arbitrary signed
@@ -75258,14 +79230,14 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * This also guarantees all values remain fastints.
 		 */
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_LDINT: {
+		DUK__OPCASE(LDINT): {
 			duk_int32_t val;
 
 			val = (duk_int32_t) DUK_DEC_BC(ins) - (duk_int32_t) DUK_BC_LDINT_BIAS;
 			duk_push_int(thr, val);
 			DUK__REPLACE_TOP_A_BREAK();
 		}
-		case DUK_OP_LDINTX: {
+		DUK__OPCASE(LDINTX): {
 			duk_int32_t val;
 
 			val = (duk_int32_t) duk_get_int(thr, DUK_DEC_A(ins));
@@ -75274,16 +79246,16 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_LDINT: {
+		DUK__OPCASE(LDINT): {
 			duk_tval *tv1;
 			duk_int32_t val;
 
 			val = (duk_int32_t) DUK_DEC_BC(ins) - (duk_int32_t) DUK_BC_LDINT_BIAS;
 			tv1 = DUK__REGP_A(ins);
 			DUK_TVAL_SET_I32_UPDREF(thr, tv1, val);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDINTX: {
+		DUK__OPCASE(LDINTX): {
 			duk_tval *tv1;
 			duk_int32_t val;
 
@@ -75298,33 +79270,33 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #endif
 			val = (val << DUK_BC_LDINTX_SHIFT) + (duk_int32_t) DUK_DEC_BC(ins);  /* no bias */
 			DUK_TVAL_SET_I32_UPDREF(thr, tv1, val);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_LDTHIS: {
+		DUK__OPCASE(LDTHIS): {
 			duk_push_this(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
-		case DUK_OP_LDUNDEF: {
+		DUK__OPCASE(LDUNDEF): {
 			duk_to_undefined(thr, (duk_idx_t) DUK_DEC_BC(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDNULL: {
+		DUK__OPCASE(LDNULL): {
 			duk_to_null(thr, (duk_idx_t) DUK_DEC_BC(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDTRUE: {
+		DUK__OPCASE(LDTRUE): {
 			duk_push_true(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
-		case DUK_OP_LDFALSE: {
+		DUK__OPCASE(LDFALSE): {
 			duk_push_false(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_LDTHIS: {
+		DUK__OPCASE(LDTHIS): {
 			/* Note: 'this' may be bound to any value, not just an object */
 			duk_tval *tv1, *tv2;
 
@@ -75332,67 +79304,67 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			tv2 = thr->valstack_bottom - 1;  /* 'this binding' is just under bottom */
 			DUK_ASSERT(tv2 >= thr->valstack);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv1, tv2);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDUNDEF: {
+		DUK__OPCASE(LDUNDEF): {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_UNDEFINED_UPDREF(thr, tv1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDNULL: {
+		DUK__OPCASE(LDNULL): {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_NULL_UPDREF(thr, tv1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDTRUE: {
+		DUK__OPCASE(LDTRUE): {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv1, 1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDFALSE: {
+		DUK__OPCASE(LDFALSE): {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv1, 0);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
-		case DUK_OP_BNOT: {
+		DUK__OPCASE(BNOT): {
 			duk__vm_bitwise_not(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_LNOT: {
+		DUK__OPCASE(LNOT): {
 			duk__vm_logical_not(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_UNM:
-		case DUK_OP_UNP: {
+		DUK__OPCASE(UNM):
+		DUK__OPCASE(UNP): {
 			duk__vm_arith_unary_op(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_UNM: {
+		DUK__OPCASE(UNM): {
 			duk__vm_arith_unary_op(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins), DUK_OP_UNM);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_UNP: {
+		DUK__OPCASE(UNP): {
 			duk__vm_arith_unary_op(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins), DUK_OP_UNP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_TYPEOF: {
+		DUK__OPCASE(TYPEOF): {
 			duk_small_uint_t stridx;
 
 			stridx = duk_js_typeof_stridx(DUK__REGP_BC(ins));
@@ -75401,7 +79373,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_TYPEOF: {
+		DUK__OPCASE(TYPEOF): {
 			duk_tval *tv;
 			duk_small_uint_t stridx;
 			duk_hstring *h_str;
@@ -75412,11 +79384,11 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			h_str = DUK_HTHREAD_GET_STRING(thr, stridx);
 			tv = DUK__REGP_A(ins);
 			DUK_TVAL_SET_STRING_UPDREF(thr, tv, h_str);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
-		case DUK_OP_TYPEOFID: {
+		DUK__OPCASE(TYPEOFID): {
 			duk_small_uint_t stridx;
 #if !defined(DUK_USE_EXEC_PREFER_SIZE)
 			duk_hstring *h_str;
@@ -75452,7 +79424,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			h_str = DUK_HTHREAD_GET_STRING(thr, stridx);
 			tv = DUK__REGP_A(ins);
 			DUK_TVAL_SET_STRING_UPDREF(thr, tv, h_str);
-			break;
+			DUK__DISPATCH_NEXT();
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 		}
 
@@ -75485,58 +79457,58 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_BOOL_A_BREAK(tmp); \
 	}
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_EQ_RR:
-		case DUK_OP_EQ_CR:
-		case DUK_OP_EQ_RC:
-		case DUK_OP_EQ_CC:
+		DUK__OPCASE(EQ_RR):
+		DUK__OPCASE(EQ_CR):
+		DUK__OPCASE(EQ_RC):
+		DUK__OPCASE(EQ_CC):
 			DUK__EQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_NEQ_RR:
-		case DUK_OP_NEQ_CR:
-		case DUK_OP_NEQ_RC:
-		case DUK_OP_NEQ_CC:
+		DUK__OPCASE(NEQ_RR):
+		DUK__OPCASE(NEQ_CR):
+		DUK__OPCASE(NEQ_RC):
+		DUK__OPCASE(NEQ_CC):
 			DUK__NEQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_SEQ_RR:
-		case DUK_OP_SEQ_CR:
-		case DUK_OP_SEQ_RC:
-		case DUK_OP_SEQ_CC:
+		DUK__OPCASE(SEQ_RR):
+		DUK__OPCASE(SEQ_CR):
+		DUK__OPCASE(SEQ_RC):
+		DUK__OPCASE(SEQ_CC):
 			DUK__SEQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_SNEQ_RR:
-		case DUK_OP_SNEQ_CR:
-		case DUK_OP_SNEQ_RC:
-		case DUK_OP_SNEQ_CC:
+		DUK__OPCASE(SNEQ_RR):
+		DUK__OPCASE(SNEQ_CR):
+		DUK__OPCASE(SNEQ_RC):
+		DUK__OPCASE(SNEQ_CC):
 			DUK__SNEQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_EQ_RR:
+		DUK__OPCASE(EQ_RR):
 			DUK__EQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_EQ_CR:
+		DUK__OPCASE(EQ_CR):
 			DUK__EQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_EQ_RC:
+		DUK__OPCASE(EQ_RC):
 			DUK__EQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_EQ_CC:
+		DUK__OPCASE(EQ_CC):
 			DUK__EQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_NEQ_RR:
+		DUK__OPCASE(NEQ_RR):
 			DUK__NEQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_NEQ_CR:
+		DUK__OPCASE(NEQ_CR):
 			DUK__NEQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_NEQ_RC:
+		DUK__OPCASE(NEQ_RC):
 			DUK__NEQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_NEQ_CC:
+		DUK__OPCASE(NEQ_CC):
 			DUK__NEQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SEQ_RR:
+		DUK__OPCASE(SEQ_RR):
 			DUK__SEQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SEQ_CR:
+		DUK__OPCASE(SEQ_CR):
 			DUK__SEQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SEQ_RC:
+		DUK__OPCASE(SEQ_RC):
 			DUK__SEQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SEQ_CC:
+		DUK__OPCASE(SEQ_CC):
 			DUK__SEQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SNEQ_RR:
+		DUK__OPCASE(SNEQ_RR):
 			DUK__SNEQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SNEQ_CR:
+		DUK__OPCASE(SNEQ_CR):
 			DUK__SNEQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SNEQ_RC:
+		DUK__OPCASE(SNEQ_RC):
 			DUK__SNEQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SNEQ_CC:
+		DUK__OPCASE(SNEQ_CC):
 			DUK__SNEQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
@@ -75551,353 +79523,483 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #define DUK__LT_BODY(barg,carg) DUK__COMPARE_BODY((barg), (carg), DUK_COMPARE_FLAG_EVAL_LEFT_FIRST)
 #define DUK__LE_BODY(barg,carg) DUK__COMPARE_BODY((carg), (barg), DUK_COMPARE_FLAG_NEGATE)
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_GT_RR:
-		case DUK_OP_GT_CR:
-		case DUK_OP_GT_RC:
-		case DUK_OP_GT_CC:
+		DUK__OPCASE(GT_RR):
+		DUK__OPCASE(GT_CR):
+		DUK__OPCASE(GT_RC):
+		DUK__OPCASE(GT_CC):
 			DUK__GT_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_GE_RR:
-		case DUK_OP_GE_CR:
-		case DUK_OP_GE_RC:
-		case DUK_OP_GE_CC:
+		DUK__OPCASE(GE_RR):
+		DUK__OPCASE(GE_CR):
+		DUK__OPCASE(GE_RC):
+		DUK__OPCASE(GE_CC):
 			DUK__GE_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_LT_RR:
-		case DUK_OP_LT_CR:
-		case DUK_OP_LT_RC:
-		case DUK_OP_LT_CC:
+		DUK__OPCASE(LT_RR):
+		DUK__OPCASE(LT_CR):
+		DUK__OPCASE(LT_RC):
+		DUK__OPCASE(LT_CC):
 			DUK__LT_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_LE_RR:
-		case DUK_OP_LE_CR:
-		case DUK_OP_LE_RC:
-		case DUK_OP_LE_CC:
+		DUK__OPCASE(LE_RR):
+		DUK__OPCASE(LE_CR):
+		DUK__OPCASE(LE_RC):
+		DUK__OPCASE(LE_CC):
 			DUK__LE_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_GT_RR:
+		DUK__OPCASE(GT_RR):
 			DUK__GT_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GT_CR:
+		DUK__OPCASE(GT_CR):
 			DUK__GT_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GT_RC:
+		DUK__OPCASE(GT_RC):
 			DUK__GT_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GT_CC:
+		DUK__OPCASE(GT_CC):
 			DUK__GT_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GE_RR:
+		DUK__OPCASE(GE_RR):
 			DUK__GE_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GE_CR:
+		DUK__OPCASE(GE_CR):
 			DUK__GE_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GE_RC:
+		DUK__OPCASE(GE_RC):
 			DUK__GE_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GE_CC:
+		DUK__OPCASE(GE_CC):
 			DUK__GE_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LT_RR:
+		DUK__OPCASE(LT_RR):
 			DUK__LT_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LT_CR:
+		DUK__OPCASE(LT_CR):
 			DUK__LT_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LT_RC:
+		DUK__OPCASE(LT_RC):
 			DUK__LT_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LT_CC:
+		DUK__OPCASE(LT_CC):
 			DUK__LT_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LE_RR:
+		DUK__OPCASE(LE_RR):
 			DUK__LE_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LE_CR:
+		DUK__OPCASE(LE_CR):
 			DUK__LE_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LE_RC:
+		DUK__OPCASE(LE_RC):
 			DUK__LE_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LE_CC:
+		DUK__OPCASE(LE_CC):
 			DUK__LE_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
+		/* Compare + IFTRUE/IFFALSE superinstructions, created by the
+		 * compiler peephole pass (duk__peephole_fuse_compare_if).  The
+		 * boolean result is still written to A, the fused IF (which
+		 * follows the compare in the bytecode) is skipped, and a JUMP
+		 * that would be executed next is taken directly.
+		 */
+#if defined(DUK_USE_EXEC_SUPERINSTRUCTIONS)
+#define DUK__CMPIF_BODY(cond,skipval) { \
+		duk_bool_t duk__cond; \
+		duk_tval *duk__tvdst; \
+		duk_instr_t duk__ins_next; \
+		duk__cond = (cond); \
+		DUK_ASSERT(duk__cond == 0 || duk__cond == 1); \
+		duk__tvdst = DUK__REGP_A(ins); \
+		DUK_TVAL_SET_BOOLEAN_UPDREF(thr, duk__tvdst, duk__cond);  /* side effects */ \
+		DUK_ASSERT(DUK_DEC_OP(*curr_pc) == ((skipval) ? DUK_OP_IFTRUE_R : DUK_OP_IFFALSE_R)); \
+		curr_pc++; \
+		if (duk__cond == (skipval)) { \
+			curr_pc++; \
+		} else { \
+			duk__ins_next = *curr_pc; \
+			if (DUK_DEC_OP(duk__ins_next) == DUK_OP_JUMP) { \
+				curr_pc += 1 + (duk_int_fast_t) DUK_DEC_ABC(duk__ins_next) - (duk_int_fast_t) DUK_BC_JUMP_BIAS; \
+			} \
+		} \
+		DUK__DISPATCH_NEXT(); \
+	}
+#define DUK__EQ_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_equals(thr, (barg), (carg)), (skipval))
+#define DUK__NEQ_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_equals(thr, (barg), (carg)) ^ 1, (skipval))
+#define DUK__SEQ_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_strict_equals((barg), (carg)), (skipval))
+#define DUK__SNEQ_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_strict_equals((barg), (carg)) ^ 1, (skipval))
+#define DUK__GT_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_compare_helper(thr, (carg), (barg), 0), (skipval))
+#define DUK__GE_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_compare_helper(thr, (barg), (carg), DUK_COMPARE_FLAG_EVAL_LEFT_FIRST | DUK_COMPARE_FLAG_NEGATE), (skipval))
+#define DUK__LT_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_compare_helper(thr, (barg), (carg), DUK_COMPARE_FLAG_EVAL_LEFT_FIRST), (skipval))
+#define DUK__LE_IF_BODY(barg,carg,skipval) DUK__CMPIF_BODY(duk_js_compare_helper(thr, (carg), (barg), DUK_COMPARE_FLAG_NEGATE), (skipval))
+		DUK__OPCASE(EQ_IFTRUE_RR):
+			DUK__EQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(EQ_IFTRUE_RC):
+			DUK__EQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(EQ_IFFALSE_RR):
+			DUK__EQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(EQ_IFFALSE_RC):
+			DUK__EQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(NEQ_IFTRUE_RR):
+			DUK__NEQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(NEQ_IFTRUE_RC):
+			DUK__NEQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(NEQ_IFFALSE_RR):
+			DUK__NEQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(NEQ_IFFALSE_RC):
+			DUK__NEQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(SEQ_IFTRUE_RR):
+			DUK__SEQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(SEQ_IFTRUE_RC):
+			DUK__SEQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(SEQ_IFFALSE_RR):
+			DUK__SEQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(SEQ_IFFALSE_RC):
+			DUK__SEQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(SNEQ_IFTRUE_RR):
+			DUK__SNEQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(SNEQ_IFTRUE_RC):
+			DUK__SNEQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(SNEQ_IFFALSE_RR):
+			DUK__SNEQ_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(SNEQ_IFFALSE_RC):
+			DUK__SNEQ_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(GT_IFTRUE_RR):
+			DUK__GT_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(GT_IFTRUE_RC):
+			DUK__GT_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(GT_IFFALSE_RR):
+			DUK__GT_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(GT_IFFALSE_RC):
+			DUK__GT_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(GE_IFTRUE_RR):
+			DUK__GE_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(GE_IFTRUE_RC):
+			DUK__GE_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(GE_IFFALSE_RR):
+			DUK__GE_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(GE_IFFALSE_RC):
+			DUK__GE_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(LT_IFTRUE_RR):
+			DUK__LT_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(LT_IFTRUE_RC):
+			DUK__LT_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(LT_IFFALSE_RR):
+			DUK__LT_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(LT_IFFALSE_RC):
+			DUK__LT_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+		DUK__OPCASE(LE_IFTRUE_RR):
+			DUK__LE_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 1);
+		DUK__OPCASE(LE_IFTRUE_RC):
+			DUK__LE_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 1);
+		DUK__OPCASE(LE_IFFALSE_RR):
+			DUK__LE_IF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins), 0);
+		DUK__OPCASE(LE_IFFALSE_RC):
+			DUK__LE_IF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins), 0);
+#endif  /* DUK_USE_EXEC_SUPERINSTRUCTIONS */
+
 		/* No size optimized variant at present for IF. */
-		case DUK_OP_IFTRUE_R: {
+		DUK__OPCASE(IFTRUE_R): {
 			if (duk_js_toboolean(DUK__REGP_BC(ins)) != 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_IFTRUE_C: {
+		DUK__OPCASE(IFTRUE_C): {
 			if (duk_js_toboolean(DUK__CONSTP_BC(ins)) != 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_IFFALSE_R: {
+		DUK__OPCASE(IFFALSE_R): {
 			if (duk_js_toboolean(DUK__REGP_BC(ins)) == 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_IFFALSE_C: {
+		DUK__OPCASE(IFFALSE_C): {
 			if (duk_js_toboolean(DUK__CONSTP_BC(ins)) == 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_ADD_RR:
-		case DUK_OP_ADD_CR:
-		case DUK_OP_ADD_RC:
-		case DUK_OP_ADD_CC: {
+		DUK__OPCASE(ADD_RR):
+		DUK__OPCASE(ADD_CR):
+		DUK__OPCASE(ADD_RC):
+		DUK__OPCASE(ADD_CC): {
 			/* XXX: could leave value on stack top and goto replace_top_a; */
 			duk__vm_arith_add(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_ADD_RR: {
+		DUK__OPCASE(ADD_RR): {
 			duk__vm_arith_add(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_ADD_CR: {
+		DUK__OPCASE(ADD_CR): {
 			duk__vm_arith_add(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_ADD_RC: {
+		DUK__OPCASE(ADD_RC): {
 			duk__vm_arith_add(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_ADD_CC: {
+		DUK__OPCASE(ADD_CC): {
 			duk__vm_arith_add(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
+		}
+#endif  /* DUK_USE_EXEC_PREFER_SIZE */
+
+#if defined(DUK_USE_CONCAT_INPLACE)
+#if defined(DUK_USE_EXEC_PREFER_SIZE)
+		DUK__OPCASE(ADDASN_RR):
+		DUK__OPCASE(ADDASN_CR):
+		DUK__OPCASE(ADDASN_RC):
+		DUK__OPCASE(ADDASN_CC): {
+			duk__vm_arith_add_assign(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+#else  /* DUK_USE_EXEC_PREFER_SIZE */
+		DUK__OPCASE(ADDASN_RR): {
+			duk__vm_arith_add_assign(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__OPCASE(ADDASN_CR): {
+			duk__vm_arith_add_assign(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__OPCASE(ADDASN_RC): {
+			duk__vm_arith_add_assign(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__OPCASE(ADDASN_CC): {
+			duk__vm_arith_add_assign(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
+#endif  /* DUK_USE_CONCAT_INPLACE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_SUB_RR:
-		case DUK_OP_SUB_CR:
-		case DUK_OP_SUB_RC:
-		case DUK_OP_SUB_CC:
-		case DUK_OP_MUL_RR:
-		case DUK_OP_MUL_CR:
-		case DUK_OP_MUL_RC:
-		case DUK_OP_MUL_CC:
-		case DUK_OP_DIV_RR:
-		case DUK_OP_DIV_CR:
-		case DUK_OP_DIV_RC:
-		case DUK_OP_DIV_CC:
-		case DUK_OP_MOD_RR:
-		case DUK_OP_MOD_CR:
-		case DUK_OP_MOD_RC:
-		case DUK_OP_MOD_CC:
+		DUK__OPCASE(SUB_RR):
+		DUK__OPCASE(SUB_CR):
+		DUK__OPCASE(SUB_RC):
+		DUK__OPCASE(SUB_CC):
+		DUK__OPCASE(MUL_RR):
+		DUK__OPCASE(MUL_CR):
+		DUK__OPCASE(MUL_RC):
+		DUK__OPCASE(MUL_CC):
+		DUK__OPCASE(DIV_RR):
+		DUK__OPCASE(DIV_CR):
+		DUK__OPCASE(DIV_RC):
+		DUK__OPCASE(DIV_CC):
+		DUK__OPCASE(MOD_RR):
+		DUK__OPCASE(MOD_CR):
+		DUK__OPCASE(MOD_RC):
+		DUK__OPCASE(MOD_CC):
 #if defined(DUK_USE_ES7_EXP_OPERATOR)
-		case DUK_OP_EXP_RR:
-		case DUK_OP_EXP_CR:
-		case DUK_OP_EXP_RC:
-		case DUK_OP_EXP_CC:
+		DUK__OPCASE(EXP_RR):
+		DUK__OPCASE(EXP_CR):
+		DUK__OPCASE(EXP_RC):
+		DUK__OPCASE(EXP_CC):
 #endif  /* DUK_USE_ES7_EXP_OPERATOR */
 		{
 			/* XXX: could leave value on stack top and goto replace_top_a; */
 			duk__vm_arith_binary_op(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_SUB_RR: {
+		DUK__OPCASE(SUB_RR): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_SUB_CR: {
+		DUK__OPCASE(SUB_CR): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_SUB_RC: {
+		DUK__OPCASE(SUB_RC): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_SUB_CC: {
+		DUK__OPCASE(SUB_CC): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_RR: {
+		DUK__OPCASE(MUL_RR): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_CR: {
+		DUK__OPCASE(MUL_CR): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_RC: {
+		DUK__OPCASE(MUL_RC): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_CC: {
+		DUK__OPCASE(MUL_CC): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_RR: {
+		DUK__OPCASE(DIV_RR): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_CR: {
+		DUK__OPCASE(DIV_CR): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_RC: {
+		DUK__OPCASE(DIV_RC): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_CC: {
+		DUK__OPCASE(DIV_CC): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_RR: {
+		DUK__OPCASE(MOD_RR): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_CR: {
+		DUK__OPCASE(MOD_CR): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_RC: {
+		DUK__OPCASE(MOD_RC): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_CC: {
+		DUK__OPCASE(MOD_CC): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #if defined(DUK_USE_ES7_EXP_OPERATOR)
-		case DUK_OP_EXP_RR: {
+		DUK__OPCASE(EXP_RR): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_EXP_CR: {
+		DUK__OPCASE(EXP_CR): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_EXP_RC: {
+		DUK__OPCASE(EXP_RC): {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_EXP_CC: {
+		DUK__OPCASE(EXP_CC): {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_ES7_EXP_OPERATOR */
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_BAND_RR:
-		case DUK_OP_BAND_CR:
-		case DUK_OP_BAND_RC:
-		case DUK_OP_BAND_CC:
-		case DUK_OP_BOR_RR:
-		case DUK_OP_BOR_CR:
-		case DUK_OP_BOR_RC:
-		case DUK_OP_BOR_CC:
-		case DUK_OP_BXOR_RR:
-		case DUK_OP_BXOR_CR:
-		case DUK_OP_BXOR_RC:
-		case DUK_OP_BXOR_CC:
-		case DUK_OP_BASL_RR:
-		case DUK_OP_BASL_CR:
-		case DUK_OP_BASL_RC:
-		case DUK_OP_BASL_CC:
-		case DUK_OP_BLSR_RR:
-		case DUK_OP_BLSR_CR:
-		case DUK_OP_BLSR_RC:
-		case DUK_OP_BLSR_CC:
-		case DUK_OP_BASR_RR:
-		case DUK_OP_BASR_CR:
-		case DUK_OP_BASR_RC:
-		case DUK_OP_BASR_CC: {
+		DUK__OPCASE(BAND_RR):
+		DUK__OPCASE(BAND_CR):
+		DUK__OPCASE(BAND_RC):
+		DUK__OPCASE(BAND_CC):
+		DUK__OPCASE(BOR_RR):
+		DUK__OPCASE(BOR_CR):
+		DUK__OPCASE(BOR_RC):
+		DUK__OPCASE(BOR_CC):
+		DUK__OPCASE(BXOR_RR):
+		DUK__OPCASE(BXOR_CR):
+		DUK__OPCASE(BXOR_RC):
+		DUK__OPCASE(BXOR_CC):
+		DUK__OPCASE(BASL_RR):
+		DUK__OPCASE(BASL_CR):
+		DUK__OPCASE(BASL_RC):
+		DUK__OPCASE(BASL_CC):
+		DUK__OPCASE(BLSR_RR):
+		DUK__OPCASE(BLSR_CR):
+		DUK__OPCASE(BLSR_RC):
+		DUK__OPCASE(BLSR_CC):
+		DUK__OPCASE(BASR_RR):
+		DUK__OPCASE(BASR_CR):
+		DUK__OPCASE(BASR_RC):
+		DUK__OPCASE(BASR_CC): {
 			/* XXX: could leave value on stack top and goto replace_top_a; */
 			duk__vm_bitwise_binary_op(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_BAND_RR: {
+		DUK__OPCASE(BAND_RR): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BAND_CR: {
+		DUK__OPCASE(BAND_CR): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BAND_RC: {
+		DUK__OPCASE(BAND_RC): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BAND_CC: {
+		DUK__OPCASE(BAND_CC): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_RR: {
+		DUK__OPCASE(BOR_RR): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_CR: {
+		DUK__OPCASE(BOR_CR): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_RC: {
+		DUK__OPCASE(BOR_RC): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_CC: {
+		DUK__OPCASE(BOR_CC): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_RR: {
+		DUK__OPCASE(BXOR_RR): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_CR: {
+		DUK__OPCASE(BXOR_CR): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_RC: {
+		DUK__OPCASE(BXOR_RC): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_CC: {
+		DUK__OPCASE(BXOR_CC): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_RR: {
+		DUK__OPCASE(BASL_RR): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_CR: {
+		DUK__OPCASE(BASL_CR): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_RC: {
+		DUK__OPCASE(BASL_RC): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_CC: {
+		DUK__OPCASE(BASL_CC): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_RR: {
+		DUK__OPCASE(BLSR_RR): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_CR: {
+		DUK__OPCASE(BLSR_CR): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_RC: {
+		DUK__OPCASE(BLSR_RC): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_CC: {
+		DUK__OPCASE(BLSR_CC): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_RR: {
+		DUK__OPCASE(BASR_RR): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_CR: {
+		DUK__OPCASE(BASR_CR): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_RC: {
+		DUK__OPCASE(BASR_RC): {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_CC: {
+		DUK__OPCASE(BASR_CC): {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
@@ -75915,104 +80017,104 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_BOOL_A_BREAK(tmp); \
 	}
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_INSTOF_RR:
-		case DUK_OP_INSTOF_CR:
-		case DUK_OP_INSTOF_RC:
-		case DUK_OP_INSTOF_CC:
+		DUK__OPCASE(INSTOF_RR):
+		DUK__OPCASE(INSTOF_CR):
+		DUK__OPCASE(INSTOF_RC):
+		DUK__OPCASE(INSTOF_CC):
 			DUK__INSTOF_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_IN_RR:
-		case DUK_OP_IN_CR:
-		case DUK_OP_IN_RC:
-		case DUK_OP_IN_CC:
+		DUK__OPCASE(IN_RR):
+		DUK__OPCASE(IN_CR):
+		DUK__OPCASE(IN_RC):
+		DUK__OPCASE(IN_CC):
 			DUK__IN_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_INSTOF_RR:
+		DUK__OPCASE(INSTOF_RR):
 			DUK__INSTOF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_INSTOF_CR:
+		DUK__OPCASE(INSTOF_CR):
 			DUK__INSTOF_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_INSTOF_RC:
+		DUK__OPCASE(INSTOF_RC):
 			DUK__INSTOF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_INSTOF_CC:
+		DUK__OPCASE(INSTOF_CC):
 			DUK__INSTOF_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_IN_RR:
+		DUK__OPCASE(IN_RR):
 			DUK__IN_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_IN_CR:
+		DUK__OPCASE(IN_CR):
 			DUK__IN_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_IN_RC:
+		DUK__OPCASE(IN_RC):
 			DUK__IN_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_IN_CC:
+		DUK__OPCASE(IN_CC):
 			DUK__IN_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* Pre/post inc/dec for register variables, important for loops. */
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_PREINCR:
-		case DUK_OP_PREDECR:
-		case DUK_OP_POSTINCR:
-		case DUK_OP_POSTDECR: {
+		DUK__OPCASE(PREINCR):
+		DUK__OPCASE(PREDECR):
+		DUK__OPCASE(POSTINCR):
+		DUK__OPCASE(POSTDECR): {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREINCV:
-		case DUK_OP_PREDECV:
-		case DUK_OP_POSTINCV:
-		case DUK_OP_POSTDECV: {
+		DUK__OPCASE(PREINCV):
+		DUK__OPCASE(PREDECV):
+		DUK__OPCASE(POSTINCV):
+		DUK__OPCASE(POSTDECV): {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), op, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_PREINCR: {
+		DUK__OPCASE(PREINCR): {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_PREINCR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREDECR: {
+		DUK__OPCASE(PREDECR): {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_PREDECR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTINCR: {
+		DUK__OPCASE(POSTINCR): {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_POSTINCR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTDECR: {
+		DUK__OPCASE(POSTDECR): {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_POSTDECR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREINCV: {
+		DUK__OPCASE(PREINCV): {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_PREINCV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREDECV: {
+		DUK__OPCASE(PREDECV): {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_PREDECV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTINCV: {
+		DUK__OPCASE(POSTINCV): {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_POSTINCV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTDECV: {
+		DUK__OPCASE(POSTDECV): {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_POSTDECV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* XXX: Move to separate helper, optimize for perf/size separately. */
 		/* Preinc/predec for object properties. */
-		case DUK_OP_PREINCP_RR:
-		case DUK_OP_PREINCP_CR:
-		case DUK_OP_PREINCP_RC:
-		case DUK_OP_PREINCP_CC:
-		case DUK_OP_PREDECP_RR:
-		case DUK_OP_PREDECP_CR:
-		case DUK_OP_PREDECP_RC:
-		case DUK_OP_PREDECP_CC:
-		case DUK_OP_POSTINCP_RR:
-		case DUK_OP_POSTINCP_CR:
-		case DUK_OP_POSTINCP_RC:
-		case DUK_OP_POSTINCP_CC:
-		case DUK_OP_POSTDECP_RR:
-		case DUK_OP_POSTDECP_CR:
-		case DUK_OP_POSTDECP_RC:
-		case DUK_OP_POSTDECP_CC: {
+		DUK__OPCASE(PREINCP_RR):
+		DUK__OPCASE(PREINCP_CR):
+		DUK__OPCASE(PREINCP_RC):
+		DUK__OPCASE(PREINCP_CC):
+		DUK__OPCASE(PREDECP_RR):
+		DUK__OPCASE(PREDECP_CR):
+		DUK__OPCASE(PREDECP_RC):
+		DUK__OPCASE(PREDECP_CC):
+		DUK__OPCASE(POSTINCP_RR):
+		DUK__OPCASE(POSTINCP_CR):
+		DUK__OPCASE(POSTINCP_RC):
+		DUK__OPCASE(POSTINCP_CC):
+		DUK__OPCASE(POSTDECP_RR):
+		DUK__OPCASE(POSTDECP_CR):
+		DUK__OPCASE(POSTDECP_RC):
+		DUK__OPCASE(POSTDECP_CC): {
 			duk_tval *tv_obj;
 			duk_tval *tv_key;
 			duk_tval *tv_val;
@@ -76074,7 +80176,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #else
 			tv_dst = DUK__REGP_A(ins);
 			DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_dst, z);
-			break;
+			DUK__DISPATCH_NEXT();
 #endif
 		}
 
@@ -76082,17 +80184,45 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * Occurs relatively often in object oriented code.
 		 */
 
+#if defined(DUK_USE_EXEC_PROPCACHE)
+#define DUK__GETPROP_PROPCACHE(barg,carg,callable) { \
+		/* Property cache hit: copy value directly into A, \
+		 * curr_pc identifies the instruction. \
+		 */ \
+		duk_tval *duk__tvval; \
+		duk__tvval = duk__propcache_getprop(thr, (barg), (carg), DUK__PROPCACHE_SLOT(thr, curr_pc)); \
+		if (duk__tvval != NULL && (!(callable) || duk_is_callable_tval(thr, duk__tvval))) { \
+			duk_tval *duk__tvdst; \
+			duk__tvdst = DUK__REGP_A(ins); \
+			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, duk__tvdst, duk__tvval);  /* side effects */ \
+			DUK__DISPATCH_NEXT(); \
+		} \
+	}
+#define DUK__PUTPROP_PROPCACHE(aarg,barg,carg) { \
+		duk_tval *duk__tvval; \
+		duk__tvval = duk__propcache_putprop(thr, (aarg), (barg), DUK__PROPCACHE_SLOT(thr, curr_pc)); \
+		if (duk__tvval != NULL) { \
+			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, duk__tvval, (carg));  /* side effects */ \
+			DUK__DISPATCH_NEXT(); \
+		} \
+	}
+#else
+#define DUK__GETPROP_PROPCACHE(barg,carg,callable)
+#define DUK__PUTPROP_PROPCACHE(aarg,barg,carg)
+#endif
 #define DUK__GETPROP_BODY(barg,carg) { \
 		/* A -> target reg \
 		 * B -> object reg/const (may be const e.g. in "'foo'[1]") \
 		 * C -> key reg/const \
 		 */ \
+		DUK__GETPROP_PROPCACHE((barg), (carg), 0); \
 		(void) duk_hobject_getprop(thr, (barg), (carg)); \
 		DUK__REPLACE_TOP_A_BREAK(); \
 	}
 #define DUK__GETPROPC_BODY(barg,carg) { \
 		/* Same as GETPROP but callability check for property-based calls. */ \
 		duk_tval *tv__targ; \
+		DUK__GETPROP_PROPCACHE((barg), (carg), 1); \
 		(void) duk_hobject_getprop(thr, (barg), (carg)); \
 		DUK_GC_TORTURE(thr->heap); \
 		tv__targ = DUK_GET_TVAL_NEGIDX(thr, -1); \
@@ -76113,8 +80243,9 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * Note: intentional difference to register arrangement \
 		 * of e.g. GETPROP; 'A' must contain a register-only value. \
 		 */ \
+		DUK__PUTPROP_PROPCACHE((aarg), (barg), (carg)); \
 		(void) duk_hobject_putprop(thr, (aarg), (barg), (carg), DUK__STRICT()); \
-		break; \
+		DUK__DISPATCH_NEXT(); \
 	}
 #define DUK__DELPROP_BODY(barg,carg) { \
 		/* A -> result reg \
@@ -76127,64 +80258,64 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_BOOL_A_BREAK(rc); \
 	}
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_GETPROP_RR:
-		case DUK_OP_GETPROP_CR:
-		case DUK_OP_GETPROP_RC:
-		case DUK_OP_GETPROP_CC:
+		DUK__OPCASE(GETPROP_RR):
+		DUK__OPCASE(GETPROP_CR):
+		DUK__OPCASE(GETPROP_RC):
+		DUK__OPCASE(GETPROP_CC):
 			DUK__GETPROP_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #if defined(DUK_USE_VERBOSE_ERRORS)
-		case DUK_OP_GETPROPC_RR:
-		case DUK_OP_GETPROPC_CR:
-		case DUK_OP_GETPROPC_RC:
-		case DUK_OP_GETPROPC_CC:
+		DUK__OPCASE(GETPROPC_RR):
+		DUK__OPCASE(GETPROPC_CR):
+		DUK__OPCASE(GETPROPC_RC):
+		DUK__OPCASE(GETPROPC_CC):
 			DUK__GETPROPC_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #endif
-		case DUK_OP_PUTPROP_RR:
-		case DUK_OP_PUTPROP_CR:
-		case DUK_OP_PUTPROP_RC:
-		case DUK_OP_PUTPROP_CC:
+		DUK__OPCASE(PUTPROP_RR):
+		DUK__OPCASE(PUTPROP_CR):
+		DUK__OPCASE(PUTPROP_RC):
+		DUK__OPCASE(PUTPROP_CC):
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_DELPROP_RR:
-		case DUK_OP_DELPROP_RC:  /* B is always reg */
+		DUK__OPCASE(DELPROP_RR):
+		DUK__OPCASE(DELPROP_RC):  /* B is always reg */
 			DUK__DELPROP_BODY(DUK__REGP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_GETPROP_RR:
+		DUK__OPCASE(GETPROP_RR):
 			DUK__GETPROP_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROP_CR:
+		DUK__OPCASE(GETPROP_CR):
 			DUK__GETPROP_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROP_RC:
+		DUK__OPCASE(GETPROP_RC):
 			DUK__GETPROP_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GETPROP_CC:
+		DUK__OPCASE(GETPROP_CC):
 			DUK__GETPROP_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #if defined(DUK_USE_VERBOSE_ERRORS)
-		case DUK_OP_GETPROPC_RR:
+		DUK__OPCASE(GETPROPC_RR):
 			DUK__GETPROPC_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROPC_CR:
+		DUK__OPCASE(GETPROPC_CR):
 			DUK__GETPROPC_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROPC_RC:
+		DUK__OPCASE(GETPROPC_RC):
 			DUK__GETPROPC_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GETPROPC_CC:
+		DUK__OPCASE(GETPROPC_CC):
 			DUK__GETPROPC_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif
-		case DUK_OP_PUTPROP_RR:
+		DUK__OPCASE(PUTPROP_RR):
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_PUTPROP_CR:
+		DUK__OPCASE(PUTPROP_CR):
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_PUTPROP_RC:
+		DUK__OPCASE(PUTPROP_RC):
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_PUTPROP_CC:
+		DUK__OPCASE(PUTPROP_CC):
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_DELPROP_RR:  /* B is always reg */
+		DUK__OPCASE(DELPROP_RR):  /* B is always reg */
 			DUK__DELPROP_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_DELPROP_RC:
+		DUK__OPCASE(DELPROP_RC):
 			DUK__DELPROP_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* No fast path for DECLVAR now, it's quite a rare instruction. */
-		case DUK_OP_DECLVAR_RR:
-		case DUK_OP_DECLVAR_CR:
-		case DUK_OP_DECLVAR_RC:
-		case DUK_OP_DECLVAR_CC: {
+		DUK__OPCASE(DECLVAR_RR):
+		DUK__OPCASE(DECLVAR_CR):
+		DUK__OPCASE(DECLVAR_RC):
+		DUK__OPCASE(DECLVAR_CC): {
 			duk_activation *act;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_tval *tv1;
@@ -76230,17 +80361,17 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			}
 
 			duk_pop_unsafe(thr);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_REGEXP_SUPPORT)
 		/* The compiler should never emit DUK_OP_REGEXP if there is no
 		 * regexp support.
 		 */
-		case DUK_OP_REGEXP_RR:
-		case DUK_OP_REGEXP_CR:
-		case DUK_OP_REGEXP_RC:
-		case DUK_OP_REGEXP_CC: {
+		DUK__OPCASE(REGEXP_RR):
+		DUK__OPCASE(REGEXP_CR):
+		DUK__OPCASE(REGEXP_RC):
+		DUK__OPCASE(REGEXP_CC): {
 			/* A -> target register
 			 * B -> bytecode (also contains flags)
 			 * C -> escaped source
@@ -76254,10 +80385,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #endif  /* DUK_USE_REGEXP_SUPPORT */
 
 		/* XXX: 'c' is unused, use whole BC, etc. */
-		case DUK_OP_CSVAR_RR:
-		case DUK_OP_CSVAR_CR:
-		case DUK_OP_CSVAR_RC:
-		case DUK_OP_CSVAR_CC: {
+		DUK__OPCASE(CSVAR_RR):
+		DUK__OPCASE(CSVAR_CR):
+		DUK__OPCASE(CSVAR_RC):
+		DUK__OPCASE(CSVAR_CC): {
 			/* The speciality of calling through a variable binding is that the
 			 * 'this' value may be provided by the variable lookup: E5 Section 6.b.i.
 			 *
@@ -76287,10 +80418,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			/* Could add direct value stack handling. */
 			duk_replace(thr, (duk_idx_t) (idx + 1));  /* 'this' binding */
 			duk_replace(thr, (duk_idx_t) idx);        /* variable value (function, we hope, not checked here) */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_CLOSURE: {
+		DUK__OPCASE(CLOSURE): {
 			duk_activation *act;
 			duk_hcompfunc *fun_act;
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
@@ -76335,7 +80466,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 
-		case DUK_OP_GETVAR: {
+		DUK__OPCASE(GETVAR): {
 			duk_activation *act;
 			duk_tval *tv1;
 			duk_hstring *name;
@@ -76351,7 +80482,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 
-		case DUK_OP_PUTVAR: {
+		DUK__OPCASE(PUTVAR): {
 			duk_activation *act;
 			duk_tval *tv1;
 			duk_hstring *name;
@@ -76368,10 +80499,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			tv1 = DUK__REGP_A(ins);  /* val */
 			act = thr->callstack_curr;
 			duk_js_putvar_activation(thr, act, name, tv1, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_DELVAR: {
+		DUK__OPCASE(DELVAR): {
 			duk_activation *act;
 			duk_tval *tv1;
 			duk_hstring *name;
@@ -76386,13 +80517,13 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_BOOL_A_BREAK(rc);
 		}
 
-		case DUK_OP_JUMP: {
+		DUK__OPCASE(JUMP): {
 			/* Note: without explicit cast to signed, MSVC will
 			 * apparently generate a large positive jump when the
 			 * bias-corrected value would normally be negative.
 			 */
 			curr_pc += (duk_int_fast_t) DUK_DEC_ABC(ins) - (duk_int_fast_t) DUK_BC_JUMP_BIAS;
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #define DUK__RETURN_SHARED() do { \
@@ -76410,10 +80541,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		return; \
 	} while (0)
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_RETREG:
-		case DUK_OP_RETCONST:
-		case DUK_OP_RETCONSTN:
-		case DUK_OP_RETUNDEF: {
+		DUK__OPCASE(RETREG):
+		DUK__OPCASE(RETCONST):
+		DUK__OPCASE(RETCONSTN):
+		DUK__OPCASE(RETUNDEF): {
 			 /* BC -> return value reg/const */
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -76431,7 +80562,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__RETURN_SHARED();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_RETREG: {
+		DUK__OPCASE(RETREG): {
 			duk_tval *tv;
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -76442,7 +80573,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__RETURN_SHARED();
 		}
 		/* This will be unused without refcounting. */
-		case DUK_OP_RETCONST: {
+		DUK__OPCASE(RETCONST): {
 			duk_tval *tv;
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -76452,7 +80583,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			thr->valstack_top++;
 			DUK__RETURN_SHARED();
 		}
-		case DUK_OP_RETCONSTN: {
+		DUK__OPCASE(RETCONSTN): {
 			duk_tval *tv;
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -76465,7 +80596,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			thr->valstack_top++;
 			DUK__RETURN_SHARED();
 		}
-		case DUK_OP_RETUNDEF: {
+		DUK__OPCASE(RETUNDEF): {
 			DUK__SYNC_AND_NULL_CURR_PC();
 			thr->valstack_top++;  /* value at valstack top is already undefined by valstack policy */
 			DUK_ASSERT(DUK_TVAL_IS_UNDEFINED(thr->valstack_top));
@@ -76473,7 +80604,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
-		case DUK_OP_LABEL: {
+		DUK__OPCASE(LABEL): {
 			duk_activation *act;
 			duk_catcher *cat;
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
@@ -76499,10 +80630,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			                     (long) cat->idx_base, (duk_heaphdr *) cat->h_varname, (long) DUK_CAT_GET_LABEL(cat)));
 
 			curr_pc += 2;  /* skip jump slots */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDLABEL: {
+		DUK__OPCASE(ENDLABEL): {
 			duk_activation *act;
 #if (defined(DUK_USE_DEBUG_LEVEL) && (DUK_USE_DEBUG_LEVEL >= 2)) || defined(DUK_USE_ASSERTIONS)
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
@@ -76518,10 +80649,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			duk_hthread_catcher_unwind_nolexenv_norz(thr, act);
 
 			/* no need to unwind callstack */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_BREAK: {
+		DUK__OPCASE(BREAK): {
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -76529,7 +80660,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			goto restart_execution;
 		}
 
-		case DUK_OP_CONTINUE: {
+		DUK__OPCASE(CONTINUE): {
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -76538,23 +80669,23 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		}
 
 		/* XXX: move to helper, too large to be inline here */
-		case DUK_OP_TRYCATCH: {
+		DUK__OPCASE(TRYCATCH): {
 			duk__handle_op_trycatch(thr, ins, curr_pc);
 			curr_pc += 2;  /* skip jump slots */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDTRY: {
+		DUK__OPCASE(ENDTRY): {
 			curr_pc = duk__handle_op_endtry(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDCATCH: {
+		DUK__OPCASE(ENDCATCH): {
 			duk__handle_op_endcatch(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDFIN: {
+		DUK__OPCASE(ENDFIN): {
 			/* Sync and NULL early. */
 			DUK__SYNC_AND_NULL_CURR_PC();
 
@@ -76566,7 +80697,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			goto restart_execution;
 		}
 
-		case DUK_OP_THROW: {
+		DUK__OPCASE(THROW): {
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
 
 			/* Note: errors are augmented when they are created, not
@@ -76597,10 +80728,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK_ASSERT(thr->heap->lj.jmpbuf_ptr != NULL);  /* always in executor */
 			duk_err_longjmp(thr);
 			DUK_UNREACHABLE();
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_CSREG: {
+		DUK__OPCASE(CSREG): {
 			/*
 			 *  Assuming a register binds to a variable declared within this
 			 *  function (a declarative binding), the 'this' for the call
@@ -76636,7 +80767,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK_TVAL_DECREF(thr, &tv_tmp1);
 			DUK_TVAL_DECREF(thr, &tv_tmp2);
 #endif
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 
@@ -76646,14 +80777,14 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * stack resize would be large).
 		 */
 
-		case DUK_OP_CALL0:
-		case DUK_OP_CALL1:
-		case DUK_OP_CALL2:
-		case DUK_OP_CALL3:
-		case DUK_OP_CALL4:
-		case DUK_OP_CALL5:
-		case DUK_OP_CALL6:
-		case DUK_OP_CALL7: {
+		DUK__OPCASE(CALL0):
+		DUK__OPCASE(CALL1):
+		DUK__OPCASE(CALL2):
+		DUK__OPCASE(CALL3):
+		DUK__OPCASE(CALL4):
+		DUK__OPCASE(CALL5):
+		DUK__OPCASE(CALL6):
+		DUK__OPCASE(CALL7): {
 			/* Opcode packs 4 flag bits: 1 for indirect, 3 map
 			 * 1:1 to three lowest call handling flags.
 			 *
@@ -76697,17 +80828,17 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			 * status after returning.  This is now handled by call handling
 			 * and heap->dbg_force_restart.
 			 */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_CALL8:
-		case DUK_OP_CALL9:
-		case DUK_OP_CALL10:
-		case DUK_OP_CALL11:
-		case DUK_OP_CALL12:
-		case DUK_OP_CALL13:
-		case DUK_OP_CALL14:
-		case DUK_OP_CALL15: {
+		DUK__OPCASE(CALL8):
+		DUK__OPCASE(CALL9):
+		DUK__OPCASE(CALL10):
+		DUK__OPCASE(CALL11):
+		DUK__OPCASE(CALL12):
+		DUK__OPCASE(CALL13):
+		DUK__OPCASE(CALL14):
+		DUK__OPCASE(CALL15): {
 			/* Indirect variant. */
 			duk_uint_fast_t nargs;
 			duk_idx_t idx;
@@ -76734,10 +80865,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			fun = DUK__FUN();
 #endif
 			duk_set_top_unsafe(thr, (duk_idx_t) fun->nregs);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_NEWOBJ: {
+		DUK__OPCASE(NEWOBJ): {
 			duk_push_object(thr);
 #if defined(DUK_USE_ASSERTIONS)
 			{
@@ -76756,7 +80887,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
 
-		case DUK_OP_NEWARR: {
+		DUK__OPCASE(NEWARR): {
 			duk_push_array(thr);
 #if defined(DUK_USE_ASSERTIONS)
 			{
@@ -76783,8 +80914,8 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
 
-		case DUK_OP_MPUTOBJ:
-		case DUK_OP_MPUTOBJI: {
+		DUK__OPCASE(MPUTOBJ):
+		DUK__OPCASE(MPUTOBJI): {
 			duk_idx_t obj_idx;
 			duk_uint_fast_t idx, idx_end;
 			duk_small_uint_fast_t count;
@@ -76836,17 +80967,17 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 				                           DUK_DEFPROP_SET_CONFIGURABLE);
 				idx += 2;
 			} while (idx < idx_end);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INITSET:
-		case DUK_OP_INITGET: {
+		DUK__OPCASE(INITSET):
+		DUK__OPCASE(INITGET): {
 			duk__handle_op_initset_initget(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_MPUTARR:
-		case DUK_OP_MPUTARRI: {
+		DUK__OPCASE(MPUTARR):
+		DUK__OPCASE(MPUTARRI): {
 			duk_idx_t obj_idx;
 			duk_uint_fast_t idx, idx_end;
 			duk_small_uint_fast_t count;
@@ -76914,10 +81045,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			 * 'arr_idx' type.
 			 */
 			duk_set_length(thr, obj_idx, (duk_size_t) (duk_uarridx_t) arr_idx);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_SETALEN: {
+		DUK__OPCASE(SETALEN): {
 			duk_tval *tv1;
 			duk_hobject *h;
 			duk_uint32_t len;
@@ -76936,26 +81067,26 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			len = (duk_uint32_t) DUK_TVAL_GET_NUMBER(tv1);
 #endif
 			((duk_harray *) h)->length = len;
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INITENUM: {
+		DUK__OPCASE(INITENUM): {
 			duk__handle_op_initenum(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_NEXTENUM: {
+		DUK__OPCASE(NEXTENUM): {
 			curr_pc += duk__handle_op_nextenum(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INVLHS: {
+		DUK__OPCASE(INVLHS): {
 			DUK_ERROR_REFERENCE(thr, DUK_STR_INVALID_LVALUE);
 			DUK_UNREACHABLE();
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_DEBUGGER: {
+		DUK__OPCASE(DEBUGGER): {
 			/* Opcode only emitted by compiler when debugger
 			 * support is enabled.  Ignore it silently without
 			 * debugger support, in case it has been loaded
@@ -76974,23 +81105,23 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #else
 			DUK_D(DUK_DPRINT("DEBUGGER statement ignored, no debugger support"));
 #endif
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_NOP: {
+		DUK__OPCASE(NOP): {
 			/* Nop, ignored, but ABC fields may carry a value e.g.
 			 * for indirect opcode handling.
 			 */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INVALID: {
+		DUK__OPCASE(INVALID): {
 			DUK_ERROR_FMT1(thr, DUK_ERR_ERROR, "INVALID opcode (%ld)", (long) DUK_DEC_ABC(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_ES6)
-		case DUK_OP_NEWTARGET: {
+		DUK__OPCASE(NEWTARGET): {
 			/* https://www.ecma-international.org/ecma-262/6.0/#sec-meta-properties-runtime-semantics-evaluation
 			 * https://www.ecma-international.org/ecma-262/6.0/#sec-getnewtarget
 			 *
@@ -77031,65 +81162,71 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 
 #if !defined(DUK_USE_EXEC_PREFER_SIZE)
 #if !defined(DUK_USE_ES7_EXP_OPERATOR)
-		case DUK_OP_EXP_RR:
-		case DUK_OP_EXP_CR:
-		case DUK_OP_EXP_RC:
-		case DUK_OP_EXP_CC:
+		DUK__OPCASE(EXP_RR):
+		DUK__OPCASE(EXP_CR):
+		DUK__OPCASE(EXP_RC):
+		DUK__OPCASE(EXP_CC):
 #endif
 #if !defined(DUK_USE_ES6)
-		case DUK_OP_NEWTARGET:
+		DUK__OPCASE(NEWTARGET):
 #endif
 #if !defined(DUK_USE_VERBOSE_ERRORS)
-		case DUK_OP_GETPROPC_RR:
-		case DUK_OP_GETPROPC_CR:
-		case DUK_OP_GETPROPC_RC:
-		case DUK_OP_GETPROPC_CC:
-#endif
-		case DUK_OP_UNUSED207:
-		case DUK_OP_UNUSED212:
-		case DUK_OP_UNUSED213:
-		case DUK_OP_UNUSED214:
-		case DUK_OP_UNUSED215:
-		case DUK_OP_UNUSED216:
-		case DUK_OP_UNUSED217:
-		case DUK_OP_UNUSED218:
-		case DUK_OP_UNUSED219:
-		case DUK_OP_UNUSED220:
-		case DUK_OP_UNUSED221:
-		case DUK_OP_UNUSED222:
-		case DUK_OP_UNUSED223:
-		case DUK_OP_UNUSED224:
-		case DUK_OP_UNUSED225:
-		case DUK_OP_UNUSED226:
-		case DUK_OP_UNUSED227:
-		case DUK_OP_UNUSED228:
-		case DUK_OP_UNUSED229:
-		case DUK_OP_UNUSED230:
-		case DUK_OP_UNUSED231:
-		case DUK_OP_UNUSED232:
-		case DUK_OP_UNUSED233:
-		case DUK_OP_UNUSED234:
-		case DUK_OP_UNUSED235:
-		case DUK_OP_UNUSED236:
-		case DUK_OP_UNUSED237:
-		case DUK_OP_UNUSED238:
-		case DUK_OP_UNUSED239:
-		case DUK_OP_UNUSED240:
-		case DUK_OP_UNUSED241:
-		case DUK_OP_UNUSED242:
-		case DUK_OP_UNUSED243:
-		case DUK_OP_UNUSED244:
-		case DUK_OP_UNUSED245:
-		case DUK_OP_UNUSED246:
-		case DUK_OP_UNUSED247:
-		case DUK_OP_UNUSED248:
-		case DUK_OP_UNUSED249:
-		case DUK_OP_UNUSED250:
-		case DUK_OP_UNUSED251:
-		case DUK_OP_UNUSED252:
-		case DUK_OP_UNUSED253:
-		case DUK_OP_UNUSED254:
-		case DUK_OP_UNUSED255:
+		DUK__OPCASE(GETPROPC_RR):
+		DUK__OPCASE(GETPROPC_CR):
+		DUK__OPCASE(GETPROPC_RC):
+		DUK__OPCASE(GETPROPC_CC):
+#endif
+		DUK__OPCASE(DELPROP_CR_UNUSED):
+		DUK__OPCASE(DELPROP_CC_UNUSED):
+		DUK__OPCASE(UNUSED207):
+#if !defined(DUK_USE_EXEC_SUPERINSTRUCTIONS)
+		DUK__OPCASE(EQ_IFTRUE_RR):
+		DUK__OPCASE(EQ_IFTRUE_RC):
+		DUK__OPCASE(EQ_IFFALSE_RR):
+		DUK__OPCASE(EQ_IFFALSE_RC):
+		DUK__OPCASE(NEQ_IFTRUE_RR):
+		DUK__OPCASE(NEQ_IFTRUE_RC):
+		DUK__OPCASE(NEQ_IFFALSE_RR):
+		DUK__OPCASE(NEQ_IFFALSE_RC):
+		DUK__OPCASE(SEQ_IFTRUE_RR):
+		DUK__OPCASE(SEQ_IFTRUE_RC):
+		DUK__OPCASE(SEQ_IFFALSE_RR):
+		DUK__OPCASE(SEQ_IFFALSE_RC):
+		DUK__OPCASE(SNEQ_IFTRUE_RR):
+		DUK__OPCASE(SNEQ_IFTRUE_RC):
+		DUK__OPCASE(SNEQ_IFFALSE_RR):
+		DUK__OPCASE(SNEQ_IFFALSE_RC):
+		DUK__OPCASE(GT_IFTRUE_RR):
+		DUK__OPCASE(GT_IFTRUE_RC):
+		DUK__OPCASE(GT_IFFALSE_RR):
+		DUK__OPCASE(GT_IFFALSE_RC):
+		DUK__OPCASE(GE_IFTRUE_RR):
+		DUK__OPCASE(GE_IFTRUE_RC):
+		DUK__OPCASE(GE_IFFALSE_RR):
+		DUK__OPCASE(GE_IFFALSE_RC):
+		DUK__OPCASE(LT_IFTRUE_RR):
+		DUK__OPCASE(LT_IFTRUE_RC):
+		DUK__OPCASE(LT_IFFALSE_RR):
+		DUK__OPCASE(LT_IFFALSE_RC):
+		DUK__OPCASE(LE_IFTRUE_RR):
+		DUK__OPCASE(LE_IFTRUE_RC):
+		DUK__OPCASE(LE_IFFALSE_RR):
+		DUK__OPCASE(LE_IFFALSE_RC):
+#endif
+#if !defined(DUK_USE_CONCAT_INPLACE)
+		DUK__OPCASE(ADDASN_RR):
+		DUK__OPCASE(ADDASN_CR):
+		DUK__OPCASE(ADDASN_RC):
+		DUK__OPCASE(ADDASN_CC):
+#endif
+		DUK__OPCASE(UNUSED248):
+		DUK__OPCASE(UNUSED249):
+		DUK__OPCASE(UNUSED250):
+		DUK__OPCASE(UNUSED251):
+		DUK__OPCASE(UNUSED252):
+		DUK__OPCASE(UNUSED253):
+		DUK__OPCASE(UNUSED254):
+		DUK__OPCASE(UNUSED255):
 		/* Force all case clauses to map to an actual handler
 		 * so that the compiler can emit a jump without a bounds
 		 * check: the switch argument is a duk_uint8_t so that
@@ -77104,7 +81241,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			/* Default case catches invalid/unsupported opcodes. */
 			DUK_D(DUK_DPRINT("invalid opcode: %ld - %!I", (long) op, ins));
 			DUK__INTERNAL_ERROR("invalid opcode");
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 		}  /* end switch */
@@ -77139,6 +81276,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #undef DUK__BYTEOFF_B
 #undef DUK__BYTEOFF_BC
 #undef DUK__BYTEOFF_C
+#undef DUK__CMPIF_BODY
 #undef DUK__COMPARE_BODY
 #undef DUK__CONST
 #undef DUK__CONSTP
@@ -77147,12 +81285,19 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #undef DUK__CONSTP_BC
 #undef DUK__CONSTP_C
 #undef DUK__DELPROP_BODY
+#undef DUK__DISPATCH_INTERRUPT_CHECK
+#undef DUK__DISPATCH_NEXT
 #undef DUK__EQ_BODY
+#undef DUK__EQ_IF_BODY
+#undef DUK__EXEC_COMPUTED_GOTO
 #undef DUK__FUN
 #undef DUK__GETPROPC_BODY
 #undef DUK__GETPROP_BODY
+#undef DUK__GETPROP_PROPCACHE
 #undef DUK__GE_BODY
+#undef DUK__GE_IF_BODY
 #undef DUK__GT_BODY
+#undef DUK__GT_IF_BODY
 #undef DUK__INLINE_PERF
 #undef DUK__INSTOF_BODY
 #undef DUK__INTERNAL_ERROR
@@ -77160,17 +81305,23 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #undef DUK__INT_RESTART
 #undef DUK__IN_BODY
 #undef DUK__LE_BODY
+#undef DUK__LE_IF_BODY
 #undef DUK__LONGJMP_RESTART
 #undef DUK__LONGJMP_RETHROW
 #undef DUK__LOOKUP_INDIRECT
 #undef DUK__LT_BODY
+#undef DUK__LT_IF_BODY
 #undef DUK__MASK_A
 #undef DUK__MASK_B
 #undef DUK__MASK_BC
 #undef DUK__MASK_C
 #undef DUK__NEQ_BODY
+#undef DUK__NEQ_IF_BODY
 #undef DUK__NOINLINE_PERF
+#undef DUK__OPCASE
+#undef DUK__PROPCACHE_SLOT
 #undef DUK__PUTPROP_BODY
+#undef DUK__PUTPROP_PROPCACHE
 #undef DUK__RCBIT_B
 #undef DUK__RCBIT_C
 #undef DUK__REG
@@ -77189,11 +81340,13 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #undef DUK__RETHAND_RESTART
 #undef DUK__RETURN_SHARED
 #undef DUK__SEQ_BODY
+#undef DUK__SEQ_IF_BODY
 #undef DUK__SHIFT_A
 #undef DUK__SHIFT_B
 #undef DUK__SHIFT_BC
 #undef DUK__SHIFT_C
 #undef DUK__SNEQ_BODY
+#undef DUK__SNEQ_IF_BODY
 #undef DUK__STRICT
 #undef DUK__SYNC_AND_NULL_CURR_PC
 #undef DUK__SYNC_CURR_PC
@@ -82886,6 +87039,14 @@ DUK_LOCAL const duk_uint8_t duk__str2num_digits_for_radix[] = {
 	14, 14, 14, 14, 14                         /* 31 to 36 */
 };
 
+#if defined(DUK_USE_NUMCONV_FAST)
+/* Powers of ten which are exact as doubles, for string-to-number fast path. */
+DUK_LOCAL const duk_double_t duk__str2num_pow10_exact[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
 typedef struct {
 	duk_int16_t upper;
 	duk_int16_t lower;
@@ -84378,6 +88539,283 @@ DUK_LOCAL void duk__dragon4_ctx_to_double(duk__numconv_stringify_ctx *nc_ctx, du
 	*x = DUK_DBLUNION_GET_DOUBLE(&u);
 }
 
+/*
+ *  Grisu3 number-to-string fast path
+ *
+ *  Generates the shortest round tripping digits of a double using 64-bit
+ *  integer arithmetic and a table of cached powers of ten.  Grisu3 detects
+ *  the rare inputs (about 0.5%) for which it can't prove its result is the
+ *  shortest correct one, and those go through Dragon4.  Only used for plain
+ *  radix 10 ToString(), other formatting always goes through Dragon4.
+ *
+ *  See: Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+ *  Accurately with Integers", PLDI 2010.
+ */
+
+#if defined(DUK_USE_NUMCONV_FAST)
+
+#define DUK__GRISU_POW10_K_MIN      (-348)  /* decimal exponent of first cached power */
+#define DUK__GRISU_POW10_K_STEP     8
+#define DUK__GRISU_ALPHA            (-60)   /* target binary exponent range */
+#define DUK__GRISU_GAMMA            (-32)
+
+typedef struct {
+	duk_uint64_t f;
+	duk_int_t e;
+} duk__diyfp;
+
+/* Normalized 64-bit significands (rounded to nearest) and binary exponents
+ * of 10^k for k = -348, -340, ..., 340.
+ */
+DUK_LOCAL const duk_uint64_t duk__grisu_pow10_f[87] = {
+	DUK_U64_CONSTANT(0xfa8fd5a0081c0288), DUK_U64_CONSTANT(0xbaaee17fa23ebf76), DUK_U64_CONSTANT(0x8b16fb203055ac76),
+	DUK_U64_CONSTANT(0xcf42894a5dce35ea), DUK_U64_CONSTANT(0x9a6bb0aa55653b2d), DUK_U64_CONSTANT(0xe61acf033d1a45df),
+	DUK_U64_CONSTANT(0xab70fe17c79ac6ca), DUK_U64_CONSTANT(0xff77b1fcbebcdc4f), DUK_U64_CONSTANT(0xbe5691ef416bd60c),
+	DUK_U64_CONSTANT(0x8dd01fad907ffc3c), DUK_U64_CONSTANT(0xd3515c2831559a83), DUK_U64_CONSTANT(0x9d71ac8fada6c9b5),
+	DUK_U64_CONSTANT(0xea9c227723ee8bcb), DUK_U64_CONSTANT(0xaecc49914078536d), DUK_U64_CONSTANT(0x823c12795db6ce57),
+	DUK_U64_CONSTANT(0xc21094364dfb5637), DUK_U64_CONSTANT(0x9096ea6f3848984f), DUK_U64_CONSTANT(0xd77485cb25823ac7),
+	DUK_U64_CONSTANT(0xa086cfcd97bf97f4), DUK_U64_CONSTANT(0xef340a98172aace5), DUK_U64_CONSTANT(0xb23867fb2a35b28e),
+	DUK_U64_CONSTANT(0x84c8d4dfd2c63f3b), DUK_U64_CONSTANT(0xc5dd44271ad3cdba), DUK_U64_CONSTANT(0x936b9fcebb25c996),
+	DUK_U64_CONSTANT(0xdbac6c247d62a584), DUK_U64_CONSTANT(0xa3ab66580d5fdaf6), DUK_U64_CONSTANT(0xf3e2f893dec3f126),
+	DUK_U64_CONSTANT(0xb5b5ada8aaff80b8), DUK_U64_CONSTANT(0x87625f056c7c4a8b), DUK_U64_CONSTANT(0xc9bcff6034c13053),
+	DUK_U64_CONSTANT(0x964e858c91ba2655), DUK_U64_CONSTANT(0xdff9772470297ebd), DUK_U64_CONSTANT(0xa6dfbd9fb8e5b88f),
+	DUK_U64_CONSTANT(0xf8a95fcf88747d94), DUK_U64_CONSTANT(0xb94470938fa89bcf), DUK_U64_CONSTANT(0x8a08f0f8bf0f156b),
+	DUK_U64_CONSTANT(0xcdb02555653131b6), DUK_U64_CONSTANT(0x993fe2c6d07b7fac), DUK_U64_CONSTANT(0xe45c10c42a2b3b06),
+	DUK_U64_CONSTANT(0xaa242499697392d3), DUK_U64_CONSTANT(0xfd87b5f28300ca0e), DUK_U64_CONSTANT(0xbce5086492111aeb),
+	DUK_U64_CONSTANT(0x8cbccc096f5088cc), DUK_U64_CONSTANT(0xd1b71758e219652c), DUK_U64_CONSTANT(0x9c40000000000000),
+	DUK_U64_CONSTANT(0xe8d4a51000000000), DUK_U64_CONSTANT(0xad78ebc5ac620000), DUK_U64_CONSTANT(0x813f3978f8940984),
+	DUK_U64_CONSTANT(0xc097ce7bc90715b3), DUK_U64_CONSTANT(0x8f7e32ce7bea5c70), DUK_U64_CONSTANT(0xd5d238a4abe98068),
+	DUK_U64_CONSTANT(0x9f4f2726179a2245), DUK_U64_CONSTANT(0xed63a231d4c4fb27), DUK_U64_CONSTANT(0xb0de65388cc8ada8),
+	DUK_U64_CONSTANT(0x83c7088e1aab65db), DUK_U64_CONSTANT(0xc45d1df942711d9a), DUK_U64_CONSTANT(0x924d692ca61be758),
+	DUK_U64_CONSTANT(0xda01ee641a708dea), DUK_U64_CONSTANT(0xa26da3999aef774a), DUK_U64_CONSTANT(0xf209787bb47d6b85),
+	DUK_U64_CONSTANT(0xb454e4a179dd1877), DUK_U64_CONSTANT(0x865b86925b9bc5c2), DUK_U64_CONSTANT(0xc83553c5c8965d3d),
+	DUK_U64_CONSTANT(0x952ab45cfa97a0b3), DUK_U64_CONSTANT(0xde469fbd99a05fe3), DUK_U64_CONSTANT(0xa59bc234db398c25),
+	DUK_U64_CONSTANT(0xf6c69a72a3989f5c), DUK_U64_CONSTANT(0xb7dcbf5354e9bece), DUK_U64_CONSTANT(0x88fcf317f22241e2),
+	DUK_U64_CONSTANT(0xcc20ce9bd35c78a5), DUK_U64_CONSTANT(0x98165af37b2153df), DUK_U64_CONSTANT(0xe2a0b5dc971f303a),
+	DUK_U64_CONSTANT(0xa8d9d1535ce3b396), DUK_U64_CONSTANT(0xfb9b7cd9a4a7443c), DUK_U64_CONSTANT(0xbb764c4ca7a44410),
+	DUK_U64_CONSTANT(0x8bab8eefb6409c1a), DUK_U64_CONSTANT(0xd01fef10a657842c), DUK_U64_CONSTANT(0x9b10a4e5e9913129),
+	DUK_U64_CONSTANT(0xe7109bfba19c0c9d), DUK_U64_CONSTANT(0xac2820d9623bf429), DUK_U64_CONSTANT(0x80444b5e7aa7cf85),
+	DUK_U64_CONSTANT(0xbf21e44003acdd2d), DUK_U64_CONSTANT(0x8e679c2f5e44ff8f), DUK_U64_CONSTANT(0xd433179d9c8cb841),
+	DUK_U64_CONSTANT(0x9e19db92b4e31ba9), DUK_U64_CONSTANT(0xeb96bf6ebadf77d9), DUK_U64_CONSTANT(0xaf87023b9bf0ee6b)
+};
+DUK_LOCAL const duk_int16_t duk__grisu_pow10_e[87] = {
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+	-901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+	-582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+	-263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+	56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+	375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+	694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+	1013, 1039, 1066
+};
+
+DUK_LOCAL duk__diyfp duk__diyfp_normalize(duk_uint64_t f, duk_int_t e) {
+	duk__diyfp res;
+
+	DUK_ASSERT(f != 0);
+	while ((f & DUK_U64_CONSTANT(0xffc0000000000000)) == 0) {
+		f <<= 10;
+		e -= 10;
+	}
+	while ((f & DUK_U64_CONSTANT(0x8000000000000000)) == 0) {
+		f <<= 1;
+		e--;
+	}
+	res.f = f;
+	res.e = e;
+	return res;
+}
+
+/* Product rounded to 64 bits. */
+DUK_LOCAL duk__diyfp duk__diyfp_mul(duk__diyfp x, duk__diyfp y) {
+	duk__diyfp res;
+	duk_uint64_t a, b, c, d;
+	duk_uint64_t ac, bc, ad, bd;
+	duk_uint64_t tmp;
+
+	a = x.f >> 32;
+	b = x.f & DUK_U64_CONSTANT(0xffffffff);
+	c = y.f >> 32;
+	d = y.f & DUK_U64_CONSTANT(0xffffffff);
+	ac = a * c;
+	bc = b * c;
+	ad = a * d;
+	bd = b * d;
+	tmp = (bd >> 32) + (ad & DUK_U64_CONSTANT(0xffffffff)) + (bc & DUK_U64_CONSTANT(0xffffffff));
+	tmp += DUK_U64_CONSTANT(0x80000000);  /* round */
+	res.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	res.e = x.e + y.e + 64;
+	return res;
+}
+
+/* Move the last generated digit towards 'w' while staying inside the safe
+ * interval, and check that the result is provably the closest one.
+ */
+DUK_LOCAL duk_bool_t duk__grisu_round_weed(duk_uint8_t *digits,
+                                           duk_small_int_t count,
+                                           duk_uint64_t dist_high_w,
+                                           duk_uint64_t unsafe_interval,
+                                           duk_uint64_t rest,
+                                           duk_uint64_t ten_kappa,
+                                           duk_uint64_t unit) {
+	duk_uint64_t small_dist = dist_high_w - unit;
+	duk_uint64_t big_dist = dist_high_w + unit;
+
+	while (rest < small_dist &&
+	       unsafe_interval - rest >= ten_kappa &&
+	       (rest + ten_kappa < small_dist ||
+	        small_dist - rest >= rest + ten_kappa - small_dist)) {
+		digits[count - 1]--;
+		rest += ten_kappa;
+	}
+
+	if (rest < big_dist &&
+	    unsafe_interval - rest >= ten_kappa &&
+	    (rest + ten_kappa < big_dist ||
+	     big_dist - rest > rest + ten_kappa - big_dist)) {
+		return 0;
+	}
+
+	return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+}
+
+/* Fills nc_ctx->digits, nc_ctx->count and nc_ctx->k (as Dragon4 would) for
+ * a finite 'x' > 0.  Returns 0 if the result couldn't be verified.
+ */
+DUK_LOCAL duk_bool_t duk__grisu3(duk__numconv_stringify_ctx *nc_ctx, duk_double_t x) {
+	duk_double_union u;
+	duk_uint32_t hi;
+	duk_uint64_t f;
+	duk_int_t e;
+	duk_int_t be;
+	duk_int_t kd;
+	duk_int_t idx;
+	duk_int_t mk;
+	duk_small_int_t kappa;
+	duk_small_int_t count;
+	duk__diyfp w, m_plus, m_minus, c;
+	duk__diyfp too_low, too_high;
+	duk_uint64_t unsafe_interval;
+	duk_uint64_t one_f;
+	duk_small_int_t one_shift;
+	duk_uint32_t integrals;
+	duk_uint32_t divisor;
+	duk_uint64_t fractionals;
+	duk_uint64_t unit;
+	duk_uint64_t rest;
+	duk_bool_t ok;
+
+	DUK_DBLUNION_SET_DOUBLE(&u, x);
+	hi = DUK_DBLUNION_GET_HIGH32(&u);
+	f = (((duk_uint64_t) (hi & 0x000fffffUL)) << 32) | (duk_uint64_t) DUK_DBLUNION_GET_LOW32(&u);
+	be = (duk_int_t) ((hi >> 20) & 0x07ffUL);
+	if (be == 0) {
+		e = DUK__IEEE_DOUBLE_EXP_MIN - 52;  /* denormal */
+	} else {
+		f |= DUK_U64_CONSTANT(0x0010000000000000);
+		e = be - DUK__IEEE_DOUBLE_EXP_BIAS - 52;
+	}
+	DUK_ASSERT(f != 0);
+
+	/* Boundaries m- and m+ halfway to the neighbouring doubles; the lower
+	 * one is closer when 'x' is a power of two (except the smallest normal).
+	 */
+	w = duk__diyfp_normalize(f, e);
+	m_plus = duk__diyfp_normalize((f << 1) + 1, e - 1);
+	if (be > 1 && f == DUK_U64_CONSTANT(0x0010000000000000)) {
+		m_minus.f = (f << 2) - 1;
+		m_minus.e = e - 2;
+	} else {
+		m_minus.f = (f << 1) - 1;
+		m_minus.e = e - 1;
+	}
+	m_minus.f <<= m_minus.e - m_plus.e;
+	m_minus.e = m_plus.e;
+	DUK_ASSERT(w.e == m_plus.e);
+
+	/* Cached power c = 10^mk bringing the binary exponent of the scaled
+	 * values into [DUK__GRISU_ALPHA, DUK__GRISU_GAMMA].
+	 */
+	kd = (duk_int_t) DUK_CEIL((duk_double_t) (DUK__GRISU_ALPHA - (w.e + 64) + 63) * 0.30102999566398114);
+	idx = (-DUK__GRISU_POW10_K_MIN + kd - 1) / DUK__GRISU_POW10_K_STEP + 1;
+	DUK_ASSERT(idx >= 0 && idx < 87);
+	c.f = duk__grisu_pow10_f[idx];
+	c.e = (duk_int_t) duk__grisu_pow10_e[idx];
+	mk = DUK__GRISU_POW10_K_MIN + idx * DUK__GRISU_POW10_K_STEP;
+
+	w = duk__diyfp_mul(w, c);
+	m_plus = duk__diyfp_mul(m_plus, c);
+	m_minus = duk__diyfp_mul(m_minus, c);
+	DUK_ASSERT(w.e >= DUK__GRISU_ALPHA && w.e <= DUK__GRISU_GAMMA);
+
+	/*
+	 *  Digit generation.  The scaled boundaries have an error of at most
+	 *  one unit, so digits are generated for the unsafe interval
+	 *  [m- - unit, m+ + unit] and verified in duk__grisu_round_weed().
+	 */
+
+	unit = 1;
+	too_low.f = m_minus.f - unit;
+	too_high.f = m_plus.f + unit;
+	unsafe_interval = too_high.f - too_low.f;
+	one_shift = (duk_small_int_t) -w.e;
+	one_f = ((duk_uint64_t) 1) << one_shift;
+	integrals = (duk_uint32_t) (too_high.f >> one_shift);
+	fractionals = too_high.f & (one_f - 1);
+
+	divisor = 1;
+	kappa = 1;
+	while (kappa < 10 && (duk_uint64_t) divisor * 10 <= (duk_uint64_t) integrals) {
+		divisor *= 10;
+		kappa++;
+	}
+
+	count = 0;
+	while (kappa > 0) {
+		nc_ctx->digits[count++] = (duk_uint8_t) (integrals / divisor);
+		integrals %= divisor;
+		kappa--;
+		rest = (((duk_uint64_t) integrals) << one_shift) + fractionals;
+		if (rest < unsafe_interval) {
+			ok = duk__grisu_round_weed(nc_ctx->digits, count, too_high.f - w.f, unsafe_interval,
+			                           rest, ((duk_uint64_t) divisor) << one_shift, unit);
+			goto digits_done;
+		}
+		divisor /= 10;
+	}
+	for (;;) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafe_interval *= 10;
+		nc_ctx->digits[count++] = (duk_uint8_t) (fractionals >> one_shift);
+		fractionals &= one_f - 1;
+		kappa--;
+		if (fractionals < unsafe_interval) {
+			ok = duk__grisu_round_weed(nc_ctx->digits, count, (too_high.f - w.f) * unit, unsafe_interval,
+			                           fractionals, one_f, unit);
+			goto digits_done;
+		}
+		if (count >= 18) {
+			return 0;  /* can't happen for doubles; be safe */
+		}
+	}
+
+ digits_done:
+	if (!ok) {
+		return 0;
+	}
+
+	/* value = digits * 10^(kappa - mk) */
+	while (count > 1 && nc_ctx->digits[count - 1] == 0) {
+		count--;
+		kappa++;
+	}
+	nc_ctx->count = count;
+	nc_ctx->k = count + kappa - mk;
+	return 1;
+}
+#endif  /* DUK_USE_NUMCONV_FAST */
+
 /*
  *  Exposed number-to-string API
  *
@@ -84458,6 +88896,38 @@ DUK_INTERNAL void duk_numconv_stringify(duk_hthread *thr, duk_small_int_t radix,
 		return;
 	}
 
+#if defined(DUK_USE_NUMCONV_FAST)
+	/* Larger integers which are still exact (below 2^53), e.g. millisecond
+	 * timestamps, and then shortest round trip digits using Grisu3.
+	 */
+	if (flags == 0 && radix == 10 && c != DUK_FP_ZERO) {
+		if (x < 9007199254740992.0 && (duk_double_t) (duk_uint64_t) x == x) {
+			duk_uint8_t buf[24];
+			duk_uint8_t *p = buf + sizeof(buf);
+			duk_uint64_t v = (duk_uint64_t) x;
+
+			do {
+				*--p = (duk_uint8_t) ('0' + (duk_small_int_t) (v % 10));
+				v /= 10;
+			} while (v != 0);
+			if (neg) {
+				*--p = (duk_uint8_t) '-';
+			}
+			duk_push_lstring(thr, (const char *) p, (duk_size_t) (buf + sizeof(buf) - p));
+			return;
+		}
+
+		if (duk__grisu3(nc_ctx, x)) {
+			nc_ctx->is_s2n = 0;
+			nc_ctx->B = 10;
+			nc_ctx->is_fixed = 0;
+			nc_ctx->abs_pos = 0;
+			duk__dragon4_convert_and_push(nc_ctx, thr, radix, digits, flags, neg);
+			return;
+		}
+	}
+#endif  /* DUK_USE_NUMCONV_FAST */
+
 	/*
 	 *  Dragon4 setup.
 	 *
@@ -84997,6 +89467,34 @@ DUK_INTERNAL void duk_numconv_parse(duk_hthread *thr, duk_small_int_t radix, duk
 		goto negcheck_and_ret;
 	}
 
+#if defined(DUK_USE_NUMCONV_FAST) && !(defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ != 0))
+	/* Decimal significand of at most 53 bits and a power of ten which is
+	 * exact as a double: a single IEEE multiply or divide rounds correctly
+	 * (Clinger's fast path).  Not used with extended precision evaluation,
+	 * where double rounding could happen.
+	 */
+	if (radix == 10 && expt >= -22 && expt <= 22 &&
+	    (nc_ctx->f.n <= 1 || (nc_ctx->f.n == 2 && nc_ctx->f.v[1] <= 0x001fffffUL))) {
+		duk_uint64_t sig;
+
+		DUK_DDD(DUK_DDDPRINT("exact fast path number parse"));
+		sig = 0;
+		if (nc_ctx->f.n >= 1) {
+			sig = (duk_uint64_t) nc_ctx->f.v[0];
+		}
+		if (nc_ctx->f.n == 2) {
+			sig |= ((duk_uint64_t) nc_ctx->f.v[1]) << 32;
+		}
+		res = (duk_double_t) sig;
+		if (expt >= 0) {
+			res *= duk__str2num_pow10_exact[expt];
+		} else {
+			res /= duk__str2num_pow10_exact[-expt];
+		}
+		goto negcheck_and_ret;
+	}
+#endif  /* DUK_USE_NUMCONV_FAST */
+
 	/* Significand ('f') padding. */
 
 	while (dig_prec < duk__str2num_digits_for_radix[radix - 2]) {
@@ -85114,6 +89612,10 @@ DUK_INTERNAL void duk_numconv_parse(duk_hthread *thr, duk_small_int_t radix, duk
 #undef DUK__BI_PRINT
 #undef DUK__DIGITCHAR
 #undef DUK__DRAGON4_OUTPUT_PREINC
+#undef DUK__GRISU_ALPHA
+#undef DUK__GRISU_GAMMA
+#undef DUK__GRISU_POW10_K_MIN
+#undef DUK__GRISU_POW10_K_STEP
 #undef DUK__IEEE_DOUBLE_EXP_BIAS
 #undef DUK__IEEE_DOUBLE_EXP_MIN
 #undef DUK__MAX_FORMATTED_LENGTH
@@ -85166,6 +89668,9 @@ typedef struct {
 	 */
 	duk_int32_t charlen;
 
+	/* Whether the atom can match the empty string. */
+	duk_bool_t nullable;
+
 #if 0
 	/* These are not needed to implement quantifier capture handling,
 	 * but might be needed at some point.
@@ -85642,6 +90147,9 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 	duk_int32_t unpatched_disjunction_jump = -1;
 	duk_uint32_t entry_offset = (duk_uint32_t) DUK__RE_BUFLEN(re_ctx);
 	duk_int32_t res_charlen = 0;  /* -1 if disjunction is complex, char length if simple */
+	duk_bool_t atom_nullable = 0;
+	duk_uint32_t alt_nonnull_atoms = 0;  /* atoms in the current alternative which can't match empty */
+	duk_bool_t res_nullable = 0;         /* some alternative can match empty */
 	duk__re_disjunction_info tmp_disj;
 
 	DUK_ASSERT(out_atom_info != NULL);
@@ -85667,6 +90175,7 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 		                                     * (allows quantifiers to copy the atom bytecode)
 		                                     */
 		duk_uint32_t new_atom_start_captures;  /* re_ctx->captures at the start of the atom parsed in this loop */
+		duk_bool_t new_atom_nullable;       /* whether the atom parsed in this loop can match empty */
 
 		duk_lexer_parse_re_token(&re_ctx->lex, &re_ctx->curr_token);
 
@@ -85680,6 +90189,7 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 		new_atom_start_offset = -1;
 		new_atom_char_length = -1;
 		new_atom_start_captures = re_ctx->captures;
+		new_atom_nullable = 0;
 
 		switch (re_ctx->curr_token.t) {
 		case DUK_RETOK_DISJUNCTION: {
@@ -85714,6 +90224,11 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 			duk__append_reop(re_ctx, DUK_REOP_JUMP);
 			unpatched_disjunction_jump = (duk_int32_t) DUK__RE_BUFLEN(re_ctx);
 
+			if (alt_nonnull_atoms == 0) {
+				res_nullable = 1;
+			}
+			alt_nonnull_atoms = 0;
+
 			/* 'taint' result as complex */
 			res_charlen = -1;
 			break;
@@ -85725,6 +90240,10 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 			if (re_ctx->curr_token.qmin > re_ctx->curr_token.qmax) {
 				DUK_ERROR_SYNTAX(re_ctx->thr, DUK_STR_INVALID_QUANTIFIER_VALUES);
 			}
+			if (re_ctx->curr_token.qmin == 0 && !atom_nullable) {
+				DUK_ASSERT(alt_nonnull_atoms > 0);
+				alt_nonnull_atoms--;
+			}
 			if (atom_char_length >= 0) {
 				/*
 				 *  Simple atom
@@ -85810,6 +90329,22 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 					                     (long) atom_start_captures));
 				}
 
+#if defined(DUK_USE_REGEXP_LINEAR)
+				/* An optional iteration which matches empty must fail
+				 * (E6 Section 21.2.2.5.1, RepeatMatcher),
+				 * leaving the captures of the skipped iteration
+				 * undefined.  The linear matcher only gets this right
+				 * for loops, where an empty iteration ends up where
+				 * it started and the thread is dropped, but not for
+				 * the unrolled copies of a bounded quantifier.
+				 */
+				if (atom_start_captures != re_ctx->captures && atom_nullable &&
+				    re_ctx->curr_token.qmax != DUK_RE_QUANTIFIER_INFINITE &&
+				    re_ctx->curr_token.qmax > re_ctx->curr_token.qmin) {
+					re_ctx->linear_unsupported = 1;
+				}
+#endif
+
 				atom_code_length = (duk_int32_t) DUK__RE_BUFLEN(re_ctx) - atom_start_offset;
 
 				/* insert the required matches (qmin) by copying the atom */
@@ -85982,6 +90517,7 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 				re_ctx->highest_backref = backref;
 			}
 			new_atom_char_length = -1;   /* mark as complex */
+			new_atom_nullable = 1;       /* the capture may be empty or undefined */
 			new_atom_start_offset = (duk_int32_t) DUK__RE_BUFLEN(re_ctx);
 			duk__append_reop(re_ctx, DUK_REOP_BACKREFERENCE);
 			duk__append_u32(re_ctx, backref);
@@ -85998,12 +90534,14 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 			duk__parse_disjunction(re_ctx, 0, &tmp_disj);  /* retval (sub-atom char length) unused, tainted as complex above */
 			duk__append_reop(re_ctx, DUK_REOP_SAVE);
 			duk__append_u32(re_ctx, cap * 2 + 1);
+			new_atom_nullable = tmp_disj.nullable;
 			break;
 		}
 		case DUK_RETOK_ATOM_START_NONCAPTURE_GROUP: {
 			new_atom_start_offset = (duk_int32_t) DUK__RE_BUFLEN(re_ctx);
 			duk__parse_disjunction(re_ctx, 0, &tmp_disj);
 			new_atom_char_length = tmp_disj.charlen;
+			new_atom_nullable = tmp_disj.nullable;
 			break;
 		}
 		case DUK_RETOK_ATOM_START_CHARCLASS:
@@ -86077,12 +90615,16 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 				/* only advance if not tainted */
 				res_charlen += new_atom_char_length;
 			}
+			if (!new_atom_nullable) {
+				alt_nonnull_atoms++;
+			}
 		}
 
 		/* record previous atom info in case next token is a quantifier */
 		atom_start_offset = new_atom_start_offset;
 		atom_char_length = new_atom_char_length;
 		atom_start_captures = new_atom_start_captures;
+		atom_nullable = new_atom_nullable;
 	}
 
  done:
@@ -86106,6 +90648,7 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 	out_atom_info->end_captures = re_ctx->captures;
 #endif
 	out_atom_info->charlen = res_charlen;
+	out_atom_info->nullable = res_nullable || alt_nonnull_atoms == 0;
 	DUK_DDD(DUK_DDDPRINT("parse disjunction finished: charlen=%ld",
 	                     (long) out_atom_info->charlen));
 
@@ -86229,6 +90772,395 @@ DUK_LOCAL void duk__create_escaped_source(duk_hthread *thr, int idx_pattern) {
 	/* [ ... escaped_source ] */
 }
 
+#if defined(DUK_USE_REGEXP_LINEAR)
+/*
+ *  Linear-time matcher program.
+ *
+ *  Bytecode without backreferences and lookaheads is translated into a flat
+ *  instruction array for the matcher in duk_regexp_executor.c.  Simple
+ *  quantifiers (SQGREEDY/SQMINIMAL) are expanded into atom copies and splits
+ *  because matcher threads have no counters.  Jumps are first emitted with
+ *  bytecode offset targets (DUK__RE_LINEAR_PENDING) and patched when the
+ *  region containing them is complete; an atom copy is a region of its own.
+ *
+ *  With prog->instrs == NULL only sizes are computed, which the compiler
+ *  uses to decide whether a regexp is eligible.
+ */
+
+#define DUK__RE_LINEAR_PENDING     0x80000000UL
+#define DUK__RE_LINEAR_MAX_RANGES  16384L  /* codepoints in all char class copies */
+
+DUK_LOCAL duk_uint32_t duk__re_linear_get_u32(duk_re_linear_prog *prog, const duk_uint8_t **pc) {
+	return (duk_uint32_t) duk_unicode_decode_xutf8_checked(prog->thr, pc, prog->bytecode, prog->bytecode_end);
+}
+
+DUK_LOCAL duk_int32_t duk__re_linear_get_i32(duk_re_linear_prog *prog, const duk_uint8_t **pc) {
+	duk_uint32_t t;
+
+	t = duk__re_linear_get_u32(prog, pc);
+	if (t & 1) {
+		return -((duk_int32_t) (t >> 1));
+	} else {
+		return (duk_int32_t) (t >> 1);
+	}
+}
+
+DUK_LOCAL duk_bool_t duk__re_linear_emit(duk_re_linear_prog *prog, duk_uint32_t op, duk_uint32_t x, duk_uint32_t y) {
+	if (prog->ninstr >= DUK_RE_LINEAR_MAX_INSTR) {
+		return 0;
+	}
+	if (prog->instrs != NULL) {
+		prog->instrs[prog->ninstr].op = op;
+		prog->instrs[prog->ninstr].x = x;
+		prog->instrs[prog->ninstr].y = y;
+	}
+	prog->ninstr++;
+	return 1;
+}
+
+/* Bytecode offset of a jump target, 0 (a valid offset) if insane. */
+DUK_LOCAL duk_uint32_t duk__re_linear_target(duk_re_linear_prog *prog, const duk_uint8_t *pc, duk_int32_t skip) {
+	duk_int32_t off = (duk_int32_t) (pc - prog->bytecode) + skip;
+
+	if (off < 0 || off > (duk_int32_t) (prog->bytecode_end - prog->bytecode)) {
+		return 0;
+	}
+	return (duk_uint32_t) off;
+}
+
+DUK_LOCAL duk_bool_t duk__re_linear_region(duk_re_linear_prog *prog, const duk_uint8_t *pc, const duk_uint8_t *pc_end, duk_bool_t is_atom);
+
+DUK_LOCAL duk_bool_t duk__re_linear_quantifier(duk_re_linear_prog *prog,
+                                               const duk_uint8_t *atom,
+                                               const duk_uint8_t *atom_end,
+                                               duk_uint32_t qmin,
+                                               duk_uint32_t qmax,
+                                               duk_bool_t greedy) {
+	duk_uint32_t i, split, stride, out;
+
+	for (i = 0; i < qmin; i++) {
+		if (!duk__re_linear_region(prog, atom, atom_end, 1 /*is_atom*/)) {
+			return 0;
+		}
+	}
+
+	split = prog->ninstr;
+	if (qmax == DUK_RE_QUANTIFIER_INFINITE) {
+		/* L: split L+1, out; atom; jump L; out: */
+		if (!duk__re_linear_emit(prog, DUK_REOP_SPLIT1, 0, 0) ||
+		    !duk__re_linear_region(prog, atom, atom_end, 1 /*is_atom*/) ||
+		    !duk__re_linear_emit(prog, DUK_REOP_JUMP, split, 0)) {
+			return 0;
+		}
+		stride = 0;
+		qmax = qmin + 1;
+	} else {
+		/* (split next, out; atom) x (qmax - qmin); out: */
+		stride = 0;
+		for (i = qmin; i < qmax; i++) {
+			if (!duk__re_linear_emit(prog, DUK_REOP_SPLIT1, 0, 0) ||
+			    !duk__re_linear_region(prog, atom, atom_end, 1 /*is_atom*/)) {
+				return 0;
+			}
+			if (stride == 0) {
+				stride = prog->ninstr - split;  /* every copy has the same size */
+			}
+		}
+	}
+
+	if (prog->instrs != NULL) {
+		out = prog->ninstr;
+		for (i = qmin; i < qmax; i++, split += stride) {
+			if (greedy) {
+				prog->instrs[split].x = split + 1;
+				prog->instrs[split].y = out;
+			} else {
+				prog->instrs[split].x = out;
+				prog->instrs[split].y = split + 1;
+			}
+		}
+	}
+	return 1;
+}
+
+DUK_LOCAL duk_bool_t duk__re_linear_region(duk_re_linear_prog *prog, const duk_uint8_t *pc, const duk_uint8_t *pc_end, duk_bool_t is_atom) {
+	duk_uint32_t first = prog->ninstr;
+	duk_uint32_t i;
+
+	while (pc < pc_end) {
+		duk_uint32_t op;
+		duk_uint32_t x, y;
+		duk_int32_t skip;
+
+		if (prog->offset_map != NULL) {
+			prog->offset_map[pc - prog->bytecode] = prog->ninstr;
+		}
+		op = *pc++;
+
+		switch (op) {
+		case DUK_REOP_MATCH: {
+			/* An atom ends in a MATCH, continue with what follows it. */
+			if (!is_atom && !duk__re_linear_emit(prog, op, 0, 0)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_CHAR: {
+			x = duk__re_linear_get_u32(prog, &pc);
+			if (!duk__re_linear_emit(prog, op, x, 0)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_PERIOD:
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+			if (!duk__re_linear_emit(prog, op, 0, 0)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_RANGES:
+		case DUK_REOP_INVRANGES: {
+			y = duk__re_linear_get_u32(prog, &pc);
+			x = prog->nranges;
+			if (y > (duk_uint32_t) (DUK__RE_LINEAR_MAX_RANGES / 2) ||
+			    x + y * 2 > (duk_uint32_t) DUK__RE_LINEAR_MAX_RANGES) {
+				return 0;
+			}
+			for (i = 0; i < y * 2; i++) {
+				duk_codepoint_t r = (duk_codepoint_t) duk__re_linear_get_u32(prog, &pc);
+				if (prog->ranges != NULL) {
+					prog->ranges[x + i] = r;
+				}
+			}
+			prog->nranges += y * 2;
+			if (!duk__re_linear_emit(prog, op, x, y)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_JUMP: {
+			skip = duk__re_linear_get_i32(prog, &pc);
+			x = duk__re_linear_target(prog, pc, skip);
+			if (!duk__re_linear_emit(prog, op | DUK__RE_LINEAR_PENDING, x, 0)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_SPLIT1:
+		case DUK_REOP_SPLIT2: {
+			skip = duk__re_linear_get_i32(prog, &pc);
+			x = duk__re_linear_target(prog, pc, 0);
+			y = duk__re_linear_target(prog, pc, skip);
+			if (op == DUK_REOP_SPLIT2) {
+				/* prefer jump */
+				duk_uint32_t t = x;
+				x = y;
+				y = t;
+			}
+			if (!duk__re_linear_emit(prog, DUK_REOP_SPLIT1 | DUK__RE_LINEAR_PENDING, x, y)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_SAVE: {
+			x = duk__re_linear_get_u32(prog, &pc);
+			if (x >= prog->nsaved || !duk__re_linear_emit(prog, op, x, 0)) {
+				return 0;
+			}
+			prog->nrestore++;
+			break;
+		}
+		case DUK_REOP_WIPERANGE: {
+			x = duk__re_linear_get_u32(prog, &pc);
+			y = duk__re_linear_get_u32(prog, &pc);
+			if (y == 0 || x >= prog->nsaved || y > prog->nsaved - x ||
+			    !duk__re_linear_emit(prog, op, x, y)) {
+				return 0;
+			}
+			prog->nrestore += y;
+			break;
+		}
+		case DUK_REOP_SQMINIMAL:
+		case DUK_REOP_SQGREEDY: {
+			duk_uint32_t qmin, qmax;
+
+			qmin = duk__re_linear_get_u32(prog, &pc);
+			qmax = duk__re_linear_get_u32(prog, &pc);
+			if (op == DUK_REOP_SQGREEDY) {
+				(void) duk__re_linear_get_u32(prog, &pc);  /* atomlen, only needed for backtracking */
+			}
+			skip = duk__re_linear_get_i32(prog, &pc);
+			if (skip <= 0 || skip > pc_end - pc || qmin > qmax) {
+				return 0;
+			}
+			if (!duk__re_linear_quantifier(prog, pc, pc + skip, qmin, qmax, op == DUK_REOP_SQGREEDY)) {
+				return 0;
+			}
+			pc += skip;
+			break;
+		}
+		default: {
+			/* Backreferences and lookaheads need backtracking. */
+			return 0;
+		}
+		}
+	}
+
+	if (prog->instrs != NULL) {
+		for (i = first; i < prog->ninstr; i++) {
+			duk_re_linear_instr *ins = prog->instrs + i;
+			if (ins->op & DUK__RE_LINEAR_PENDING) {
+				ins->op &= ~DUK__RE_LINEAR_PENDING;
+				ins->x = prog->offset_map[ins->x];
+				if (ins->op == DUK_REOP_SPLIT1) {
+					ins->y = prog->offset_map[ins->y];
+				}
+			}
+		}
+	}
+	return 1;
+}
+
+/* Build (or with prog->instrs == NULL, size) the linear matcher program for
+ * prog->bytecode.  Returns 0 if the bytecode isn't supported or the program
+ * would exceed the size limits.
+ */
+DUK_INTERNAL duk_bool_t duk_regexp_linear_build(duk_re_linear_prog *prog) {
+	prog->ninstr = 0;
+	prog->nranges = 0;
+	prog->nrestore = 0;
+
+	if (!duk__re_linear_region(prog, prog->bytecode, prog->bytecode_end, 0 /*is_atom*/)) {
+		return 0;
+	}
+	if (prog->ninstr == 0 ||
+	    prog->nsaved > (duk_uint32_t) (DUK_RE_LINEAR_MAX_THREAD_SAVES / (duk_int32_t) prog->ninstr)) {
+		return 0;
+	}
+	return 1;
+}
+#endif  /* DUK_USE_REGEXP_LINEAR */
+
+#if defined(DUK_USE_REGEXP_PREFILTER)
+/*
+ *  Literal prefix and anchoring analysis.
+ *
+ *  Looks at the code following the initial 'save 0', before the header has
+ *  been inserted.  A leading '^' without the multiline flag anchors the
+ *  regexp to input start.  For case sensitive regexps leading CHAR
+ *  instructions form a literal prefix; their operands use the same extended
+ *  UTF-8 encoding as the input so they can be copied as is.
+ */
+
+DUK_LOCAL duk_uint32_t duk__re_analyze_prefix(duk_re_compiler_ctx *re_ctx, duk_uint8_t *prefix) {
+	const duk_uint8_t *p_start = (const duk_uint8_t *) DUK_BW_GET_BASEPTR(re_ctx->thr, &re_ctx->bw);
+	const duk_uint8_t *p_end = p_start + DUK_BW_GET_SIZE(re_ctx->thr, &re_ctx->bw);
+	const duk_uint8_t *p;
+	duk_uint32_t len = 0;
+
+	DUK_ASSERT(p_end - p_start >= 2 && p_start[0] == DUK_REOP_SAVE && p_start[1] == 0);
+	p = p_start + 2;
+
+	if (p < p_end && *p == DUK_REOP_ASSERT_START && !(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+		re_ctx->re_flags |= DUK_RE_FLAG_ANCHORED;
+		p++;
+	}
+	if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
+		return 0;
+	}
+	while (p < p_end && *p == DUK_REOP_CHAR) {
+		const duk_uint8_t *q = p + 1;
+		duk_size_t n;
+
+		(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &q, p_start, p_end);
+		n = (duk_size_t) (q - (p + 1));
+		if (len + n > DUK_RE_PREFIX_MAX_BYTES) {
+			break;
+		}
+		DUK_MEMCPY((void *) (prefix + len), (const void *) (p + 1), n);
+		len += (duk_uint32_t) n;
+		p = q;
+	}
+	return len;
+}
+#endif  /* DUK_USE_REGEXP_PREFILTER */
+
+#if defined(DUK_USE_REGEXP_CACHE)
+/*
+ *  Compiled regexp cache.
+ *
+ *  Compilation only depends on the pattern and flags strings (which are
+ *  interned, so they're compared by pointer), and the escaped source and
+ *  bytecode strings are immutable.  They can thus be shared by all RegExp
+ *  instances created from the same pattern and flags, as they already are
+ *  for instances created by evaluating the same regexp literal.
+ */
+
+/* On a hit: [ ... pattern flags ] -> [ ... escaped_source bytecode ] */
+DUK_LOCAL duk_bool_t duk__re_cache_lookup(duk_hthread *thr, duk_hstring *h_pattern, duk_hstring *h_flags) {
+	duk_heap *heap = thr->heap;
+	duk_small_uint_t i;
+
+	for (i = 0; i < DUK_HEAP_REGEXP_CACHE_SIZE; i++) {
+		duk_regexp_cache *c = heap->recache + i;
+
+		if (c->pattern == NULL) {
+			break;  /* unused entries are always last */
+		}
+		if (c->pattern == h_pattern && c->flags == h_flags) {
+			if (i > 0) {
+				duk_regexp_cache tmp;
+
+				tmp = *c;
+				DUK_MEMMOVE((void *) (&heap->recache[1]),
+				            (const void *) (&heap->recache[0]),
+				            (size_t) (sizeof(duk_regexp_cache) * i));
+				heap->recache[0] = tmp;
+			}
+			duk_push_hstring(thr, heap->recache[0].source);
+			duk_push_hstring(thr, heap->recache[0].bytecode);
+			duk_remove(thr, -4);
+			duk_remove(thr, -3);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Add a compilation result as the most recently used entry, evicting the
+ * least recently used one.
+ */
+DUK_LOCAL void duk__re_cache_insert(duk_hthread *thr, duk_hstring *h_pattern, duk_hstring *h_flags, duk_hstring *h_source, duk_hstring *h_bytecode) {
+	duk_heap *heap = thr->heap;
+	duk_regexp_cache old;
+
+	old = heap->recache[DUK_HEAP_REGEXP_CACHE_SIZE - 1];
+	DUK_MEMMOVE((void *) (&heap->recache[1]),
+	            (const void *) (&heap->recache[0]),
+	            (size_t) (sizeof(duk_regexp_cache) * (DUK_HEAP_REGEXP_CACHE_SIZE - 1)));
+	heap->recache[0].pattern = h_pattern;
+	heap->recache[0].flags = h_flags;
+	heap->recache[0].source = h_source;
+	heap->recache[0].bytecode = h_bytecode;
+	DUK_HSTRING_INCREF(thr, h_pattern);
+	DUK_HSTRING_INCREF(thr, h_flags);
+	DUK_HSTRING_INCREF(thr, h_source);
+	DUK_HSTRING_INCREF(thr, h_bytecode);
+
+	if (old.pattern != NULL) {
+		/* Strings have no finalizers, so no side effects here. */
+		DUK_HSTRING_DECREF(thr, old.pattern);
+		DUK_HSTRING_DECREF(thr, old.flags);
+		DUK_HSTRING_DECREF(thr, old.source);
+		DUK_HSTRING_DECREF(thr, old.bytecode);
+	}
+}
+#endif  /* DUK_USE_REGEXP_CACHE */
+
 /*
  *  Exposed regexp compilation primitive.
  *
@@ -86250,6 +91182,10 @@ DUK_INTERNAL void duk_regexp_compile(duk_hthread *thr) {
 	duk_hstring *h_pattern;
 	duk_hstring *h_flags;
 	duk__re_disjunction_info ign_disj;
+#if defined(DUK_USE_REGEXP_PREFILTER)
+	duk_uint8_t prefix[DUK_RE_PREFIX_MAX_BYTES];
+	duk_uint32_t prefix_len;
+#endif
 
 	DUK_ASSERT(thr != NULL);
 
@@ -86261,6 +91197,13 @@ DUK_INTERNAL void duk_regexp_compile(duk_hthread *thr) {
 	h_pattern = duk_require_hstring_notsymbol(thr, -2);
 	h_flags = duk_require_hstring_notsymbol(thr, -1);
 
+#if defined(DUK_USE_REGEXP_CACHE)
+	if (duk__re_cache_lookup(thr, h_pattern, h_flags)) {
+		DUK_DD(DUK_DDPRINT("regexp cache hit, bytecode: %!T", (duk_tval *) duk_get_tval(thr, -1)));
+		return;
+	}
+#endif
+
 	/*
 	 *  Create normalized 'source' property (E5 Section 15.10.3).
 	 */
@@ -86326,11 +91269,68 @@ DUK_INTERNAL void duk_regexp_compile(duk_hthread *thr) {
 		DUK_ERROR_SYNTAX(thr, DUK_STR_INVALID_BACKREFS);
 	}
 
+#if defined(DUK_USE_REGEXP_LINEAR)
+	/*
+	 *  Build a linear-time matcher program if the bytecode allows it,
+	 *  and append it to the bytecode.
+	 */
+
+	{
+		duk_re_linear_prog prog;
+		duk_uint32_t trailer[3];
+		duk_uint8_t *p;
+
+		DUK_MEMZERO(&prog, sizeof(prog));
+		prog.thr = thr;
+		prog.bytecode = (const duk_uint8_t *) DUK_BW_GET_BASEPTR(thr, &re_ctx.bw);
+		prog.bytecode_end = prog.bytecode + DUK_BW_GET_SIZE(thr, &re_ctx.bw);
+		prog.nsaved = (re_ctx.captures + 1) * 2;
+		if (!re_ctx.linear_unsupported && duk_regexp_linear_build(&prog)) {
+			/* [ ... pattern flags escaped_source buffer ] */
+			p = (duk_uint8_t *) duk_push_fixed_buffer_zero(thr,
+			        sizeof(duk_re_linear_instr) * prog.ninstr +
+			        sizeof(duk_codepoint_t) * prog.nranges +
+			        sizeof(duk_uint32_t) * (DUK_BW_GET_SIZE(thr, &re_ctx.bw) + 1));
+			prog.instrs = (duk_re_linear_instr *) (void *) p;
+			prog.ranges = (duk_codepoint_t *) (void *) (prog.instrs + prog.ninstr);
+			prog.offset_map = (duk_uint32_t *) (void *) (prog.ranges + prog.nranges);
+			if (!duk_regexp_linear_build(&prog)) {
+				DUK_ERROR_INTERNAL(thr);
+			}
+			trailer[0] = prog.ninstr;
+			trailer[1] = prog.nranges;
+			trailer[2] = prog.nrestore;
+			DUK_BW_WRITE_ENSURE_BYTES(thr, &re_ctx.bw, p,
+			                          sizeof(duk_re_linear_instr) * prog.ninstr +
+			                          sizeof(duk_codepoint_t) * prog.nranges);
+			DUK_BW_WRITE_ENSURE_BYTES(thr, &re_ctx.bw, (duk_uint8_t *) trailer, sizeof(trailer));
+			duk_pop(thr);
+			re_ctx.re_flags |= DUK_RE_FLAG_LINEAR;
+		}
+		DUK_DD(DUK_DDPRINT("linear matcher %s, ninstr=%ld",
+		                   (re_ctx.re_flags & DUK_RE_FLAG_LINEAR) ? "enabled" : "not eligible",
+		                   (long) prog.ninstr));
+	}
+#endif
+
+#if defined(DUK_USE_REGEXP_PREFILTER)
+	prefix_len = duk__re_analyze_prefix(&re_ctx, prefix);
+	DUK_DD(DUK_DDPRINT("regexp anchored: %ld, literal prefix length: %ld",
+	                   (long) ((re_ctx.re_flags & DUK_RE_FLAG_ANCHORED) != 0), (long) prefix_len));
+#endif
+
 	/*
-	 *  Emit compiled regexp header: flags, ncaptures
+	 *  Emit compiled regexp header: flags, ncaptures, optional prefix
 	 *  (insertion order inverted on purpose)
 	 */
 
+#if defined(DUK_USE_REGEXP_PREFILTER)
+	if (prefix_len > 0) {
+		DUK_BW_INSERT_ENSURE_BYTES(thr, &re_ctx.bw, 0, prefix, (duk_size_t) prefix_len);
+		duk__insert_u32(&re_ctx, 0, prefix_len);
+		re_ctx.re_flags |= DUK_RE_FLAG_PREFIX;
+	}
+#endif
 	duk__insert_u32(&re_ctx, 0, (re_ctx.captures + 1) * 2);
 	duk__insert_u32(&re_ctx, 0, re_ctx.re_flags);
 
@@ -86341,6 +91341,10 @@ DUK_INTERNAL void duk_regexp_compile(duk_hthread *thr) {
 
 	/* [ ... pattern flags escaped_source bytecode ] */
 
+#if defined(DUK_USE_REGEXP_CACHE)
+	duk__re_cache_insert(thr, h_pattern, h_flags, duk_known_hstring(thr, -2), duk_known_hstring(thr, -1));
+#endif
+
 	/*
 	 *  Finalize stack
 	 */
@@ -86404,6 +91408,8 @@ DUK_INTERNAL void duk_regexp_create_instance(duk_hthread *thr) {
 /* automatic undefs */
 #undef DUK__RE_BUFLEN
 #undef DUK__RE_INITIAL_BUFSIZE
+#undef DUK__RE_LINEAR_MAX_RANGES
+#undef DUK__RE_LINEAR_PENDING
 #line 1 "duk_regexp_executor.c"
 /*
  *  Regexp executor.
@@ -86541,6 +91547,72 @@ DUK_LOCAL duk_codepoint_t duk__inp_get_prev_cp(duk_re_matcher_ctx *re_ctx, const
 	return duk__inp_get_cp(re_ctx, &sp);
 }
 
+/*
+ *  Zero-width assertions, shared by both matchers.  Returns non-zero if the
+ *  assertion holds at 'sp'.
+ */
+
+DUK_LOCAL duk_bool_t duk__check_assertion(duk_re_matcher_ctx *re_ctx, duk_small_int_t op, const duk_uint8_t *sp) {
+	duk_codepoint_t c;
+
+	switch (op) {
+	case DUK_REOP_ASSERT_START: {
+		if (sp <= re_ctx->input) {
+			return 1;
+		}
+		if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+			return 0;
+		}
+		c = duk__inp_get_prev_cp(re_ctx, sp);
+		/* E5 Sections 15.10.2.8, 7.3 */
+		return duk_unicode_is_line_terminator(c);
+	}
+	case DUK_REOP_ASSERT_END: {
+		const duk_uint8_t *tmp_sp;
+
+		tmp_sp = sp;
+		c = duk__inp_get_cp(re_ctx, &tmp_sp);
+		if (c < 0) {
+			return 1;
+		}
+		if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+			return 0;
+		}
+		/* E5 Sections 15.10.2.8, 7.3 */
+		return duk_unicode_is_line_terminator(c);
+	}
+	default: {
+		/*
+		 *  E5 Section 15.10.2.6.  The previous and current character
+		 *  should -not- be canonicalized as they are now.  However,
+		 *  canonicalization does not affect the result of IsWordChar()
+		 *  (which depends on Unicode characters never canonicalizing
+		 *  into ASCII characters) so this does not matter.
+		 */
+		duk_small_int_t w1, w2;
+
+		DUK_ASSERT(op == DUK_REOP_ASSERT_WORD_BOUNDARY || op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY);
+		if (sp <= re_ctx->input) {
+			w1 = 0;  /* not a wordchar */
+		} else {
+			c = duk__inp_get_prev_cp(re_ctx, sp);
+			w1 = duk_unicode_re_is_wordchar(c);
+		}
+		if (sp >= re_ctx->input_end) {
+			w2 = 0;  /* not a wordchar */
+		} else {
+			const duk_uint8_t *tmp_sp = sp;  /* dummy so sp won't get updated */
+			c = duk__inp_get_cp(re_ctx, &tmp_sp);
+			w2 = duk_unicode_re_is_wordchar(c);
+		}
+		if (op == DUK_REOP_ASSERT_WORD_BOUNDARY) {
+			return w1 != w2;
+		}
+		return w1 == w2;
+	}
+	}
+}
+
 /*
  *  Regexp recursive matching function.
  *
@@ -86554,6 +91626,13 @@ DUK_LOCAL duk_codepoint_t duk__inp_get_prev_cp(duk_re_matcher_ctx *re_ctx, const
 
 DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *pc, const duk_uint8_t *sp) {
 	if (re_ctx->recursion_depth >= re_ctx->recursion_limit) {
+#if defined(DUK_USE_REGEXP_LINEAR)
+		if (re_ctx->re_flags & DUK_RE_FLAG_LINEAR) {
+			/* Abort like for the step limit below. */
+			re_ctx->steps_count = re_ctx->steps_limit;
+			return NULL;
+		}
+#endif
 		DUK_ERROR_RANGE(re_ctx->thr, DUK_STR_REGEXP_EXECUTOR_RECURSION_LIMIT);
 	}
 	re_ctx->recursion_depth++;
@@ -86562,6 +91641,15 @@ DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const
 		duk_small_int_t op;
 
 		if (re_ctx->steps_count >= re_ctx->steps_limit) {
+#if defined(DUK_USE_REGEXP_LINEAR)
+			if (re_ctx->re_flags & DUK_RE_FLAG_LINEAR) {
+				/* Step budget exhausted: every pending alternative now fails
+				 * on its first step, and the caller restarts the match with
+				 * the linear-time matcher.
+				 */
+				goto fail;
+			}
+#endif
 			DUK_ERROR_RANGE(re_ctx->thr, DUK_STR_REGEXP_EXECUTOR_STEP_LIMIT);
 		}
 		re_ctx->steps_count++;
@@ -86674,76 +91762,12 @@ DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const
 			}
 			break;
 		}
-		case DUK_REOP_ASSERT_START: {
-			duk_codepoint_t c;
-
-			if (sp <= re_ctx->input) {
-				break;
-			}
-			if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
-				goto fail;
-			}
-			c = duk__inp_get_prev_cp(re_ctx, sp);
-			if (duk_unicode_is_line_terminator(c)) {
-				/* E5 Sections 15.10.2.8, 7.3 */
-				break;
-			}
-			goto fail;
-		}
-		case DUK_REOP_ASSERT_END: {
-			duk_codepoint_t c;
-			const duk_uint8_t *tmp_sp;
-
-			tmp_sp = sp;
-			c = duk__inp_get_cp(re_ctx, &tmp_sp);
-			if (c < 0) {
-				break;
-			}
-			if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
-				goto fail;
-			}
-			if (duk_unicode_is_line_terminator(c)) {
-				/* E5 Sections 15.10.2.8, 7.3 */
-				break;
-			}
-			goto fail;
-		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
 		case DUK_REOP_ASSERT_WORD_BOUNDARY:
 		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
-			/*
-			 *  E5 Section 15.10.2.6.  The previous and current character
-			 *  should -not- be canonicalized as they are now.  However,
-			 *  canonicalization does not affect the result of IsWordChar()
-			 *  (which depends on Unicode characters never canonicalizing
-			 *  into ASCII characters) so this does not matter.
-			 */
-			duk_small_int_t w1, w2;
-
-			if (sp <= re_ctx->input) {
-				w1 = 0;  /* not a wordchar */
-			} else {
-				duk_codepoint_t c;
-				c = duk__inp_get_prev_cp(re_ctx, sp);
-				w1 = duk_unicode_re_is_wordchar(c);
-			}
-			if (sp >= re_ctx->input_end) {
-				w2 = 0;  /* not a wordchar */
-			} else {
-				const duk_uint8_t *tmp_sp = sp;  /* dummy so sp won't get updated */
-				duk_codepoint_t c;
-				c = duk__inp_get_cp(re_ctx, &tmp_sp);
-				w2 = duk_unicode_re_is_wordchar(c);
-			}
-
-			if (op == DUK_REOP_ASSERT_WORD_BOUNDARY) {
-				if (w1 == w2) {
-					goto fail;
-				}
-			} else {
-				DUK_ASSERT(op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY);
-				if (w1 != w2) {
-					goto fail;
-				}
+			if (!duk__check_assertion(re_ctx, op, sp)) {
+				goto fail;
 			}
 			break;
 		}
@@ -87075,6 +92099,358 @@ DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const
 	return NULL;  /* never here */
 }
 
+#if defined(DUK_USE_REGEXP_PREFILTER)
+/*
+ *  Skip to the next position where a match may start, based on the
+ *  compile time analysis in duk_regexp_compiler.c.  Returns NULL if there
+ *  is none.  The first prefix byte is never a UTF-8 continuation byte, so
+ *  memchr() can only stop at a character boundary.
+ */
+
+DUK_LOCAL const duk_uint8_t *duk__re_find_candidate(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *sp) {
+	duk_size_t prefix_len = (duk_size_t) re_ctx->prefix_len;
+
+	if ((re_ctx->re_flags & DUK_RE_FLAG_ANCHORED) && sp != re_ctx->input) {
+		return NULL;
+	}
+	if (prefix_len == 0) {
+		return sp;
+	}
+
+	for (;;) {
+		duk_size_t avail = (duk_size_t) (re_ctx->input_end - sp);
+
+		if (avail < prefix_len) {
+			return NULL;
+		}
+		sp = (const duk_uint8_t *) DUK_MEMCHR((const void *) sp, (int) re_ctx->prefix[0], avail - prefix_len + 1);
+		if (sp == NULL) {
+			return NULL;
+		}
+		if (DUK_MEMCMP((const void *) (sp + 1), (const void *) (re_ctx->prefix + 1), prefix_len - 1) == 0) {
+			return sp;
+		}
+		if (re_ctx->re_flags & DUK_RE_FLAG_ANCHORED) {
+			return NULL;
+		}
+		sp++;
+	}
+}
+#endif  /* DUK_USE_REGEXP_PREFILTER */
+
+#if defined(DUK_USE_REGEXP_LINEAR)
+/*
+ *  Linear-time matcher.
+ *
+ *  Pike VM style simulation of the program built by duk_regexp_linear_build():
+ *  all threads advance over the input in lockstep, one codepoint at a time,
+ *  so matching is O(input length * program size) without backtracking.
+ *  Threads are kept in priority order and the first thread reaching MATCH
+ *  cuts off all lower priority threads, which gives the same leftmost-first
+ *  match and captures as the backtracking matcher.  A lowest priority thread
+ *  is started at every input position until a match is found, so the whole
+ *  unanchored search is a single pass over the input.
+ *
+ *  The backtracking matcher is usually faster for ordinary patterns, so it
+ *  still runs first, but with a step budget proportional to the linear
+ *  matcher's worst case (see duk__re_linear_step_budget()).  If the budget
+ *  or the recursion limit is exceeded, the match is redone here.  Empty
+ *  loops (e.g. /(a|)*b/) also terminate here, because a thread is added at
+ *  most once per program position and input position.  This also drops a
+ *  loop iteration which matched empty, as E6 requires.  Bounded quantifiers
+ *  are unrolled, so the same doesn't hold for them, and the compiler builds
+ *  no program when that would affect captures.
+ */
+
+#define DUK__RE_LINEAR_EXPLORE      0xffffffffUL
+#define DUK__RE_LINEAR_STEP_FACTOR  4  /* backtracking steps per input byte and instruction */
+
+typedef struct {
+	const duk_uint8_t *ptr;  /* capture value to restore */
+	duk_uint32_t pc;
+	duk_uint32_t idx;        /* capture index to restore, or DUK__RE_LINEAR_EXPLORE */
+} duk__re_linear_stackent;
+
+typedef struct {
+	duk_uint32_t *pcs;
+	const duk_uint8_t **caps;  /* 'nsaved' captures for each thread */
+	duk_uint32_t count;
+	duk_uint32_t gen;
+} duk__re_linear_list;
+
+typedef struct {
+	duk_re_matcher_ctx *re_ctx;
+	duk_re_linear_prog *prog;
+	duk_uint32_t *marks;              /* generation of the list which last added each pc */
+	const duk_uint8_t **tmp_caps;     /* captures of the thread being added */
+	duk__re_linear_stackent *stack;
+} duk__re_linear_ctx;
+
+/* Add a thread at 'pc' with captures 'tmp_caps' to 'list', following jumps,
+ * splits, saves and assertions in priority order.  An explicit stack is used
+ * instead of C recursion; restore entries undo capture updates once a branch
+ * has been explored.
+ */
+DUK_LOCAL void duk__re_linear_add(duk__re_linear_ctx *lc, duk__re_linear_list *list, duk_uint32_t pc, const duk_uint8_t *sp) {
+	duk__re_linear_stackent *stack = lc->stack;
+	const duk_uint8_t **tmp_caps = lc->tmp_caps;
+	duk_uint32_t nsaved = lc->prog->nsaved;
+	duk_uint32_t top = 0;
+	duk_uint32_t i;
+
+	stack[top].pc = pc;
+	stack[top].idx = DUK__RE_LINEAR_EXPLORE;
+	top++;
+
+	while (top > 0) {
+		duk__re_linear_stackent *ent = stack + (--top);
+		duk_re_linear_instr *ins;
+
+		if (ent->idx != DUK__RE_LINEAR_EXPLORE) {
+			tmp_caps[ent->idx] = ent->ptr;
+			continue;
+		}
+		pc = ent->pc;
+		if (pc >= lc->prog->ninstr || lc->marks[pc] == list->gen) {
+			continue;
+		}
+		lc->marks[pc] = list->gen;
+		ins = lc->prog->instrs + pc;
+
+		switch (ins->op) {
+		case DUK_REOP_JUMP: {
+			stack[top].pc = ins->x;
+			stack[top++].idx = DUK__RE_LINEAR_EXPLORE;
+			break;
+		}
+		case DUK_REOP_SPLIT1: {
+			stack[top].pc = ins->y;
+			stack[top++].idx = DUK__RE_LINEAR_EXPLORE;
+			stack[top].pc = ins->x;
+			stack[top++].idx = DUK__RE_LINEAR_EXPLORE;
+			break;
+		}
+		case DUK_REOP_SAVE: {
+			stack[top].ptr = tmp_caps[ins->x];
+			stack[top++].idx = ins->x;
+			tmp_caps[ins->x] = sp;
+			stack[top].pc = pc + 1;
+			stack[top++].idx = DUK__RE_LINEAR_EXPLORE;
+			break;
+		}
+		case DUK_REOP_WIPERANGE: {
+			for (i = ins->x; i < ins->x + ins->y; i++) {
+				stack[top].ptr = tmp_caps[i];
+				stack[top++].idx = i;
+				tmp_caps[i] = NULL;
+			}
+			stack[top].pc = pc + 1;
+			stack[top++].idx = DUK__RE_LINEAR_EXPLORE;
+			break;
+		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+			if (duk__check_assertion(lc->re_ctx, (duk_small_int_t) ins->op, sp)) {
+				stack[top].pc = pc + 1;
+				stack[top++].idx = DUK__RE_LINEAR_EXPLORE;
+			}
+			break;
+		}
+		default: {
+			/* Character matching instruction or MATCH: the thread waits here
+			 * for the next input character.
+			 */
+			list->pcs[list->count] = pc;
+			DUK_MEMCPY((void *) (list->caps + (duk_size_t) list->count * nsaved),
+			           (const void *) tmp_caps,
+			           sizeof(duk_uint8_t *) * nsaved);
+			list->count++;
+			break;
+		}
+		}
+	}
+}
+
+/* Run the linear matcher from 'sp' onwards.  On a match the captures are
+ * written to re_ctx->saved and non-zero is returned.
+ */
+DUK_LOCAL duk_bool_t duk__match_regexp_linear(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *sp) {
+	duk_hthread *thr = re_ctx->thr;
+	duk_re_linear_prog prog;
+	duk__re_linear_ctx lc;
+	duk__re_linear_list lists[2];
+	duk__re_linear_list *clist, *nlist, *tmp_list;
+	duk_uint32_t nsaved = re_ctx->nsaved;
+	duk_uint32_t trailer[3];
+	duk_uint32_t stack_size;
+	duk_size_t prog_size;
+	duk_uint8_t *p;
+	duk_uint32_t i;
+	duk_bool_t matched = 0;
+
+	/* Locate the program appended by the compiler and copy it to an
+	 * aligned scratch buffer which also holds the thread lists.
+	 */
+	DUK_ASSERT((duk_size_t) (re_ctx->bytecode_end - re_ctx->bytecode) >= DUK_RE_LINEAR_TRAILER_SIZE);
+	DUK_MEMCPY((void *) trailer, (const void *) (re_ctx->bytecode_end - DUK_RE_LINEAR_TRAILER_SIZE), sizeof(trailer));
+	DUK_MEMZERO(&prog, sizeof(prog));
+	prog.nsaved = nsaved;
+	prog.ninstr = trailer[0];
+	prog.nranges = trailer[1];
+	prog.nrestore = trailer[2];
+	DUK_ASSERT(prog.ninstr > 0 && prog.ninstr <= DUK_RE_LINEAR_MAX_INSTR);
+	prog_size = sizeof(duk_re_linear_instr) * prog.ninstr + sizeof(duk_codepoint_t) * prog.nranges;
+	DUK_ASSERT((duk_size_t) (re_ctx->bytecode_end - re_ctx->bytecode) >= prog_size + DUK_RE_LINEAR_TRAILER_SIZE);
+	stack_size = prog.ninstr * 2 + 1 + prog.nrestore;
+
+	duk_require_stack(thr, 1);
+	p = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr,
+	        sizeof(duk_uint8_t *) * nsaved * (2 * (duk_size_t) prog.ninstr + 1) +
+	        sizeof(duk__re_linear_stackent) * stack_size +
+	        prog_size +
+	        sizeof(duk_uint32_t) * 3 * (duk_size_t) prog.ninstr);
+	lists[0].caps = (const duk_uint8_t **) (void *) p;
+	lists[1].caps = lists[0].caps + nsaved * prog.ninstr;
+	lc.tmp_caps = lists[1].caps + nsaved * prog.ninstr;
+	lc.stack = (duk__re_linear_stackent *) (void *) (lc.tmp_caps + nsaved);
+	prog.instrs = (duk_re_linear_instr *) (void *) (lc.stack + stack_size);
+	prog.ranges = (duk_codepoint_t *) (void *) (prog.instrs + prog.ninstr);
+	lists[0].pcs = (duk_uint32_t *) (void *) (prog.ranges + prog.nranges);
+	lists[1].pcs = lists[0].pcs + prog.ninstr;
+	lc.marks = lists[1].pcs + prog.ninstr;
+	DUK_MEMCPY((void *) prog.instrs,
+	           (const void *) (re_ctx->bytecode_end - DUK_RE_LINEAR_TRAILER_SIZE - prog_size),
+	           prog_size);
+	DUK_MEMZERO((void *) lc.marks, sizeof(duk_uint32_t) * prog.ninstr);
+	lc.re_ctx = re_ctx;
+	lc.prog = &prog;
+
+	/* [ ... re_obj input bc saved_buf linear_buf ] */
+
+	clist = &lists[0];
+	nlist = &lists[1];
+	clist->count = 0;
+	clist->gen = 1;
+	nlist->count = 0;
+	nlist->gen = 0;
+
+	for (;;) {
+		const duk_uint8_t *sp_next;
+		duk_codepoint_t c;
+
+		if (!matched) {
+#if defined(DUK_USE_REGEXP_PREFILTER)
+			if (clist->count == 0) {
+				/* No threads alive, skip ahead.  Positions may have been
+				 * marked with the current generation at 'sp'.
+				 */
+				sp_next = duk__re_find_candidate(re_ctx, sp);
+				if (sp_next == NULL) {
+					break;
+				}
+				if (sp_next != sp) {
+					sp = sp_next;
+					clist->gen += 2;
+				}
+			}
+#endif
+			/* Lowest priority: a new match attempt at this position. */
+			for (i = 0; i < nsaved; i++) {
+				lc.tmp_caps[i] = NULL;
+			}
+			duk__re_linear_add(&lc, clist, 0, sp);
+		}
+		if (clist->count == 0) {
+			if (matched || sp >= re_ctx->input_end) {
+				break;
+			}
+			(void) duk__inp_get_cp(re_ctx, &sp);
+			clist->gen += 2;
+			continue;
+		}
+
+		sp_next = sp;
+		c = duk__inp_get_cp(re_ctx, &sp_next);  /* < 0 at end of input */
+		nlist->count = 0;
+		nlist->gen = clist->gen + 1;
+
+		for (i = 0; i < clist->count; i++) {
+			duk_re_linear_instr *ins = prog.instrs + clist->pcs[i];
+			const duk_uint8_t **caps = clist->caps + (duk_size_t) i * nsaved;
+			duk_bool_t ok;
+
+			switch (ins->op) {
+			case DUK_REOP_MATCH: {
+				matched = 1;
+				DUK_MEMCPY((void *) re_ctx->saved, (const void *) caps, sizeof(duk_uint8_t *) * nsaved);
+				goto cut;  /* drop lower priority threads */
+			}
+			case DUK_REOP_CHAR: {
+				ok = (c == (duk_codepoint_t) ins->x);
+				break;
+			}
+			case DUK_REOP_PERIOD: {
+				/* E5 Sections 15.10.2.8, 7.3 */
+				ok = (c >= 0 && !duk_unicode_is_line_terminator(c));
+				break;
+			}
+			default: {
+				const duk_codepoint_t *r = prog.ranges + ins->x;
+				const duk_codepoint_t *r_end = r + ins->y * 2;
+
+				DUK_ASSERT(ins->op == DUK_REOP_RANGES || ins->op == DUK_REOP_INVRANGES);
+				if (c < 0) {
+					ok = 0;
+					break;
+				}
+				for (; r < r_end; r += 2) {
+					if (c >= r[0] && c <= r[1]) {
+						break;
+					}
+				}
+				ok = ((r < r_end) == (ins->op == DUK_REOP_RANGES));
+				break;
+			}
+			}
+			if (ok) {
+				DUK_MEMCPY((void *) lc.tmp_caps, (const void *) caps, sizeof(duk_uint8_t *) * nsaved);
+				duk__re_linear_add(&lc, nlist, clist->pcs[i] + 1, sp_next);
+			}
+		}
+	 cut:
+		if (sp >= re_ctx->input_end) {
+			break;
+		}
+		sp = sp_next;
+		tmp_list = clist;
+		clist = nlist;
+		nlist = tmp_list;
+	}
+
+	duk_pop_unsafe(thr);
+	return matched;
+}
+
+/* Step budget for the backtracking matcher when the linear matcher is
+ * available as a fallback: proportional to the work the linear matcher
+ * would do for the rest of the input, so that the total stays linear.
+ */
+DUK_LOCAL duk_uint32_t duk__re_linear_step_budget(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *sp) {
+	duk_uint32_t trailer[3];
+	duk_double_t budget;
+
+	DUK_MEMCPY((void *) trailer, (const void *) (re_ctx->bytecode_end - DUK_RE_LINEAR_TRAILER_SIZE), sizeof(trailer));
+	budget = (duk_double_t) DUK__RE_LINEAR_STEP_FACTOR * (duk_double_t) trailer[0] *
+	         ((duk_double_t) (re_ctx->input_end - sp) + 1.0);
+	if (budget >= (duk_double_t) re_ctx->steps_limit) {
+		return re_ctx->steps_limit;
+	}
+	return (duk_uint32_t) budget;
+}
+#endif  /* DUK_USE_REGEXP_LINEAR */
+
 /*
  *  Exposed matcher function which provides the semantics of RegExp.prototype.exec().
  *
@@ -87100,6 +92476,10 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 	duk_uint_fast32_t i;
 	double d;
 	duk_uint32_t char_offset;
+#if defined(DUK_USE_REGEXP_LINEAR)
+	const duk_uint8_t *sp_start;
+	duk_uint32_t char_offset_start;
+#endif
 
 	DUK_ASSERT(thr != NULL);
 
@@ -87134,6 +92514,7 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 	 *
 	 *    uint   flags
 	 *    uint   nsaved (even, 2n+2 where n = num captures)
+	 *    uint   prefix length, followed by prefix bytes (if DUK_RE_FLAG_PREFIX)
 	 */
 
 	/* [ ... re_obj input bc ] */
@@ -87153,6 +92534,16 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 	pc = re_ctx.bytecode;
 	re_ctx.re_flags = duk__bc_get_u32(&re_ctx, &pc);
 	re_ctx.nsaved = duk__bc_get_u32(&re_ctx, &pc);
+#if defined(DUK_USE_REGEXP_PREFILTER)
+	if (re_ctx.re_flags & DUK_RE_FLAG_PREFIX) {
+		re_ctx.prefix_len = duk__bc_get_u32(&re_ctx, &pc);
+		re_ctx.prefix = pc;
+		if (re_ctx.prefix_len == 0 || re_ctx.prefix_len > (duk_uint32_t) (re_ctx.bytecode_end - pc)) {
+			DUK_ERROR_INTERNAL(thr);
+		}
+		pc += re_ctx.prefix_len;
+	}
+#endif
 	re_ctx.bytecode = pc;
 
 	DUK_ASSERT(DUK_RE_FLAG_GLOBAL < 0x10000UL);  /* must fit into duk_small_int_t */
@@ -87236,7 +92627,31 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 
 	DUK_ASSERT(match == 0);
 
+#if defined(DUK_USE_REGEXP_LINEAR)
+	sp_start = sp;
+	char_offset_start = char_offset;
+	if (re_ctx.re_flags & DUK_RE_FLAG_LINEAR) {
+		re_ctx.steps_limit = duk__re_linear_step_budget(&re_ctx, sp);
+	}
+#endif
+
 	for (;;) {
+#if defined(DUK_USE_REGEXP_PREFILTER)
+		{
+			const duk_uint8_t *sp_cand;
+
+			sp_cand = duk__re_find_candidate(&re_ctx, sp);
+			if (sp_cand == NULL) {
+				DUK_DDD(DUK_DDDPRINT("no match candidates left"));
+				break;
+			}
+			if (sp_cand != sp) {
+				char_offset += (duk_uint32_t) duk_unicode_unvalidated_utf8_length(sp, (duk_size_t) (sp_cand - sp));
+				sp = sp_cand;
+			}
+		}
+#endif
+
 		/* char offset in [0, h_input->clen] (both ends inclusive), checked before entry */
 		DUK_ASSERT_DISABLE(char_offset >= 0);
 		DUK_ASSERT(char_offset <= DUK_HSTRING_GET_CHARLEN(h_input));
@@ -87273,6 +92688,24 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 			break;
 		}
 
+#if defined(DUK_USE_REGEXP_LINEAR)
+		if (re_ctx.steps_count >= re_ctx.steps_limit) {
+			/* Backtracking gave up (only possible for DUK_RE_FLAG_LINEAR),
+			 * redo the whole unanchored match in linear time.
+			 */
+			DUK_ASSERT(re_ctx.re_flags & DUK_RE_FLAG_LINEAR);
+			DUK_DD(DUK_DDPRINT("regexp step budget exhausted, using linear matcher"));
+			sp = sp_start;
+			char_offset = char_offset_start;
+			if (duk__match_regexp_linear(&re_ctx, sp)) {
+				DUK_ASSERT(re_ctx.saved[0] != NULL && re_ctx.saved[0] >= sp);
+				char_offset += (duk_uint32_t) duk_unicode_unvalidated_utf8_length(sp, (duk_size_t) (re_ctx.saved[0] - sp));
+				match = 1;
+			}
+			break;
+		}
+#endif
+
 		/* advance by one character (code point) and one char_offset */
 		char_offset++;
 		if (char_offset > DUK_HSTRING_GET_CHARLEN(h_input)) {
@@ -87429,6 +92862,10 @@ DUK_INTERNAL void duk_regexp_match_force_global(duk_hthread *thr) {
 /* regexp support disabled */
 
 #endif  /* DUK_USE_REGEXP_SUPPORT */
+
+/* automatic undefs */
+#undef DUK__RE_LINEAR_EXPLORE
+#undef DUK__RE_LINEAR_STEP_FACTOR
 #line 1 "duk_selftest.c"
 /*
  *  Self tests to ensure execution environment is sane.  Intended to catch
@@ -95014,6 +100451,9 @@ DUK_INTERNAL duk_uint32_t duk_util_hashbytes(const duk_uint8_t *data, duk_size_t
  *
  *  Default algorithm is xoroshiro128+: http://xoroshiro.di.unimi.it/xoroshiro128plus.c
  *  with SplitMix64 seed preparation: http://xorshift.di.unimi.it/splitmix64.c.
+ *  With DUK_USE_RANDOM_XOSHIRO the generator is xoshiro256+ instead (see
+ *  duk_util_xoshiro256plus_double()), which has a longer period and no
+ *  linear artifacts in the bits used for doubles.
  *
  *  Low memory targets and targets without 64-bit types use a slightly smaller
  *  (but slower) algorithm by Adi Shamir:
@@ -95027,6 +100467,8 @@ DUK_INTERNAL duk_uint32_t duk_util_hashbytes(const duk_uint8_t *data, duk_size_t
 
 #if defined(DUK_USE_PREFER_SIZE) || !defined(DUK_USE_64BIT_OPS)
 #define DUK__RANDOM_SHAMIR3OP
+#elif defined(DUK_USE_RANDOM_XOSHIRO)
+#define DUK__RANDOM_XOSHIRO256PLUS
 #else
 #define DUK__RANDOM_XOROSHIRO128PLUS
 #endif
@@ -95068,7 +100510,7 @@ DUK_INTERNAL duk_double_t duk_util_tinyrandom_get_double(duk_hthread *thr) {
 }
 #endif  /* DUK__RANDOM_SHAMIR3OP */
 
-#if defined(DUK__RANDOM_XOROSHIRO128PLUS)
+#if defined(DUK__RANDOM_XOROSHIRO128PLUS) || defined(DUK__RANDOM_XOSHIRO256PLUS)
 DUK_LOCAL DUK_ALWAYS_INLINE duk_uint64_t duk__rnd_splitmix64(duk_uint64_t *x) {
 	duk_uint64_t z;
 	z = (*x += DUK_U64_CONSTANT(0x9E3779B97F4A7C15));
@@ -95076,7 +100518,28 @@ DUK_LOCAL DUK_ALWAYS_INLINE duk_uint64_t duk__rnd_splitmix64(duk_uint64_t *x) {
 	z = (z ^ (z >> 27U)) * DUK_U64_CONSTANT(0x94D049BB133111EB);
 	return z ^ (z >> 31U);
 }
+#endif  /* DUK__RANDOM_XOROSHIRO128PLUS || DUK__RANDOM_XOSHIRO256PLUS */
 
+#if defined(DUK__RANDOM_XOSHIRO256PLUS)
+DUK_INTERNAL void duk_util_tinyrandom_prepare_seed(duk_hthread *thr) {
+	duk_small_uint_t i;
+	duk_uint64_t x;
+
+	/* Same SplitMix64 mixing as for xoroshiro128+, filling all four
+	 * state words.  SplitMix64 never yields an all-zero state here.
+	 */
+	x = thr->heap->rnd_state[0];  /* Only [0] is used as input here. */
+	for (i = 0; i < 64; i++) {
+		thr->heap->rnd_state[i & 0x03] = duk__rnd_splitmix64(&x);  /* Keep last 4 values. */
+	}
+}
+
+DUK_INTERNAL duk_double_t duk_util_tinyrandom_get_double(duk_hthread *thr) {
+	return duk_util_xoshiro256plus_double((duk_uint64_t *) thr->heap->rnd_state);
+}
+#endif  /* DUK__RANDOM_XOSHIRO256PLUS */
+
+#if defined(DUK__RANDOM_XOROSHIRO128PLUS)
 DUK_LOCAL DUK_ALWAYS_INLINE duk_uint64_t duk__rnd_rotl(const duk_uint64_t x, duk_small_uint_t k) {
 	return (x << k) | (x >> (64U - k));
 }
@@ -95138,5 +100601,6 @@ DUK_INTERNAL duk_double_t duk_util_tinyrandom_get_double(duk_hthread *thr) {
 /* automatic undefs */
 #undef DUK__RANDOM_SHAMIR3OP
 #undef DUK__RANDOM_XOROSHIRO128PLUS
+#undef DUK__RANDOM_XOSHIRO256PLUS
 #undef DUK__RND_BIT
 #undef DUK__UPDATE_RND
@@ -205,6 +205,12 @@ struct duk_memory_functions;
 struct duk_function_list_entry;
 struct duk_number_list_entry;
 struct duk_time_components;
+struct duk_strtab_stats;
+struct duk_sample_frame;
+struct duk_call_stats_entry;
+struct duk_call_stats_label;
+struct duk_heap_node;
+struct duk_heap_edge;
 
 /* duk_context is now defined in duk_config.h because it may also be
  * referenced there by prototypes.
@@ -214,6 +220,12 @@ typedef struct duk_memory_functions duk_memory_functions;
 typedef struct duk_function_list_entry duk_function_list_entry;
 typedef struct duk_number_list_entry duk_number_list_entry;
 typedef struct duk_time_components duk_time_components;
+typedef struct duk_strtab_stats duk_strtab_stats;
+typedef struct duk_sample_frame duk_sample_frame;
+typedef struct duk_call_stats_entry duk_call_stats_entry;
+typedef struct duk_call_stats_label duk_call_stats_label;
+typedef struct duk_heap_node duk_heap_node;
+typedef struct duk_heap_edge duk_heap_edge;
 
 typedef duk_ret_t (*duk_c_function)(duk_context *ctx);
 typedef void *(*duk_alloc_function) (void *udata, duk_size_t size);
@@ -223,6 +235,12 @@ typedef void (*duk_fatal_function) (void *udata, const char *msg);
 typedef void (*duk_decode_char_function) (void *udata, duk_codepoint_t codepoint);
 typedef duk_codepoint_t (*duk_map_char_function) (void *udata, duk_codepoint_t codepoint);
 typedef duk_ret_t (*duk_safe_call_function) (duk_context *ctx, void *udata);
+typedef duk_ret_t (*duk_proxy_trap_function) (duk_context *ctx, duk_uint_t trap, void *udata);
+typedef void (*duk_sample_function) (void *udata, const duk_sample_frame *frames, duk_size_t num_frames);
+typedef void (*duk_call_stats_function) (void *udata, const duk_call_stats_entry *entry);
+typedef void (*duk_alloc_sample_function) (void *udata, duk_uint_t type, duk_size_t size, const duk_sample_frame *frames, duk_size_t num_frames);
+typedef void (*duk_heap_node_function) (void *udata, const duk_heap_node *node);
+typedef void (*duk_heap_edge_function) (void *udata, const duk_heap_edge *edge);
 typedef duk_size_t (*duk_debug_read_function) (void *udata, char *buffer, duk_size_t length);
 typedef duk_size_t (*duk_debug_write_function) (void *udata, const char *buffer, duk_size_t length);
 typedef duk_size_t (*duk_debug_peek_function) (void *udata);
@@ -268,6 +286,66 @@ struct duk_time_components {
 	duk_double_t weekday;       /* weekday: 0-6, 0=Sunday, 1=Monday, ..., 6=Saturday */
 };
 
+struct duk_strtab_stats {
+	duk_uint32_t size;          /* number of buckets */
+	duk_uint32_t min_size;      /* bucket count the table won't shrink below */
+	duk_uint32_t count;         /* number of interned strings */
+	duk_uint32_t used_buckets;  /* buckets with at least one string */
+	duk_uint32_t max_chain;     /* longest bucket chain */
+	duk_uint32_t grow_count;    /* resizes since heap creation: grow steps */
+	duk_uint32_t shrink_count;  /* resizes since heap creation: shrink steps */
+	duk_double_t probe_total;   /* string comparisons to look up every string once */
+};
+
+struct duk_sample_frame {
+	const char *name;           /* function name (CESU-8, not NUL terminated), NULL if none */
+	duk_size_t name_len;
+	const char *filename;       /* fileName of ECMAScript functions, NULL if none */
+	duk_size_t filename_len;
+	duk_uint32_t pc;            /* pc of the executing or calling instruction, 0 if native */
+	duk_uint32_t line;          /* line of 'pc', 0 if native or without pc2line data */
+	duk_uint32_t native;        /* nonzero for native functions and lightfuncs */
+};
+
+struct duk_call_stats_entry {
+	const void *key;            /* identifies the function across calls and closures */
+	const char *name;           /* function name or native label (CESU-8, not NUL terminated), NULL if none */
+	duk_size_t name_len;
+	const char *filename;       /* fileName of Ecmascript functions, NULL if none */
+	duk_size_t filename_len;
+	duk_uint32_t line;          /* first line of Ecmascript functions, 0 if unknown */
+	duk_uint32_t native;        /* nonzero for labelled native calls */
+	duk_double_t total_time;    /* milliseconds from call to return */
+	duk_double_t self_time;     /* total_time less the time spent in callees */
+};
+
+struct duk_call_stats_label {
+	const void *key;            /* reported as duk_call_stats_entry key */
+	const char *name;
+	duk_size_t name_len;
+	const char *filename;
+	duk_size_t filename_len;
+	duk_uint32_t line;
+};
+
+struct duk_heap_node {
+	const void *ptr;            /* identifies the node, and its edges' 'to' */
+	duk_uint_t kind;            /* DUK_HEAP_NODE_xxx */
+	duk_uint_t class_number;    /* DUK_HOBJECT_CLASS_xxx of objects, 0 otherwise */
+	duk_size_t size;            /* bytes allocated for the node alone */
+	const char *name;           /* string data, function name or constructor name (CESU-8, not NUL terminated), NULL if none */
+	duk_size_t name_len;
+};
+
+struct duk_heap_edge {
+	const void *from;           /* node 'ptr', NULL for roots */
+	const void *to;
+	duk_uint_t kind;            /* DUK_HEAP_EDGE_xxx */
+	duk_uint32_t index;         /* element or slot index, 0 if unused */
+	const char *name;           /* property key or description of the reference, NULL if none */
+	duk_size_t name_len;
+};
+
 /*
  *  Constants
  */
@@ -402,6 +480,33 @@ struct duk_time_components {
 /* Flags for duk_push_thread_raw() */
 #define DUK_THREAD_NEW_GLOBAL_ENV         (1U << 0)    /* create a new global environment */
 
+/* Traps for duk_push_proxy_native() */
+#define DUK_PROXY_TRAP_GET                (1U << 0)    /* [ ... target key receiver ] -> value */
+#define DUK_PROXY_TRAP_SET                (1U << 1)    /* [ ... target key value receiver ] -> success */
+#define DUK_PROXY_TRAP_HAS                (1U << 2)    /* [ ... target key ] -> found */
+#define DUK_PROXY_TRAP_DELETE_PROPERTY    (1U << 3)    /* [ ... target key ] -> success */
+#define DUK_PROXY_TRAP_OWN_KEYS           (1U << 4)    /* [ ... target ] -> array of keys */
+#define DUK_PROXY_TRAP_ALL                ((1U << 5) - 1U)
+
+/* Allocation types for duk_set_alloc_sampler() */
+#define DUK_ALLOC_TYPE_STRING             0    /* string, including in-place concatenation growth */
+#define DUK_ALLOC_TYPE_OBJECT             1    /* object, function or thread (without properties) */
+#define DUK_ALLOC_TYPE_BUFFER             2    /* buffer, including dynamic buffer growth */
+#define DUK_ALLOC_TYPE_PROPERTIES         3    /* object property table */
+
+/* Node kinds for duk_walk_heap() */
+#define DUK_HEAP_NODE_STRING              0
+#define DUK_HEAP_NODE_OBJECT              1
+#define DUK_HEAP_NODE_BUFFER              2
+
+/* Edge kinds for duk_walk_heap() */
+#define DUK_HEAP_EDGE_PROPERTY            0    /* property value, 'name' is the key */
+#define DUK_HEAP_EDGE_GETTER              1    /* accessor property getter, 'name' is the key */
+#define DUK_HEAP_EDGE_SETTER              2    /* accessor property setter, 'name' is the key */
+#define DUK_HEAP_EDGE_ELEMENT             3    /* array element, 'index' is the array index */
+#define DUK_HEAP_EDGE_INTERNAL            4    /* internal reference, 'name' describes it */
+#define DUK_HEAP_EDGE_HIDDEN              5    /* one of several like references, 'name' describes them and 'index' tells them apart */
+
 /* Flags for duk_gc() */
 #define DUK_GC_COMPACT                    (1U << 0)    /* compact heap objects */
 
@@ -492,6 +597,27 @@ DUK_EXTERNAL_DECL void duk_free(duk_context *ctx, void *ptr);
 DUK_EXTERNAL_DECL void *duk_realloc(duk_context *ctx, void *ptr, duk_size_t size);
 DUK_EXTERNAL_DECL void duk_get_memory_functions(duk_context *ctx, duk_memory_functions *out_funcs);
 DUK_EXTERNAL_DECL void duk_gc(duk_context *ctx, duk_uint_t flags);
+DUK_EXTERNAL_DECL void duk_get_strtab_stats(duk_context *ctx, duk_strtab_stats *out_stats);
+DUK_EXTERNAL_DECL void duk_set_strtab_min_size(duk_context *ctx, duk_uint32_t min_size);
+DUK_EXTERNAL_DECL void duk_set_sampling_profiler(duk_context *ctx, duk_uint32_t interval, duk_sample_function func, void *udata);
+DUK_EXTERNAL_DECL void duk_set_call_stats(duk_context *ctx, duk_call_stats_function func, void *udata);
+DUK_EXTERNAL_DECL duk_bool_t duk_set_call_stats_label(duk_context *ctx, const duk_call_stats_label *label);
+DUK_EXTERNAL_DECL void duk_set_alloc_sampler(duk_context *ctx, duk_size_t interval, duk_uint_t max_frames, duk_alloc_sample_function func, void *udata);
+DUK_EXTERNAL_DECL void duk_walk_heap(duk_context *ctx, duk_heap_node_function node_func, duk_heap_edge_function edge_func, void *udata);
+
+/*
+ *  Random numbers
+ */
+
+DUK_EXTERNAL_DECL void duk_random_seed(duk_context *ctx, duk_uint64_t seed);
+DUK_EXTERNAL_DECL void duk_random_fill(duk_context *ctx, void *out, duk_size_t count);
+DUK_EXTERNAL_DECL duk_ret_t duk_random_fill_float64array(duk_context *ctx);
+
+/*
+ *  Typed array kernels
+ */
+
+DUK_EXTERNAL_DECL void duk_push_float64_kernels(duk_context *ctx);
 
 /*
  *  Error handling
@@ -683,6 +809,7 @@ DUK_EXTERNAL_DECL duk_idx_t duk_push_c_function(duk_context *ctx, duk_c_function
 DUK_EXTERNAL_DECL duk_idx_t duk_push_c_lightfunc(duk_context *ctx, duk_c_function func, duk_idx_t nargs, duk_idx_t length, duk_int_t magic);
 DUK_EXTERNAL_DECL duk_idx_t duk_push_thread_raw(duk_context *ctx, duk_uint_t flags);
 DUK_EXTERNAL_DECL duk_idx_t duk_push_proxy(duk_context *ctx, duk_uint_t proxy_flags);
+DUK_EXTERNAL_DECL duk_idx_t duk_push_proxy_native(duk_context *ctx, duk_proxy_trap_function func, duk_uint_t traps, void *udata);
 
 #define duk_push_thread(ctx) \
 	duk_push_thread_raw((ctx), 0 /*flags*/)
@@ -984,6 +1111,11 @@ DUK_EXTERNAL_DECL const char *duk_base64_encode(duk_context *ctx, duk_idx_t idx)
 DUK_EXTERNAL_DECL void duk_base64_decode(duk_context *ctx, duk_idx_t idx);
 DUK_EXTERNAL_DECL const char *duk_hex_encode(duk_context *ctx, duk_idx_t idx);
 DUK_EXTERNAL_DECL void duk_hex_decode(duk_context *ctx, duk_idx_t idx);
+DUK_EXTERNAL_DECL void duk_base64_encode_raw(const void *src, duk_size_t len, void *dst);
+DUK_EXTERNAL_DECL duk_bool_t duk_base64_decode_raw(const void *src, duk_size_t len, void *dst, duk_size_t *out_len);
+DUK_EXTERNAL_DECL void duk_hex_encode_raw(const void *src, duk_size_t len, void *dst);
+DUK_EXTERNAL_DECL duk_bool_t duk_hex_decode_raw(const void *src, duk_size_t len, void *dst);
+DUK_EXTERNAL_DECL duk_size_t duk_ascii_span(const void *buf, duk_size_t len);
 DUK_EXTERNAL_DECL const char *duk_json_encode(duk_context *ctx, duk_idx_t idx);
 DUK_EXTERNAL_DECL void duk_json_decode(duk_context *ctx, duk_idx_t idx);
 
@@ -201,6 +201,25 @@ pub const DUK_DEFPROP_ATTR_WE: u32 = 59;
 pub const DUK_DEFPROP_ATTR_WC: u32 = 61;
 pub const DUK_DEFPROP_ATTR_WEC: u32 = 63;
 pub const DUK_THREAD_NEW_GLOBAL_ENV: u32 = 1;
+pub const DUK_PROXY_TRAP_GET: u32 = 1;
+pub const DUK_PROXY_TRAP_SET: u32 = 2;
+pub const DUK_PROXY_TRAP_HAS: u32 = 4;
+pub const DUK_PROXY_TRAP_DELETE_PROPERTY: u32 = 8;
+pub const DUK_PROXY_TRAP_OWN_KEYS: u32 = 16;
+pub const DUK_PROXY_TRAP_ALL: u32 = 31;
+pub const DUK_ALLOC_TYPE_STRING: u32 = 0;
+pub const DUK_ALLOC_TYPE_OBJECT: u32 = 1;
+pub const DUK_ALLOC_TYPE_BUFFER: u32 = 2;
+pub const DUK_ALLOC_TYPE_PROPERTIES: u32 = 3;
+pub const DUK_HEAP_NODE_STRING: u32 = 0;
+pub const DUK_HEAP_NODE_OBJECT: u32 = 1;
+pub const DUK_HEAP_NODE_BUFFER: u32 = 2;
+pub const DUK_HEAP_EDGE_PROPERTY: u32 = 0;
+pub const DUK_HEAP_EDGE_GETTER: u32 = 1;
+pub const DUK_HEAP_EDGE_SETTER: u32 = 2;
+pub const DUK_HEAP_EDGE_ELEMENT: u32 = 3;
+pub const DUK_HEAP_EDGE_INTERNAL: u32 = 4;
+pub const DUK_HEAP_EDGE_HIDDEN: u32 = 5;
 pub const DUK_GC_COMPACT: u32 = 1;
 pub const DUK_ERR_NONE: u32 = 0;
 pub const DUK_ERR_ERROR: u32 = 1;
@@ -343,6 +362,38 @@ pub struct duk_hthread {
 pub type duk_context = duk_hthread;
 pub type duk_c_function =
     ::std::option::Option<unsafe extern "C" fn(ctx: *mut duk_context) -> duk_ret_t>;
+pub type duk_proxy_trap_function = ::std::option::Option<
+    unsafe extern "C" fn(
+        ctx: *mut duk_context,
+        trap: duk_uint_t,
+        udata: *mut ::std::os::raw::c_void,
+    ) -> duk_ret_t,
+>;
+pub type duk_sample_function = ::std::option::Option<
+    unsafe extern "C" fn(
+        udata: *mut ::std::os::raw::c_void,
+        frames: *const duk_sample_frame,
+        num_frames: duk_size_t,
+    ),
+>;
+pub type duk_call_stats_function = ::std::option::Option<
+    unsafe extern "C" fn(udata: *mut ::std::os::raw::c_void, entry: *const duk_call_stats_entry),
+>;
+pub type duk_alloc_sample_function = ::std::option::Option<
+    unsafe extern "C" fn(
+        udata: *mut ::std::os::raw::c_void,
+        type_: duk_uint_t,
+        size: duk_size_t,
+        frames: *const duk_sample_frame,
+        num_frames: duk_size_t,
+    ),
+>;
+pub type duk_heap_node_function = ::std::option::Option<
+    unsafe extern "C" fn(udata: *mut ::std::os::raw::c_void, node: *const duk_heap_node),
+>;
+pub type duk_heap_edge_function = ::std::option::Option<
+    unsafe extern "C" fn(udata: *mut ::std::os::raw::c_void, edge: *const duk_heap_edge),
+>;
 pub type duk_alloc_function = ::std::option::Option<
     unsafe extern "C" fn(udata: *mut ::std::os::raw::c_void, size: duk_size_t)
         -> *mut ::std::os::raw::c_void,
@@ -687,6 +738,570 @@ fn bindgen_test_layout_duk_time_components() {
         )
     );
 }
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct duk_strtab_stats {
+    pub size: duk_uint32_t,
+    pub min_size: duk_uint32_t,
+    pub count: duk_uint32_t,
+    pub used_buckets: duk_uint32_t,
+    pub max_chain: duk_uint32_t,
+    pub grow_count: duk_uint32_t,
+    pub shrink_count: duk_uint32_t,
+    pub probe_total: duk_double_t,
+}
+#[test]
+fn bindgen_test_layout_duk_strtab_stats() {
+    assert_eq!(
+        ::std::mem::size_of::<duk_strtab_stats>(),
+        40usize,
+        concat!("Size of: ", stringify!(duk_strtab_stats))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duk_strtab_stats>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duk_strtab_stats))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).size as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(size)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).min_size as *const _ as usize },
+        4usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(min_size)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).count as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(count)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).used_buckets as *const _ as usize },
+        12usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(used_buckets)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).max_chain as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(max_chain)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).grow_count as *const _ as usize },
+        20usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(grow_count)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).shrink_count as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(shrink_count)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_strtab_stats>())).probe_total as *const _ as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_strtab_stats),
+            "::",
+            stringify!(probe_total)
+        )
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct duk_sample_frame {
+    pub name: *const ::std::os::raw::c_char,
+    pub name_len: duk_size_t,
+    pub filename: *const ::std::os::raw::c_char,
+    pub filename_len: duk_size_t,
+    pub pc: duk_uint32_t,
+    pub line: duk_uint32_t,
+    pub native: duk_uint32_t,
+}
+#[test]
+fn bindgen_test_layout_duk_sample_frame() {
+    assert_eq!(
+        ::std::mem::size_of::<duk_sample_frame>(),
+        48usize,
+        concat!("Size of: ", stringify!(duk_sample_frame))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duk_sample_frame>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duk_sample_frame))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).name as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(name)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).name_len as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(name_len)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).filename as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(filename)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).filename_len as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(filename_len)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).pc as *const _ as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(pc)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).line as *const _ as usize },
+        36usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(line)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_sample_frame>())).native as *const _ as usize },
+        40usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_sample_frame),
+            "::",
+            stringify!(native)
+        )
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct duk_call_stats_entry {
+    pub key: *const ::std::os::raw::c_void,
+    pub name: *const ::std::os::raw::c_char,
+    pub name_len: duk_size_t,
+    pub filename: *const ::std::os::raw::c_char,
+    pub filename_len: duk_size_t,
+    pub line: duk_uint32_t,
+    pub native: duk_uint32_t,
+    pub total_time: duk_double_t,
+    pub self_time: duk_double_t,
+}
+#[test]
+fn bindgen_test_layout_duk_call_stats_entry() {
+    assert_eq!(
+        ::std::mem::size_of::<duk_call_stats_entry>(),
+        64usize,
+        concat!("Size of: ", stringify!(duk_call_stats_entry))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duk_call_stats_entry>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duk_call_stats_entry))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).key as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(key)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).name as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(name)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).name_len as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(name_len)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).filename as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(filename)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).filename_len as *const _ as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(filename_len)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).line as *const _ as usize },
+        40usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(line)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).native as *const _ as usize },
+        44usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(native)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).total_time as *const _ as usize },
+        48usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(total_time)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_entry>())).self_time as *const _ as usize },
+        56usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_entry),
+            "::",
+            stringify!(self_time)
+        )
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct duk_call_stats_label {
+    pub key: *const ::std::os::raw::c_void,
+    pub name: *const ::std::os::raw::c_char,
+    pub name_len: duk_size_t,
+    pub filename: *const ::std::os::raw::c_char,
+    pub filename_len: duk_size_t,
+    pub line: duk_uint32_t,
+}
+#[test]
+fn bindgen_test_layout_duk_call_stats_label() {
+    assert_eq!(
+        ::std::mem::size_of::<duk_call_stats_label>(),
+        48usize,
+        concat!("Size of: ", stringify!(duk_call_stats_label))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duk_call_stats_label>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duk_call_stats_label))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_label>())).key as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_label),
+            "::",
+            stringify!(key)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_label>())).name as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_label),
+            "::",
+            stringify!(name)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_label>())).name_len as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_label),
+            "::",
+            stringify!(name_len)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_label>())).filename as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_label),
+            "::",
+            stringify!(filename)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_label>())).filename_len as *const _ as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_label),
+            "::",
+            stringify!(filename_len)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_call_stats_label>())).line as *const _ as usize },
+        40usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_call_stats_label),
+            "::",
+            stringify!(line)
+        )
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct duk_heap_node {
+    pub ptr: *const ::std::os::raw::c_void,
+    pub kind: duk_uint_t,
+    pub class_number: duk_uint_t,
+    pub size: duk_size_t,
+    pub name: *const ::std::os::raw::c_char,
+    pub name_len: duk_size_t,
+}
+#[test]
+fn bindgen_test_layout_duk_heap_node() {
+    assert_eq!(
+        ::std::mem::size_of::<duk_heap_node>(),
+        40usize,
+        concat!("Size of: ", stringify!(duk_heap_node))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duk_heap_node>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duk_heap_node))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_node>())).ptr as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_node),
+            "::",
+            stringify!(ptr)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_node>())).kind as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_node),
+            "::",
+            stringify!(kind)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_node>())).class_number as *const _ as usize },
+        12usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_node),
+            "::",
+            stringify!(class_number)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_node>())).size as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_node),
+            "::",
+            stringify!(size)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_node>())).name as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_node),
+            "::",
+            stringify!(name)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_node>())).name_len as *const _ as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_node),
+            "::",
+            stringify!(name_len)
+        )
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct duk_heap_edge {
+    pub from: *const ::std::os::raw::c_void,
+    pub to: *const ::std::os::raw::c_void,
+    pub kind: duk_uint_t,
+    pub index: duk_uint32_t,
+    pub name: *const ::std::os::raw::c_char,
+    pub name_len: duk_size_t,
+}
+#[test]
+fn bindgen_test_layout_duk_heap_edge() {
+    assert_eq!(
+        ::std::mem::size_of::<duk_heap_edge>(),
+        40usize,
+        concat!("Size of: ", stringify!(duk_heap_edge))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duk_heap_edge>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duk_heap_edge))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_edge>())).from as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_edge),
+            "::",
+            stringify!(from)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_edge>())).to as *const _ as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_edge),
+            "::",
+            stringify!(to)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_edge>())).kind as *const _ as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_edge),
+            "::",
+            stringify!(kind)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_edge>())).index as *const _ as usize },
+        20usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_edge),
+            "::",
+            stringify!(index)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_edge>())).name as *const _ as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_edge),
+            "::",
+            stringify!(name)
+        )
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<duk_heap_edge>())).name_len as *const _ as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(duk_heap_edge),
+            "::",
+            stringify!(name_len)
+        )
+    );
+}
 extern "C" {
     pub fn duk_create_heap(
         alloc_func: duk_alloc_function,
@@ -737,6 +1352,66 @@ extern "C" {
 extern "C" {
     pub fn duk_gc(ctx: *mut duk_context, flags: duk_uint_t);
 }
+extern "C" {
+    pub fn duk_get_strtab_stats(ctx: *mut duk_context, out_stats: *mut duk_strtab_stats);
+}
+extern "C" {
+    pub fn duk_set_strtab_min_size(ctx: *mut duk_context, min_size: duk_uint32_t);
+}
+extern "C" {
+    pub fn duk_set_sampling_profiler(
+        ctx: *mut duk_context,
+        interval: duk_uint32_t,
+        func: duk_sample_function,
+        udata: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    pub fn duk_set_call_stats(
+        ctx: *mut duk_context,
+        func: duk_call_stats_function,
+        udata: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    pub fn duk_set_call_stats_label(
+        ctx: *mut duk_context,
+        label: *const duk_call_stats_label,
+    ) -> duk_bool_t;
+}
+extern "C" {
+    pub fn duk_set_alloc_sampler(
+        ctx: *mut duk_context,
+        interval: duk_size_t,
+        max_frames: duk_uint_t,
+        func: duk_alloc_sample_function,
+        udata: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    pub fn duk_walk_heap(
+        ctx: *mut duk_context,
+        node_func: duk_heap_node_function,
+        edge_func: duk_heap_edge_function,
+        udata: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    pub fn duk_random_seed(ctx: *mut duk_context, seed: duk_uint64_t);
+}
+extern "C" {
+    pub fn duk_random_fill(
+        ctx: *mut duk_context,
+        out: *mut ::std::os::raw::c_void,
+        count: duk_size_t,
+    );
+}
+extern "C" {
+    pub fn duk_random_fill_float64array(ctx: *mut duk_context) -> duk_ret_t;
+}
+extern "C" {
+    pub fn duk_push_float64_kernels(ctx: *mut duk_context);
+}
 extern "C" {
     pub fn duk_throw_raw(ctx: *mut duk_context);
 }
@@ -946,6 +1621,14 @@ extern "C" {
 extern "C" {
     pub fn duk_push_proxy(ctx: *mut duk_context, proxy_flags: duk_uint_t) -> duk_idx_t;
 }
+extern "C" {
+    pub fn duk_push_proxy_native(
+        ctx: *mut duk_context,
+        func: duk_proxy_trap_function,
+        traps: duk_uint_t,
+        udata: *mut ::std::os::raw::c_void,
+    ) -> duk_idx_t;
+}
 extern "C" {
     pub fn duk_push_error_object_raw(
         ctx: *mut duk_context,
@@ -1454,6 +2137,38 @@ extern "C" {
 extern "C" {
     pub fn duk_hex_decode(ctx: *mut duk_context, idx: duk_idx_t);
 }
+extern "C" {
+    pub fn duk_base64_encode_raw(
+        src: *const ::std::os::raw::c_void,
+        len: duk_size_t,
+        dst: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    pub fn duk_base64_decode_raw(
+        src: *const ::std::os::raw::c_void,
+        len: duk_size_t,
+        dst: *mut ::std::os::raw::c_void,
+        out_len: *mut duk_size_t,
+    ) -> duk_bool_t;
+}
+extern "C" {
+    pub fn duk_hex_encode_raw(
+        src: *const ::std::os::raw::c_void,
+        len: duk_size_t,
+        dst: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    pub fn duk_hex_decode_raw(
+        src: *const ::std::os::raw::c_void,
+        len: duk_size_t,
+        dst: *mut ::std::os::raw::c_void,
+    ) -> duk_bool_t;
+}
+extern "C" {
+    pub fn duk_ascii_span(buf: *const ::std::os::raw::c_void, len: duk_size_t) -> duk_size_t;
+}
 extern "C" {
     pub fn duk_json_encode(ctx: *mut duk_context, idx: duk_idx_t) -> *const ::std::os::raw::c_char;
 }
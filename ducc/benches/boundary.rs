@@ -0,0 +1,131 @@
+// Micro-benchmarks of the Rust API and of crossing between Rust and JavaScript. Run with
+// `cargo bench -p ducc --bench boundary`; the engine's own hot loops are in `interpreter.rs`. Pass
+// `-- --save-baseline <name>` and later `-- --baseline <name>` to compare two builds.
+
+#[macro_use]
+extern crate criterion;
+extern crate ducc;
+
+use criterion::Criterion;
+use ducc::{Array, Bytes, Ducc, Function, Invocation, Object, Result, String, Variadic};
+
+const SMALL_SCRIPT: &str = "var x = 1 + 2; x * 3;";
+
+// About 2000 lines of varied functions, to compile.
+fn large_script() -> std::string::String {
+    let mut source = std::string::String::new();
+    for i in 0..250 {
+        source.push_str(&format!(r#"
+            function f{0}(a, b) {{
+                var o = {{ k: a, v: b, s: 'name{0}' }};
+                for (var i = 0; i < a; i++) {{ o.v += i * {0}; }}
+                return o.s.length + o.v;
+            }}
+        "#, i));
+    }
+    source.push_str("f0(1, 2);");
+    source
+}
+
+fn boundary(c: &mut Criterion) {
+    c.bench_function("ducc_new", |b| b.iter(Ducc::new));
+
+    let ducc = Ducc::new();
+    let large = large_script();
+    c.bench_function("compile_small", |b| b.iter(|| ducc.compile(SMALL_SCRIPT, None).unwrap()));
+    c.bench_function("compile_large", |b| b.iter(|| ducc.compile(&large, None).unwrap()));
+    c.bench_function("exec_small", |b| b.iter(|| {
+        ducc.exec::<()>(SMALL_SCRIPT, None, Default::default()).unwrap();
+    }));
+    c.bench_function("exec_large", |b| b.iter(|| {
+        ducc.exec::<()>(&large, None, Default::default()).unwrap();
+    }));
+
+    let func: Function = ducc.exec("(function () { return arguments.length; })", None,
+        Default::default()).unwrap();
+    c.bench_function("call_0_args", |b| b.iter(|| {
+        assert_eq!(func.call::<_, u32>(()).unwrap(), 0);
+    }));
+    c.bench_function("call_4_args", |b| b.iter(|| {
+        assert_eq!(func.call::<_, u32>((1.0, 2.0, 3.0, 4.0)).unwrap(), 4);
+    }));
+    let args = vec![1.0; 16];
+    c.bench_function("call_16_args", |b| b.iter(|| {
+        assert_eq!(func.call::<_, u32>(Variadic::from_vec(args.clone())).unwrap(), 16);
+    }));
+
+    let add = ducc.create_function(|inv: Invocation| -> Result<f64> {
+        let (a, b): (f64, f64) = inv.args.into(inv.ducc)?;
+        Ok(a + b)
+    });
+    ducc.globals().set("add", add).unwrap();
+    let callbacks: Function = ducc.compile(r#"
+        for (var i = 0, s = 0; i < 10000; i++) { s = add(s, i); }
+    "#, None).unwrap();
+    c.bench_function("rust_callback_from_js", |b| b.iter(|| {
+        callbacks.call::<_, ()>(()).unwrap();
+    }));
+
+    let object: Object = ducc.exec("({ a: 1, b: 'two', c: 3.5 })", None, Default::default())
+        .unwrap();
+    c.bench_function("object_get", |b| b.iter(|| object.get::<_, f64>("c").unwrap()));
+    c.bench_function("object_set", |b| b.iter(|| object.set("a", 2.0).unwrap()));
+
+    let array: Array = ducc.exec("var a = []; for (var i = 0; i < 10000; i++) { a.push(i); } a",
+        None, Default::default()).unwrap();
+    c.bench_function("array_elements", |b| b.iter(|| {
+        let sum: f64 = array.clone().elements::<f64>().map(|value| value.unwrap()).sum();
+        assert!(sum > 0.0);
+    }));
+    c.bench_function("array_get_index", |b| b.iter(|| {
+        for i in 0..10000 {
+            array.get::<f64>(i).unwrap();
+        }
+    }));
+
+    let ascii = "The quick brown fox jumps over the lazy dog. ".repeat(20);
+    let unicode = "Příliš žluťoučký kůň úpěl ďábelské ódy 🦊. ".repeat(20);
+    c.bench_function("string_ascii_roundtrip", |b| b.iter(|| {
+        ducc.create_string(&ascii).unwrap().to_string().unwrap()
+    }));
+    c.bench_function("string_unicode_roundtrip", |b| b.iter(|| {
+        ducc.create_string(&unicode).unwrap().to_string().unwrap()
+    }));
+    let js_string: String = ducc.exec(&format!("{:?}", unicode), None, Default::default())
+        .unwrap();
+    c.bench_function("string_unicode_to_rust", |b| b.iter(|| js_string.to_string().unwrap()));
+
+    let payload = vec![0xa5u8; 64 * 1024];
+    c.bench_function("bytes_to_js", |b| b.iter(|| ducc.create_bytes(&payload).unwrap()));
+    let bytes: Bytes = ducc.create_bytes(&payload).unwrap();
+    c.bench_function("bytes_to_rust", |b| b.iter(|| bytes.to_vec()));
+
+    let json: Function = ducc.compile(r#"
+        var rows = [];
+        for (var i = 0; i < 1000; i++) {
+            rows.push({ id: i, name: 'row ' + i, tags: ['a', 'b'], score: i / 3 });
+        }
+        JSON.parse(JSON.stringify(rows)).length;
+    "#, None).unwrap();
+    c.bench_function("json_roundtrip", |b| b.iter(|| json.call::<_, ()>(()).unwrap()));
+
+    // Allocates garbage while a large live set is held, so that collections have work to do.
+    let gc: Function = ducc.compile(r#"
+        var live = [];
+        for (var i = 0; i < 20000; i++) { live.push({ i: i, next: null }); }
+        for (var k = 0; k < 50000; k++) {
+            var tmp = { a: [k, k + 1], b: 'x' + k };
+            tmp.self = tmp;
+            live[k % live.length].next = tmp;
+        }
+    "#, None).unwrap();
+    c.bench_function("gc_under_load", |b| b.iter(|| gc.call::<_, ()>(()).unwrap()));
+}
+
+criterion_group! {
+    name = benches;
+    // Several cases run for milliseconds per iteration.
+    config = Criterion::default().sample_size(20);
+    targets = boundary
+}
+criterion_main!(benches);
@@ -0,0 +1,303 @@
+// Interpreter-bound micro-benchmarks. Run with `cargo bench -p ducc --bench interpreter`. To see
+// the effect of a `ducc-sys` feature such as `use-exec-computed-goto`, run once with
+// `-- --save-baseline <name>` and then against a build without it with `-- --baseline <name>`.
+
+#[macro_use]
+extern crate criterion;
+extern crate ducc;
+
+use criterion::Criterion;
+use ducc::{
+    ClassBuilder, Ducc, HostObject, Object, PropertyDescriptor, ProxyHandler, Result, ToValue,
+    Value, Values,
+};
+
+const CASES: &[(&str, &str)] = &[
+    ("arith_loop", r#"
+        var s = 0;
+        for (var i = 0; i < 300000; i++) {
+            s = (s + i * 3) % 1000003;
+            if (s & 1) { s ^= 5; }
+        }
+        s;
+    "#),
+    ("fib_recursive", r#"
+        function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+        fib(20);
+    "#),
+    ("array_sum", r#"
+        var a = [];
+        for (var i = 0; i < 20000; i++) { a[i] = i; }
+        var t = 0;
+        for (var k = 0; k < 10; k++) {
+            for (var j = 0; j < a.length; j++) { t += a[j]; }
+        }
+        t;
+    "#),
+    ("property_access", r#"
+        var objs = [];
+        for (var i = 0; i < 100; i++) { objs.push({ a: i, b: i * 2, c: 3, d: 4 }); }
+        var s = 0;
+        for (var k = 0; k < 1000; k++) {
+            for (var j = 0; j < objs.length; j++) {
+                var o = objs[j];
+                s += o.a + o.d;
+                o.c = s & 7;
+            }
+        }
+        s;
+    "#),
+    ("string_build", r#"
+        var parts = [];
+        for (var i = 0; i < 20000; i++) { parts.push('x' + (i % 10)); }
+        parts.join('').length;
+    "#),
+    ("array_methods", r#"
+        var a = [];
+        for (var i = 0; i < 200000; i++) { a.push(i); }
+        var m = a.map(function (v) { return v + 1; });
+        var c = a.slice(10).concat(m);
+        c.length + a.indexOf(199999) + a.lastIndexOf(0);
+    "#),
+    ("array_sort", r#"
+        var recs = [];
+        for (var i = 0; i < 50000; i++) { recs.push({ k: (i * 2654435761) % 1000003 }); }
+        recs.sort(function (a, b) { return a.k - b.k; });
+        recs.map(function (r) { return r.k; }).sort()[0];
+    "#),
+    ("regexp_match", r#"
+        var s = '';
+        for (var i = 0; i < 2000; i++) { s += 'key' + i + ' = "value ' + i + '"\n'; }
+        var re = /(\w+) = "([^"]*)"/g, m, n = 0;
+        while ((m = re.exec(s)) !== null) { n += m[2].length; }
+        var t = ''; for (var j = 0; j < 5000; j++) { t += 'a'; }
+        n + /(a+)+b/.test(t);
+    "#),
+    ("regexp_build", r#"
+        var words = ['alpha', 'beta', 'gamma', 'delta'], n = 0;
+        for (var i = 0; i < 20000; i++) {
+            if (new RegExp('\\b' + words[i & 3] + '(\\d+)').test('x alpha12 beta3')) { n++; }
+        }
+        var s = []; for (var j = 0; j < 20000; j++) { s.push('lorem ipsum ' + j); }
+        n + s.join(';').search(/needle/);
+    "#),
+    ("string_append", r#"
+        function render(n) {
+            var html = '';
+            for (var i = 0; i < n; i++) { html += '<li data-id="' + i + '">item ' + i + '</li>\n'; }
+            return html;
+        }
+        render(5000).length;
+    "#),
+    ("string_index_unicode", r#"
+        function make(n) {
+            var s = '';
+            for (var i = 0; i < n; i++) { s += i % 7 ? 'a' : '\u00e9'; }
+            return s;
+        }
+        var s = make(100000), seed = 1, acc = 0;
+        for (var k = 0; k < 20000; k++) {
+            seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+            acc += s.charCodeAt(seed % s.length) + s.substring(seed % 5000, seed % 5000 + 2).length;
+        }
+        acc;
+    "#),
+    ("string_search", r#"
+        var lines = [];
+        for (var i = 0; i < 20000; i++) { lines.push('GET /api/v1/items/' + i + ' HTTP/1.1 200' + (i % 3 ? '' : ' \u00e9')); }
+        var log = lines.join('\n'), n = 0;
+        for (var k = 0; k < 20; k++) {
+            n += log.indexOf('items/19999 ') + log.split('\n').length + (log.includes('HTTP/2') ? 1 : 0);
+            n += log.replace('items/15000 ', 'x').length;
+        }
+        n;
+    "#),
+    ("json_numbers", r#"
+        var rows = [];
+        for (var i = 0; i < 2000; i++) {
+            rows.push({ id: 1500000000000 + i * 7919, x: i / 7, y: -i * 0.001, z: i });
+        }
+        var len = 0;
+        for (var k = 0; k < 10; k++) {
+            var text = JSON.stringify(rows);
+            len += JSON.parse(text).length + text.length;
+        }
+        len;
+    "#),
+    ("text_codecs", r#"
+        var parts = [];
+        for (var i = 0; i < 5000; i++) { parts.push('{"id":' + i + ',"name":"item' + i + '"}'); }
+        var text = parts.join(','), n = 0;
+        for (var k = 0; k < 20; k++) {
+            n += new TextDecoder().decode(new TextEncoder().encode(text)).length;
+        }
+        n;
+    "#),
+    ("random", r#"
+        var a = new Float64Array(1 << 16), s = 0;
+        for (var i = 0; i < 200000; i++) { s += Math.random(); }
+        for (var k = 0; k < 50; k++) { s += fillRandom(a)[k]; }
+        s;
+    "#),
+    ("typed_arrays", r#"
+        var n = 1 << 16, f = new Float64Array(n), i32 = new Int32Array(n), u8 = new Uint8Array(n), arr = [];
+        for (var i = 0; i < n; i++) { arr.push(i * 0.5); i32[i] = i; }
+        for (var k = 0; k < 20; k++) {
+            f.set(i32);
+            f.set(arr);
+            u8.set(f);
+            f.fill(k).copyWithin(1, 0);
+            f64.mul(f, f, 0.5);
+        }
+        f64.sum(f.slice(1)) + u8[n - 1];
+    "#),
+    ("dates", r#"
+        var acc = 0;
+        for (var i = 0; i < 2000; i++) {
+            var d = new Date(1.6e12 + i * 3600000);
+            acc += d.getHours() + d.getDate() + d.getMonth();
+            acc += Date.parse(d.toISOString()) & 1;
+            acc += new Date(2020, i % 12, 1 + i % 28, 12).getTime() & 1;
+        }
+        acc;
+    "#),
+    ("proxy_native_get", r#"
+        (function (grid) {
+            var s = 0;
+            for (var i = 0; i < 10000; i++) { s += grid[i & 255] + grid.length; }
+            return s;
+        })(nativeGrid);
+    "#),
+    ("proxy_function_get", r#"
+        (function (grid) {
+            var s = 0;
+            for (var i = 0; i < 10000; i++) { s += grid[i & 255] + grid.length; }
+            return s;
+        })(new Proxy({}, { get: gridGet }));
+    "#),
+    ("host_object_fields", r#"
+        (function (point) {
+            var s = 0;
+            for (var i = 0; i < 10000; i++) { s += point.x * point.y + point.z; }
+            return s;
+        })(hostPoint);
+    "#),
+    ("getter_fields", r#"
+        (function (point) {
+            var s = 0;
+            for (var i = 0; i < 10000; i++) { s += point.x * point.y + point.z; }
+            return s;
+        })(getterPoint);
+    "#),
+    ("class_methods", r#"
+        (function (point) {
+            var s = 0;
+            for (var i = 0; i < 10000; i++) { s += point.dot(point) + point.norm(); }
+            return s;
+        })(classPoint);
+    "#),
+    ("closure_calls", r#"
+        function make(n) { return function (x) { return x + n; }; }
+        var add = make(1), v = 0;
+        for (var i = 0; i < 100000; i++) { v = add(v); }
+        v;
+    "#),
+];
+
+struct Point {
+    x: f64,
+    y: f64,
+    z: f64,
+}
+
+impl Point {
+    fn dot(&self, other: &Point) -> f64 {
+        self.x * other.x + self.y * other.y + self.z * other.z
+    }
+}
+
+impl HostObject for Point {
+    fn get<'ducc>(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<Value<'ducc>>> {
+        Ok(match key {
+            "x" => Some(self.x.to_value(ducc)?),
+            "y" => Some(self.y.to_value(ducc)?),
+            "z" => Some(self.z.to_value(ducc)?),
+            _ => None,
+        })
+    }
+}
+
+fn interpreter(c: &mut Criterion) {
+    let ducc = Ducc::new();
+    ducc.globals().set("fillRandom", ducc.create_fill_random()).unwrap();
+    ducc.globals().set("f64", ducc.create_float64_kernels()).unwrap();
+    // The same virtual object, once with a native trap and once with a Rust function as the trap.
+    let grid = ProxyHandler::new().get(|_, key| Ok(match key.parse::<u32>() {
+        Ok(index) => index * 2,
+        Err(_) => 256,
+    }));
+    let grid = ducc.create_proxy(&ducc.create_object(), grid);
+    ducc.globals().set("nativeGrid", grid).unwrap();
+    let grid_get = ducc.create_function(|invocation| -> Result<u32> {
+        Ok(match invocation.args.get(1) {
+            Value::Number(index) => index as u32 * 2,
+            _ => 256,
+        })
+    });
+    ducc.globals().set("gridGet", grid_get).unwrap();
+
+    // The same Rust struct, once as a host object and once through a getter function per field.
+    ducc.globals().set("hostPoint", ducc.create_host_object(Point { x: 1.0, y: 2.0, z: 3.0 }))
+        .unwrap();
+    let getter_point = ducc.create_object();
+    for &(key, value) in &[("x", 1.0), ("y", 2.0), ("z", 3.0)] {
+        let getter = ducc.create_function(move |_| Ok(value));
+        getter_point.define_prop(key, PropertyDescriptor::new().getter(getter)).unwrap();
+    }
+    ducc.globals().set("getterPoint", getter_point).unwrap();
+
+    // One shared prototype for every instance, against a fresh set of method functions per object.
+    let class = ducc.create_class(ClassBuilder::<Point>::new()
+        .method("dot", |ducc, this, args: Values| {
+            let other: Object = args.from(ducc, 0)?;
+            Ok(this.dot(&Point {
+                x: other.get("x")?,
+                y: other.get("y")?,
+                z: other.get("z")?,
+            }))
+        })
+        .method("norm", |_, this, _| Ok(this.dot(this).sqrt()))
+        .method("x", |_, this, _| Ok(this.x))
+        .method("y", |_, this, _| Ok(this.y))
+        .method("z", |_, this, _| Ok(this.z)));
+    let mut group = c.benchmark_group("interpreter");
+    // Most cases run for milliseconds per iteration.
+    group.sample_size(10);
+    group.bench_function("class_create", |b| b.iter_with_large_drop(|| {
+        (0..10000).map(|i| class.create(Point { x: i as f64, y: 2.0, z: 3.0 }))
+            .collect::<Vec<_>>()
+    }));
+    group.bench_function("closure_object_create", |b| b.iter_with_large_drop(|| {
+        (0..10000).map(|i| {
+            let object = ducc.create_object();
+            for &name in &["dot", "norm", "x", "y", "z"] {
+                object.set(name, ducc.create_function(move |_| Ok(i))).unwrap();
+            }
+            object
+        }).collect::<Vec<_>>()
+    }));
+    let class_point = class.create(Point { x: 1.0, y: 2.0, z: 3.0 });
+    class_point.set("x", 1.0).unwrap();
+    class_point.set("y", 2.0).unwrap();
+    class_point.set("z", 3.0).unwrap();
+    ducc.globals().set("classPoint", class_point).unwrap();
+
+    for &(name, source) in CASES {
+        let func = ducc.compile(source, Some(name)).unwrap();
+        group.bench_function(name, |b| b.iter(|| func.call::<_, ()>(()).unwrap()));
+    }
+    group.finish();
+}
+
+criterion_group!(benches, interpreter);
+criterion_main!(benches);
@@ -0,0 +1,243 @@
+use ducc::Ducc;
+use error::{Error, Result};
+use ffi;
+use function::create_callback;
+use object::Object;
+use stats::CallLabel;
+use std::any::type_name;
+use std::cell::RefCell;
+use std::marker::PhantomData;
+use std::panic::Location;
+use std::os::raw::c_void;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use types::Callback;
+use value::{ToValue, Value, Values};
+
+/// A builder for a JavaScript class backed by the Rust type `T`, with methods shared by all of its
+/// instances. Turned into a [`Class`] with [`Ducc::create_class`].
+///
+/// The methods are created once, as native functions on a single prototype object. An instance
+/// is an ordinary object inheriting from that prototype, holding a boxed `T` in a hidden property,
+/// so creating one allocates no function objects and costs the same however many methods the
+/// class has. The boxed value is dropped by a finalizer (one function shared by all instances)
+/// when the instance is garbage collected.
+///
+/// Calling a method with a `this` that isn't an instance of the class throws a `TypeError`.
+///
+/// [`Class`]: struct.Class.html
+/// [`Ducc::create_class`]: struct.Ducc.html#method.create_class
+pub struct ClassBuilder<'callback, T> {
+    id: usize,
+    methods: Vec<(String, Callback<'callback, 'static>)>,
+    _type: PhantomData<fn(T)>,
+}
+
+impl<'callback, T: 'static + Send> ClassBuilder<'callback, T> {
+    /// Creates a builder for a class without any methods.
+    pub fn new() -> ClassBuilder<'callback, T> {
+        static NEXT_ID: AtomicUsize = AtomicUsize::new(1);
+        ClassBuilder {
+            id: NEXT_ID.fetch_add(1, Ordering::Relaxed),
+            methods: Vec::new(),
+            _type: PhantomData,
+        }
+    }
+
+    /// Adds a method, called as `func(ducc, this, args)` with `this` borrowing the instance's
+    /// value.
+    ///
+    /// In `Ducc::function_stats`, the method is identified by its name and the source location of
+    /// the call to `method`.
+    #[track_caller]
+    pub fn method<R, F>(mut self, name: &str, func: F) -> ClassBuilder<'callback, T>
+    where
+        R: ToValue<'callback>,
+        F: 'static + Send + Fn(&'callback Ducc, &T, Values<'callback>) -> Result<R>,
+    {
+        let id = self.id;
+        let label = CallLabel::new(name.to_string(), Location::caller());
+        self.methods.push((name.to_string(), Box::new(move |ducc, this, args| {
+            label.set(ducc);
+            let (_owner, instance) = unsafe { get_instance::<T>(ducc, id, &this)? };
+            let value = instance.try_borrow().map_err(|_| Error::recursive_mut_callback())?;
+            func(ducc, &*value, args)?.to_value(ducc)
+        })));
+        self
+    }
+
+    /// Adds a method that mutates the instance's value. Calling back into any method of the same
+    /// instance while it runs returns an error.
+    #[track_caller]
+    pub fn method_mut<R, F>(mut self, name: &str, func: F) -> ClassBuilder<'callback, T>
+    where
+        R: ToValue<'callback>,
+        F: 'static + Send + Fn(&'callback Ducc, &mut T, Values<'callback>) -> Result<R>,
+    {
+        let id = self.id;
+        let label = CallLabel::new(name.to_string(), Location::caller());
+        self.methods.push((name.to_string(), Box::new(move |ducc, this, args| {
+            label.set(ducc);
+            let (_owner, instance) = unsafe { get_instance::<T>(ducc, id, &this)? };
+            let mut value = instance.try_borrow_mut().map_err(|_| Error::recursive_mut_callback())?;
+            func(ducc, &mut *value, args)?.to_value(ducc)
+        })));
+        self
+    }
+}
+
+/// A class created from a [`ClassBuilder`], used to wrap values of `T` as instances.
+///
+/// [`ClassBuilder`]: struct.ClassBuilder.html
+pub struct Class<'ducc, T> {
+    id: usize,
+    prototype: Object<'ducc>,
+    finalizer: Object<'ducc>,
+    _type: PhantomData<fn(T)>,
+}
+
+impl<'ducc, T: 'static + Send> Class<'ducc, T> {
+    /// Returns the prototype shared by all instances, which holds the class's methods.
+    pub fn prototype(&self) -> &Object<'ducc> {
+        &self.prototype
+    }
+
+    /// Wraps `value` in a new instance of the class. The value is dropped when the instance is
+    /// garbage collected.
+    pub fn create(&self, value: T) -> Object<'ducc> {
+        let ducc = self.prototype.0.ducc;
+        unsafe {
+            assert_stack!(ducc.ctx, 0, {
+                ffi::duk_require_stack(ducc.ctx, 3);
+                ffi::duk_push_object(ducc.ctx);
+                ducc.push_ref(&self.prototype.0);
+                ffi::duk_set_prototype(ducc.ctx, -2);
+                // On the instance rather than the prototype, so that changing the instance's
+                // prototype doesn't leak the box.
+                ducc.push_ref(&self.finalizer.0);
+                ffi::duk_set_finalizer(ducc.ctx, -2);
+                let instance = Box::new(Instance {
+                    header: Header {
+                        class_id: self.id,
+                        owner: ffi::duk_get_heapptr(ducc.ctx, -1),
+                        drop: drop_instance::<T>,
+                        borrowed: instance_borrowed::<T>,
+                    },
+                    value: RefCell::new(value),
+                });
+                ffi::duk_push_pointer(ducc.ctx, Box::into_raw(instance) as *mut _);
+                ffi::duk_put_prop_string(ducc.ctx, -2, DATA.as_ptr() as *const _);
+                Object(ducc.pop_ref())
+            })
+        }
+    }
+}
+
+const DATA: [i8; 6] = hidden_i8str!('d', 'a', 't', 'a');
+
+// Every instance's box starts with a `Header`, so the class and the drop function can be read
+// without knowing `T`. The header records the object the box was created for: objects inheriting
+// from an instance (`Object.create(instance)`) see its hidden property and its finalizer too, and
+// must not drop a box they don't own.
+#[repr(C)]
+struct Header {
+    class_id: usize,
+    owner: *mut c_void,
+    drop: unsafe fn(*mut Header),
+    borrowed: unsafe fn(*mut Header) -> bool,
+}
+
+#[repr(C)]
+struct Instance<T> {
+    header: Header,
+    value: RefCell<T>,
+}
+
+unsafe fn drop_instance<T>(header: *mut Header) {
+    drop(Box::from_raw(header as *mut Instance<T>));
+}
+
+unsafe fn instance_borrowed<T>(header: *mut Header) -> bool {
+    (*(header as *mut Instance<T>)).value.try_borrow_mut().is_err()
+}
+
+// Returns the value of the instance `this` (or that `this` inherits from), together with the
+// instance owning it. `this` only keeps the value alive while the instance stays on its prototype
+// chain, so the caller must hold on to the owner for as long as it uses the value.
+unsafe fn get_instance<'ducc, 'a, T>(
+    ducc: &'ducc Ducc,
+    class_id: usize,
+    this: &Value,
+) -> Result<(Object<'ducc>, &'a RefCell<T>)> {
+    let not_an_instance = || Error::from_js_conversion(this.type_name(), type_name::<T>());
+    let object = match *this {
+        Value::Object(ref object) => object,
+        _ => return Err(not_an_instance()),
+    };
+
+    ffi::duk_require_stack(ducc.ctx, 2);
+    ducc.push_ref(&object.0);
+    ffi::duk_get_prop_string(ducc.ctx, -1, DATA.as_ptr() as *const _);
+    let header = ffi::duk_get_pointer(ducc.ctx, -1) as *const Header;
+    ffi::duk_pop_n(ducc.ctx, 2);
+
+    if header.is_null() || (*header).class_id != class_id {
+        return Err(not_an_instance());
+    }
+    ffi::duk_push_heapptr(ducc.ctx, (*header).owner);
+    let owner = Object(ducc.pop_ref());
+    Ok((owner, &(*(header as *const Instance<T>)).value))
+}
+
+// Shared by all instances of all classes, and inherited by anything inheriting from an instance,
+// which doesn't own a box. A box that is still borrowed (which methods prevent by holding on to
+// its owner, but the heap being destroyed during a call doesn't) is leaked rather than freed
+// under the borrow.
+unsafe extern "C" fn finalizer(ctx: *mut ffi::duk_context) -> ffi::duk_ret_t {
+    ffi::duk_require_stack(ctx, 1);
+    ffi::duk_get_prop_string(ctx, 0, DATA.as_ptr() as *const _);
+    let header = ffi::duk_get_pointer(ctx, -1) as *mut Header;
+    ffi::duk_pop(ctx);
+    if !header.is_null() && (*header).owner == ffi::duk_get_heapptr(ctx, 0) {
+        if ((*header).borrowed)(header) {
+            return 0;
+        }
+        ((*header).drop)(header);
+        ffi::duk_push_undefined(ctx);
+        ffi::duk_put_prop_string(ctx, 0, DATA.as_ptr() as *const _);
+    }
+    0
+}
+
+pub(crate) fn create_class<'ducc, 'callback, T: 'static + Send>(
+    ducc: &'ducc Ducc,
+    builder: ClassBuilder<'callback, T>,
+) -> Class<'ducc, T> {
+    let prototype = ducc.create_object();
+    for (name, func) in builder.methods {
+        let func = create_callback(ducc, func);
+        unsafe {
+            assert_stack!(ducc.ctx, 0, {
+                ffi::duk_require_stack(ducc.ctx, 2);
+                ducc.push_ref(&prototype.0);
+                ducc.push_ref(&func.0);
+                ffi::duk_put_prop_lstring(
+                    ducc.ctx,
+                    -2,
+                    name.as_ptr() as *const _,
+                    name.len() as ffi::duk_size_t,
+                );
+                ffi::duk_pop(ducc.ctx);
+            })
+        }
+    }
+
+    let finalizer = unsafe {
+        assert_stack!(ducc.ctx, 0, {
+            ffi::duk_require_stack(ducc.ctx, 1);
+            ffi::duk_push_c_function(ducc.ctx, Some(finalizer), 1);
+            Object(ducc.pop_ref())
+        })
+    };
+
+    Class { id: builder.id, prototype, finalizer, _type: PhantomData }
+}
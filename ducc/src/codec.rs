@@ -0,0 +1,53 @@
+use ffi;
+use std::os::raw::c_void;
+use std::string::String as StdString;
+
+/// Encodes `bytes` as padded base64 (RFC 4648, standard alphabet).
+pub fn base64_encode(bytes: &[u8]) -> StdString {
+    let mut out = vec![0u8; (bytes.len() + 2) / 3 * 4];
+    unsafe {
+        ffi::duk_base64_encode_raw(bytes.as_ptr() as *const c_void, bytes.len(),
+            out.as_mut_ptr() as *mut c_void);
+        StdString::from_utf8_unchecked(out)
+    }
+}
+
+/// Decodes padded base64, allowing ASCII whitespace between characters. Returns `None` if `text`
+/// is not valid base64.
+pub fn base64_decode(text: &str) -> Option<Vec<u8>> {
+    let mut out = vec![0u8; (text.len() + 3) / 4 * 3];
+    let mut len = 0;
+    let ok = unsafe {
+        ffi::duk_base64_decode_raw(text.as_ptr() as *const c_void, text.len(),
+            out.as_mut_ptr() as *mut c_void, &mut len)
+    };
+    if ok == 0 {
+        return None;
+    }
+    out.truncate(len);
+    Some(out)
+}
+
+/// Encodes `bytes` as lowercase hex.
+pub fn hex_encode(bytes: &[u8]) -> StdString {
+    let mut out = vec![0u8; bytes.len() * 2];
+    unsafe {
+        ffi::duk_hex_encode_raw(bytes.as_ptr() as *const c_void, bytes.len(),
+            out.as_mut_ptr() as *mut c_void);
+        StdString::from_utf8_unchecked(out)
+    }
+}
+
+/// Decodes hex digits (either case). Returns `None` if `text` has an odd length or a character
+/// that is not a hex digit.
+pub fn hex_decode(text: &str) -> Option<Vec<u8>> {
+    let mut out = vec![0u8; text.len() / 2];
+    let ok = unsafe {
+        ffi::duk_hex_decode_raw(text.as_ptr() as *const c_void, text.len(),
+            out.as_mut_ptr() as *mut c_void)
+    };
+    if ok == 0 {
+        return None;
+    }
+    Some(out)
+}
@@ -9,12 +9,23 @@
 
 use array::Array;
 use bytes::Bytes;
+use class::{create_class, Class, ClassBuilder};
 use error::{Error, Result};
 use ffi;
 use function::{create_callback, Function, Invocation};
+use host::{create_host_object, HostObject};
 use object::Object;
+use profiler::{
+    alloc_sample_func, sample_func, AllocationProfile, AllocationProfiler, Profile, Profiler,
+};
+use proxy::{create_native_proxy, ProxyHandler};
+use snapshot::{HeapGraph, HeapSummary};
+use stats::{call_stats_func, CallLabel, FunctionStats, StatsRecorder};
 use std::any::Any;
 use std::cell::RefCell;
+use std::io::{self, Write};
+use std::panic::Location;
+use std::ptr;
 use string::String;
 use types::Ref;
 use util::{
@@ -46,6 +57,19 @@ impl Ducc {
         Ducc { ctx: unsafe { create_heap() }, is_top: true }
     }
 
+    /// Creates a new JavaScript execution environment, configuring the Duktape heap with the given
+    /// settings.
+    pub fn with_settings(settings: HeapSettings) -> Ducc {
+        let ducc = Ducc::new();
+        if let Some(size) = settings.string_table_size {
+            unsafe { ffi::duk_set_strtab_min_size(ducc.ctx, size); }
+        }
+        if let Some(seed) = settings.random_seed {
+            ducc.set_random_seed(seed);
+        }
+        ducc
+    }
+
     /// Returns the global object.
     pub fn globals(&self) -> Object {
         unsafe {
@@ -146,12 +170,18 @@ impl Ducc {
     /// If the function returns `Ok`, the contained value will be converted to one or more
     /// JavaScript values. For details on Rust-to-JavaScript conversions, refer to the `ToValue` and
     /// `ToValues` traits.
+    ///
+    /// In `function_stats`, the function is identified by the source location of the call to
+    /// `create_function`.
+    #[track_caller]
     pub fn create_function<'ducc, 'callback, R, F>(&'ducc self, func: F) -> Function<'ducc>
     where
         R: ToValue<'callback>,
         F: 'static + Send + Fn(Invocation<'callback>) -> Result<R>,
     {
+        let label = CallLabel::new("".to_string(), Location::caller());
         create_callback(self, Box::new(move |ducc, this, args| {
+            label.set(ducc);
             func(Invocation { ducc, this, args })?.to_value(ducc)
         }))
     }
@@ -160,6 +190,7 @@ impl Ducc {
     ///
     /// This is a version of `create_function` that accepts a FnMut argument. Refer to
     /// `create_function` for more information about the implementation.
+    #[track_caller]
     pub fn create_function_mut<'ducc, 'callback, R, F>(&'ducc self, func: F) -> Function<'ducc>
     where
         R: ToValue<'callback>,
@@ -171,6 +202,66 @@ impl Ducc {
         })
     }
 
+    /// Creates a `Proxy` for `target` whose traps are the native callbacks in `handler`, the
+    /// equivalent of `new Proxy(target, handler)` in JavaScript. See `ProxyHandler` for details.
+    pub fn create_proxy<'ducc, 'callback>(
+        &'ducc self,
+        target: &Object<'ducc>,
+        handler: ProxyHandler<'callback>,
+    ) -> Object<'ducc> {
+        create_native_proxy(self, target, Box::new(handler))
+    }
+
+    /// Wraps a Rust value implementing `HostObject` in a JavaScript object whose properties are
+    /// computed by the value on every access. The value is dropped when the object is garbage
+    /// collected. See `HostObject` for details.
+    pub fn create_host_object<T: HostObject>(&self, object: T) -> Object {
+        create_host_object(self, object)
+    }
+
+    /// Creates a class from `builder`, creating its prototype and methods. Instances are then
+    /// created with `Class::create`, without creating any further functions. See `ClassBuilder`
+    /// for details.
+    pub fn create_class<'ducc, 'callback, T: 'static + Send>(
+        &'ducc self,
+        builder: ClassBuilder<'callback, T>,
+    ) -> Class<'ducc, T> {
+        create_class(self, builder)
+    }
+
+    /// Creates a native function that fills a `Float64Array` argument with values from the same
+    /// sequence as `Math.random()` in a single call, and returns the array. Throws a `TypeError`
+    /// for any other argument. Scripts only see it once it's installed somewhere, for example as
+    /// `globals().set("fillRandom", ducc.create_fill_random())`.
+    pub fn create_fill_random(&self) -> Function {
+        unsafe {
+            assert_stack!(self.ctx, 0, {
+                ffi::duk_require_stack(self.ctx, 1);
+                ffi::duk_push_c_function(self.ctx, Some(ffi::duk_random_fill_float64array), 1);
+                Function(self.pop_ref())
+            })
+        }
+    }
+
+    /// Creates an object with native element-wise kernels over `Float64Array`s, meant to be exposed
+    /// to scripts as a module (for example as `globals().set("f64", ducc.create_float64_kernels())`):
+    ///
+    /// * `add(dst, a, b)`, `sub`, `mul`, `div`: `dst[i] = a[i] op b[i]`, where `b` may also be a
+    ///   number. Return `dst`.
+    /// * `sum(a)`, `dot(a, b)`: return a number.
+    ///
+    /// Array arguments must be `Float64Array`s of the same length (they may be the same array), or
+    /// the kernels throw. Requires the `use-typedarray-kernels` feature of `ducc-sys`.
+    pub fn create_float64_kernels(&self) -> Object {
+        unsafe {
+            assert_stack!(self.ctx, 0, {
+                ffi::duk_require_stack(self.ctx, 1);
+                ffi::duk_push_float64_kernels(self.ctx);
+                Object(self.pop_ref())
+            })
+        }
+    }
+
     /// Pass a `&str` to Duktape, creating and returning an interned string.
     pub fn create_string(&self, value: &str) -> Result<String> {
         unsafe {
@@ -217,7 +308,8 @@ impl Ducc {
     /// iterator. Keys are coerced to object properties.
     ///
     /// This is a thin wrapper around `Ducc::create_object` and `Object::set`. See `Object::set` for
-    /// how this method might return an error.
+    /// how this method might return an error. The object's property storage is compacted once all
+    /// entries have been added.
     pub fn create_object_from<'ducc, K, V, I>(&'ducc self, iter: I) -> Result<Object<'ducc>>
     where
         K: ToValue<'ducc>,
@@ -228,6 +320,16 @@ impl Ducc {
         for (k, v) in iter {
             object.set(k, v)?;
         }
+
+        unsafe {
+            assert_stack!(self.ctx, 0, {
+                ffi::duk_require_stack(self.ctx, 1);
+                self.push_ref(&object.0);
+                ffi::duk_compact(self.ctx, -1);
+                ffi::duk_pop(self.ctx);
+            });
+        }
+
         Ok(object)
     }
 
@@ -324,6 +426,183 @@ impl Ducc {
         }
     }
 
+    /// Starts a sampling CPU profiler, which records the JavaScript call stack every `interval`
+    /// bytecode instructions (an interval of a few thousand instructions takes a sample every few
+    /// microseconds). Any previously collected profile is discarded. The samples are retrieved
+    /// with `profile`, during or after profiling.
+    ///
+    /// Requires the `use-sampling-profiler` feature of `ducc-sys`.
+    pub fn start_profiler(&self, interval: u32) {
+        unsafe {
+            let udata = get_udata(self.ctx);
+            let mut profiler = Box::new(Profiler::new());
+            let profiler_ptr = &mut *profiler as *mut Profiler;
+            ffi::duk_set_sampling_profiler(
+                self.ctx,
+                interval,
+                Some(sample_func),
+                profiler_ptr as *mut _,
+            );
+            (*udata).profiler = Some(profiler);
+        }
+    }
+
+    /// Stops the profiler started with `start_profiler`, keeping the samples collected so far.
+    pub fn stop_profiler(&self) {
+        unsafe { ffi::duk_set_sampling_profiler(self.ctx, 0, None, ptr::null_mut()); }
+    }
+
+    /// Returns the samples collected since the last call to `start_profiler`. See `Profile`.
+    pub fn profile(&self) -> Profile {
+        unsafe {
+            let udata = get_udata(self.ctx);
+            match (*udata).profiler {
+                Some(ref profiler) => profiler.profile(),
+                None => Profile::default(),
+            }
+        }
+    }
+
+    /// Starts recording the number of calls and the time spent in every JavaScript function, and
+    /// every Rust function created with `create_function` or as a class method, as they return.
+    /// Any previously recorded statistics are discarded. The statistics are retrieved with
+    /// `function_stats`, during or after recording.
+    ///
+    /// Recording adds two reads of the monotonic clock to every call, and nothing to code that
+    /// doesn't make calls. Calls that are already running when recording starts are not recorded.
+    ///
+    /// Requires the `use-call-stats` feature of `ducc-sys`.
+    pub fn start_function_stats(&self) {
+        unsafe {
+            let udata = get_udata(self.ctx);
+            let mut recorder = Box::new(StatsRecorder::new());
+            let recorder_ptr = &mut *recorder as *mut StatsRecorder;
+            ffi::duk_set_call_stats(self.ctx, Some(call_stats_func), recorder_ptr as *mut _);
+            (*udata).call_stats = Some(recorder);
+        }
+    }
+
+    /// Stops the recording started with `start_function_stats`, keeping the statistics recorded
+    /// so far.
+    pub fn stop_function_stats(&self) {
+        unsafe { ffi::duk_set_call_stats(self.ctx, None, ptr::null_mut()); }
+    }
+
+    /// Returns the statistics recorded since the last call to `start_function_stats`, one entry
+    /// per function in no particular order. See `FunctionStats`.
+    pub fn function_stats(&self) -> Vec<FunctionStats> {
+        unsafe {
+            let udata = get_udata(self.ctx);
+            match (*udata).call_stats {
+                Some(ref recorder) => recorder.function_stats(),
+                None => Vec::new(),
+            }
+        }
+    }
+
+    /// Starts an allocation profiler, which records the allocation and the innermost `max_frames`
+    /// frames of the JavaScript call stack (at most 64) about once every `interval` bytes
+    /// allocated for strings, objects, buffers and property tables. Any previously collected
+    /// profile is discarded. The samples are retrieved with `allocation_profile`, during or after
+    /// profiling. See `AllocationProfile` for what is and isn't measured.
+    ///
+    /// Requires the `use-alloc-profiler` feature of `ducc-sys`.
+    pub fn start_allocation_profiler(&self, interval: usize, max_frames: u32) {
+        unsafe {
+            let udata = get_udata(self.ctx);
+            let mut profiler = Box::new(AllocationProfiler::new(interval));
+            let profiler_ptr = &mut *profiler as *mut AllocationProfiler;
+            ffi::duk_set_alloc_sampler(
+                self.ctx,
+                interval as ffi::duk_size_t,
+                max_frames,
+                Some(alloc_sample_func),
+                profiler_ptr as *mut _,
+            );
+            (*udata).alloc_profiler = Some(profiler);
+        }
+    }
+
+    /// Stops the profiler started with `start_allocation_profiler`, keeping the samples
+    /// collected so far.
+    pub fn stop_allocation_profiler(&self) {
+        unsafe { ffi::duk_set_alloc_sampler(self.ctx, 1, 0, None, ptr::null_mut()); }
+    }
+
+    /// Returns the samples collected since the last call to `start_allocation_profiler`. See
+    /// `AllocationProfile`.
+    pub fn allocation_profile(&self) -> AllocationProfile {
+        unsafe {
+            let udata = get_udata(self.ctx);
+            match (*udata).alloc_profiler {
+                Some(ref profiler) => profiler.profile(),
+                None => AllocationProfile::default(),
+            }
+        }
+    }
+
+    /// Writes a snapshot of the heap to `out` in the JSON format of Chrome's `.heapsnapshot` files,
+    /// which can be loaded in the Memory tab of Chrome DevTools. The snapshot holds every string,
+    /// object and buffer with its size, its constructor or function name and its references to
+    /// others. Like Chrome, this runs the garbage collector first (which may run finalizers), so
+    /// the snapshot holds little garbage.
+    ///
+    /// Requires the `use-heap-walk` feature of `ducc-sys`.
+    pub fn heap_snapshot<W: Write>(&self, out: &mut W) -> io::Result<()> {
+        let graph = unsafe {
+            ffi::duk_gc(self.ctx, 0);
+            HeapGraph::capture(self.ctx)
+        };
+        graph.write_chrome(out)
+    }
+
+    /// Summarizes what keeps memory alive in the heap, with the sizes retained by each constructor
+    /// and by the `top` nodes that retain the most. Runs the garbage collector first, like
+    /// `heap_snapshot`. See `HeapSummary`.
+    ///
+    /// Requires the `use-heap-walk` feature of `ducc-sys`.
+    pub fn heap_summary(&self, top: usize) -> HeapSummary {
+        let graph = unsafe {
+            ffi::duk_gc(self.ctx, 0);
+            HeapGraph::capture(self.ctx)
+        };
+        graph.summary(top)
+    }
+
+    /// Reseeds the generator behind `Math.random()`. Every `Ducc` created with the same seed (or
+    /// reseeded with it) produces the same sequence of numbers from then on, which makes script
+    /// runs that depend on randomness replayable.
+    pub fn set_random_seed(&self, seed: u64) {
+        unsafe { ffi::duk_random_seed(self.ctx, seed); }
+    }
+
+    /// Fills `out` with values from the same sequence as `Math.random()`.
+    pub fn fill_random(&self, out: &mut [f64]) {
+        unsafe { ffi::duk_random_fill(self.ctx, out.as_mut_ptr() as *mut _, out.len()); }
+    }
+
+    /// Returns statistics about the heap's string table, through which every string (including
+    /// every property key) is interned. Walks the whole table, so this is not meant to be called in
+    /// a hot loop.
+    pub fn string_table_stats(&self) -> StringTableStats {
+        let mut stats: ffi::duk_strtab_stats = unsafe { ::std::mem::zeroed() };
+        unsafe { ffi::duk_get_strtab_stats(self.ctx, &mut stats); }
+        StringTableStats {
+            size: stats.size,
+            min_size: stats.min_size,
+            count: stats.count,
+            used_buckets: stats.used_buckets,
+            max_chain: stats.max_chain,
+            average_probes: if stats.count > 0 {
+                stats.probe_total / stats.count as f64
+            } else {
+                0.0
+            },
+            grow_count: stats.grow_count,
+            shrink_count: stats.shrink_count,
+        }
+    }
+
     pub(crate) unsafe fn push_value(&self, value: Value) {
         assert_stack!(self.ctx, 1, {
             match value {
@@ -488,6 +767,40 @@ pub struct ExecSettings {
     pub cancel_fn: Option<Box<dyn Fn() -> bool>>,
 }
 
+/// A list of settings applied when creating a [Ducc](Ducc::with_settings).
+#[derive(Default)]
+pub struct HeapSettings {
+    /// The number of string table buckets to start with, rounded up to a power of two. The table
+    /// still grows with the number of interned strings, but never shrinks below this size. Set
+    /// this to roughly the expected number of live strings to avoid resizes while warming up.
+    pub string_table_size: Option<u32>,
+    /// A seed for `Math.random()` (see [set_random_seed](Ducc::set_random_seed)). By default the
+    /// generator is seeded from the current time and the heap address.
+    pub random_seed: Option<u64>,
+}
+
+/// Statistics about the string table of a `Ducc`, as returned by
+/// [string_table_stats](Ducc::string_table_stats).
+#[derive(Clone, Copy, Debug)]
+pub struct StringTableStats {
+    /// Number of buckets.
+    pub size: u32,
+    /// Number of buckets the table will not shrink below.
+    pub min_size: u32,
+    /// Number of interned strings.
+    pub count: u32,
+    /// Number of buckets holding at least one string.
+    pub used_buckets: u32,
+    /// Length of the longest bucket chain.
+    pub max_chain: u32,
+    /// Average number of string comparisons needed to find an interned string.
+    pub average_probes: f64,
+    /// Number of times the table doubled in size since the `Ducc` was created.
+    pub grow_count: u32,
+    /// Number of times the table halved in size since the `Ducc` was created.
+    pub shrink_count: u32,
+}
+
 
 /// Internal entry on the call stack as returned by
 /// [inspect_call_stack_entry](Ducc::inspect_call_stack_entry).
@@ -0,0 +1,100 @@
+use ducc::Ducc;
+use error::{Error, Result};
+use ffi;
+use object::Object;
+use proxy::{create_native_proxy, Traps};
+use std::cell::{Ref, RefCell, RefMut};
+use value::{ToValue, Value};
+
+/// A Rust value that scripts see as an object, with its properties computed on every access
+/// rather than copied into Duktape. Created with [`Ducc::create_host_object`].
+///
+/// Every property access on the object is a single native call into one of these methods, without
+/// any function object or `Box` per property. Keys are passed as a `&str`, with index accesses like
+/// `obj[0]` passing `"0"`.
+///
+/// The object behaves like an ordinary empty object wherever `get` returns `None` (or `has` returns
+/// `false`), so for example `toString` is still inherited from `Object.prototype` unless `get`
+/// returns something for it, and `'toString' in obj` is `true`.
+/// Writes and deletions are rejected by default, which makes the object read-only (writes throw a
+/// `TypeError` in strict mode code).
+///
+/// Requires the `use-proxy-native` feature of `ducc-sys`.
+///
+/// [`Ducc::create_host_object`]: struct.Ducc.html#method.create_host_object
+pub trait HostObject: 'static + Send {
+    /// Returns the value of the property `key`, or `None` if the object has no such property.
+    fn get<'ducc>(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<Value<'ducc>>>;
+
+    /// Sets the property `key`, returning `false` to reject the write. By default all writes are
+    /// rejected.
+    fn set<'ducc>(&mut self, _ducc: &'ducc Ducc, _key: &str, _value: Value<'ducc>) -> Result<bool> {
+        Ok(false)
+    }
+
+    /// Returns whether the object has the property `key`, for the `in` operator. By default this
+    /// is whether `get` returns a value. Returning `false` falls back to the properties of an
+    /// empty object, so inherited properties like `toString` are still found.
+    fn has(&self, ducc: &Ducc, key: &str) -> Result<bool> {
+        Ok(self.get(ducc, key)?.is_some())
+    }
+
+    /// Deletes the property `key`, returning `false` to reject the deletion. By default all
+    /// deletions are rejected.
+    fn delete(&mut self, _ducc: &Ducc, _key: &str) -> Result<bool> {
+        Ok(false)
+    }
+
+    /// Returns the keys of the object's enumerable properties, as seen by `Object.keys()`,
+    /// `for-in` and `JSON.stringify()`. By default there are none.
+    fn own_keys(&self, _ducc: &Ducc) -> Result<Vec<String>> {
+        Ok(Vec::new())
+    }
+}
+
+// `set` and `delete` take the object mutably, so a script reentering the object from within one
+// of those gets an error rather than aliasing it.
+struct HostTraps<T>(RefCell<T>);
+
+impl<T: HostObject> HostTraps<T> {
+    fn borrow<'a>(&'a self) -> Result<Ref<'a, T>> {
+        self.0.try_borrow().map_err(|_| Error::recursive_mut_callback())
+    }
+
+    fn borrow_mut<'a>(&'a self) -> Result<RefMut<'a, T>> {
+        self.0.try_borrow_mut().map_err(|_| Error::recursive_mut_callback())
+    }
+}
+
+impl<'ducc, T: HostObject> Traps<'ducc> for HostTraps<T> {
+    fn mask(&self) -> ffi::duk_uint_t {
+        ffi::DUK_PROXY_TRAP_ALL
+    }
+
+    fn get(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<Value<'ducc>>> {
+        self.borrow()?.get(ducc, key)
+    }
+
+    fn set(&self, ducc: &'ducc Ducc, key: &str, value: Value<'ducc>) -> Result<bool> {
+        self.borrow_mut()?.set(ducc, key, value)
+    }
+
+    fn has(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<bool>> {
+        Ok(if self.borrow()?.has(ducc, key)? { Some(true) } else { None })
+    }
+
+    fn delete(&self, ducc: &'ducc Ducc, key: &str) -> Result<bool> {
+        self.borrow_mut()?.delete(ducc, key)
+    }
+
+    fn own_keys(&self, ducc: &'ducc Ducc) -> Result<Value<'ducc>> {
+        self.borrow()?.own_keys(ducc)?.to_value(ducc)
+    }
+}
+
+pub(crate) fn create_host_object<'ducc, T: HostObject>(
+    ducc: &'ducc Ducc,
+    object: T,
+) -> Object<'ducc> {
+    create_native_proxy(ducc, &ducc.create_object(), Box::new(HostTraps(RefCell::new(object))))
+}
@@ -4,11 +4,18 @@ extern crate ducc_sys as ffi;
 #[macro_use] mod util;
 mod array;
 mod bytes;
+mod class;
+mod codec;
 mod conversion;
 mod ducc;
 mod error;
 mod function;
+mod host;
 mod object;
+mod profiler;
+mod proxy;
+mod snapshot;
+mod stats;
 mod string;
 mod types;
 mod value;
@@ -17,9 +24,18 @@ mod value;
 
 pub use array::{Array, Elements};
 pub use bytes::Bytes;
-pub use ducc::{Ducc, ExecSettings};
+pub use class::{Class, ClassBuilder};
+pub use codec::{base64_decode, base64_encode, hex_decode, hex_encode};
+pub use ducc::{Ducc, ExecSettings, HeapSettings, StringTableStats};
 pub use error::{Error, ErrorKind, Result, ResultExt, RuntimeError, RuntimeErrorCode};
 pub use function::{Function, Invocation};
+pub use host::HostObject;
 pub use object::{Object, Properties, PropertyDescriptor};
+pub use profiler::{
+    AllocationKind, AllocationProfile, AllocationSite, Profile, ProfileFrame, ProfileStack,
+};
+pub use proxy::ProxyHandler;
+pub use snapshot::{HeapGroup, HeapRetainer, HeapSummary};
+pub use stats::FunctionStats;
 pub use string::String;
 pub use value::{FromValue, FromValues, ToValue, ToValues, Value, Values, Variadic};
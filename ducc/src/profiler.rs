@@ -0,0 +1,260 @@
+use ffi;
+use std::collections::HashMap;
+use std::fmt::Write;
+use std::os::raw::c_void;
+use std::slice;
+use util::cesu8_to_str;
+
+/// A CPU profile collected by [`Ducc::start_profiler`], as returned by [`Ducc::profile`].
+///
+/// Each sample is a snapshot of the JavaScript call stack taken while the bytecode interpreter
+/// is running, every `interval` instructions. The profile therefore shows where scripts spend
+/// their instructions: time spent inside native functions (including Rust callbacks) is only
+/// attributed to them in proportion to how often the interpreter is running when they are on the
+/// stack, i.e. not at all for a native function that doesn't call back into JavaScript.
+///
+/// [`Ducc::start_profiler`]: struct.Ducc.html#method.start_profiler
+/// [`Ducc::profile`]: struct.Ducc.html#method.profile
+#[derive(Clone, Debug, Default)]
+pub struct Profile {
+    /// The distinct call stacks that were sampled, in no particular order.
+    pub stacks: Vec<ProfileStack>,
+}
+
+/// A distinct call stack in a `Profile`, with the number of times it was sampled.
+#[derive(Clone, Debug)]
+pub struct ProfileStack {
+    /// The frames of the stack, outermost first.
+    pub frames: Vec<ProfileFrame>,
+    /// Number of samples that found the interpreter executing this stack.
+    pub samples: u64,
+}
+
+/// A call stack frame in a `Profile`.
+#[derive(Clone, Debug, PartialEq, Eq, Hash)]
+pub struct ProfileFrame {
+    /// Name of the function, or the empty string for anonymous functions.
+    pub function: String,
+    /// The `fileName` of the function (the name given to `compile` or `exec`), or the empty
+    /// string if it has none.
+    pub file_name: String,
+    /// Line of the executing instruction, or for callers the line of the call. Zero for native
+    /// functions.
+    pub line: u32,
+    /// Whether the function is a native function, like a builtin or a Rust callback.
+    pub native: bool,
+}
+
+impl Profile {
+    /// Returns the total number of samples.
+    pub fn samples(&self) -> u64 {
+        self.stacks.iter().map(|stack| stack.samples).sum()
+    }
+
+    /// Formats the profile as "collapsed stacks", one line per stack with its frames separated by
+    /// `;` followed by its sample count, as read by `flamegraph.pl`, inferno and speedscope.
+    /// Frames are written as `name (file:line)`, or `name [native]` for native functions.
+    pub fn to_collapsed(&self) -> String {
+        let mut out = String::new();
+        for stack in &self.stacks {
+            write_collapsed_frames(&mut out, &stack.frames);
+            let _ = writeln!(out, " {}", stack.samples);
+        }
+        out
+    }
+}
+
+/// An allocation profile collected by [`Ducc::start_allocation_profiler`], as returned by
+/// [`Ducc::allocation_profile`].
+///
+/// Allocations of strings, objects (including functions), buffers and property tables are
+/// sampled about once every `interval` bytes, each sample recording the allocation and the call
+/// stack that made it. An allocation is sampled with a probability proportional to its size, so
+/// the byte and allocation counts of each site are estimates scaled up from the samples; they are
+/// exact with an interval of 1. Growing a buffer or a string in place counts the growth as an
+/// allocation. Memory used by the engine itself, like value stacks and compiled bytecode, isn't
+/// included, and neither is any freeing: the profile shows where memory was allocated, not what
+/// is still alive.
+///
+/// [`Ducc::start_allocation_profiler`]: struct.Ducc.html#method.start_allocation_profiler
+/// [`Ducc::allocation_profile`]: struct.Ducc.html#method.allocation_profile
+#[derive(Clone, Debug, Default)]
+pub struct AllocationProfile {
+    /// The sampling interval in bytes.
+    pub interval: usize,
+    /// The distinct allocation sites that were sampled, in no particular order.
+    pub sites: Vec<AllocationSite>,
+}
+
+/// A distinct call stack and allocation kind in an `AllocationProfile`.
+#[derive(Clone, Debug)]
+pub struct AllocationSite {
+    /// The frames of the stack, outermost first, up to the profiler's `max_frames` innermost
+    /// ones. Empty for allocations made while no function is running.
+    pub frames: Vec<ProfileFrame>,
+    /// What was allocated.
+    pub kind: AllocationKind,
+    /// Estimated number of bytes allocated.
+    pub bytes: u64,
+    /// Estimated number of allocations.
+    pub allocations: u64,
+    /// Number of samples taken at this site.
+    pub samples: u64,
+}
+
+/// The kind of memory allocated at an `AllocationSite`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]
+pub enum AllocationKind {
+    /// A string, or the growth of a string being appended to in place.
+    String,
+    /// An object, array, function or thread, without its properties.
+    Object,
+    /// A buffer, or the growth of a dynamic buffer.
+    Buffer,
+    /// The property table of an object, allocated when the object outgrows its previous one.
+    Properties,
+}
+
+impl AllocationProfile {
+    /// Returns the estimated total number of bytes allocated.
+    pub fn bytes(&self) -> u64 {
+        self.sites.iter().map(|site| site.bytes).sum()
+    }
+
+    /// Formats the profile as "collapsed stacks" like `Profile::to_collapsed`, weighted by
+    /// estimated bytes, with the allocation kind as the innermost frame.
+    pub fn to_collapsed(&self) -> String {
+        let mut out = String::new();
+        for site in &self.sites {
+            write_collapsed_frames(&mut out, &site.frames);
+            if !site.frames.is_empty() {
+                out.push(';');
+            }
+            let _ = writeln!(out, "[{:?}] {}", site.kind, site.bytes);
+        }
+        out
+    }
+}
+
+fn write_collapsed_frames(out: &mut String, frames: &[ProfileFrame]) {
+    for (i, frame) in frames.iter().enumerate() {
+        if i > 0 {
+            out.push(';');
+        }
+        let name = if frame.function.is_empty() { "(anonymous)" } else { &frame.function };
+        let _ = if frame.native {
+            write!(out, "{} [native]", collapsed_str(name))
+        } else {
+            write!(out, "{} ({}:{})", collapsed_str(name), collapsed_str(&frame.file_name),
+                frame.line)
+        };
+    }
+}
+
+// The collapsed format has no escaping, so separators within names are replaced.
+fn collapsed_str(s: &str) -> String {
+    s.replace(|c| c == ';' || c == '\n', " ")
+}
+
+// Samples are aggregated as they are taken, so a long profiling session costs memory in the number
+// of distinct stacks rather than in the number of samples.
+pub(crate) struct Profiler {
+    stacks: HashMap<Vec<ProfileFrame>, u64>,
+}
+
+impl Profiler {
+    pub fn new() -> Profiler {
+        Profiler { stacks: HashMap::new() }
+    }
+
+    pub fn profile(&self) -> Profile {
+        let stacks = self.stacks.iter()
+            .map(|(frames, &samples)| ProfileStack { frames: frames.clone(), samples })
+            .collect();
+        Profile { stacks }
+    }
+}
+
+pub(crate) unsafe extern "C" fn sample_func(
+    udata: *mut c_void,
+    frames: *const ffi::duk_sample_frame,
+    num_frames: ffi::duk_size_t,
+) {
+    let profiler = &mut *(udata as *mut Profiler);
+    let frames = slice::from_raw_parts(frames, num_frames as usize);
+    let stack = frames.iter().rev().map(|frame| ProfileFrame {
+        function: frame_str(frame.name, frame.name_len),
+        file_name: frame_str(frame.filename, frame.filename_len),
+        line: frame.line,
+        native: frame.native != 0,
+    }).collect();
+    *profiler.stacks.entry(stack).or_insert(0) += 1;
+}
+
+// Samples are aggregated per site as they are taken. Estimates are kept as floating point, since a
+// sampled allocation smaller than the interval stands for a fraction of `interval / size`
+// allocations.
+pub(crate) struct AllocationProfiler {
+    interval: usize,
+    sites: HashMap<(AllocationKind, Vec<ProfileFrame>), (f64, f64, u64)>,
+}
+
+impl AllocationProfiler {
+    pub fn new(interval: usize) -> AllocationProfiler {
+        AllocationProfiler { interval: interval.max(1), sites: HashMap::new() }
+    }
+
+    pub fn profile(&self) -> AllocationProfile {
+        let sites = self.sites.iter()
+            .map(|(&(kind, ref frames), &(bytes, allocations, samples))| AllocationSite {
+                frames: frames.clone(),
+                kind,
+                bytes: bytes.round() as u64,
+                allocations: allocations.round() as u64,
+                samples,
+            })
+            .collect();
+        AllocationProfile { interval: self.interval, sites }
+    }
+}
+
+pub(crate) unsafe extern "C" fn alloc_sample_func(
+    udata: *mut c_void,
+    type_: ffi::duk_uint_t,
+    size: ffi::duk_size_t,
+    frames: *const ffi::duk_sample_frame,
+    num_frames: ffi::duk_size_t,
+) {
+    let profiler = &mut *(udata as *mut AllocationProfiler);
+    let kind = match type_ {
+        ffi::DUK_ALLOC_TYPE_STRING => AllocationKind::String,
+        ffi::DUK_ALLOC_TYPE_OBJECT => AllocationKind::Object,
+        ffi::DUK_ALLOC_TYPE_BUFFER => AllocationKind::Buffer,
+        _ => AllocationKind::Properties,
+    };
+    let frames = if num_frames > 0 { slice::from_raw_parts(frames, num_frames as usize) } else { &[] };
+    let stack = frames.iter().rev().map(|frame| ProfileFrame {
+        function: frame_str(frame.name, frame.name_len),
+        file_name: frame_str(frame.filename, frame.filename_len),
+        line: frame.line,
+        native: frame.native != 0,
+    }).collect();
+
+    let size = (size as f64).max(1.0);
+    let interval = profiler.interval as f64;
+    let site = profiler.sites.entry((kind, stack)).or_insert((0.0, 0.0, 0));
+    site.0 += size.max(interval);
+    site.1 += (interval / size).max(1.0);
+    site.2 += 1;
+}
+
+unsafe fn frame_str(ptr: *const ::std::os::raw::c_char, len: ffi::duk_size_t) -> String {
+    if ptr.is_null() {
+        return String::new();
+    }
+    let bytes = slice::from_raw_parts(ptr as *const u8, len as usize);
+    match cesu8_to_str(bytes) {
+        Some(string) => string.into_owned(),
+        None => String::new(),
+    }
+}
@@ -0,0 +1,299 @@
+use ducc::Ducc;
+use error::Result;
+use ffi;
+use object::Object;
+use std::borrow::Cow;
+use std::os::raw::c_void;
+use std::panic::{AssertUnwindSafe, catch_unwind};
+use std::{slice, str};
+use util::{cesu8_to_str, push_error};
+use value::{ToValue, Value};
+
+type GetTrap<'ducc> = Box<dyn Fn(&'ducc Ducc, &str) -> Result<Value<'ducc>>>;
+type SetTrap<'ducc> = Box<dyn Fn(&'ducc Ducc, &str, Value<'ducc>) -> Result<bool>>;
+type KeyTrap<'ducc> = Box<dyn Fn(&'ducc Ducc, &str) -> Result<bool>>;
+type OwnKeysTrap<'ducc> = Box<dyn Fn(&'ducc Ducc) -> Result<Value<'ducc>>>;
+
+/// A set of native traps for a `Proxy` created with [`Ducc::create_proxy`].
+///
+/// Native traps are called straight from the property access, without a lookup on a handler
+/// object or a JavaScript call. Keys are passed as a borrowed `&str` (index accesses like `p[0]`
+/// see `"0"`), and the target is not passed at all: the closures are expected to capture whatever
+/// Rust data the proxy exposes. Accesses with symbol keys, and traps left unset, operate on the
+/// target as if there were no trap. Returning `Err` from a trap throws the error into the script
+/// performing the access.
+///
+/// Requires the `use-proxy-native` feature of `ducc-sys`.
+///
+/// [`Ducc::create_proxy`]: struct.Ducc.html#method.create_proxy
+#[derive(Default)]
+pub struct ProxyHandler<'callback> {
+    get: Option<GetTrap<'callback>>,
+    set: Option<SetTrap<'callback>>,
+    has: Option<KeyTrap<'callback>>,
+    delete: Option<KeyTrap<'callback>>,
+    own_keys: Option<OwnKeysTrap<'callback>>,
+}
+
+impl<'callback> ProxyHandler<'callback> {
+    /// Creates a handler without any traps.
+    pub fn new() -> ProxyHandler<'callback> {
+        Default::default()
+    }
+
+    /// Sets the `get` trap, called as `func(ducc, key)` for property reads.
+    pub fn get<R, F>(mut self, func: F) -> ProxyHandler<'callback>
+    where
+        R: ToValue<'callback>,
+        F: 'static + Send + Fn(&'callback Ducc, &str) -> Result<R>,
+    {
+        self.get = Some(Box::new(move |ducc, key| func(ducc, key)?.to_value(ducc)));
+        self
+    }
+
+    /// Sets the `set` trap, called as `func(ducc, key, value)` for property writes. The write is
+    /// rejected (which throws in strict mode code) if the trap returns `false`.
+    pub fn set<F>(mut self, func: F) -> ProxyHandler<'callback>
+    where
+        F: 'static + Send + Fn(&'callback Ducc, &str, Value<'callback>) -> Result<bool>,
+    {
+        self.set = Some(Box::new(func));
+        self
+    }
+
+    /// Sets the `has` trap, called as `func(ducc, key)` for the `in` operator.
+    pub fn has<F>(mut self, func: F) -> ProxyHandler<'callback>
+    where
+        F: 'static + Send + Fn(&'callback Ducc, &str) -> Result<bool>,
+    {
+        self.has = Some(Box::new(func));
+        self
+    }
+
+    /// Sets the `deleteProperty` trap, called as `func(ducc, key)` for the `delete` operator. The
+    /// deletion is rejected (which throws in strict mode code) if the trap returns `false`.
+    pub fn delete<F>(mut self, func: F) -> ProxyHandler<'callback>
+    where
+        F: 'static + Send + Fn(&'callback Ducc, &str) -> Result<bool>,
+    {
+        self.delete = Some(Box::new(func));
+        self
+    }
+
+    /// Sets the `ownKeys` trap, called as `func(ducc)` for `Object.keys()`, `for-in` enumeration
+    /// and the like. The result must convert to an array of keys (a `Vec<String>`, for example),
+    /// which are all reported as enumerable own properties.
+    pub fn own_keys<R, F>(mut self, func: F) -> ProxyHandler<'callback>
+    where
+        R: ToValue<'callback>,
+        F: 'static + Send + Fn(&'callback Ducc) -> Result<R>,
+    {
+        self.own_keys = Some(Box::new(move |ducc| func(ducc)?.to_value(ducc)));
+        self
+    }
+
+}
+
+// The traps behind a native proxy. Only the traps in `mask` are ever called. A `get` or `has`
+// returning `None` falls back to the property on the target.
+pub(crate) trait Traps<'ducc> {
+    fn mask(&self) -> ffi::duk_uint_t;
+    fn get(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<Value<'ducc>>>;
+    fn set(&self, ducc: &'ducc Ducc, key: &str, value: Value<'ducc>) -> Result<bool>;
+    fn has(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<bool>>;
+    fn delete(&self, ducc: &'ducc Ducc, key: &str) -> Result<bool>;
+    fn own_keys(&self, ducc: &'ducc Ducc) -> Result<Value<'ducc>>;
+}
+
+impl<'callback> Traps<'callback> for ProxyHandler<'callback> {
+    fn mask(&self) -> ffi::duk_uint_t {
+        let mut mask = 0;
+        if self.get.is_some() { mask |= ffi::DUK_PROXY_TRAP_GET; }
+        if self.set.is_some() { mask |= ffi::DUK_PROXY_TRAP_SET; }
+        if self.has.is_some() { mask |= ffi::DUK_PROXY_TRAP_HAS; }
+        if self.delete.is_some() { mask |= ffi::DUK_PROXY_TRAP_DELETE_PROPERTY; }
+        if self.own_keys.is_some() { mask |= ffi::DUK_PROXY_TRAP_OWN_KEYS; }
+        mask
+    }
+
+    fn get(&self, ducc: &'callback Ducc, key: &str) -> Result<Option<Value<'callback>>> {
+        (self.get.as_ref().unwrap())(ducc, key).map(Some)
+    }
+
+    fn set(&self, ducc: &'callback Ducc, key: &str, value: Value<'callback>) -> Result<bool> {
+        (self.set.as_ref().unwrap())(ducc, key, value)
+    }
+
+    fn has(&self, ducc: &'callback Ducc, key: &str) -> Result<Option<bool>> {
+        (self.has.as_ref().unwrap())(ducc, key).map(Some)
+    }
+
+    fn delete(&self, ducc: &'callback Ducc, key: &str) -> Result<bool> {
+        (self.delete.as_ref().unwrap())(ducc, key)
+    }
+
+    fn own_keys(&self, ducc: &'callback Ducc) -> Result<Value<'callback>> {
+        (self.own_keys.as_ref().unwrap())(ducc)
+    }
+}
+
+const PROXY_TRAPS: [i8; 7] = hidden_i8str!('t', 'r', 'a', 'p', 's');
+
+pub(crate) fn create_native_proxy<'ducc, 'callback>(
+    ducc: &'ducc Ducc,
+    target: &Object<'ducc>,
+    traps: Box<dyn Traps<'callback> + 'callback>,
+) -> Object<'ducc> {
+    // Called with the trap arguments on the stack top, which must be left in place. No stack frame
+    // is set up for the call, so everything is addressed relative to the top.
+    unsafe extern "C" fn dispatch(
+        ctx: *mut ffi::duk_context,
+        trap: ffi::duk_uint_t,
+        udata: *mut c_void,
+    ) -> ffi::duk_ret_t {
+        let key_index = match trap {
+            ffi::DUK_PROXY_TRAP_GET => -2,
+            ffi::DUK_PROXY_TRAP_SET => -3,
+            _ => -1,
+        };
+
+        // Index keys arrive as numbers and are formatted here, which is much cheaper than having
+        // Duktape coerce (and intern) them. Other keys are coerced on a copy. Keys that can't be
+        // passed as a `&str` (symbols and strings with unpaired surrogates) get the default
+        // behavior.
+        let mut index_buf = [0u8; 10];
+        let mut key_str = None;
+        let mut key_pushed = false;
+        if trap != ffi::DUK_PROXY_TRAP_OWN_KEYS {
+            let number = ffi::duk_get_number_default(ctx, key_index, -1.0);
+            if number >= 0.0 && number < 4294967295.0 && number == (number as u32) as f64 {
+                let mut index = number as u32;
+                let mut start = index_buf.len();
+                loop {
+                    start -= 1;
+                    index_buf[start] = b'0' + (index % 10) as u8;
+                    index /= 10;
+                    if index == 0 {
+                        break;
+                    }
+                }
+                key_str = Some(Cow::Borrowed(str::from_utf8_unchecked(&index_buf[start..])));
+            } else if ffi::duk_is_symbol(ctx, key_index) != 0 {
+                return default_trap(ctx, trap, key_index);
+            } else {
+                ffi::duk_require_stack(ctx, 1);
+                ffi::duk_dup(ctx, key_index);
+                key_pushed = true;
+                let mut len = 0;
+                let data = ffi::duk_to_lstring(ctx, -1, &mut len);
+                match cesu8_to_str(slice::from_raw_parts(data as *const u8, len)) {
+                    Some(key) => key_str = Some(key),
+                    None => {
+                        ffi::duk_pop(ctx);
+                        return default_trap(ctx, trap, key_index);
+                    },
+                }
+            }
+        }
+        let key = key_str.as_ref().map(|key| &**key).unwrap_or("");
+
+        let ducc = Ducc { ctx, is_top: false };
+        let traps = &**(udata as *const Box<dyn Traps>);
+        let inner = || match trap {
+            ffi::DUK_PROXY_TRAP_GET => traps.get(&ducc, key),
+            ffi::DUK_PROXY_TRAP_SET => {
+                ffi::duk_dup(ctx, if key_pushed { -3 } else { -2 });
+                let value = ducc.pop_value();
+                traps.set(&ducc, key, value).map(|result| Some(Value::Boolean(result)))
+            },
+            ffi::DUK_PROXY_TRAP_HAS => {
+                traps.has(&ducc, key).map(|result| result.map(Value::Boolean))
+            },
+            ffi::DUK_PROXY_TRAP_DELETE_PROPERTY => {
+                traps.delete(&ducc, key).map(|result| Some(Value::Boolean(result)))
+            },
+            ffi::DUK_PROXY_TRAP_OWN_KEYS => traps.own_keys(&ducc).map(Some),
+            _ => unreachable!(),
+        };
+
+        let result = assert_stack!(ctx, if key_pushed { -1 } else { 0 }, {
+            let result = match catch_unwind(AssertUnwindSafe(inner)) {
+                Ok(result) => result,
+                Err(_) => {
+                    ffi::duk_fatal_raw(ctx, cstr!("panic occurred during script execution"));
+                    unreachable!();
+                },
+            };
+            if key_pushed {
+                ffi::duk_pop(ctx);
+            }
+            result
+        });
+
+        match result {
+            Ok(Some(value)) => {
+                ducc.push_value(value);
+                1
+            },
+            Ok(None) => default_trap(ctx, trap, key_index),
+            Err(error) => {
+                push_error(ctx, error);
+                -1
+            },
+        }
+    }
+
+    // Performs the operation of a trap on the target, as if the proxy had no trap for it.
+    unsafe fn default_trap(
+        ctx: *mut ffi::duk_context,
+        trap: ffi::duk_uint_t,
+        key: ffi::duk_idx_t,
+    ) -> ffi::duk_ret_t {
+        let target = key - 1;
+        ffi::duk_require_stack(ctx, 2);
+        ffi::duk_dup(ctx, key);
+        let result = match trap {
+            ffi::DUK_PROXY_TRAP_GET => {
+                ffi::duk_get_prop(ctx, target - 1);
+                return 1;
+            },
+            ffi::DUK_PROXY_TRAP_SET => {
+                ffi::duk_dup(ctx, -3);
+                ffi::duk_put_prop(ctx, target - 2)
+            },
+            ffi::DUK_PROXY_TRAP_HAS => ffi::duk_has_prop(ctx, target - 1),
+            _ => ffi::duk_del_prop(ctx, target - 1),
+        };
+        ffi::duk_push_boolean(ctx, result);
+        1
+    }
+
+    unsafe extern "C" fn finalizer(ctx: *mut ffi::duk_context) -> ffi::duk_ret_t {
+        ffi::duk_require_stack(ctx, 1);
+        ffi::duk_get_prop_string(ctx, 0, PROXY_TRAPS.as_ptr() as *const _);
+        let traps = Box::from_raw(ffi::duk_get_pointer(ctx, -1) as *mut Box<dyn Traps>);
+        drop(traps);
+        ffi::duk_pop(ctx);
+        ffi::duk_push_undefined(ctx);
+        ffi::duk_put_prop_string(ctx, 0, PROXY_TRAPS.as_ptr() as *const _);
+        0
+    }
+
+    unsafe {
+        assert_stack!(ducc.ctx, 0, {
+            let mask = traps.mask();
+            let traps = Box::into_raw(Box::new(traps));
+            ffi::duk_require_stack(ducc.ctx, 3);
+            ducc.push_ref(&target.0);
+            // The handler object is never visible to scripts, it only keeps the native traps alive
+            // for as long as the proxy is.
+            ffi::duk_push_bare_object(ducc.ctx);
+            ffi::duk_push_pointer(ducc.ctx, traps as *mut _);
+            ffi::duk_put_prop_string(ducc.ctx, -2, PROXY_TRAPS.as_ptr() as *const _);
+            ffi::duk_push_c_function(ducc.ctx, Some(finalizer), 1);
+            ffi::duk_set_finalizer(ducc.ctx, -2);
+            ffi::duk_push_proxy_native(ducc.ctx, Some(dispatch), mask, traps as *mut _);
+            Object(ducc.pop_ref())
+        })
+    }
+}
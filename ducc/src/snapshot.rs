@@ -0,0 +1,533 @@
+use ffi;
+use std::collections::{HashMap, VecDeque};
+use std::io::{self, BufWriter, Write};
+use std::os::raw::c_void;
+use std::slice;
+use util::cesu8_to_str;
+
+/// A summary of what keeps memory alive in the heap, as returned by [`Ducc::heap_summary`].
+///
+/// The heap is seen as a graph of strings, objects (including functions, arrays and scopes) and
+/// buffers, reachable from the same roots as the garbage collector uses. An object *retains* the
+/// memory that would be freed if it were freed, i.e. its own size plus the size of everything
+/// that is only reachable through it (everything it dominates). Sizes count the memory Duktape
+/// allocates for a value, including the property table of objects, but not allocator overhead.
+///
+/// [`Ducc::heap_summary`]: struct.Ducc.html#method.heap_summary
+#[derive(Clone, Debug, Default)]
+pub struct HeapSummary {
+    /// Number of strings, objects and buffers in the heap.
+    pub nodes: usize,
+    /// Total size of all nodes, in bytes.
+    pub total_size: usize,
+    /// Size of the nodes that are no longer reachable but haven't been freed yet, such as objects
+    /// waiting for their finalizer to run.
+    pub unreachable_size: usize,
+    /// Nodes grouped by constructor, largest retained size first.
+    pub groups: Vec<HeapGroup>,
+    /// The reachable nodes with the largest retained sizes, largest first. The engine's own
+    /// roots, like the global object, naturally come first.
+    pub retainers: Vec<HeapRetainer>,
+}
+
+/// Nodes of a `HeapSummary` that share a constructor.
+#[derive(Clone, Debug)]
+pub struct HeapGroup {
+    /// The name of the objects' constructor (e.g. `Object`, `Array` or the name of a class), or
+    /// one of `(string)`, `(closure)`, `(buffer)`, `(scope)` and `(thread)`.
+    pub name: String,
+    /// Number of nodes in the group.
+    pub count: usize,
+    /// Size of the nodes themselves.
+    pub self_size: usize,
+    /// Size retained by the nodes of the group together, not counting twice nodes that retain
+    /// each other.
+    pub retained_size: usize,
+}
+
+/// A node of a `HeapSummary` that retains a lot of memory.
+#[derive(Clone, Debug)]
+pub struct HeapRetainer {
+    /// Constructor or function name of the node, or the beginning of a string.
+    pub name: String,
+    /// A shortest chain of references from the roots to the node, like
+    /// `heap_thread.builtin[0].cache[3]` for an element of the array in the global `cache`.
+    pub path: String,
+    /// Size of the node itself.
+    pub self_size: usize,
+    /// Size retained by the node.
+    pub retained_size: usize,
+}
+
+// Strings longer than this are truncated when used as node names.
+const MAX_NAME_BYTES: usize = 256;
+
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum NodeType {
+    Hidden,
+    String,
+    Object,
+    Closure,
+    Regexp,
+    Native,
+    Synthetic,
+}
+
+impl NodeType {
+    // Index into `node_types` of the Chrome format.
+    fn chrome_index(self) -> usize {
+        match self {
+            NodeType::Hidden => 0,
+            NodeType::String => 2,
+            NodeType::Object => 3,
+            NodeType::Closure => 5,
+            NodeType::Regexp => 6,
+            NodeType::Native => 8,
+            NodeType::Synthetic => 9,
+        }
+    }
+}
+
+struct Node {
+    type_: NodeType,
+    name: usize,
+    size: usize,
+}
+
+struct Edge {
+    to: usize,
+    kind: u32,
+    index: u32,
+    name: usize,
+}
+
+// The heap as reported by `duk_walk_heap`. Node 0 is a synthetic root whose edges are the heap's
+// roots, and the edges of each node are stored contiguously, in node order. Names are indices into
+// `strings`, which also serves as the string table of the Chrome format.
+pub(crate) struct HeapGraph {
+    nodes: Vec<Node>,
+    edges: Vec<Edge>,
+    edge_start: Vec<usize>,
+    strings: Vec<String>,
+}
+
+struct GraphBuilder {
+    nodes: Vec<Node>,
+    edges: Vec<(usize, usize, u32, u32, usize)>,
+    by_ptr: HashMap<usize, usize>,
+    strings: Vec<String>,
+    string_ids: HashMap<Vec<u8>, usize>,
+}
+
+impl GraphBuilder {
+    fn new() -> GraphBuilder {
+        let mut builder = GraphBuilder {
+            nodes: Vec::new(),
+            edges: Vec::new(),
+            by_ptr: HashMap::new(),
+            strings: Vec::new(),
+            string_ids: HashMap::new(),
+        };
+        let name = builder.intern(b"");
+        builder.nodes.push(Node { type_: NodeType::Synthetic, name, size: 0 });
+        builder
+    }
+
+    fn intern(&mut self, bytes: &[u8]) -> usize {
+        if let Some(&id) = self.string_ids.get(bytes) {
+            return id;
+        }
+        let string = cesu8_to_str(bytes).map(|s| s.into_owned()).unwrap_or_else(String::new);
+        self.strings.push(string);
+        self.string_ids.insert(bytes.to_vec(), self.strings.len() - 1);
+        self.strings.len() - 1
+    }
+
+    fn add_node(&mut self, node: &ffi::duk_heap_node) {
+        let mut name = unsafe { raw_bytes(node.name, node.name_len) };
+        let (type_, name) = match node.kind {
+            ffi::DUK_HEAP_NODE_STRING => {
+                if name.len() > MAX_NAME_BYTES {
+                    // Back off to the start of a (CESU-8) character.
+                    let mut end = MAX_NAME_BYTES;
+                    while end > 0 && name[end] & 0xc0 == 0x80 {
+                        end -= 1;
+                    }
+                    name = &name[..end];
+                }
+                (NodeType::String, self.intern(name))
+            },
+            ffi::DUK_HEAP_NODE_OBJECT => match node.class_number {
+                CLASS_FUNCTION => (NodeType::Closure, self.intern(name)),
+                CLASS_REGEXP => (NodeType::Regexp, self.intern(b"RegExp")),
+                CLASS_OBJENV | CLASS_DECENV => (NodeType::Hidden, self.intern(b"(scope)")),
+                CLASS_THREAD => (NodeType::Hidden, self.intern(b"(thread)")),
+                class if name.is_empty() => {
+                    let class_name = CLASS_NAMES.get(class as usize).unwrap_or(&"Object");
+                    (NodeType::Object, self.intern(class_name.as_bytes()))
+                },
+                _ => (NodeType::Object, self.intern(name)),
+            },
+            _ => (NodeType::Native, self.intern(b"(buffer)")),
+        };
+        self.by_ptr.insert(node.ptr as usize, self.nodes.len());
+        self.nodes.push(Node { type_, name, size: node.size as usize });
+    }
+
+    fn add_edge(&mut self, edge: &ffi::duk_heap_edge) {
+        // Duktape reports the edges of a node right after the node, and the roots before any node.
+        let from = if edge.from.is_null() { 0 } else { self.nodes.len() - 1 };
+        let key = unsafe { raw_bytes(edge.name, edge.name_len) };
+        let name = match edge.kind {
+            ffi::DUK_HEAP_EDGE_GETTER => self.intern(&[b"get ", key].concat()),
+            ffi::DUK_HEAP_EDGE_SETTER => self.intern(&[b"set ", key].concat()),
+            _ => self.intern(key),
+        };
+        self.edges.push((from, edge.to as usize, edge.kind, edge.index, name));
+    }
+
+    fn finish(self) -> HeapGraph {
+        let by_ptr = self.by_ptr;
+        let mut edge_start = vec![0; self.nodes.len() + 1];
+        let mut edges = Vec::with_capacity(self.edges.len());
+        for (from, to, kind, index, name) in self.edges {
+            if let Some(&to) = by_ptr.get(&to) {
+                edge_start[from + 1] += 1;
+                edges.push(Edge { to, kind, index, name });
+            }
+        }
+        for i in 1..edge_start.len() {
+            edge_start[i] += edge_start[i - 1];
+        }
+        HeapGraph { nodes: self.nodes, edges, edge_start, strings: self.strings }
+    }
+}
+
+unsafe extern "C" fn heap_node_func(udata: *mut c_void, node: *const ffi::duk_heap_node) {
+    (*(udata as *mut GraphBuilder)).add_node(&*node);
+}
+
+unsafe extern "C" fn heap_edge_func(udata: *mut c_void, edge: *const ffi::duk_heap_edge) {
+    (*(udata as *mut GraphBuilder)).add_edge(&*edge);
+}
+
+impl HeapGraph {
+    pub unsafe fn capture(ctx: *mut ffi::duk_context) -> HeapGraph {
+        let mut builder = GraphBuilder::new();
+        ffi::duk_walk_heap(
+            ctx,
+            Some(heap_node_func),
+            Some(heap_edge_func),
+            &mut builder as *mut GraphBuilder as *mut _,
+        );
+        builder.finish()
+    }
+
+    fn edges_of(&self, node: usize) -> &[Edge] {
+        &self.edges[self.edge_start[node]..self.edge_start[node + 1]]
+    }
+
+    // Writes the graph in the JSON format of Chrome's `.heapsnapshot` files.
+    pub fn write_chrome<W: Write>(&self, out: &mut W) -> io::Result<()> {
+        let mut out = BufWriter::new(out);
+        out.write_all(concat!(
+            r#"{"snapshot":{"meta":{"#,
+            r#""node_fields":["type","name","id","self_size","edge_count","trace_node_id"],"#,
+            r#""node_types":[["hidden","array","string","object","code","closure","regexp","#,
+            r#""number","native","synthetic","concatenated string","sliced string","symbol","#,
+            r#""bigint"],"string","number","number","number","number","number"],"#,
+            r#""edge_fields":["type","name_or_index","to_node"],"#,
+            r#""edge_types":[["context","element","property","internal","hidden","shortcut","#,
+            r#""weak"],"string_or_number","node"],"#,
+            r#""trace_function_info_fields":["function_id","name","script_name","script_id","#,
+            r#""line","column"],"#,
+            r#""trace_node_fields":["id","function_info_index","count","size","children"],"#,
+            r#""sample_fields":["timestamp_us","last_assigned_id"],"#,
+            r#""location_fields":["object_index","script_id","line","column"]},"#,
+        ).as_bytes())?;
+        write!(out, r#""node_count":{},"edge_count":{},"trace_function_count":0}},"#,
+            self.nodes.len(), self.edges.len())?;
+
+        out.write_all(b"\n\"nodes\":[")?;
+        for (i, node) in self.nodes.iter().enumerate() {
+            let sep = if i > 0 { ",\n" } else { "" };
+            write!(out, "{}{},{},{},{},{},0", sep, node.type_.chrome_index(), node.name, 2 * i + 1,
+                node.size, self.edge_start[i + 1] - self.edge_start[i])?;
+        }
+
+        out.write_all(b"],\n\"edges\":[")?;
+        for (i, edge) in self.edges.iter().enumerate() {
+            let sep = if i > 0 { ",\n" } else { "" };
+            let (type_, name_or_index) = match edge.kind {
+                ffi::DUK_HEAP_EDGE_ELEMENT => (1, edge.index as usize),
+                ffi::DUK_HEAP_EDGE_INTERNAL => (3, edge.name),
+                ffi::DUK_HEAP_EDGE_HIDDEN => (4, edge.index as usize),
+                _ => (2, edge.name),
+            };
+            write!(out, "{}{},{},{}", sep, type_, name_or_index, edge.to * 6)?;
+        }
+
+        out.write_all(b"],\n\"trace_function_infos\":[],\"trace_tree\":[],\"samples\":[],")?;
+        out.write_all(b"\"locations\":[],\n\"strings\":[")?;
+        for (i, string) in self.strings.iter().enumerate() {
+            if i > 0 {
+                out.write_all(b",\n")?;
+            }
+            write_json_str(&mut out, string)?;
+        }
+        out.write_all(b"]}\n")?;
+        out.flush()
+    }
+
+    pub fn summary(&self, top: usize) -> HeapSummary {
+        let count = self.nodes.len();
+        let order = self.postorder();
+        let idom = self.dominators(&order);
+
+        // Each node's retained size is added to its immediate dominator's, children first.
+        let mut retained: Vec<usize> = self.nodes.iter().map(|node| node.size).collect();
+        for &node in &order {
+            if node != 0 {
+                retained[idom[node]] += retained[node];
+            }
+        }
+
+        let mut group_ids = HashMap::new();
+        let mut groups = Vec::new();
+        let mut group_of = vec![0; count];
+        for (i, node) in self.nodes.iter().enumerate().skip(1) {
+            let name = match node.type_ {
+                NodeType::String => "(string)",
+                NodeType::Closure => "(closure)",
+                _ => &self.strings[node.name],
+            };
+            let id = *group_ids.entry(name).or_insert_with(|| {
+                groups.push(HeapGroup {
+                    name: name.to_string(),
+                    count: 0,
+                    self_size: 0,
+                    retained_size: 0,
+                });
+                groups.len() - 1
+            });
+            group_of[i] = id;
+            groups[id].count += 1;
+            groups[id].self_size += node.size;
+        }
+
+        // A group retains what its outermost members in the dominator tree retain.
+        let mut children = vec![Vec::new(); count];
+        for &node in &order {
+            if node != 0 {
+                children[idom[node]].push(node);
+            }
+        }
+        let mut active = vec![0usize; groups.len()];
+        let mut stack = vec![(0, false)];
+        while let Some((node, exiting)) = stack.pop() {
+            if node == 0 {
+                if !exiting {
+                    stack.push((0, true));
+                    stack.extend(children[0].iter().map(|&child| (child, false)));
+                }
+                continue;
+            }
+            let group = group_of[node];
+            if exiting {
+                active[group] -= 1;
+                continue;
+            }
+            if active[group] == 0 {
+                groups[group].retained_size += retained[node];
+            }
+            active[group] += 1;
+            stack.push((node, true));
+            stack.extend(children[node].iter().map(|&child| (child, false)));
+        }
+        groups.sort_by(|a, b| b.retained_size.cmp(&a.retained_size).then(a.name.cmp(&b.name)));
+
+        let mut largest: Vec<usize> = order.iter().cloned().filter(|&node| node != 0).collect();
+        largest.sort_by(|&a, &b| retained[b].cmp(&retained[a]).then(a.cmp(&b)));
+        largest.truncate(top);
+        let paths = self.paths(&largest);
+        let retainers = largest.iter().zip(paths).map(|(&node, path)| HeapRetainer {
+            name: self.strings[self.nodes[node].name].clone(),
+            path,
+            self_size: self.nodes[node].size,
+            retained_size: retained[node],
+        }).collect();
+
+        let total_size = self.nodes.iter().map(|node| node.size).sum();
+        HeapSummary {
+            nodes: count - 1,
+            total_size,
+            unreachable_size: total_size - retained[0],
+            groups,
+            retainers,
+        }
+    }
+
+    // The nodes reachable from the root, in depth-first postorder.
+    fn postorder(&self) -> Vec<usize> {
+        let mut visited = vec![false; self.nodes.len()];
+        let mut order = Vec::new();
+        let mut stack = vec![(0, self.edge_start[0])];
+        visited[0] = true;
+        while let Some(&(node, next)) = stack.last() {
+            if next == self.edge_start[node + 1] {
+                order.push(node);
+                stack.pop();
+                continue;
+            }
+            let to = self.edges[next].to;
+            stack.last_mut().unwrap().1 += 1;
+            if !visited[to] {
+                visited[to] = true;
+                stack.push((to, self.edge_start[to]));
+            }
+        }
+        order
+    }
+
+    // Immediate dominators, computed with the iterative algorithm of Cooper, Harvey and Kennedy
+    // ("A Simple, Fast Dominance Algorithm"). Unreachable nodes get `usize::MAX`.
+    fn dominators(&self, order: &[usize]) -> Vec<usize> {
+        const NONE: usize = ::std::usize::MAX;
+        let count = self.nodes.len();
+        let mut rank = vec![NONE; count];
+        for (i, &node) in order.iter().enumerate() {
+            rank[node] = i;
+        }
+
+        let mut preds = vec![Vec::new(); count];
+        for &node in order {
+            for edge in self.edges_of(node) {
+                preds[edge.to].push(node);
+            }
+        }
+
+        let mut idom = vec![NONE; count];
+        idom[0] = 0;
+        let mut changed = true;
+        while changed {
+            changed = false;
+            for &node in order.iter().rev().skip(1) {
+                let mut new_idom = NONE;
+                for &pred in &preds[node] {
+                    if idom[pred] == NONE {
+                        continue;
+                    }
+                    new_idom = if new_idom == NONE {
+                        pred
+                    } else {
+                        let (mut a, mut b) = (pred, new_idom);
+                        while a != b {
+                            while rank[a] < rank[b] {
+                                a = idom[a];
+                            }
+                            while rank[b] < rank[a] {
+                                b = idom[b];
+                            }
+                        }
+                        a
+                    };
+                }
+                if idom[node] != new_idom {
+                    idom[node] = new_idom;
+                    changed = true;
+                }
+            }
+        }
+        idom
+    }
+
+    // Shortest paths from the root to each of `targets`, as property access expressions.
+    fn paths(&self, targets: &[usize]) -> Vec<String> {
+        const NONE: usize = ::std::usize::MAX;
+        let mut parent = vec![(NONE, NONE); self.nodes.len()];
+        let mut queue = VecDeque::new();
+        parent[0] = (0, NONE);
+        queue.push_back(0);
+        while let Some(node) = queue.pop_front() {
+            for i in self.edge_start[node]..self.edge_start[node + 1] {
+                let to = self.edges[i].to;
+                if parent[to].0 == NONE {
+                    parent[to] = (node, i);
+                    queue.push_back(to);
+                }
+            }
+        }
+
+        targets.iter().map(|&target| {
+            let mut labels = Vec::new();
+            let mut node = target;
+            while node != 0 && parent[node].0 != NONE {
+                labels.push(self.edge_label(&self.edges[parent[node].1]));
+                node = parent[node].0;
+            }
+            let mut path = String::new();
+            for label in labels.iter().rev() {
+                if !path.is_empty() && !label.starts_with('[') {
+                    path.push('.');
+                }
+                path.push_str(label);
+            }
+            path
+        }).collect()
+    }
+
+    fn edge_label(&self, edge: &Edge) -> String {
+        match edge.kind {
+            ffi::DUK_HEAP_EDGE_ELEMENT => format!("[{}]", edge.index),
+            ffi::DUK_HEAP_EDGE_HIDDEN => format!("{}[{}]", self.strings[edge.name], edge.index),
+            _ => self.strings[edge.name].clone(),
+        }
+    }
+}
+
+// Duktape's internal class numbers (`DUK_HOBJECT_CLASS_*`), which `duk_heap_node` reports.
+const CLASS_FUNCTION: u32 = 3;
+const CLASS_REGEXP: u32 = 11;
+const CLASS_OBJENV: u32 = 15;
+const CLASS_DECENV: u32 = 16;
+const CLASS_THREAD: u32 = 18;
+
+const CLASS_NAMES: [&str; 30] = [
+    "Object", "Object", "Array", "Function", "Arguments", "Boolean", "Date", "Error", "JSON",
+    "Math", "Number", "RegExp", "String", "global", "Symbol", "ObjEnv", "DecEnv", "Pointer",
+    "Thread", "ArrayBuffer", "DataView", "Int8Array", "Uint8Array", "Uint8ClampedArray",
+    "Int16Array", "Uint16Array", "Int32Array", "Uint32Array", "Float32Array", "Float64Array",
+];
+
+fn write_json_str<W: Write>(out: &mut W, s: &str) -> io::Result<()> {
+    out.write_all(b"\"")?;
+    let mut start = 0;
+    for (i, c) in s.char_indices() {
+        let escape = match c {
+            '"' => "\\\"",
+            '\\' => "\\\\",
+            '\n' => "\\n",
+            '\r' => "\\r",
+            '\t' => "\\t",
+            c if (c as u32) < 0x20 => "",
+            _ => continue,
+        };
+        out.write_all(s[start..i].as_bytes())?;
+        if escape.is_empty() {
+            write!(out, "\\u{:04x}", c as u32)?;
+        } else {
+            out.write_all(escape.as_bytes())?;
+        }
+        start = i + c.len_utf8();
+    }
+    out.write_all(s[start..].as_bytes())?;
+    out.write_all(b"\"")
+}
+
+unsafe fn raw_bytes<'a>(ptr: *const ::std::os::raw::c_char, len: ffi::duk_size_t) -> &'a [u8] {
+    if ptr.is_null() {
+        &[]
+    } else {
+        slice::from_raw_parts(ptr as *const u8, len as usize)
+    }
+}
@@ -0,0 +1,171 @@
+use ducc::Ducc;
+use ffi;
+use std::collections::HashMap;
+use std::os::raw::c_void;
+use std::panic::Location;
+use std::slice;
+use std::time::Duration;
+use util::cesu8_to_str;
+
+/// Call counts and times of a single function, as returned by [`Ducc::function_stats`].
+///
+/// Times are measured with the monotonic clock from the call to its return (or throw). For
+/// recursive functions, `total_time` counts the time of nested calls once per enclosing call.
+///
+/// [`Ducc::function_stats`]: struct.Ducc.html#method.function_stats
+#[derive(Clone, Debug)]
+pub struct FunctionStats {
+    /// Name of the function. Empty for anonymous functions, and for Rust functions created with
+    /// `create_function`.
+    pub function: String,
+    /// For JavaScript functions, the `fileName` of the function. For Rust functions, the Rust
+    /// source file that created the function.
+    pub file_name: String,
+    /// For JavaScript functions, the first line of the function body. For Rust functions, the line
+    /// of the Rust source that created the function.
+    pub line: u32,
+    /// Whether this is a Rust function.
+    pub native: bool,
+    /// Number of calls that returned or threw while recording.
+    pub calls: u64,
+    /// Time from call to return, summed over all calls.
+    pub total_time: Duration,
+    /// Time spent in the function itself, excluding the functions it called.
+    pub self_time: Duration,
+}
+
+struct Entry {
+    name: Vec<u8>,
+    file_name: Vec<u8>,
+    line: u32,
+    native: bool,
+    calls: u64,
+    total_time: f64,
+    self_time: f64,
+}
+
+// Entries are found through the key reported by Duktape (the function's bytecode, shared by all of
+// its closures, or a label's key), and checked against the reported name, file and line in case
+// the key has been reused by a different function since. Functions that compare equal by name,
+// file and line are aggregated together.
+pub(crate) struct StatsRecorder {
+    entries: Vec<Entry>,
+    by_key: HashMap<usize, usize>,
+    by_name: HashMap<(Vec<u8>, Vec<u8>, u32, bool), usize>,
+}
+
+impl StatsRecorder {
+    pub fn new() -> StatsRecorder {
+        StatsRecorder { entries: Vec::new(), by_key: HashMap::new(), by_name: HashMap::new() }
+    }
+
+    pub fn function_stats(&self) -> Vec<FunctionStats> {
+        self.entries.iter().map(|entry| FunctionStats {
+            function: lossy_str(&entry.name),
+            file_name: lossy_str(&entry.file_name),
+            line: entry.line,
+            native: entry.native,
+            calls: entry.calls,
+            total_time: millis_to_duration(entry.total_time),
+            self_time: millis_to_duration(entry.self_time),
+        }).collect()
+    }
+
+    fn record(&mut self, entry: &ffi::duk_call_stats_entry) {
+        let name = unsafe { raw_bytes(entry.name, entry.name_len) };
+        let file_name = unsafe { raw_bytes(entry.filename, entry.filename_len) };
+        let native = entry.native != 0;
+
+        let cached = self.by_key.get(&(entry.key as usize)).cloned().filter(|&index| {
+            let cached = &self.entries[index];
+            cached.line == entry.line && cached.native == native && cached.name == name &&
+                cached.file_name == file_name
+        });
+        let index = match cached {
+            Some(index) => index,
+            None => {
+                let name_key = (name.to_vec(), file_name.to_vec(), entry.line, native);
+                let entries = &mut self.entries;
+                let index = *self.by_name.entry(name_key).or_insert_with(|| {
+                    entries.push(Entry {
+                        name: name.to_vec(),
+                        file_name: file_name.to_vec(),
+                        line: entry.line,
+                        native,
+                        calls: 0,
+                        total_time: 0.0,
+                        self_time: 0.0,
+                    });
+                    entries.len() - 1
+                });
+                self.by_key.insert(entry.key as usize, index);
+                index
+            },
+        };
+
+        let stats = &mut self.entries[index];
+        stats.calls += 1;
+        stats.total_time += entry.total_time;
+        stats.self_time += entry.self_time;
+    }
+}
+
+pub(crate) unsafe extern "C" fn call_stats_func(
+    udata: *mut c_void,
+    entry: *const ffi::duk_call_stats_entry,
+) {
+    (*(udata as *mut StatsRecorder)).record(&*entry);
+}
+
+// Identifies a Rust function in the statistics. Owned by the function's callback: Duktape reads
+// the label when the call unwinds, after the callback itself has returned.
+pub(crate) struct CallLabel {
+    raw: ffi::duk_call_stats_label,
+    _name: String,
+}
+
+// The raw label only points into the label's own `String` and to `'static` data.
+unsafe impl Send for CallLabel {}
+
+impl CallLabel {
+    pub fn new(name: String, location: &'static Location<'static>) -> CallLabel {
+        // Names tell apart the methods created on a single line, anonymous functions need the
+        // location.
+        let key = if name.is_empty() {
+            location as *const _ as *const c_void
+        } else {
+            name.as_ptr() as *const c_void
+        };
+        let raw = ffi::duk_call_stats_label {
+            key,
+            name: name.as_ptr() as *const _,
+            name_len: name.len() as ffi::duk_size_t,
+            filename: location.file().as_ptr() as *const _,
+            filename_len: location.file().len() as ffi::duk_size_t,
+            line: location.line(),
+        };
+        CallLabel { raw, _name: name }
+    }
+
+    // Called at the start of the labelled function, with the label borrowed from the callback for
+    // the duration of the call.
+    pub fn set(&self, ducc: &Ducc) {
+        unsafe { ffi::duk_set_call_stats_label(ducc.ctx, &self.raw); }
+    }
+}
+
+unsafe fn raw_bytes<'a>(ptr: *const ::std::os::raw::c_char, len: ffi::duk_size_t) -> &'a [u8] {
+    if ptr.is_null() {
+        &[]
+    } else {
+        slice::from_raw_parts(ptr as *const u8, len as usize)
+    }
+}
+
+fn lossy_str(bytes: &[u8]) -> String {
+    cesu8_to_str(bytes).map(|s| s.into_owned()).unwrap_or_else(String::new)
+}
+
+fn millis_to_duration(millis: f64) -> Duration {
+    Duration::from_nanos((millis.max(0.0) * 1_000_000.0) as u64)
+}
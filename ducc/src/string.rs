@@ -1,10 +1,10 @@
-use cesu8::from_cesu8;
 use error::{Error, Result};
 use ffi;
 use std::borrow::Cow;
 use std::slice;
 use std::string::String as StdString;
 use types::Ref;
+use util::cesu8_to_str;
 
 /// An immutable, interned JavaScript string managed by Duktape.
 ///
@@ -16,9 +16,9 @@ impl<'ducc> String<'ducc> {
     /// Returns a Rust string converted from the Duktape string as long as it can be converted from
     /// CESU-8 to UTF-8.
     pub fn to_string(&self) -> Result<StdString> {
-        match from_cesu8(self.as_bytes()) {
-            Ok(string) => Ok(string.into_owned()),
-            Err(_) => Err(Error::from_js_conversion("string", "String"))
+        match cesu8_to_str(self.as_bytes()) {
+            Some(string) => Ok(string.into_owned()),
+            None => Err(Error::from_js_conversion("string", "String"))
         }
     }
 
@@ -31,7 +31,7 @@ impl<'ducc> String<'ducc> {
     ///
     /// Otherwise, returns a copy of the string converted to UTF-8.
     pub fn to_str(&self) -> Result<Cow<str>> {
-        from_cesu8(self.as_bytes()).map_err(|_| Error::from_js_conversion("string", "Cow<str>"))
+        cesu8_to_str(self.as_bytes()).ok_or_else(|| Error::from_js_conversion("string", "Cow<str>"))
     }
 
     /// Returns the bytes that make up this string, without a trailing nul byte. This is a CESU-8
@@ -0,0 +1,113 @@
+use class::ClassBuilder;
+use ducc::Ducc;
+use function::Function;
+use error::{Error, ErrorKind, Result};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use value::Values;
+
+struct Counter {
+    count: f64,
+    drops: Arc<AtomicUsize>,
+}
+
+impl Drop for Counter {
+    fn drop(&mut self) {
+        self.drops.fetch_add(1, Ordering::SeqCst);
+    }
+}
+
+#[test]
+fn class_methods() {
+    let drops = Arc::new(AtomicUsize::new(0));
+    {
+        let ducc = Ducc::new();
+        let class = ducc.create_class(ClassBuilder::<Counter>::new()
+            .method("get", |_, this, _| Ok(this.count))
+            .method_mut("add", |ducc, this, args: Values| {
+                this.count += args.from::<f64>(ducc, 0)?;
+                Ok(this.count)
+            }));
+
+        let a = class.create(Counter { count: 1.0, drops: drops.clone() });
+        let b = class.create(Counter { count: 10.0, drops: drops.clone() });
+        ducc.globals().set("a", a).unwrap();
+        ducc.globals().set("b", b).unwrap();
+
+        let result: String = ducc.exec(r#"
+            var out = [a.add(2), b.add(5), a.get(), b.get(), a.add === b.add];
+            out.push(Object.getPrototypeOf(a) === Object.getPrototypeOf(b), Object.keys(a).length);
+            try { a.get.call({}); } catch (e) { out.push(e.name); }
+            try { a.get.call(1); } catch (e) { out.push(e.name); }
+            var c = Object.create(a);
+            out.push(c.get());
+            out.join();
+        "#, None, Default::default()).unwrap();
+        assert_eq!(result, "3,15,3,15,true,true,0,TypeError,TypeError,3");
+        assert_eq!(drops.load(Ordering::SeqCst), 0);
+        drop(class);
+    }
+    assert_eq!(drops.load(Ordering::SeqCst), 2);
+}
+
+#[test]
+fn class_reentrant_mut() {
+    let ducc = Ducc::new();
+    let class = ducc.create_class(ClassBuilder::<f64>::new()
+        .method_mut("call", |ducc, _, args: Values| -> Result<()> {
+            args.from::<Function>(ducc, 0)?.call(())
+        }));
+    ducc.globals().set("x", class.create(0.0)).unwrap();
+    let result: Result<()> = ducc.exec(
+        "x.call(function () { x.call(function () {}); });",
+        None,
+        Default::default(),
+    );
+    match result {
+        Err(Error { kind: ErrorKind::RecursiveMutCallback, .. }) => {},
+        other => panic!("incorrect result: {:?}", other),
+    }
+    drop(class);
+}
+
+#[test]
+fn class_owner_released_during_method() {
+    let drops = Arc::new(AtomicUsize::new(0));
+    {
+        let ducc = Ducc::new();
+        let during = drops.clone();
+        let class = ducc.create_class(ClassBuilder::<Counter>::new()
+            .method_mut("each", move |ducc, this, args: Values| -> Result<f64> {
+                args.from::<Function>(ducc, 0)?.call::<_, ()>(())?;
+                // The instance is no longer reachable from `this`, but must outlive the call.
+                assert_eq!(during.load(Ordering::SeqCst), 0);
+                this.count += 1.0;
+                Ok(this.count)
+            }));
+        ducc.globals().set("inst", class.create(Counter { count: 1.0, drops: drops.clone() }))
+            .unwrap();
+        let result: f64 = ducc.exec(r#"
+            var d = Object.create(inst);
+            inst = null;
+            d.each(function () { Object.setPrototypeOf(d, null); });
+        "#, None, Default::default()).unwrap();
+        assert_eq!(result, 2.0);
+        drop(class);
+    }
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+}
+
+#[test]
+fn class_instance_prototype_changed() {
+    let drops = Arc::new(AtomicUsize::new(0));
+    {
+        let ducc = Ducc::new();
+        let class = ducc.create_class(ClassBuilder::<Counter>::new());
+        ducc.globals().set("inst", class.create(Counter { count: 1.0, drops: drops.clone() }))
+            .unwrap();
+        ducc.exec::<()>("Object.setPrototypeOf(inst, {}); inst = null;", None, Default::default())
+            .unwrap();
+        drop(class);
+    }
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+}
@@ -0,0 +1,43 @@
+use codec::{base64_decode, base64_encode, hex_decode, hex_encode};
+
+#[test]
+fn base64() {
+    assert_eq!(base64_encode(b""), "");
+    assert_eq!(base64_encode(b"f"), "Zg==");
+    assert_eq!(base64_encode(b"fo"), "Zm8=");
+    assert_eq!(base64_encode(b"foobar"), "Zm9vYmFy");
+    assert_eq!(base64_decode("Zm9v\nYmE=").unwrap(), b"fooba");
+    assert_eq!(base64_decode("Zm9vYmE"), None);
+    assert_eq!(base64_decode("Zm9v*mFy"), None);
+
+    let bytes: Vec<u8> = (0..1000u32).map(|i| (i * 7919 % 251) as u8).collect();
+    for len in &[0, 1, 2, 12, 16, 23, 24, 25, 48, 100, 1000] {
+        let encoded = base64_encode(&bytes[..*len]);
+        assert_eq!(base64_decode(&encoded).unwrap(), &bytes[..*len]);
+        let wrapped = encoded.as_bytes().chunks(76)
+            .map(|line| ::std::str::from_utf8(line).unwrap())
+            .collect::<Vec<_>>()
+            .join("\r\n");
+        assert_eq!(base64_decode(&wrapped).unwrap(), &bytes[..*len]);
+    }
+}
+
+#[test]
+fn hex() {
+    assert_eq!(hex_encode(&[0x00, 0x7f, 0xab, 0xff]), "007fabff");
+    assert_eq!(hex_decode("007FabfF").unwrap(), vec![0x00, 0x7f, 0xab, 0xff]);
+    assert_eq!(hex_decode("abc"), None);
+    assert_eq!(hex_decode("0g"), None);
+
+    let bytes: Vec<u8> = (0..1000u32).map(|i| (i * 7919 % 256) as u8).collect();
+    for len in &[0, 1, 15, 16, 17, 31, 32, 33, 100, 1000] {
+        let encoded = hex_encode(&bytes[..*len]);
+        assert_eq!(encoded.len(), len * 2);
+        assert_eq!(hex_decode(&encoded).unwrap(), &bytes[..*len]);
+        if *len > 20 {
+            let mut bad = encoded.clone().into_bytes();
+            bad[len + 3] = b'z';
+            assert_eq!(hex_decode(::std::str::from_utf8(&bad).unwrap()), None);
+        }
+    }
+}
@@ -1,4 +1,4 @@
-use ducc::{Ducc, ExecSettings};
+use ducc::{Ducc, ExecSettings, HeapSettings};
 use std::cell::RefCell;
 use std::rc::Rc;
 use std::time::{Duration, Instant};
@@ -38,6 +38,111 @@ fn timeout() {
     assert!(result.is_err());
 }
 
+#[test]
+fn create_object_from() {
+    let ducc = Ducc::new();
+    let object = ducc.create_object_from(vec![("a", 1), ("b", 2), ("0", 3), ("a", 4)]).unwrap();
+    object.set("c", 5).unwrap();
+    assert_eq!(object.get::<_, i32>("a").unwrap(), 4);
+    assert_eq!(object.get::<_, i32>("b").unwrap(), 2);
+    assert_eq!(object.get::<_, i32>(0).unwrap(), 3);
+    assert_eq!(object.get::<_, i32>("c").unwrap(), 5);
+}
+
+#[test]
+fn string_table() {
+    let ducc = Ducc::new();
+    let stats = ducc.string_table_stats();
+    assert_eq!(stats.min_size, 1024);
+    assert!(stats.count > 0 && stats.count <= stats.size * 2);
+
+    let ducc = Ducc::with_settings(HeapSettings {
+        string_table_size: Some(5000),
+        ..Default::default()
+    });
+    let stats = ducc.string_table_stats();
+    assert_eq!(stats.min_size, 8192);
+    assert_eq!(stats.size, 8192);
+    let grow_count = stats.grow_count;
+
+    let script = "
+        var keys = [];
+        for (var i = 0; i < 20000; i++) {
+            keys.push('a-long-common-prefix-that-is-shared-by-every-key/' + i + '/suffix');
+        }
+    ";
+    let _: () = ducc.exec(script, None, ExecSettings::default()).unwrap();
+    let stats = ducc.string_table_stats();
+    assert!(stats.count > 20000);
+    assert!(stats.size >= 16384);
+    assert!(stats.grow_count > grow_count);
+    assert!(stats.used_buckets <= stats.size && stats.used_buckets > stats.size / 4);
+    assert!(stats.max_chain < 16);
+    assert!(stats.average_probes >= 1.0 && stats.average_probes < 4.0);
+}
+
+#[test]
+fn random_seed() {
+    let script = "
+        var a = [];
+        for (var i = 0; i < 5; i++) { a.push(Math.random()); }
+        var b = fillRandom(new Float64Array(1000));
+        for (var i = 0; i < b.length; i++) {
+            if (!(b[i] >= 0 && b[i] < 1)) { throw new Error('out of range'); }
+        }
+        var error;
+        try { fillRandom([1, 2]); } catch (e) { error = e.name; }
+        a.concat([b[0], b[999], b.length, error]).join();
+    ";
+    let run = |ducc: &Ducc| -> String {
+        ducc.globals().set("fillRandom", ducc.create_fill_random()).unwrap();
+        ducc.exec(script, None, ExecSettings::default()).unwrap()
+    };
+
+    let first = Ducc::with_settings(HeapSettings { random_seed: Some(42), ..Default::default() });
+    let second = Ducc::new();
+    second.set_random_seed(42);
+    let result = run(&first);
+    assert_eq!(result, run(&second));
+    assert!(result.ends_with(",1000,TypeError"));
+
+    let third = Ducc::with_settings(HeapSettings { random_seed: Some(43), ..Default::default() });
+    assert_ne!(result, run(&third));
+
+    let mut values = [0.0; 4];
+    first.set_random_seed(7);
+    first.fill_random(&mut values);
+    second.set_random_seed(7);
+    let from_script: f64 = second.exec("Math.random()", None, ExecSettings::default()).unwrap();
+    assert_eq!(values[0], from_script);
+    assert!(values.iter().all(|v| *v >= 0.0 && *v < 1.0) && values[1] != values[2]);
+}
+
+#[test]
+fn float64_kernels() {
+    let ducc = Ducc::new();
+    ducc.globals().set("f64", ducc.create_float64_kernels()).unwrap();
+    let script = "
+        var n = 1003, a = new Float64Array(n), b = new Float64Array(n), c = new Float64Array(n);
+        for (var i = 0; i < n; i++) { a[i] = i; b[i] = 2; }
+        var r = [f64.add(c, a, b) === c, c[0], c[n - 1]];
+        f64.mul(c, c, 0.5);
+        f64.sub(c, c, a);
+        r.push(c[10], f64.sum(c), f64.dot(a, b), f64.sum(new Float64Array(0)));
+        f64.div(c, a, b);
+        r.push(c[7]);
+        var view = new Float64Array(new ArrayBuffer(8 * 4), 8, 3);
+        view.set([1, 2, 3]);
+        r.push(f64.dot(view, view));
+        try { f64.add(c, a, new Float64Array(3)); } catch (e) { r.push(e.name); }
+        try { f64.sum([1, 2]); } catch (e) { r.push(e.name); }
+        try { f64.mul(new Float32Array(n), a, 2); } catch (e) { r.push(e.name); }
+        r.join();
+    ";
+    let result: String = ducc.exec(script, None, ExecSettings::default()).unwrap();
+    assert_eq!(result, "true,2,1004,-4,-250248.5,1005006,0,3.5,14,RangeError,TypeError,TypeError");
+}
+
 #[test]
 fn no_duktape_global() {
     let ducc = Ducc::new();
@@ -0,0 +1,634 @@
+use ducc::{Ducc, ExecSettings};
+use error::Result;
+use ffi;
+use function::Invocation;
+use std::thread;
+
+fn eval<'ducc>(ducc: &'ducc Ducc, source: &str) -> String {
+    ducc.exec(source, None, ExecSettings::default()).unwrap()
+}
+
+#[test]
+fn property_cache_layouts() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        function read(o) { return o.b; }
+        var out = [];
+        var objs = [{ a: 1, b: 2 }, { b: 3, a: 4 }, { a: 5 }, Object.create({ b: 6 })];
+        for (var i = 0; i < 8; i++) {
+            out.push(read(objs[i % objs.length]));
+        }
+        var o = { a: 1, b: 2 };
+        read(o);
+        delete o.a;
+        out.push(read(o));
+        Object.defineProperty(o, 'b', { get: function () { return 'getter'; } });
+        out.push(read(o));
+        var p = new Proxy({ b: 'target' }, { get: function () { return 'trap'; } });
+        out.push(read(p));
+        out.join(',');
+    "#);
+    assert_eq!(result, "2,3,,6,2,3,,6,2,getter,trap");
+}
+
+#[test]
+fn property_cache_writes() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        function write(o, v) { o.x = v; return o.x; }
+        var out = [];
+        var a = { x: 0 };
+        out.push(write(a, 1), write(a, 2));
+        var frozen = Object.freeze({ x: 'frozen' });
+        out.push(write(frozen, 3));
+        var inherited = Object.create({ x: 'proto' });
+        out.push(write(inherited, 4), Object.getPrototypeOf(inherited).x);
+        var setter = { set x(v) { this.y = v; }, get x() { return 'y=' + this.y; } };
+        out.push(write(setter, 5));
+        var arr = [1, 2, 3];
+        arr.length = 1;
+        out.push(arr.length);
+        out.join(',');
+    "#);
+    assert_eq!(result, "1,2,frozen,4,proto,y=5,1");
+}
+
+#[test]
+fn compare_and_branch() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var out = [];
+        var calls = 0;
+        var obj = { valueOf: function () { calls++; return 2; } };
+        var vals = [0, 2, NaN, '2', null, undefined, obj];
+        for (var i = 0; i < vals.length; i++) {
+            var a = vals[i], r = '';
+            if (a < 1) { r += 'a'; } else { r += 'b'; }
+            if (a >= 2) { r += 'c'; }
+            if (a == 2) { r += 'd'; } else if (a != null) { r += 'e'; }
+            if (a === 2) { r += 'f'; }
+            while (a !== a) { r += 'g'; break; }
+            r += (a > 1 && a <= 2) ? 'h' : 'i';
+            var flag = a > 1;
+            if (flag) { r += 'j'; }
+            out.push(r);
+        }
+        var n = 0;
+        outer: for (var x = 0; x < 10; x++) {
+            for (var y = 0; y < 10; y++) {
+                if (y > x) { continue outer; }
+                if (x * y >= 20) { break outer; }
+                n++;
+            }
+        }
+        out.push(n, calls);
+        out.join(',');
+    "#);
+    assert_eq!(result, "aei,bcdfhj,begi,bcdhj,ai,bi,bcdhj,19,6");
+}
+
+#[test]
+fn json_parse_records() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var src = JSON.stringify([
+            { id: 1, type: 'a', tags: { x: 1, y: 2 } },
+            { id: 2, type: 'b', tags: { x: 3, y: 4 } },
+            { id: 3, type: 'c', extra: true, tags: { x: 5 } },
+            { id: 4 },
+            { id: 5, type: 'e', tags: {} },
+        ]);
+        var data = JSON.parse(src);
+        data[3].late = 'added';
+        var dup = JSON.parse('{"k": 1, "k": 2, "0": "zero"}');
+        var revived = JSON.parse('[{"a": 1, "b": 2}, {"a": 3, "b": 4}]', function (k, v) {
+            return k === 'b' ? undefined : v;
+        });
+        [
+            JSON.stringify(data) === src.replace('{"id":4}', '{"id":4,"late":"added"}'),
+            Object.keys(data[2]).join(),
+            JSON.stringify(dup),
+            JSON.stringify(revived),
+        ].join('|');
+    "#);
+    assert_eq!(result, r#"true|id,type,extra,tags|{"0":"zero","k":2}|[{"a":1},{"a":3}]"#);
+}
+
+#[test]
+fn array_fast_paths() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var out = [];
+        function S(x) { out.push(JSON.stringify(x)); }
+        var a = [1, 2, 3, 'x', NaN, null, undefined, 2];
+        S([a.indexOf(2), a.lastIndexOf(2), a.indexOf(NaN), a.indexOf(2, -3), a.lastIndexOf(2, -3)]);
+        var h = [1, , 3];
+        Array.prototype[1] = 'proto';
+        S([h.indexOf('proto'), h.slice(0), [].concat(h, [4, , 6])]);
+        delete Array.prototype[1];
+        S([h.map(function (v) { return v; }), [0].concat(1, [2, 3], 'a', [[5]])]);
+        var b = [1, 2, 3, 4, 5];
+        S(b.map(function (v, i, arr) { if (i == 1) { arr.length = 3; } return v * 2; }));
+        var e = [5, 6, 7, 8];
+        S([e.slice({ valueOf: function () { e.length = 2; return 1; } }), b.slice(1, -1)]);
+        var g = [1, 2, 3];
+        Object.defineProperty(g, 1, { get: function () { return 'getter'; } });
+        S([g.slice(0), g.indexOf('getter'), [].concat(g)]);
+        out.join('|');
+    "#);
+    assert_eq!(
+        result,
+        r#"[1,7,-1,7,1]|[1,[1,"proto",3],[1,"proto",3,4,"proto",6]]|[[1,null,3],[0,1,2,3,"a",[5]]]|[2,4,6,null,null]|[[6],[2]]|[[1,"getter",3],1,[1,"getter",3]]"#
+    );
+}
+
+#[test]
+fn array_map_compaction() {
+    let ducc = Ducc::new();
+    // Compacting forces the same object compaction as an emergency GC after a failed allocation.
+    let compact = ducc.create_function(|inv: Invocation| -> Result<()> {
+        unsafe { ffi::duk_gc(inv.ducc.ctx, ffi::DUK_GC_COMPACT); }
+        Ok(())
+    });
+    ducc.globals().set("compact", compact).unwrap();
+    let result = eval(&ducc, r#"
+        var a = [];
+        for (var i = 0; i < 1000; i++) { a.push(i); }
+        var r = a.map(function (v, i) { if (i == 10) { compact(); } return v; });
+        [r.length, r[10], r[999], r[500]].join(' ');
+    "#);
+    assert_eq!(result, "1000 10 999 500");
+}
+
+#[test]
+fn array_sort() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var out = [];
+        function S(x) { out.push(JSON.stringify(x)); }
+        S([3, 1, 2, 10, 21, 100].sort());
+        S([3, 1, 2, 10, 21, 100].sort(function (a, b) { return a - b; }));
+        S([true, null, 1, 'x', false, 0, -1].sort());
+        var h = [5, undefined, 1, , 3];
+        S([h.sort(), h.length, 3 in h, 4 in h]);
+        var recs = [];
+        for (var i = 0; i < 500; i++) { recs.push({ k: (i * 7919) % 13, i: i }); }
+        recs.sort(function (a, b) { return a.k - b.k; });
+        var stable = true;
+        for (var i = 1; i < recs.length; i++) {
+            var p = recs[i - 1], q = recs[i];
+            if (p.k > q.k || (p.k === q.k && p.i > q.i)) { stable = false; }
+        }
+        S(stable);
+        var o = { length: 4, 0: 'd', 1: 'b', 3: 'a' };
+        Array.prototype.sort.call(o);
+        S([o, 3 in o]);
+        var m = [4, 3, 2, 1];
+        m.sort(function (a, b) { m.length = 0; return a - b; });
+        S(m);
+        var ex = [3, 1, 2];
+        try { ex.sort(function () { throw new Error('boom'); }); } catch (e) { S([e.message, ex]); }
+        try { [1, 2].sort('x'); } catch (e) { S(e.name); }
+        out.join('|');
+    "#);
+    assert_eq!(
+        result,
+        r#"[1,10,100,2,21,3]|[1,2,3,10,21,100]|[-1,0,1,false,null,true,"x"]|[[1,3,5,null,null],5,true,false]|true|[{"0":"a","1":"b","2":"d","length":4},false]|[1,2,3,4]|["boom",[3,1,2]]|"TypeError""#
+    );
+}
+
+#[test]
+fn array_sort_symbols() {
+    let ducc = Ducc::new();
+    // The Symbol built-in is disabled, so the symbol is created through the API.
+    unsafe {
+        let bytes = b"\x81sym\xff";
+        ffi::duk_push_lstring(ducc.ctx, bytes.as_ptr() as *const _, bytes.len());
+        ffi::duk_put_global_string(ducc.ctx, cstr!("sym"));
+    }
+    let result = eval(&ducc, r#"
+        var out = [];
+        function S(x) { out.push(JSON.stringify(x)); }
+        S([typeof sym, [sym].sort()[0] === sym, [undefined, sym, ,].sort()[0] === sym]);
+        try { [sym, 1].sort(); } catch (e) { S(e.name); }
+        try { [1, 2, 3, sym].sort(); } catch (e) { S(e.name); }
+        out.join('|');
+    "#);
+    assert_eq!(result, r#"["symbol",true,true]|"TypeError"|"TypeError""#);
+}
+
+#[test]
+fn regexp_linear() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var out = [];
+        function S(x) { out.push(JSON.stringify(x)); }
+        var a = '';
+        for (var i = 0; i < 30; i++) { a += 'a'; }
+        S([/(a+)+b/.test(a), /(x+x+)+y/.test('xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx')]);
+        var ab = '';
+        for (var i = 0; i < 1000; i++) { ab += i % 2 ? 'a' : 'b'; }
+        S([/(?:a|b)*c/.test(ab), /(a|b)+$/.exec(ab)[1], ab.replace(/(ab)+/g, 'x')]);
+        S([/(a*)*/.exec('aab'), /(a|)+b/.exec('aab'), /(z)((a+)?(b+)?(c))*/.exec('zaacbbbcac')]);
+        S([/a.*?(b+)/.exec(a + 'bbb' + a), /^(\w+\s?)*$/.test('aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa!')]);
+        S([/(a)\1/.exec('xaa'), /x(?=y)/.exec('xzxy').index]);
+        out.join('|');
+    "#);
+    assert_eq!(
+        result,
+        r#"[false,false]|[false,"a","bxa"]|[["aa","aa"],["aab","a"],["zaacbbbcac","z","ac","a",null,"c"]]|[["aaaaaaaaaaaaaaaaaaaaaaaaaaaaaabbb","bbb"],false]|[["aa","a"],2]"#
+    );
+}
+
+#[test]
+fn regexp_linear_empty_iterations() {
+    let ducc = Ducc::new();
+    // Loops whose body can match empty, which the backtracking matcher gives up on. An iteration
+    // matching empty fails, so it leaves no captures behind. Expected values are from Node.
+    check_cases(&ducc, &[
+        ("JSON.stringify(/(a|())*b/.exec('aab'))", r#"["aab","a",null]"#),
+        ("JSON.stringify(/(?:|())*b/.exec('aab'))", r#"["b",null]"#),
+        ("JSON.stringify(/(?:a|(|))*/.exec('aab'))", r#"["aa",null]"#),
+        ("JSON.stringify(/(?:a|($|[ab]))*/.exec('aab'))", r#"["aab","b"]"#),
+        ("JSON.stringify(/(?:((?:aa|a))|(|))*a/.exec('aab'))", r#"["aa","a",null]"#),
+        ("JSON.stringify(/(?:b|())*(b|)$/.exec('aab'))", r#"["b",null,""]"#),
+        ("JSON.stringify(/(?:$|(|([ab]|a$)))*\\b/.exec('aab'))", r#"["aab","b","b"]"#),
+        ("JSON.stringify(/(?:(a)$||(($)|[ab]))*a/.exec('aab'))", r#"["aa",null,"a",null]"#),
+    ]);
+
+    // Bounded quantifiers are left to the backtracking matcher, which hits its recursion limit on
+    // the inner loop. That needs a larger stack than test threads have.
+    let result = thread::Builder::new().stack_size(64 << 20).spawn(|| {
+        let ducc = Ducc::new();
+        eval(&ducc, r#"
+            var out = [];
+            try { out.push(JSON.stringify(/([ab]|(($)*))?/.exec(''))); } catch (e) { out.push(e.name); }
+            try { out.push(JSON.stringify(/(a|((b?)*)){0,2}c/.exec('ac'))); } catch (e) { out.push(e.name); }
+            out.join('|');
+        "#)
+    }).unwrap().join().unwrap();
+    assert_eq!(result, "RangeError|RangeError");
+}
+
+#[test]
+fn regexp_cache_prefilter() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var out = [];
+        function S(x) { out.push(JSON.stringify(x)); }
+        var text = 'the cat sat on the mat; caf\u00e9 caf\u00e9s \u4e2d\u6587 x';
+        var found = [];
+        for (var i = 0; i < 3; i++) {
+            found.push(new RegExp('at', 'g').exec(text).index, new RegExp('^the').test(text), new RegExp('^cat').test(text));
+        }
+        S(found);
+        var g = new RegExp('caf\u00e9s?', 'g'), m, all = [];
+        while ((m = g.exec(text)) !== null) { all.push(m.index + ':' + m[0]); }
+        S([all, text.search(/\u6587/), /CAT/.test(text), /CAT/i.test(text)]);
+        var r1 = new RegExp('the', 'g'), r2 = new RegExp('the', 'g');
+        r1.lastIndex = 5;
+        S([r1 === r2, r1.exec(text).index, r2.exec(text).index, r2.source, r2.global]);
+        var a = new RegExp('^the', 'g');
+        a.lastIndex = 1;
+        var b = new RegExp('^the', 'gm');
+        b.lastIndex = 1;
+        S([a.exec(text), b.exec('x\nthe').index]);
+        for (var j = 0; j < 40; j++) { new RegExp('p' + j); }
+        var errs = [];
+        for (var k = 0; k < 2; k++) { try { new RegExp('('); } catch (e) { errs.push(e.name); } }
+        S([new RegExp('p3').test('xp3'), errs]);
+        out.join('|');
+    "#);
+    assert_eq!(
+        result,
+        r#"[5,true,false,5,true,false,5,true,false]|[["24:café","29:cafés"],36,false,true]|[false,15,0,"the",true]|[null,2]|[true,["SyntaxError","SyntaxError"]]"#
+    );
+}
+
+#[test]
+fn string_append_in_place() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        function build(n, piece) {
+            var s = '';
+            for (var i = 0; i < n; i++) { s += piece + i + ','; }
+            return s;
+        }
+        function run() {
+            var out = [];
+            var a = build(300, 'x'), b = build(300, 'x'), o = {};
+            o[a] = 1;
+            out.push(a === b, a.length, o[b]);
+            var base = build(40, 'y'), keep = base + 'tail', t = base;
+            t += 'tail';
+            out.push(t === keep, base.length, t.length);
+            var u = build(40, 'z');
+            for (var j = 0; j < 100; j++) { u += '\u00e9\u4e2d'; }
+            out.push(u.length, u.charAt(u.length - 1) === '\u4e2d', u.indexOf('\u00e9'));
+            var alias = u;
+            u += String(u.length);
+            out.push(alias.length, u.slice(alias.length));
+            var c = build(40, 'c'), f = function () { return c.length; };
+            c += 'more';
+            out.push(f());
+            var r = build(40, 'r');
+            r += (r = 'reset', 'X');
+            out.push(r.length, r.slice(-2));
+            return out.join('|');
+        }
+        run();
+    "#);
+    assert_eq!(result, "true|1390|1|true|150|154|350|true|150|350|350|154|151|,X");
+}
+
+// Expected values are from Node. The cases run in order, since the string cache state they
+// leave behind (cached offsets and offset indexes of long strings) is part of what's tested.
+fn check_cases(ducc: &Ducc, cases: &[(&str, &str)]) {
+    for &(expr, expected) in cases {
+        assert_eq!(eval(ducc, &format!("String({})", expr)), expected, "{}", expr);
+    }
+}
+
+#[test]
+fn string_index_unicode() {
+    let ducc = Ducc::new();
+    eval(&ducc, r#"
+        function make(n, f) { var s = ''; for (var i = 0; i < n; i++) { s += f(i); } return s; }
+        function grow(n) { for (var i = 0; i < n; i++) { s += 'b'; } return s.length; }
+        var s = make(2000, function (i) { return i % 2 ? 'a' : 'é'; });
+        var e = make(600, function (i) { return i % 7 ? '😀' : 'x'; });
+        var lone = make(1100, function (i) { return i % 3 ? 'a' : '\ud800'; });
+        // Only a string held by a single local is appended to in place.
+        function growLocal() {
+            var t = '', out = [];
+            for (var i = 0; i < 2000; i++) { t += i % 2 ? 'a' : 'é'; }
+            out.push(t.charCodeAt(1500));
+            for (var i = 0; i < 200; i++) { t += 'b'; }
+            out.push(t.charCodeAt(2150), t.charCodeAt(2199), t.charCodeAt(1999), t.length);
+            for (var i = 0; i < 1000; i++) { t += 'b'; }
+            out.push(t.charCodeAt(3150), t.charCodeAt(64), t.charCodeAt(2000), t.length);
+            return out.join();
+        }
+        '';
+    "#);
+    check_cases(&ducc, &[
+        // Offset index stride (64) boundaries and the ends.
+        ("s.length", "2000"),
+        ("s.charCodeAt(1500)", "233"),
+        ("s.charCodeAt(63)", "97"),
+        ("s.charCodeAt(64)", "233"),
+        ("s.charCodeAt(65)", "97"),
+        ("s.charCodeAt(1024)", "233"),
+        ("s.charCodeAt(0)", "233"),
+        ("s.charCodeAt(1999)", "97"),
+        ("s.charCodeAt(2000)", "NaN"),
+        // Growing after the index was built, in place (within and beyond the spare capacity) and
+        // by copying.
+        ("growLocal()", "233,98,98,97,2200,98,233,98,3200"),
+        ("grow(200)", "2200"),
+        ("s.charCodeAt(2150)", "98"),
+        ("s.charCodeAt(1500)", "233"),
+        ("s.charCodeAt(2199)", "98"),
+        ("s.charCodeAt(2000)", "98"),
+        ("s.charCodeAt(1999)", "97"),
+        ("grow(1000)", "3200"),
+        ("s.charCodeAt(3150)", "98"),
+        ("s.charCodeAt(64)", "233"),
+        ("s.indexOf('b')", "2000"),
+        ("s.lastIndexOf('\\u00e9')", "1998"),
+        ("s.substring(1998, 2002)", "éabb"),
+        ("s.charAt(3200)", ""),
+        // Surrogate pairs, split by stride boundaries.
+        ("e.length", "1114"),
+        ("e.charCodeAt(64)", "56832"),
+        ("e.charCodeAt(65)", "120"),
+        ("e.charCodeAt(1000)", "56832"),
+        ("e.charCodeAt(1001)", "120"),
+        ("e.charCodeAt(e.length - 1)", "56832"),
+        ("e.substring(63, 66).length", "3"),
+        ("e.indexOf('x', 100)", "104"),
+        ("e.lastIndexOf('x', 1000)", "988"),
+        ("e.slice(-2) === '\\ud83d\\ude00'", "true"),
+        // Unpaired surrogates.
+        ("lone.length", "1100"),
+        ("lone.charCodeAt(1050)", "55296"),
+        ("lone.charCodeAt(66)", "55296"),
+        ("lone.charCodeAt(1099)", "97"),
+        ("lone.indexOf('\\ud800', 1000)", "1002"),
+    ]);
+}
+
+#[test]
+fn string_search() {
+    let ducc = Ducc::new();
+    eval(&ducc, r#"
+        var long = new Array(40).join('abcdefghijklmnopqrstuvwxyz0123456789') + 'NEEDLE' +
+            new Array(20).join('x');
+        var uni = new Array(30).join('café 中文 ') + '😀end';
+        var near = new Array(64).join('a') + 'b';
+        '';
+    "#);
+    check_cases(&ducc, &[
+        // Long ASCII haystacks, past the 16 and 32 byte blocks of the vectorized search.
+        ("long.length", "1429"),
+        ("long.indexOf('NEEDLE')", "1404"),
+        ("long.indexOf('NEEDLE', 1365)", "1404"),
+        ("long.indexOf('NEEDLE', 1366)", "1404"),
+        ("long.lastIndexOf('NEEDLE')", "1404"),
+        ("long.indexOf('x')", "23"),
+        ("long.lastIndexOf('x')", "1428"),
+        ("long.indexOf('z9')", "-1"),
+        ("long.indexOf('')", "0"),
+        ("long.indexOf('', 5)", "5"),
+        ("long.indexOf('', 99999)", "1429"),
+        ("long.lastIndexOf('')", "1429"),
+        ("long.lastIndexOf('', 3)", "3"),
+        ("long.includes('NEEDLEx')", "true"),
+        ("long.includes('NEEDLEy')", "false"),
+        ("long.indexOf('0123456789abcdefg', 20)", "26"),
+        ("long.indexOf(long + '!')", "-1"),
+        ("long.indexOf(long)", "0"),
+        // Near misses at the end of a block.
+        ("near.indexOf('aab')", "61"),
+        ("near.indexOf('ab')", "62"),
+        ("near.lastIndexOf('aa')", "61"),
+        ("near.indexOf('b', 63)", "63"),
+        ("near.indexOf('b', 64)", "-1"),
+        ("near.indexOf('a', -5)", "0"),
+        // Non-ASCII haystacks and needles, including surrogate pairs and halves.
+        ("uni.indexOf('é')", "3"),
+        ("uni.indexOf('中', 10)", "13"),
+        ("uni.lastIndexOf('文')", "230"),
+        ("uni.indexOf('😀')", "232"),
+        ("uni.indexOf('\\ude00')", "233"),
+        ("uni.indexOf('😀e')", "232"),
+        ("uni.indexOf('café 中文 c', 200)", "200"),
+        // Empty and one-char strings.
+        ("''.indexOf('')", "0"),
+        ("''.indexOf('a')", "-1"),
+        ("'a'.indexOf('a')", "0"),
+        ("'a'.lastIndexOf('a', -1)", "0"),
+        // split() and replace().
+        ("long.split('NEEDLE').length", "2"),
+        ("long.split('x').length", "59"),
+        ("long.split('', 3).join('|')", "a|b|c"),
+        ("uni.split('中').length", "30"),
+        ("uni.split('中', 2).join('|')", "café |文 café "),
+        ("'x中y中z'.split('中').join(',')", "x,y,z"),
+        ("'aaa'.split('a').join(',')", ",,,"),
+        ("long.replace('NEEDLE', '<$&>').indexOf('<NEEDLE>')", "1404"),
+        ("uni.replace('中文', '[$&]').slice(0, 12)", "café [中文] ca"),
+        ("'abc'.replace('', '-')", "-abc"),
+        ("'abc'.replace('c', '$$')", "ab$"),
+    ]);
+}
+
+#[test]
+fn number_conversion() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var values = [0, -0, 1, -1, 0.1, 0.2 + 0.1, 1 / 3, 2 / 3, 5e-324, 2.2250738585072014e-308,
+            1.7976931348623157e308, 9007199254740991, 9007199254740992, 4294967296,
+            -1500000000123, 123456789012345680000, 1e21, 1e-6, 1e-7, 123e-20, 0.000001234, 5e-7,
+            1.5, 100, 1e15 + 0.5, Math.PI, -Math.E, 2 / 1e23, 4.35, 0.3];
+        var out = [];
+        for (var i = 0; i < values.length; i++) { out.push(String(values[i])); }
+        var ok = true, x = 0.5;
+        for (var j = 0; j < 20000; j++) {
+            x = (x * 3.7 + 0.11) % 1000;
+            var v = x * Math.pow(10, (j % 40) - 30);
+            if (Number(String(v)) !== v || parseFloat(v.toString()) !== v) { ok = false; }
+        }
+        out.push(ok, JSON.stringify([0.1, -2.5e-8, 1e300]), JSON.parse('[1.25e2, 0.7, -3e-3, 12345678901234567890]').join(' '));
+        out.join('|');
+    "#);
+    assert_eq!(result, "0|0|1|-1|0.1|0.30000000000000004|0.3333333333333333|0.6666666666666666|5e-324|\
+        2.2250738585072014e-308|1.7976931348623157e+308|9007199254740991|9007199254740992|4294967296|\
+        -1500000000123|123456789012345680000|1e+21|0.000001|1e-7|1.23e-18|0.000001234|5e-7|\
+        1.5|100|1000000000000000.5|3.141592653589793|-2.718281828459045|2e-23|4.35|0.3|true|\
+        [0.1,-2.5e-8,1e+300]|125 0.7 -0.003 12345678901234567000");
+}
+
+#[test]
+fn text_codecs() {
+    let ducc = Ducc::new();
+    eval(&ducc, r#"
+        function hex(u) { var r = ''; for (var i = 0; i < u.length; i++) { r += (u[i] | 256).toString(16).slice(1); } return r; }
+        function enc(s) { return hex(new TextEncoder().encode(s)); }
+        function codes(s) { var r = []; for (var i = 0; i < s.length; i++) { r.push(s.charCodeAt(i).toString(16)); } return r.join(' '); }
+        function dec(bytes, opts) {
+            try { return codes(new TextDecoder('utf-8', opts).decode(new Uint8Array(bytes))); } catch (e) { return e.name; }
+        }
+        function ascii(n) { var a = []; for (var i = 0; i < n; i++) { a.push(0x61 + i % 26); } return a; }
+        '';
+    "#);
+    check_cases(&ducc, &[
+        // Encoding, with unpaired surrogates replaced by U+FFFD.
+        ("enc('')", ""),
+        ("enc('a')", "61"),
+        ("enc('é')", "c3a9"),
+        ("enc('中')", "e4b8ad"),
+        ("enc('😀')", "f09f9880"),
+        ("enc('\\ud800')", "efbfbd"),
+        ("enc('\\udc00')", "efbfbd"),
+        ("enc('a\\ud800b')", "61efbfbd62"),
+        ("enc('\\udc00\\ud800')", "efbfbdefbfbd"),
+        ("enc('😀\\ud83d')", "f09f9880efbfbd"),
+        // Lengths just past the 16 and 32 byte blocks of the ASCII fast path.
+        ("new TextEncoder().encode(new Array(17).join('a') + 'é').length", "18"),
+        ("new TextEncoder().encode(new Array(33).join('a') + '😀').length", "36"),
+        ("new TextEncoder().encode(new Array(32).join('a') + '\\ud800').length", "34"),
+        // Decoding valid and invalid UTF-8, including CESU-8 encoded surrogates and truncation.
+        ("dec([])", ""),
+        ("dec([0x41])", "41"),
+        ("dec([0xc3, 0xa9])", "e9"),
+        ("dec([0xf0, 0x9f, 0x98, 0x80])", "d83d de00"),
+        ("dec([0xff])", "fffd"),
+        ("dec([0xc3])", "fffd"),
+        ("dec([0xc3, 0x28])", "fffd 28"),
+        ("dec([0xc0, 0xaf])", "fffd fffd"),
+        ("dec([0xe0, 0x80, 0xaf])", "fffd fffd fffd"),
+        ("dec([0xed, 0xa0, 0x80])", "fffd fffd fffd"),
+        ("dec([0xed, 0xa0, 0xbd, 0xed, 0xb8, 0x80])", "fffd fffd fffd fffd fffd fffd"),
+        ("dec([0xf4, 0x90, 0x80, 0x80])", "fffd fffd fffd fffd"),
+        ("dec([0xf0, 0x9f, 0x98])", "fffd"),
+        // The BOM is stripped unless ignoreBOM is set.
+        ("dec([0xef, 0xbb, 0xbf, 0x41])", "41"),
+        ("dec([0xef, 0xbb, 0xbf, 0x41], { ignoreBOM: true })", "feff 41"),
+        // Fatal mode throws instead of substituting.
+        ("dec([0xc3], { fatal: true })", "TypeError"),
+        ("dec([0xed, 0xa0, 0x80], { fatal: true })", "TypeError"),
+        ("dec([0xc3, 0xa9], { fatal: true })", "e9"),
+        // Non-ASCII and invalid bytes at the end of a block.
+        ("dec(ascii(15).concat([0xc3, 0xa9])).slice(-5)", "6f e9"),
+        ("dec(ascii(16).concat([0x80])).slice(-7)", "70 fffd"),
+        ("dec(ascii(31).concat([0xff], ascii(2))).split(' ').length", "34"),
+        ("dec(ascii(32).concat([0xe4, 0xb8, 0xad])).slice(-7)", "66 4e2d"),
+        ("dec(ascii(33)) === codes(String.fromCharCode.apply(null, ascii(33)))", "true"),
+    ]);
+}
+
+#[test]
+fn typed_array_kernels() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        function dump(a) { return Array.prototype.join.call(a, ' '); }
+        var out = [];
+        var u8 = new Uint8Array(8), c8 = new Uint8ClampedArray(4), i16 = new Int16Array(6);
+        out.push(dump(u8.fill(7, 2, -2)), dump(c8.fill(300)), dump(i16.fill(-70000.9)));
+        var f = new Float64Array([1, 2, 3, 4, 5, 6]);
+        out.push(dump(f.copyWithin(0, 3)), dump(f.copyWithin(-2, 0, 2)), dump(f.copyWithin(2, -10, -4)));
+        var s = f.slice(1, -1);
+        s[0] = 99;
+        out.push(s instanceof Float64Array, dump(s), f[1], dump(new Int8Array(f.buffer, 0, 8).slice(-3)));
+        var i32 = new Int32Array(5);
+        i32.set([1.9, -1.9, 4294967295, NaN, '5']);
+        var u16 = new Uint16Array(4);
+        u16.set(new Float64Array([-1, 65536.5, Infinity, 3]));
+        var cl = new Uint8ClampedArray(5);
+        cl.set([-5, 0.5, 1.5, 254.5, 1e9]);
+        out.push(dump(i32), dump(u16), dump(cl));
+        out.join('|');
+    "#);
+    assert_eq!(
+        result,
+        "0 0 7 7 7 7 0 0|255 255 255 255|-4464 -4464 -4464 -4464 -4464 -4464|\
+         4 5 6 4 5 6|4 5 6 4 4 5|4 5 4 5 4 5|true|99 4 5 4|5|0 16 64|\
+         1 -1 -1 0 5|65535 0 0 3|0 0 2 254 255"
+    );
+}
+
+#[test]
+fn date_conversions() {
+    let ducc = Ducc::new();
+    let result = eval(&ducc, r#"
+        var out = [], bad = 0;
+        var t = [0, -1, 951782400000, 946684799999, -62198755200001, 8.64e15, -8.64e15, 4107542400000];
+        for (var i = 0; i < t.length; i++) {
+            var d = new Date(t[i]);
+            out.push(d.toISOString());
+            if (Date.parse(d.toISOString()) !== t[i]) { bad++; }
+            out.push([d.getUTCFullYear(), d.getUTCMonth(), d.getUTCDate(), d.getUTCDay()].join('-'));
+        }
+        for (var day = -600000; day < 800000; day += 997) {
+            var d = new Date(day * 86400000 + 43200000);
+            var l = new Date(2000, 0, 1, d.getHours(), d.getMinutes());
+            l.setFullYear(d.getFullYear(), d.getMonth(), d.getDate());
+            if (l.getDate() !== d.getDate() || l.getHours() !== d.getHours()) { bad++; }
+            if (Date.UTC(d.getUTCFullYear(), d.getUTCMonth(), d.getUTCDate(), 12) !== d.getTime()) { bad++; }
+        }
+        out.push(Date.parse('2012-01-02T03:04:05.678Z'), Date.parse('2012-01-02T03:04:05.6789Z'),
+            Date.parse('+002012-01-02T03:04:05.678Z'), Date.parse('2012-13-02T03:04:05.678Z'),
+            JSON.stringify({ d: new Date(1e12) }), bad);
+        out.join('|');
+    "#);
+    assert_eq!(
+        result,
+        "1970-01-01T00:00:00.000Z|1970-0-1-4|1969-12-31T23:59:59.999Z|1969-11-31-3|\
+         2000-02-29T00:00:00.000Z|2000-1-29-2|1999-12-31T23:59:59.999Z|1999-11-31-5|\
+         -000002-12-31T23:59:59.999Z|-2-11-31-4|+275760-09-13T00:00:00.000Z|275760-8-13-6|\
+         -271821-04-20T00:00:00.000Z|-271821-3-20-2|2100-03-01T00:00:00.000Z|2100-2-1-1|\
+         1325473445678|1325473445678|1325473445678|1357095845678|\
+         {\"d\":\"2001-09-09T01:46:40.000Z\"}|0"
+    );
+}
@@ -0,0 +1,119 @@
+use ducc::Ducc;
+use error::{Error, Result};
+use host::HostObject;
+use std::sync::{Arc, Mutex};
+use value::{ToValue, Value};
+
+struct Point {
+    x: f64,
+    y: f64,
+}
+
+impl HostObject for Point {
+    fn get<'ducc>(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<Value<'ducc>>> {
+        Ok(match key {
+            "x" => Some(self.x.to_value(ducc)?),
+            "y" => Some(self.y.to_value(ducc)?),
+            "norm" => Some((self.x * self.x + self.y * self.y).sqrt().to_value(ducc)?),
+            _ => None,
+        })
+    }
+
+    fn set<'ducc>(&mut self, _ducc: &'ducc Ducc, key: &str, value: Value<'ducc>) -> Result<bool> {
+        let value = match value.as_number() {
+            Some(value) => value,
+            None => return Err(Error::from_js_conversion(value.type_name(), "f64")),
+        };
+        match key {
+            "x" => self.x = value,
+            "y" => self.y = value,
+            _ => return Ok(false),
+        }
+        Ok(true)
+    }
+
+    fn own_keys(&self, _ducc: &Ducc) -> Result<Vec<String>> {
+        Ok(vec!["x".to_string(), "y".to_string()])
+    }
+}
+
+#[test]
+fn host_object_properties() {
+    let ducc = Ducc::new();
+    let point = ducc.create_host_object(Point { x: 3.0, y: 4.0 });
+    ducc.globals().set("point", point).unwrap();
+
+    let result: String = ducc.exec(r#"
+        var out = [point.x, point.y, point.norm, point.z, 'x' in point, 'z' in point];
+        out.push('toString' in point, 'hasOwnProperty' in point);
+        point.x = 6;
+        point.y = 8;
+        out.push(point.norm, Object.keys(point).join('+'), JSON.stringify(point));
+        var keys = [];
+        for (var k in point) { keys.push(k); }
+        out.push(keys.join('+'), String(point), typeof point.hasOwnProperty);
+        try { (function () { 'use strict'; point.z = 1; })(); } catch (e) { out.push(e.name); }
+        try { point.x = 'a'; } catch (e) { out.push(e.name); }
+        out.push(delete point.x, point.x);
+        out.join();
+    "#, None, Default::default()).unwrap();
+    assert_eq!(
+        result,
+        "3,4,5,,true,false,true,true,10,x+y,{\"x\":6,\"y\":8},x+y,[object Object],function,\
+         TypeError,TypeError,false,6"
+    );
+}
+
+struct Log(Arc<Mutex<Vec<String>>>);
+
+impl HostObject for Log {
+    fn get<'ducc>(&self, ducc: &'ducc Ducc, key: &str) -> Result<Option<Value<'ducc>>> {
+        let lines = self.0.lock().unwrap();
+        if key == "length" {
+            return Ok(Some(lines.len().to_value(ducc)?));
+        }
+        match key.parse::<usize>().ok().and_then(|index| lines.get(index)) {
+            Some(line) => Ok(Some(line.as_str().to_value(ducc)?)),
+            None => Ok(None),
+        }
+    }
+
+    fn set<'ducc>(&mut self, _ducc: &'ducc Ducc, key: &str, value: Value<'ducc>) -> Result<bool> {
+        let mut lines = self.0.lock().unwrap();
+        if key.parse::<usize>().ok() != Some(lines.len()) {
+            return Ok(false);
+        }
+        lines.push(value.as_string().unwrap().to_string()?);
+        Ok(true)
+    }
+
+    fn delete(&mut self, _ducc: &Ducc, key: &str) -> Result<bool> {
+        let mut lines = self.0.lock().unwrap();
+        Ok(key.parse::<usize>().ok() == Some(lines.len() - 1) && lines.pop().is_some())
+    }
+
+    fn own_keys(&self, _ducc: &Ducc) -> Result<Vec<String>> {
+        Ok((0..self.0.lock().unwrap().len()).map(|index| index.to_string()).collect())
+    }
+}
+
+#[test]
+fn host_object_indices() {
+    let lines = Arc::new(Mutex::new(vec!["a".to_string()]));
+    let ducc = Ducc::new();
+    ducc.globals().set("log", ducc.create_host_object(Log(lines.clone()))).unwrap();
+
+    let result: String = ducc.exec(r#"
+        log[log.length] = 'b';
+        log[log.length] = 'c';
+        log[7] = 'x';
+        var out = [log.length, log[0], log[2], log[7], 1 in log, 7 in log];
+        out.push(delete log[0], delete log[2], Object.keys(log).join('+'));
+        out.join();
+    "#, None, Default::default()).unwrap();
+    assert_eq!(result, "3,a,c,,true,false,false,true,0+1");
+    assert_eq!(*lines.lock().unwrap(), vec!["a".to_string(), "b".to_string()]);
+
+    drop(ducc);
+    assert_eq!(Arc::strong_count(&lines), 1);
+}
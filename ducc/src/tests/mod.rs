@@ -1,8 +1,16 @@
 mod array;
 mod bytes;
+mod class;
+mod codec;
 mod conversion;
 mod ducc;
+mod engine;
 mod function;
+mod host;
 mod object;
+mod profiler;
+mod proxy;
+mod snapshot;
+mod stats;
 mod string;
 mod util;
@@ -0,0 +1,112 @@
+use ducc::Ducc;
+use error::Result;
+use function::{Function, Invocation};
+use profiler::AllocationKind;
+use value::Value;
+
+#[test]
+fn profiler_samples() {
+    let ducc = Ducc::new();
+    let call = ducc.create_function(|inv: Invocation| -> Result<Value> {
+        let func: Function = inv.args.from(inv.ducc, 0)?;
+        func.call(())
+    });
+    ducc.globals().set("call", call).unwrap();
+
+    ducc.start_profiler(100);
+    ducc.exec::<()>(r#"
+        function hot(n) {
+            var s = 0; for (var i = 0; i < n; i++) { s += i; } return s;
+        }
+        function outer() {
+            for (var k = 0; k < 20; k++) { hot(10000); }
+        }
+        outer();
+        call(function viaNative() { hot(10000); });
+    "#, Some("prof.js"), Default::default()).unwrap();
+    ducc.stop_profiler();
+
+    let profile = ducc.profile();
+    let total = profile.samples();
+    let in_hot: u64 = profile.stacks.iter()
+        .filter(|stack| {
+            let frame = stack.frames.last().unwrap();
+            frame.function == "hot" && frame.file_name == "prof.js" && frame.line == 3
+        })
+        .map(|stack| stack.samples)
+        .sum();
+    assert!(total > 100);
+    assert!(in_hot * 10 > total * 9);
+
+    let collapsed = profile.to_collapsed();
+    assert!(collapsed.contains("eval (prof.js:8);outer (prof.js:6);hot (prof.js:3) "));
+    assert!(collapsed.contains(";(anonymous) [native];viaNative (prof.js:9);hot (prof.js:3) "));
+
+    ducc.exec::<()>("for (var i = 0; i < 100000; i++) {}", None, Default::default()).unwrap();
+    assert_eq!(ducc.profile().samples(), total);
+
+    ducc.start_profiler(100);
+    assert_eq!(ducc.profile().samples(), 0);
+    ducc.stop_profiler();
+}
+
+#[test]
+fn allocation_profiler_sites() {
+    let ducc = Ducc::new();
+    ducc.start_allocation_profiler(1, 8);
+    // Allocations are on lines without calls, which would otherwise update the reported pc.
+    ducc.exec::<()>(r#"
+        var kept = [];
+        function grow() {
+            var list = null;
+            for (var i = 0; i < 1000; i++) {
+                list = { index: i, next: list };
+            }
+            kept[0] = list;
+        }
+        function strings() {
+            var list = [];
+            for (var i = 0; i < 100; i++) {
+                list[i] = 'str' + i;
+            }
+            kept[1] = list;
+        }
+        grow();
+        strings();
+    "#, Some("alloc.js"), Default::default()).unwrap();
+    ducc.stop_allocation_profiler();
+
+    let profile = ducc.allocation_profile();
+    assert_eq!(profile.interval, 1);
+    let site = |kind: AllocationKind, function: &str, line: u32| profile.sites.iter()
+        .find(|site| {
+            let frame = site.frames.last();
+            site.kind == kind && frame.map_or(false, |frame| {
+                frame.function == function && frame.file_name == "alloc.js" && frame.line == line
+            })
+        })
+        .cloned()
+        .unwrap();
+
+    let objects = site(AllocationKind::Object, "grow", 6);
+    assert_eq!(objects.allocations, 1000);
+    assert_eq!(objects.samples, 1000);
+    assert_eq!(objects.frames[0].function, "eval");
+    assert!(objects.bytes >= 1000 * 8);
+    assert!(site(AllocationKind::Properties, "grow", 6).allocations >= 1000);
+    assert!(site(AllocationKind::String, "strings", 13).allocations >= 100);
+
+    let collapsed = profile.to_collapsed();
+    assert!(collapsed.contains("eval (alloc.js:17);grow (alloc.js:6);[Object] "));
+
+    ducc.exec::<()>("kept.push({});", None, Default::default()).unwrap();
+    assert_eq!(ducc.allocation_profile().bytes(), profile.bytes());
+
+    ducc.start_allocation_profiler(1024, 1);
+    ducc.exec::<()>("var big = []; for (var i = 0; i < 10000; i++) { big.push([i]); }",
+        None, Default::default()).unwrap();
+    ducc.stop_allocation_profiler();
+    let profile = ducc.allocation_profile();
+    assert!(profile.sites.iter().all(|site| site.frames.len() <= 1));
+    assert!(profile.bytes() > 10000 * 8);
+}
@@ -0,0 +1,87 @@
+use ducc::Ducc;
+use error::{Error, ErrorKind, Result, RuntimeError, RuntimeErrorCode};
+use proxy::ProxyHandler;
+use std::collections::BTreeMap;
+use std::sync::{Arc, Mutex};
+use value::Value;
+
+#[test]
+fn native_traps() {
+    let ducc = Ducc::new();
+    let store = Arc::new(Mutex::new(BTreeMap::new()));
+    store.lock().unwrap().insert("a".to_string(), 1.0);
+
+    let (get_store, set_store, has_store, delete_store, keys_store) =
+        (store.clone(), store.clone(), store.clone(), store.clone(), store.clone());
+    let handler = ProxyHandler::new()
+        .get(move |_, key| Ok(get_store.lock().unwrap().get(key).cloned()))
+        .set(move |_, key, value| {
+            let value = value.as_number().unwrap();
+            set_store.lock().unwrap().insert(key.to_string(), value);
+            Ok(value >= 0.0)
+        })
+        .has(move |_, key| Ok(has_store.lock().unwrap().contains_key(key)))
+        .delete(move |_, key| Ok(delete_store.lock().unwrap().remove(key).is_some()))
+        .own_keys(move |_| -> Result<Vec<String>> {
+            Ok(keys_store.lock().unwrap().keys().cloned().collect())
+        });
+
+    ducc.globals().set("p", ducc.create_proxy(&ducc.create_object(), handler)).unwrap();
+
+    let result: String = ducc.exec(r#"
+        p.b = 2;
+        p[7] = 7;
+        var out = [p.a, p.b, p.c, p['7'], 'a' in p, 'c' in p, delete p.a, delete p.a];
+        out.push(Object.keys(p).join('+'));
+        try { (function () { 'use strict'; p.b = -1; })(); } catch (e) { out.push(e.name); }
+        out.join();
+    "#, None, Default::default()).unwrap();
+    assert_eq!(result, "1,2,,7,true,false,true,false,7+b,TypeError");
+    assert_eq!(store.lock().unwrap().get("b"), Some(&-1.0));
+    assert!(!store.lock().unwrap().contains_key("a"));
+
+    drop(ducc);
+    assert_eq!(Arc::strong_count(&store), 1);
+}
+
+#[test]
+fn native_trap_errors() {
+    #[derive(Debug)]
+    struct Denied;
+
+    impl RuntimeError for Denied {
+        fn code(&self) -> RuntimeErrorCode {
+            RuntimeErrorCode::RangeError
+        }
+
+        fn message(&self) -> Option<String> {
+            Some("access denied".to_string())
+        }
+    }
+
+    let ducc = Ducc::new();
+    let handler = ProxyHandler::new().get(|_, key| -> Result<Value> {
+        match key.parse::<u32>() {
+            Ok(_) => Err(Error::external(Denied)),
+            Err(_) => Ok(Value::Undefined),
+        }
+    });
+    let proxy = ducc.create_proxy(&ducc.create_object(), handler);
+    ducc.globals().set("p", proxy).unwrap();
+
+    let result: String = ducc.exec(r#"
+        var out = [typeof p.x];
+        try { p[0]; } catch (e) { out.push(e instanceof RangeError, e.message); }
+        out.join();
+    "#, None, Default::default()).unwrap();
+    assert_eq!(result, "undefined,true,access denied");
+
+    // Uncaught errors keep their Rust identity on the way back out.
+    let result = ducc.exec::<Value>("p[1]", None, Default::default());
+    match result {
+        Err(Error { kind: ErrorKind::ExternalError(error), .. }) => {
+            assert_eq!(error.code(), RuntimeErrorCode::RangeError);
+        },
+        other => panic!("unexpected result: {:?}", other),
+    }
+}
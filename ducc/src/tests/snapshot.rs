@@ -0,0 +1,50 @@
+use ducc::Ducc;
+use std::str;
+
+const SCRIPT: &str = r#"
+    function Entry(i) {
+        this.id = i;
+        this.payload = new Array(50).join('x') + i;
+    }
+    var cache = [];
+    for (var i = 0; i < 1000; i++) {
+        cache.push(new Entry(i));
+    }
+"#;
+
+#[test]
+fn heap_summary_retainers() {
+    let ducc = Ducc::new();
+    ducc.exec::<()>(SCRIPT, None, Default::default()).unwrap();
+
+    let summary = ducc.heap_summary(20);
+    assert!(summary.nodes > 2000);
+    assert!(summary.total_size > summary.unreachable_size);
+
+    let entries = summary.groups.iter().find(|group| group.name == "Entry").unwrap();
+    assert_eq!(entries.count, 1000);
+    assert!(entries.retained_size > entries.self_size);
+
+    let cache = summary.retainers.iter().find(|retainer| retainer.path.ends_with(".cache"));
+    let cache = cache.unwrap();
+    assert_eq!(cache.name, "Array");
+    assert!(cache.retained_size > entries.retained_size);
+
+    ducc.exec::<()>("cache = null;", None, Default::default()).unwrap();
+    let summary = ducc.heap_summary(20);
+    assert!(summary.groups.iter().all(|group| group.name != "Entry"));
+}
+
+#[test]
+fn heap_snapshot_chrome_format() {
+    let ducc = Ducc::new();
+    ducc.exec::<()>(SCRIPT, None, Default::default()).unwrap();
+
+    let mut out = Vec::new();
+    ducc.heap_snapshot(&mut out).unwrap();
+    let json = str::from_utf8(&out).unwrap();
+    assert!(json.starts_with(r#"{"snapshot":{"meta":{"node_fields":["type","name","id""#));
+    assert!(json.contains("\n\"Entry\""));
+    assert!(json.contains("\n\"cache\""));
+    assert!(json.trim_end().ends_with("]}"));
+}
@@ -0,0 +1,65 @@
+use class::ClassBuilder;
+use ducc::Ducc;
+use error::Result;
+use function::{Function, Invocation};
+use value::Value;
+
+#[test]
+fn function_stats() {
+    let ducc = Ducc::new();
+    let call = ducc.create_function(|inv: Invocation| -> Result<Value> {
+        let func: Function = inv.args.from(inv.ducc, 0)?;
+        func.call(())
+    });
+    let call_line = line!() - 4;
+    ducc.globals().set("call", call).unwrap();
+    let class = ducc.create_class(ClassBuilder::new().method("get", |_, value: &u32, _| Ok(*value)));
+    ducc.globals().set("counter", class.create(7)).unwrap();
+
+    ducc.exec::<()>("function before() {} before();", None, Default::default()).unwrap();
+    ducc.start_function_stats();
+    ducc.exec::<()>(r#"
+        function leaf(n) {
+            var s = 0; for (var i = 0; i < n; i++) { s += i; } return s;
+        }
+        function outer() {
+            for (var k = 0; k < 10; k++) { leaf(1000); }
+        }
+        outer();
+        outer();
+        call(function viaNative() { leaf(10); });
+        counter.get(); counter.get(); counter.get();
+    "#, Some("stats.js"), Default::default()).unwrap();
+    ducc.stop_function_stats();
+    ducc.exec::<()>("outer();", None, Default::default()).unwrap();
+
+    let stats = ducc.function_stats();
+    let find = |name: &str| stats.iter().find(|s| s.function == name && !s.native);
+
+    let leaf = find("leaf").unwrap();
+    assert_eq!(leaf.calls, 21);
+    assert_eq!(leaf.file_name, "stats.js");
+    assert_eq!(leaf.line, 3);
+    assert_eq!(leaf.self_time, leaf.total_time);
+
+    let outer = find("outer").unwrap();
+    assert_eq!(outer.calls, 2);
+    assert!(outer.total_time >= outer.self_time);
+    assert!(outer.total_time >= leaf.total_time - find("viaNative").unwrap().total_time);
+    assert!(find("before").is_none());
+
+    let native = stats.iter()
+        .find(|s| s.native && s.file_name == file!() && s.line == call_line)
+        .unwrap();
+    assert_eq!(native.calls, 1);
+    assert_eq!(native.function, "");
+    assert!(native.total_time >= find("viaNative").unwrap().total_time);
+
+    let method = stats.iter().find(|s| s.native && s.function == "get").unwrap();
+    assert_eq!(method.calls, 3);
+    assert_eq!(method.file_name, file!());
+
+    ducc.start_function_stats();
+    assert!(ducc.function_stats().is_empty());
+    ducc.stop_function_stats();
+}
@@ -2,9 +2,12 @@ use cesu8::{from_cesu8, to_cesu8};
 use ducc::ExecSettings;
 use error::{Error, ErrorKind, Result, RuntimeErrorCode};
 use ffi;
+use profiler::{AllocationProfiler, Profiler};
+use stats::StatsRecorder;
+use std::borrow::Cow;
 use std::ffi::{CStr, CString};
 use std::os::raw::{c_char, c_void};
-use std::{process, ptr, slice};
+use std::{process, ptr, slice, str};
 use std::sync::Once;
 use types::AnyMap;
 
@@ -235,16 +238,40 @@ pub(crate) unsafe fn push_bytes(ctx: *mut ffi::duk_context, value: &[u8]) -> Res
     })
 }
 
+// Returns `bytes` as a string if they are all ASCII, which reads the same in UTF-8 and CESU-8. Uses
+// Duktape's (vectorized) ASCII scan.
+pub(crate) fn ascii_str(bytes: &[u8]) -> Option<&str> {
+    let span = unsafe { ffi::duk_ascii_span(bytes.as_ptr() as *const c_void, bytes.len()) };
+    if span == bytes.len() {
+        Some(unsafe { str::from_utf8_unchecked(bytes) })
+    } else {
+        None
+    }
+}
+
+// Converts a CESU-8 string to a UTF-8 string, borrowing it if no conversion is necessary.
+pub(crate) fn cesu8_to_str(bytes: &[u8]) -> Option<Cow<str>> {
+    match ascii_str(bytes) {
+        Some(string) => Some(Cow::Borrowed(string)),
+        None => from_cesu8(bytes).ok(),
+    }
+}
+
 // Converts a UTF-8 Rust string to a CESU-8 string and pushes it onto the Duktape stack. Returns an
 // error if the conversion failed.
 pub(crate) unsafe fn push_str(ctx: *mut ffi::duk_context, value: &str) -> Result<()> {
-    let string = CString::new(to_cesu8(value))
-        .map_err(|_| Error::to_js_conversion("&str", "string"))?;
+    let bytes = match ascii_str(value.as_bytes()) {
+        Some(string) => Cow::Borrowed(string.as_bytes()),
+        None => to_cesu8(value),
+    };
+    if bytes.contains(&0) {
+        return Err(Error::to_js_conversion("&str", "string"));
+    }
 
     assert_stack!(ctx, 1, {
         protect_duktape_closure(ctx, 0, 1, |ctx| {
             ffi::duk_require_stack(ctx, 1);
-            ffi::duk_push_lstring(ctx, string.as_ptr(), string.as_bytes().len());
+            ffi::duk_push_lstring(ctx, bytes.as_ptr() as *const c_char, bytes.len());
         })
     })
 }
@@ -259,9 +286,9 @@ unsafe fn get_string(ctx: *mut ffi::duk_context, idx: ffi::duk_idx_t) -> String
     }
 
     let bytes = slice::from_raw_parts(string as *const u8, len as usize);
-    match from_cesu8(bytes) {
-        Ok(string) => string.into_owned(),
-        Err(_) => String::new(),
+    match cesu8_to_str(bytes) {
+        Some(string) => string.into_owned(),
+        None => String::new(),
     }
 }
 
@@ -271,7 +298,12 @@ const ANYMAP: [i8; 8] = hidden_i8str!('a', 'n', 'y', 'm', 'a', 'p');
 pub(crate) unsafe fn create_heap() -> *mut ffi::duk_context {
     ensure_exec_timeout_check_exists();
 
-    let udata = Box::into_raw(Box::new(Udata { exec_settings: None }));
+    let udata = Box::into_raw(Box::new(Udata {
+        exec_settings: None,
+        profiler: None,
+        call_stats: None,
+        alloc_profiler: None,
+    }));
     let ctx = ffi::duk_create_heap(None, None, None, udata as *mut _, Some(fatal_handler));
     assert!(!ctx.is_null());
 
@@ -317,6 +349,15 @@ unsafe extern "C" fn fatal_handler(_udata: *mut c_void, msg: *const c_char) {
 
 pub(crate) struct Udata {
     exec_settings: Option<ExecSettings>,
+    // Passed to Duktape as the sampling callback's `udata` while profiling, see
+    // `Ducc::start_profiler`.
+    pub profiler: Option<Box<Profiler>>,
+    // Passed to Duktape as the call statistics callback's `udata`, see
+    // `Ducc::start_function_stats`.
+    pub call_stats: Option<Box<StatsRecorder>>,
+    // Passed to Duktape as the allocation sampler's `udata`, see
+    // `Ducc::start_allocation_profiler`.
+    pub alloc_profiler: Option<Box<AllocationProfiler>>,
 }
 
 impl Udata {